@@ -18,6 +18,11 @@ namespace api
 			{
 				RegisterGet(R"()", &InternalsController::OnGetInternals);
 				RegisterGet(R"(\/queues)", &InternalsController::OnGetQueues);
+				RegisterGet(R"(\/sockets)", &InternalsController::OnGetSockets);
+				RegisterGet(R"(\/executor)", &InternalsController::OnGetExecutor);
+				RegisterGet(R"(\/memory)", &InternalsController::OnGetMemory);
+				RegisterGet(R"(\/fileCache)", &InternalsController::OnGetFileCache);
+				RegisterGet(R"(\/convertedData)", &InternalsController::OnGetConvertedData);
 			};
 
 			ApiResponse InternalsController::OnGetInternals(const std::shared_ptr<http::svr::HttpExchange> &client)
@@ -25,6 +30,11 @@ namespace api
 				Json::Value response(Json::ValueType::arrayValue);
 
 				response.append("/v1/stats/current/internals/queues");
+				response.append("/v1/stats/current/internals/sockets");
+				response.append("/v1/stats/current/internals/executor");
+				response.append("/v1/stats/current/internals/memory");
+				response.append("/v1/stats/current/internals/fileCache");
+				response.append("/v1/stats/current/internals/convertedData");
 
 				return response;
 			}
@@ -47,6 +57,43 @@ namespace api
 
 				return response;
 			}
+
+			ApiResponse InternalsController::OnGetSockets(const std::shared_ptr<http::svr::HttpExchange> &client)
+			{
+				Json::Value response(Json::ValueType::arrayValue);
+
+				for (auto &socket_pool : ov::SocketPool::GetPoolList())
+				{
+					Json::Value obj = serdes::JsonFromSocketPool(socket_pool);
+
+					if (obj.isNull())
+						continue;
+
+					response.append(obj);
+				}
+
+				return response;
+			}
+
+			ApiResponse InternalsController::OnGetExecutor(const std::shared_ptr<http::svr::HttpExchange> &client)
+			{
+				return serdes::JsonFromTaskExecutor(ov::TaskExecutor::GetInstance());
+			}
+
+			ApiResponse InternalsController::OnGetMemory(const std::shared_ptr<http::svr::HttpExchange> &client)
+			{
+				return serdes::JsonFromMemoryPoolStats(ov::MemoryPool::GetStats());
+			}
+
+			ApiResponse InternalsController::OnGetFileCache(const std::shared_ptr<http::svr::HttpExchange> &client)
+			{
+				return serdes::JsonFromFileCacheStats(ov::FileCache::GetInstance()->GetStats());
+			}
+
+			ApiResponse InternalsController::OnGetConvertedData(const std::shared_ptr<http::svr::HttpExchange> &client)
+			{
+				return serdes::JsonFromConvertedDataStats(MediaPacketConvertedData::GetHitCount(), MediaPacketConvertedData::GetMissCount());
+			}
 		}  // namespace stats
 	}	   // namespace v1
 }  // namespace api
\ No newline at end of file
@@ -24,6 +24,15 @@ namespace api
 			protected:
 				ApiResponse OnGetInternals(const std::shared_ptr<http::svr::HttpExchange> &client);
 				ApiResponse OnGetQueues(const std::shared_ptr<http::svr::HttpExchange> &client);
+				ApiResponse OnGetSockets(const std::shared_ptr<http::svr::HttpExchange> &client);
+				// Queue depth and steal count of each worker of ov::TaskExecutor (Modules.TaskExecutor)
+				ApiResponse OnGetExecutor(const std::shared_ptr<http::svr::HttpExchange> &client);
+				// Hit rate and outstanding bytes of each size class of ov::MemoryPool
+				ApiResponse OnGetMemory(const std::shared_ptr<http::svr::HttpExchange> &client);
+				// Size and hit rate of ov::FileCache (Modules.FileCache)
+				ApiResponse OnGetFileCache(const std::shared_ptr<http::svr::HttpExchange> &client);
+				// How often the converted bitstream of a MediaPacket is reused by the publishers (MediaPacketConvertedData)
+				ApiResponse OnGetConvertedData(const std::shared_ptr<http::svr::HttpExchange> &client);
 			};
 		}  // namespace stats
 	}	   // namespace v1
@@ -8,6 +8,10 @@
 //==============================================================================
 #include "streams_controller.h"
 
+#include <orchestrator/orchestrator.h>
+
+#include "publishers/webrtc/rtc_session.h"
+
 namespace api
 {
 	namespace v1
@@ -17,6 +21,12 @@ namespace api
 			void StreamsController::PrepareHandlers()
 			{
 				RegisterGet(R"(\/(?<stream_name>[^\/]*))", &StreamsController::OnGetStream);
+				RegisterGet(R"(\/(?<stream_name>[^\/]*)\/webrtcSessions)", &StreamsController::OnGetWebRtcSessions);
+				RegisterGet(R"(\/(?<stream_name>[^\/]*)\/transcoder)", &StreamsController::OnGetTranscoder);
+				RegisterGet(R"(\/(?<stream_name>[^\/]*)\/pacing)", &StreamsController::OnGetPacing);
+				RegisterGet(R"(\/(?<stream_name>[^\/]*)\/itemTransitions)", &StreamsController::OnGetItemTransitions);
+				RegisterGet(R"(\/(?<stream_name>[^\/]*)\/latency)", &StreamsController::OnGetLatency);
+				RegisterGet(R"(\/(?<stream_name>[^\/]*)\/latency\/traces)", &StreamsController::OnGetLatencyTraces);
 			};
 
 			ApiResponse StreamsController::OnGetStream(const std::shared_ptr<http::svr::HttpExchange> &client,
@@ -27,6 +37,156 @@ namespace api
 			{
 				return ::serdes::JsonFromMetrics(stream);
 			}
+
+			ApiResponse StreamsController::OnGetWebRtcSessions(const std::shared_ptr<http::svr::HttpExchange> &client,
+															   const std::shared_ptr<mon::HostMetrics> &vhost,
+															   const std::shared_ptr<mon::ApplicationMetrics> &app,
+															   const std::shared_ptr<mon::StreamMetrics> &stream,
+															   const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams)
+			{
+				Json::Value response = Json::arrayValue;
+
+				auto publisher = ocst::Orchestrator::GetInstance()->GetPublisherFromType(PublisherType::Webrtc);
+				if (publisher == nullptr)
+				{
+					return response;
+				}
+
+				for (auto &output_stream : output_streams)
+				{
+					auto pub_stream = publisher->GetStream(app->GetId(), output_stream->GetId());
+					if (pub_stream == nullptr)
+					{
+						continue;
+					}
+
+					for (auto &item : pub_stream->GetAllSessions())
+					{
+						auto session = std::dynamic_pointer_cast<RtcSession>(item.second);
+						if (session == nullptr)
+						{
+							continue;
+						}
+
+						Json::Value value;
+
+						value["id"] = session->GetId();
+						value["outputStreamName"] = output_stream->GetName().CStr();
+						value["bandwidthEstimation"] = ::serdes::JsonFromBweStats(session->GetBweStats());
+
+						if (session->IsPacerEnabled())
+						{
+							value["pacer"] = ::serdes::JsonFromRtpPacerStats(session->GetPacerStats());
+						}
+
+						response.append(value);
+					}
+				}
+
+				return response;
+			}
+
+			ApiResponse StreamsController::OnGetTranscoder(const std::shared_ptr<http::svr::HttpExchange> &client,
+														   const std::shared_ptr<mon::HostMetrics> &vhost,
+														   const std::shared_ptr<mon::ApplicationMetrics> &app,
+														   const std::shared_ptr<mon::StreamMetrics> &stream,
+														   const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams)
+			{
+				return ::serdes::JsonFromTranscoderMetrics(stream);
+			}
+
+			ApiResponse StreamsController::OnGetPacing(const std::shared_ptr<http::svr::HttpExchange> &client,
+													   const std::shared_ptr<mon::HostMetrics> &vhost,
+													   const std::shared_ptr<mon::ApplicationMetrics> &app,
+													   const std::shared_ptr<mon::StreamMetrics> &stream,
+													   const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams)
+			{
+				auto pacing_errors = stream->PeekPacingErrorHistogram();
+				if (pacing_errors == nullptr)
+				{
+					throw http::HttpError(http::StatusCode::NotFound, "The stream is not paced (only Scheduled and File streams are paced)");
+				}
+
+				return ::serdes::JsonFromPacingMetrics(pacing_errors);
+			}
+
+			ApiResponse StreamsController::OnGetItemTransitions(const std::shared_ptr<http::svr::HttpExchange> &client,
+																const std::shared_ptr<mon::HostMetrics> &vhost,
+																const std::shared_ptr<mon::ApplicationMetrics> &app,
+																const std::shared_ptr<mon::StreamMetrics> &stream,
+																const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams)
+			{
+				auto item_transitions = stream->PeekItemTransitionMetrics();
+				if (item_transitions == nullptr)
+				{
+					throw http::HttpError(http::StatusCode::NotFound, "The stream has no item transition (only Scheduled streams have)");
+				}
+
+				return ::serdes::JsonFromItemTransitionMetrics(item_transitions);
+			}
+
+			static void ThrowIfLatencyTraceDisabled()
+			{
+				if (MediaTrace::IsEnabled() == false)
+				{
+					throw http::HttpError(http::StatusCode::NotFound, "Latency trace is disabled (Modules.LatencyTrace)");
+				}
+			}
+
+			ApiResponse StreamsController::OnGetLatency(const std::shared_ptr<http::svr::HttpExchange> &client,
+														const std::shared_ptr<mon::HostMetrics> &vhost,
+														const std::shared_ptr<mon::ApplicationMetrics> &app,
+														const std::shared_ptr<mon::StreamMetrics> &stream,
+														const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams)
+			{
+				ThrowIfLatencyTraceDisabled();
+
+				Json::Value response = Json::objectValue;
+
+				// Traces are recorded by the output streams
+				for (auto &output_stream : output_streams)
+				{
+					auto latency_metrics = output_stream->GetLatencyMetrics();
+					if (latency_metrics == nullptr)
+					{
+						continue;
+					}
+
+					response[output_stream->GetName().CStr()] = ::serdes::JsonFromLatencyMetrics(latency_metrics);
+				}
+
+				return response;
+			}
+
+			ApiResponse StreamsController::OnGetLatencyTraces(const std::shared_ptr<http::svr::HttpExchange> &client,
+															  const std::shared_ptr<mon::HostMetrics> &vhost,
+															  const std::shared_ptr<mon::ApplicationMetrics> &app,
+															  const std::shared_ptr<mon::StreamMetrics> &stream,
+															  const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams)
+			{
+				ThrowIfLatencyTraceDisabled();
+
+				Json::Value events = Json::arrayValue;
+
+				for (auto &output_stream : output_streams)
+				{
+					auto latency_metrics = output_stream->GetLatencyMetrics();
+					if (latency_metrics == nullptr)
+					{
+						continue;
+					}
+
+					for (auto &event : ::serdes::JsonFromLatencyTraces(output_stream, latency_metrics))
+					{
+						events.append(event);
+					}
+				}
+
+				Json::Value response;
+				response["traceEvents"] = events;
+
+				return response;
+			}
 		}  // namespace stats
 	}	   // namespace v1
 }  // namespace api
@@ -27,6 +27,48 @@ namespace api
 										const std::shared_ptr<mon::ApplicationMetrics> &app,
 										const std::shared_ptr<mon::StreamMetrics> &stream,
 										const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams);
+
+				// Pacer/bandwidth estimator state of each WebRTC session
+				ApiResponse OnGetWebRtcSessions(const std::shared_ptr<http::svr::HttpExchange> &client,
+												const std::shared_ptr<mon::HostMetrics> &vhost,
+												const std::shared_ptr<mon::ApplicationMetrics> &app,
+												const std::shared_ptr<mon::StreamMetrics> &stream,
+												const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams);
+
+				// Decoded frames shared/copied by the transcoder of the input stream
+				ApiResponse OnGetTranscoder(const std::shared_ptr<http::svr::HttpExchange> &client,
+											const std::shared_ptr<mon::HostMetrics> &vhost,
+											const std::shared_ptr<mon::ApplicationMetrics> &app,
+											const std::shared_ptr<mon::StreamMetrics> &stream,
+											const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams);
+
+				// Pacing error of the streams played out in real time (Scheduled, File)
+				ApiResponse OnGetPacing(const std::shared_ptr<http::svr::HttpExchange> &client,
+										const std::shared_ptr<mon::HostMetrics> &vhost,
+										const std::shared_ptr<mon::ApplicationMetrics> &app,
+										const std::shared_ptr<mon::StreamMetrics> &stream,
+										const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams);
+
+				// Transition gap and probe time of the items of a Scheduled stream
+				ApiResponse OnGetItemTransitions(const std::shared_ptr<http::svr::HttpExchange> &client,
+												 const std::shared_ptr<mon::HostMetrics> &vhost,
+												 const std::shared_ptr<mon::ApplicationMetrics> &app,
+												 const std::shared_ptr<mon::StreamMetrics> &stream,
+												 const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams);
+
+				// Per-hop latency of the output streams (Modules.LatencyTrace)
+				ApiResponse OnGetLatency(const std::shared_ptr<http::svr::HttpExchange> &client,
+										 const std::shared_ptr<mon::HostMetrics> &vhost,
+										 const std::shared_ptr<mon::ApplicationMetrics> &app,
+										 const std::shared_ptr<mon::StreamMetrics> &stream,
+										 const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams);
+
+				// Sampled traces of the output streams in the Trace Event Format
+				ApiResponse OnGetLatencyTraces(const std::shared_ptr<http::svr::HttpExchange> &client,
+											   const std::shared_ptr<mon::HostMetrics> &vhost,
+											   const std::shared_ptr<mon::ApplicationMetrics> &app,
+											   const std::shared_ptr<mon::StreamMetrics> &stream,
+											   const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams);
 			};
 		}  // namespace stats
 	}	   // namespace v1
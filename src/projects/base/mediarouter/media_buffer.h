@@ -12,8 +12,14 @@
 #include <base/common_types.h>
 
 #include <stdint.h>
+#include <atomic>
+#include <functional>
 #include <map>
+#include <mutex>
 
+#include <monitoring/sharded_counter.h>
+
+#include "media_trace.h"
 #include "media_type.h"
 
 
@@ -37,6 +43,78 @@ static ov::String GetMediaPacketFlagString(const MediaPacketFlag flag)
 	}
 }
 
+// Converted representations of the data of a MediaPacket (Annex-B -> AVCC/HVCC, ADTS -> raw, ...).
+// A packet is shared by all the publishers of a stream, so each representation is converted at most once
+// no matter how many packagers/writers need it.
+class MediaPacketConvertedData
+{
+public:
+	MediaPacketConvertedData() = default;
+
+	// The data of a copied packet is usually replaced, so the converted data is not copied
+	MediaPacketConvertedData(const MediaPacketConvertedData &)
+	{
+	}
+
+	MediaPacketConvertedData &operator=(const MediaPacketConvertedData &)
+	{
+		Clear();
+		return *this;
+	}
+
+	std::shared_ptr<const ov::Data> Get(cmn::BitstreamFormat format, const std::function<std::shared_ptr<const ov::Data>()> &converter)
+	{
+		std::lock_guard lock_guard(_mutex);
+
+		for (const auto &[converted_format, converted_data] : _converted_data_list)
+		{
+			if (converted_format == format)
+			{
+				_hit_count.Add(1);
+				return converted_data;
+			}
+		}
+
+		_miss_count.Add(1);
+
+		// Converted while holding the lock, so the other publishers wait for the result instead of converting it again
+		auto converted_data = converter();
+
+		if (converted_data != nullptr)
+		{
+			_converted_data_list.emplace_back(format, converted_data);
+		}
+
+		return converted_data;
+	}
+
+	void Clear()
+	{
+		std::lock_guard lock_guard(_mutex);
+		_converted_data_list.clear();
+	}
+
+	// Process-wide counters
+	static uint64_t GetHitCount()
+	{
+		return _hit_count.Load();
+	}
+
+	static uint64_t GetMissCount()
+	{
+		return _miss_count.Load();
+	}
+
+private:
+	std::mutex _mutex;
+	// Usually there are one or two formats, so a vector is faster than a map
+	std::vector<std::pair<cmn::BitstreamFormat, std::shared_ptr<const ov::Data>>> _converted_data_list;
+
+	// Updated per packet by every publisher thread
+	static inline mon::ShardedCounter _hit_count;
+	static inline mon::ShardedCounter _miss_count;
+};
+
 class MediaPacket
 {
 public:
@@ -118,21 +196,46 @@ public:
 	void SetData(std::shared_ptr<ov::Data> &data)
 	{
 		_data = data;
+		_read_only_data = nullptr;
+		_converted_data.Clear();
+	}
+
+	// Sets data shared with other packets (such as the converted data of another packet), which must not be modified.
+	// It is copied when the writable data is requested.
+	void SetReadOnlyData(const std::shared_ptr<const ov::Data> &data)
+	{
+		_data = nullptr;
+		_read_only_data = data;
+		_converted_data.Clear();
 	}
 
 	const std::shared_ptr<const ov::Data> GetData() const noexcept
 	{
-		return _data;
+		return (_read_only_data != nullptr) ? _read_only_data : _data;
 	}
 
 	std::shared_ptr<ov::Data> &GetData() noexcept
 	{
+		if (_read_only_data != nullptr)
+		{
+			_data = _read_only_data->Clone();
+			_read_only_data = nullptr;
+		}
+
 		return _data;
 	}
 
 	size_t GetDataLength() const noexcept
 	{
-		return (_data != nullptr) ? _data->GetLength() : 0;
+		auto data = GetData();
+		return (data != nullptr) ? data->GetLength() : 0;
+	}
+
+	// Returns the data converted into the format, which is done by the converter only if no one has requested it before.
+	// The returned data is shared by all the consumers of this packet, so it must not be modified.
+	std::shared_ptr<const ov::Data> GetConvertedData(cmn::BitstreamFormat format, const std::function<std::shared_ptr<const ov::Data>()> &converter) const
+	{
+		return _converted_data.Get(format, converter);
 	}
 
 	int64_t GetPts() const noexcept
@@ -245,9 +348,20 @@ public:
 		return _high_priority;
 	}
 
+	// nullptr unless the packet is sampled for latency tracing
+	void SetTrace(const std::shared_ptr<MediaTrace> &trace)
+	{
+		_trace = trace;
+	}
+
+	const std::shared_ptr<MediaTrace> &GetTrace() const
+	{
+		return _trace;
+	}
+
 	std::shared_ptr<MediaPacket> ClonePacket() const
 	{
-		auto packet = std::make_shared<MediaPacket>(
+		auto packet = ov::MakePooledShared<MediaPacket>(
 			GetMsid(),
 			GetMediaType(),
 			GetTrackId(),
@@ -262,6 +376,11 @@ public:
 		packet->_frag_hdr = _frag_hdr;
 		packet->_high_priority = _high_priority;
 
+		if (_trace != nullptr)
+		{
+			packet->_trace = std::make_shared<MediaTrace>(*_trace);
+		}
+
 		return packet;
 	}
 
@@ -293,6 +412,8 @@ protected:
 	uint32_t _track_id = UINT32_MAX;
 
 	std::shared_ptr<ov::Data> _data = nullptr;
+	// Used instead of _data if the data is shared with other packets (see SetReadOnlyData())
+	std::shared_ptr<const ov::Data> _read_only_data = nullptr;
 
 	int64_t _pts = -1LL;
 	int64_t _dts = -1LL;
@@ -302,9 +423,13 @@ protected:
 	cmn::PacketType _packet_type = cmn::PacketType::Unknown;
 	FragmentationHeader _frag_hdr;
 
+	mutable MediaPacketConvertedData _converted_data;
+
 	// This flag is used to indicate that this packet should be sent with high priority.
 	bool _high_priority = false; 
 
+	std::shared_ptr<MediaTrace> _trace;
+
 	// creation timepoint
 	std::chrono::time_point<std::chrono::system_clock> _creation_time = std::chrono::system_clock::now();
 };
@@ -0,0 +1,250 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+// Timestamps (monotonic clock) of a media packet at each hop of the pipeline
+//
+// A trace is attached to one of every N packets by the provider only when Modules.LatencyTrace is enabled,
+// so a packet without a trace costs a null check at each hop.
+// A trace is written by the thread that currently owns the packet/frame, and it is copied
+// when the packet/frame is branched (clone, transcoder components).
+// A bypassed packet is still shared with the transcoder when MediaRouter stamps RouterOutbound on it,
+// so the stamps are atomic and may be copied while another hop is being stamped.
+class MediaTrace
+{
+public:
+	enum class Hop : uint8_t
+	{
+		// pvd::Stream::SendFrame()
+		Provider = 0,
+		// Dequeued from the inbound queue of MediaRouteApplication
+		RouterInbound,
+		// Completed by the decoder/filter/encoder of the transcoder
+		Decoder,
+		Filter,
+		Encoder,
+		// Dequeued from the outbound queue of MediaRouteApplication
+		RouterOutbound,
+		// Dequeued from the queue of pub::ApplicationWorker (not stamped, the packet is shared by publishers)
+		Publisher,
+		// Dequeued from the queue of pub::StreamWorker (not stamped, the queue holds the data of each publisher)
+		StreamWorker,
+
+		Count
+	};
+
+	static constexpr size_t HopCount = static_cast<size_t>(Hop::Count);
+
+	MediaTrace() = default;
+
+	MediaTrace(const MediaTrace &other)
+	{
+		for (size_t index = 0; index < HopCount; index++)
+		{
+			_stamps[index].store(other._stamps[index].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+	}
+
+	static void Enable(uint32_t sample_interval, uint32_t max_sampled_traces)
+	{
+		_sample_interval = std::max<uint32_t>(sample_interval, 1);
+		_max_sampled_traces = max_sampled_traces;
+		_enabled = true;
+	}
+
+	static bool IsEnabled()
+	{
+		return _enabled.load(std::memory_order_relaxed);
+	}
+
+	static uint32_t GetMaxSampledTraces()
+	{
+		return _max_sampled_traces;
+	}
+
+	static int64_t Now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// Returns a new trace stamped at the hop for one of every sample_interval calls, nullptr otherwise
+	static std::shared_ptr<MediaTrace> Sample(Hop hop)
+	{
+		if (IsEnabled() == false)
+		{
+			return nullptr;
+		}
+
+		if ((_sample_count.fetch_add(1, std::memory_order_relaxed) % _sample_interval) != 0)
+		{
+			return nullptr;
+		}
+
+		auto trace = std::make_shared<MediaTrace>();
+		trace->Stamp(hop);
+
+		return trace;
+	}
+
+	static const char *StringFromHop(Hop hop)
+	{
+		switch (hop)
+		{
+			case Hop::Provider:
+				return "Provider";
+			case Hop::RouterInbound:
+				return "RouterInbound";
+			case Hop::Decoder:
+				return "Decoder";
+			case Hop::Filter:
+				return "Filter";
+			case Hop::Encoder:
+				return "Encoder";
+			case Hop::RouterOutbound:
+				return "RouterOutbound";
+			case Hop::Publisher:
+				return "Publisher";
+			case Hop::StreamWorker:
+				return "StreamWorker";
+			case Hop::Count:
+				break;
+		}
+
+		return "Unknown";
+	}
+
+	void Stamp(Hop hop)
+	{
+		_stamps[static_cast<size_t>(hop)].store(Now(), std::memory_order_relaxed);
+	}
+
+	// 0 if the hop is not stamped
+	int64_t GetStamp(Hop hop) const
+	{
+		return _stamps[static_cast<size_t>(hop)].load(std::memory_order_relaxed);
+	}
+
+	// Time spent from the previous stamped hop to this hop, -1 if it is not stamped
+	int64_t GetLatency(Hop hop) const
+	{
+		auto index = static_cast<size_t>(hop);
+		auto stamp = _stamps[index].load(std::memory_order_relaxed);
+
+		if (stamp == 0)
+		{
+			return -1;
+		}
+
+		for (size_t prev = index; prev > 0; prev--)
+		{
+			auto prev_stamp = _stamps[prev - 1].load(std::memory_order_relaxed);
+
+			if (prev_stamp != 0)
+			{
+				return stamp - prev_stamp;
+			}
+		}
+
+		return -1;
+	}
+
+	// Timestamp of the last stamped hop
+	int64_t GetLastStamp() const
+	{
+		for (size_t index = HopCount; index > 0; index--)
+		{
+			auto stamp = _stamps[index - 1].load(std::memory_order_relaxed);
+
+			if (stamp != 0)
+			{
+				return stamp;
+			}
+		}
+
+		return 0;
+	}
+
+private:
+	std::array<std::atomic<int64_t>, HopCount> _stamps{};
+
+	static inline std::atomic<bool> _enabled{false};
+	static inline uint32_t _sample_interval = 1;
+	static inline uint32_t _max_sampled_traces = 0;
+	static inline std::atomic<uint64_t> _sample_count{0};
+};
+
+// Carries the traces across a transcoder component (decoder, filter, encoder) whose output is a new object.
+//
+// The trace of the N-th input is attached to the N-th output, which is exact for components that emit one output
+// for each input in order. When a component emits fewer outputs than inputs (frame rate/frame size conversion),
+// the oldest traces are dropped so the numbers stay bounded.
+class MediaTraceRelay
+{
+public:
+	static constexpr size_t MaxPendingTraces = 64;
+
+	// Called for every input (even without a trace) while tracing is enabled
+	void Push(const std::shared_ptr<const MediaTrace> &trace)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_traces.size() >= MaxPendingTraces)
+		{
+			_traces.pop_front();
+		}
+
+		_traces.push_back(trace);
+	}
+
+	// Returns a copy of the trace of the oldest input stamped at the hop, so the branches of a frame do not share it
+	std::shared_ptr<MediaTrace> Pop(MediaTrace::Hop hop)
+	{
+		std::shared_ptr<const MediaTrace> trace;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			if (_traces.empty())
+			{
+				return nullptr;
+			}
+
+			trace = std::move(_traces.front());
+			_traces.pop_front();
+		}
+
+		if (trace == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto output_trace = std::make_shared<MediaTrace>(*trace);
+		output_trace->Stamp(hop);
+
+		return output_trace;
+	}
+
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_traces.clear();
+	}
+
+private:
+	std::mutex _mutex;
+	std::deque<std::shared_ptr<const MediaTrace>> _traces;
+};
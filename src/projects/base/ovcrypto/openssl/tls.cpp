@@ -389,6 +389,18 @@ namespace ov
 		return Write(data->GetData(), data->GetLength(), written_bytes);
 	}
 
+	bool Tls::EnableKtls()
+	{
+		OV_ASSERT2(_ssl != nullptr);
+
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+		::SSL_set_options(_ssl, SSL_OP_ENABLE_KTLS);
+		return true;
+#else
+		return false;
+#endif
+	}
+
 	bool Tls::FlushInput()
 	{
 		unsigned char buf[1024];
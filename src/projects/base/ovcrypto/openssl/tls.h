@@ -24,6 +24,12 @@ namespace ov
 
 		void SetTlsHostName(const ov::String &host_name);
 
+		// Allows OpenSSL to hand the traffic keys to the BIO (BIO_CTRL_SET_KTLS) once the handshake is done.
+		// Must be called before Accept()/Connect().
+		//
+		// @return Returns false if OpenSSL is built without kTLS support
+		bool EnableKtls();
+
 		// @return Returns SSL_ERROR_NONE on success
 		int Accept();
 
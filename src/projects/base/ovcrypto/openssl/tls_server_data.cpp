@@ -8,8 +8,27 @@
 //==============================================================================
 #include "tls_server_data.h"
 
+#include <linux/tls.h>
+
 #include "./openssl_private.h"
 
+// Ctrls that OpenSSL sends to the BIO when SSL_OP_ENABLE_KTLS is set (include/internal/bio.h of OpenSSL)
+#ifndef BIO_CTRL_SET_KTLS
+#	define BIO_CTRL_SET_KTLS 72
+#endif	// BIO_CTRL_SET_KTLS
+
+#ifndef BIO_CTRL_GET_KTLS_SEND
+#	define BIO_CTRL_GET_KTLS_SEND 73
+#endif	// BIO_CTRL_GET_KTLS_SEND
+
+#ifndef BIO_CTRL_SET_KTLS_TX_SEND_CTRL_MSG
+#	define BIO_CTRL_SET_KTLS_TX_SEND_CTRL_MSG 74
+#endif	// BIO_CTRL_SET_KTLS_TX_SEND_CTRL_MSG
+
+#ifndef BIO_CTRL_CLEAR_KTLS_TX_CTRL_MSG
+#	define BIO_CTRL_CLEAR_KTLS_TX_CTRL_MSG 75
+#endif	// BIO_CTRL_CLEAR_KTLS_TX_CTRL_MSG
+
 namespace ov
 {
 	TlsServerData::TlsServerData(const std::shared_ptr<TlsContext> &tls_context, bool is_nonblocking)
@@ -40,6 +59,25 @@ namespace ov
 		_tls.Uninitialize();
 	}
 
+	bool TlsServerData::EnableKtls(KtlsSendCallback send_callback, KtlsRecordCallback record_callback)
+	{
+		if (_state != State::WaitingForAccept)
+		{
+			logtd("Invalid state: %d", _state);
+			return false;
+		}
+
+		if (_tls.EnableKtls() == false)
+		{
+			return false;
+		}
+
+		_ktls_send_callback = std::move(send_callback);
+		_ktls_record_callback = std::move(record_callback);
+
+		return true;
+	}
+
 	bool TlsServerData::Decrypt(const std::shared_ptr<const Data> &cipher_data, std::shared_ptr<const Data> *plain_data)
 	{
 		if (_state == State::Invalid)
@@ -229,6 +267,26 @@ namespace ov
 
 	ssize_t TlsServerData::OnTlsWrite(Tls *tls, const void *data, size_t length)
 	{
+		if (_ktls_record_type != 0)
+		{
+			// OpenSSL writes a non-application record in plain text after kTLS is enabled (NewSessionTicket, alert, ...)
+			if (_ktls_record_callback == nullptr)
+			{
+				return -1LL;
+			}
+
+			auto sent = _ktls_record_callback(_ktls_record_type, data, length);
+			if (sent < 0L)
+			{
+				return -1LL;
+			}
+
+			// OpenSSL sets the record type again before writing the rest (0 sets BIO_set_retry_write())
+			_ktls_record_type = 0;
+			return sent;
+		}
+
+		// If kTLS is enabled, data is not encrypted here and the kernel encrypts it
 		if (_state == State::WaitingForAccept)
 		{
 			if (_write_callback != nullptr)
@@ -269,8 +327,70 @@ namespace ov
 			case BIO_CTRL_FLUSH:
 				return 1;
 
+			case BIO_CTRL_SET_KTLS:
+				return SetKtlsSend(num, arg) ? 1 : 0;
+
+			case BIO_CTRL_GET_KTLS_SEND:
+				return _ktls_send_enabled ? 1 : 0;
+
+			case BIO_CTRL_SET_KTLS_TX_SEND_CTRL_MSG:
+				_ktls_record_type = static_cast<uint8_t>(num);
+				return 0;
+
+			case BIO_CTRL_CLEAR_KTLS_TX_CTRL_MSG:
+				_ktls_record_type = 0;
+				return 0;
+
 			default:
 				return 0;
 		}
 	}
-}  // namespace ov
\ No newline at end of file
+
+	bool TlsServerData::SetKtlsSend(long is_tx, const void *crypto_info)
+	{
+		if ((is_tx == 0) || (_ktls_send_callback == nullptr) || (crypto_info == nullptr))
+		{
+			// RX records are decrypted in userspace, because they are read from the socket before being passed to Decrypt()
+			return false;
+		}
+
+		// OpenSSL passes a union of the crypto_info structures, so the length is obtained from the cipher type
+		socklen_t crypto_info_length = 0;
+
+		switch (static_cast<const struct tls_crypto_info *>(crypto_info)->cipher_type)
+		{
+			case TLS_CIPHER_AES_GCM_128:
+				crypto_info_length = sizeof(struct tls12_crypto_info_aes_gcm_128);
+				break;
+
+			case TLS_CIPHER_AES_GCM_256:
+				crypto_info_length = sizeof(struct tls12_crypto_info_aes_gcm_256);
+				break;
+
+#ifdef TLS_CIPHER_AES_CCM_128
+			case TLS_CIPHER_AES_CCM_128:
+				crypto_info_length = sizeof(struct tls12_crypto_info_aes_ccm_128);
+				break;
+#endif	// TLS_CIPHER_AES_CCM_128
+
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+			case TLS_CIPHER_CHACHA20_POLY1305:
+				crypto_info_length = sizeof(struct tls12_crypto_info_chacha20_poly1305);
+				break;
+#endif	// TLS_CIPHER_CHACHA20_POLY1305
+
+			default:
+				logtd("Unsupported cipher for kTLS: %d", static_cast<const struct tls_crypto_info *>(crypto_info)->cipher_type);
+				return false;
+		}
+
+		if (_ktls_send_callback(crypto_info, crypto_info_length) == false)
+		{
+			return false;
+		}
+
+		_ktls_send_enabled = true;
+
+		return true;
+	}
+}  // namespace ov
@@ -17,6 +17,10 @@ namespace ov
 	{
 	public:
 		using WriteCallback = std::function<ssize_t(const void *data, int64_t length)>;
+		// Installs the TX keys (struct tls12_crypto_info_*) into the socket
+		using KtlsSendCallback = std::function<bool(const void *crypto_info, socklen_t crypto_info_length)>;
+		// Sends a non-application record (handshake, alert) through the kTLS socket
+		using KtlsRecordCallback = std::function<ssize_t(uint8_t record_type, const void *data, size_t length)>;
 
 		enum class State
 		{
@@ -64,6 +68,21 @@ namespace ov
 			return _tls;
 		}
 
+		// Kernel TLS (TX only)
+		//
+		// Must be called before the handshake. When the handshake is done, OpenSSL hands the TX keys to
+		// send_callback, and from then on Encrypt() returns the plain data as it is and the kernel encrypts it.
+		// If the kernel or the cipher does not support kTLS, send_callback fails and the records are encrypted
+		// in userspace as before. Decryption is always done in userspace.
+		//
+		// @return Returns false if OpenSSL is built without kTLS support
+		bool EnableKtls(KtlsSendCallback send_callback, KtlsRecordCallback record_callback);
+
+		bool IsKtlsSendEnabled() const
+		{
+			return _ktls_send_enabled;
+		}
+
 		// Get ALPN protocol
 		AlpnProtocol GetSelectedAlpnProtocol() const;
 		ov::String GetSelectedAlpnProtocolStr() const;
@@ -87,6 +106,8 @@ namespace ov
 		// OpenSSL -> Tls::() -> Tls::TlsCtrl() -> TlsBioCallback.ctrl_callback -> TlsServerData.OnTlsCtrl()
 		long OnTlsCtrl(ov::Tls *tls, int cmd, long num, void *arg);
 
+		bool SetKtlsSend(long is_tx, const void *crypto_info);
+
 	protected:
 		State _state = State::Invalid;
 
@@ -102,5 +123,11 @@ namespace ov
 		std::shared_ptr<Data> _plain_data;
 
 		AlpnProtocol _selected_alpn_protocol = AlpnProtocol::Http11;
+
+		KtlsSendCallback _ktls_send_callback;
+		KtlsRecordCallback _ktls_record_callback;
+		std::atomic<bool> _ktls_send_enabled{false};
+		// Type of the next record written to the BIO (0: application data)
+		uint8_t _ktls_record_type = 0;
 	};
 }  // namespace ov
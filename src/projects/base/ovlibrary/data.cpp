@@ -52,7 +52,7 @@ namespace ov
 		_reference_data = data._reference_data;
 		if (data._allocated_data != nullptr)
 		{
-			_allocated_data = std::make_shared<std::vector<uint8_t>>();
+			_allocated_data = CreateBuffer();
 			Append(&data);
 		}
 		_offset = data._offset;
@@ -267,7 +267,7 @@ namespace ov
 		// Reset the offset
 		_offset = 0L;
 
-		_allocated_data = std::make_shared<std::vector<uint8_t>>(begin, end);
+		_allocated_data = CreateBuffer(begin, end);
 		_allocated_data->reserve(old_data->capacity() - old_offset);
 
 		return (_allocated_data != nullptr);
@@ -286,7 +286,7 @@ namespace ov
 		}
 		else
 		{
-			_allocated_data = std::make_shared<std::vector<uint8_t>>();
+			_allocated_data = CreateBuffer();
 		}
 
 		_allocated_data->reserve(capacity);
@@ -298,7 +298,7 @@ namespace ov
 	{
 		// Reallocate the buffer (this method is faster than Detach() & clear());
 		_reference_data = nullptr;
-		_allocated_data = std::make_shared<std::vector<uint8_t>>();
+		_allocated_data = CreateBuffer();
 		_offset = 0;
 		_length = 0;
 
@@ -11,6 +11,7 @@
 #include "./string.h"
 #include "./assert.h"
 #include "./memory_utilities.h"
+#include "./memory_pool.h"
 #include "./data.h"
 
 #include <memory>
@@ -215,8 +216,17 @@ namespace ov
 
 		const void *_reference_data = nullptr;
 
+		// The buffer and its control block are allocated from MemoryPool
+		using Buffer = std::vector<uint8_t, PoolAllocator<uint8_t>>;
+
+		template <typename... Args>
+		static std::shared_ptr<Buffer> CreateBuffer(Args &&...args)
+		{
+			return MakePooledShared<Buffer>(std::forward<Args>(args)...);
+		}
+
 		// Allocated data. If this data is subdata, _current_data and _data can be different.
-		std::shared_ptr<std::vector<uint8_t>> _allocated_data = nullptr;
+		std::shared_ptr<Buffer> _allocated_data = nullptr;
 		// Offset from _allocated_data
 		off_t _offset = 0;
 
@@ -243,6 +243,33 @@ namespace ov
 		return DumpToFile(file_name, data->GetData(), data->GetLength(), offset, append);
 	}
 
+	std::shared_ptr<FILE> DumpToFile(const char *file_name, const std::vector<std::shared_ptr<const Data>> &data_list, bool append) noexcept
+	{
+		FILE *file = ::fopen(file_name, append ? "ab" : "wb");
+
+		if (file == nullptr)
+		{
+			return nullptr;
+		}
+
+		for (const auto &data : data_list)
+		{
+			if (data != nullptr)
+			{
+				::fwrite(data->GetData(), sizeof(uint8_t), data->GetLength(), file);
+			}
+		}
+
+		::fflush(file);
+
+		return std::shared_ptr<FILE>(file, [](FILE *file) {
+			if (file != nullptr)
+			{
+				::fclose(file);
+			}
+		});
+	}
+
 	std::shared_ptr<Data> LoadFromFile(const char *file_name) noexcept
 	{
 		FILE *file = ::fopen(file_name, "rb");
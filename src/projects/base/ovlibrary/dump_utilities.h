@@ -31,6 +31,8 @@ namespace ov
 	// Write data to file
 	std::shared_ptr<FILE> DumpToFile(const char *file_name, const void *data, size_t length, off_t offset = 0, bool append = false) noexcept;
 	std::shared_ptr<FILE> DumpToFile(const char *file_name, const std::shared_ptr<const Data> &data, off_t offset = 0, bool append = false) noexcept;
+	// Write the concatenation of data_list to file
+	std::shared_ptr<FILE> DumpToFile(const char *file_name, const std::vector<std::shared_ptr<const Data>> &data_list, bool append = false) noexcept;
 
 	std::shared_ptr<Data> LoadFromFile(const char *file_name) noexcept;
 }
@@ -0,0 +1,165 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./file_cache.h"
+
+#include <sys/stat.h>
+
+#include "./dump_utilities.h"
+
+namespace ov
+{
+	void FileCache::SetMaxSize(size_t max_size)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_max_size = max_size;
+
+		EvictEntries();
+	}
+
+	std::shared_ptr<const Data> FileCache::Load(const String &path)
+	{
+		struct stat file_stat;
+		if ((::stat(path.CStr(), &file_stat) != 0) || (S_ISREG(file_stat.st_mode) == false))
+		{
+			return nullptr;
+		}
+
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		while (true)
+		{
+			auto item = _entries.find(path);
+			if (item == _entries.end())
+			{
+				break;
+			}
+
+			auto entry = item->second;
+
+			if (entry->data == nullptr)
+			{
+				// Another session is reading the file
+				_loaded_condition.wait(lock);
+				continue;
+			}
+
+			if ((entry->file_size == file_stat.st_size) &&
+				(entry->modified_time.tv_sec == file_stat.st_mtim.tv_sec) &&
+				(entry->modified_time.tv_nsec == file_stat.st_mtim.tv_nsec))
+			{
+				_hit_count++;
+				_lru_list.splice(_lru_list.begin(), _lru_list, entry->lru_iterator);
+
+				return entry->data;
+			}
+
+			// The file has been modified
+			EraseEntry(entry);
+			break;
+		}
+
+		_miss_count++;
+
+		if ((file_stat.st_size <= 0) || (static_cast<size_t>(file_stat.st_size) > _max_size))
+		{
+			lock.unlock();
+			return LoadFromFile(path.CStr());
+		}
+
+		// Other sessions requesting the file wait for this entry
+		auto entry = std::make_shared<Entry>();
+		entry->path = path;
+		entry->file_size = file_stat.st_size;
+		entry->modified_time = file_stat.st_mtim;
+
+		_lru_list.push_front(entry);
+		entry->lru_iterator = _lru_list.begin();
+		_entries[path] = entry;
+
+		lock.unlock();
+		std::shared_ptr<const Data> data = LoadFromFile(path.CStr());
+		lock.lock();
+
+		// The entry may have been removed while reading the file
+		auto item = _entries.find(path);
+		if ((item != _entries.end()) && (item->second == entry))
+		{
+			if ((data == nullptr) || (data->GetLength() != static_cast<size_t>(entry->file_size)))
+			{
+				// Could not read the file, or it has been modified while reading it
+				EraseEntry(entry);
+			}
+			else
+			{
+				entry->data = data;
+				_size += data->GetLength();
+
+				EvictEntries();
+			}
+		}
+
+		_loaded_condition.notify_all();
+
+		return data;
+	}
+
+	void FileCache::Remove(const String &path)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		auto item = _entries.find(path);
+		if (item != _entries.end())
+		{
+			EraseEntry(item->second);
+
+			// Wake up the sessions waiting for the entry
+			_loaded_condition.notify_all();
+		}
+	}
+
+	FileCache::Stats FileCache::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		return {_max_size, _size, _entries.size(), _hit_count, _miss_count};
+	}
+
+	void FileCache::EraseEntry(const std::shared_ptr<Entry> &entry)
+	{
+		if (entry->data != nullptr)
+		{
+			_size -= entry->data->GetLength();
+		}
+
+		_lru_list.erase(entry->lru_iterator);
+		_entries.erase(entry->path);
+	}
+
+	void FileCache::EvictEntries()
+	{
+		auto lru_iterator = _lru_list.end();
+
+		while ((_size > _max_size) && (lru_iterator != _lru_list.begin()))
+		{
+			--lru_iterator;
+			auto &entry = *lru_iterator;
+
+			// The entries being read are not counted in _size
+			if (entry->data == nullptr)
+			{
+				continue;
+			}
+
+			_size -= entry->data->GetLength();
+			_entries.erase(entry->path);
+			lru_iterator = _lru_list.erase(lru_iterator);
+		}
+	}
+}  // namespace ov
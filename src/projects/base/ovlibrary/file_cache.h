@@ -0,0 +1,85 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "./data.h"
+#include "./singleton.h"
+#include "./string.h"
+
+namespace ov
+{
+	// LRU cache of the recently read files (e.g. DVR segments), shared by all the sessions
+	//
+	// When many sessions request the same file at once, only the first one reads it and the others wait for it.
+	// An entry is read again if the size or the modified time of the file has been changed.
+	class FileCache : public Singleton<FileCache>
+	{
+	public:
+		struct Stats
+		{
+			size_t max_size;
+			// Bytes of the cached files
+			size_t size;
+			size_t count;
+
+			uint64_t hit_count;
+			uint64_t miss_count;
+		};
+
+		// 0: files are read every time without being cached
+		void SetMaxSize(size_t max_size);
+
+		// Returns the content of the file, nullptr if it cannot be read
+		std::shared_ptr<const Data> Load(const String &path);
+		// Called when the file is deleted or replaced
+		void Remove(const String &path);
+
+		Stats GetStats() const;
+
+	private:
+		friend class Singleton<FileCache>;
+
+		struct Entry
+		{
+			String path;
+			// nullptr while it is being read
+			std::shared_ptr<const Data> data;
+			off_t file_size = 0;
+			struct timespec modified_time = {};
+
+			// Position in _lru_list
+			std::list<std::shared_ptr<Entry>>::iterator lru_iterator;
+		};
+
+		FileCache() = default;
+
+		// Must be called with _mutex locked
+		void EraseEntry(const std::shared_ptr<Entry> &entry);
+		void EvictEntries();
+
+		mutable std::mutex _mutex;
+		std::condition_variable _loaded_condition;
+
+		size_t _max_size = 0;
+		size_t _size = 0;
+
+		std::map<String, std::shared_ptr<Entry>> _entries;
+		// The most recently used entry first
+		std::list<std::shared_ptr<Entry>> _lru_list;
+
+		uint64_t _hit_count = 0;
+		uint64_t _miss_count = 0;
+	};
+}  // namespace ov
@@ -6,18 +6,52 @@
 //  Copyright (c) 2022 AirenSoft. All rights reserved.
 //
 //==============================================================================
-#include "./string.h"
+#include "./files.h"
 #include <iostream>
 #include <sys/stat.h>
 #include <errno.h>
 #include <ftw.h>
 #include <dirent.h>
+#include <fcntl.h>
 #include <libgen.h>
 #include <unistd.h>
 #include <linux/limits.h>
 
 namespace ov
 {
+	std::shared_ptr<ReadOnlyFile> ReadOnlyFile::Open(const ov::String &path)
+	{
+		int file_descriptor = ::open(path.CStr(), O_RDONLY | O_CLOEXEC);
+		if (file_descriptor < 0)
+		{
+			return nullptr;
+		}
+
+		struct stat file_stat;
+		if ((::fstat(file_descriptor, &file_stat) != 0) || (S_ISREG(file_stat.st_mode) == false))
+		{
+			::close(file_descriptor);
+			return nullptr;
+		}
+
+		return std::make_shared<ReadOnlyFile>(path, file_descriptor, file_stat);
+	}
+
+	ReadOnlyFile::ReadOnlyFile(const ov::String &path, int file_descriptor, const struct stat &file_stat)
+		: _path(path),
+		  _file_descriptor(file_descriptor),
+		  _file_stat(file_stat)
+	{
+	}
+
+	ReadOnlyFile::~ReadOnlyFile()
+	{
+		if (_file_descriptor >= 0)
+		{
+			::close(_file_descriptor);
+		}
+	}
+
 	bool IsDirExist(const ov::String &path)
 	{
 		struct stat info;
@@ -14,8 +14,47 @@
 #include <errno.h>
 #include <ftw.h>
 
+#include <memory>
+
 namespace ov
 {
+	// A file opened for reading, which is closed when the last reference is released.
+	// It is kept open while it is waiting in the dispatch queue of a socket to be sent using sendfile().
+	class ReadOnlyFile
+	{
+	public:
+		// Returns nullptr if the file cannot be opened or it is not a regular file
+		static std::shared_ptr<ReadOnlyFile> Open(const ov::String &path);
+
+		ReadOnlyFile(const ov::String &path, int file_descriptor, const struct stat &file_stat);
+		~ReadOnlyFile();
+
+		const ov::String &GetPath() const
+		{
+			return _path;
+		}
+
+		int GetNativeHandle() const
+		{
+			return _file_descriptor;
+		}
+
+		size_t GetSize() const
+		{
+			return static_cast<size_t>(_file_stat.st_size);
+		}
+
+		const struct timespec &GetModifiedTime() const
+		{
+			return _file_stat.st_mtim;
+		}
+
+	private:
+		ov::String _path;
+		int _file_descriptor = -1;
+		struct stat _file_stat;
+	};
+
 	bool IsDirExist(const ov::String &path);
 	bool CreateDirectories(const ov::String &path);
 	static int RemoveFiles(const char *pathname, const struct stat *sbuf, int type, struct FTW *ftwb);
@@ -0,0 +1,317 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./memory_pool.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <set>
+
+namespace ov
+{
+	// The number of blocks of each class cached by a thread (up to about 620KB per thread).
+	// The blocks of 64KB or larger are not cached by the threads, they are taken from (or returned to) the depot directly.
+	static constexpr std::array<size_t, MemoryPool::ClassCount> THREAD_CACHE_LIMITS = {512, 128, 32, 16, 1, 1, 0, 0, 0};
+	// The number of blocks of each class cached by the depot (up to 48MB in total)
+	static constexpr std::array<size_t, MemoryPool::ClassCount> DEPOT_LIMITS = {16384, 8192, 1024, 512, 256, 128, 64, 32, 32};
+
+	static int GetClassIndex(size_t size)
+	{
+		for (size_t index = 0; index < MemoryPool::ClassCount; index++)
+		{
+			if (size <= MemoryPool::ClassSizes[index])
+			{
+				return static_cast<int>(index);
+			}
+		}
+
+		return -1;
+	}
+
+	namespace
+	{
+		struct Counters
+		{
+			std::atomic<uint64_t> allocation_count{0};
+			std::atomic<uint64_t> hit_count{0};
+			std::atomic<int64_t> outstanding_bytes{0};
+
+			// Counters of a thread cache are only written by its thread, so they do not need a locked RMW
+			template <typename T>
+			static void Add(std::atomic<T> &counter, T value, bool is_owned)
+			{
+				if (is_owned)
+				{
+					counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+				}
+				else
+				{
+					counter.fetch_add(value, std::memory_order_relaxed);
+				}
+			}
+		};
+
+		struct Depot
+		{
+			std::mutex mutex;
+			std::vector<void *> blocks;
+		};
+
+		struct ThreadCache;
+
+		struct Registry
+		{
+			std::array<Depot, MemoryPool::ClassCount> depots;
+
+			std::mutex thread_caches_mutex;
+			std::set<ThreadCache *> thread_caches;
+
+			// Counters of the exited threads and of the allocations without a thread cache
+			std::array<Counters, MemoryPool::ClassCount> shared_counters;
+		};
+
+		// Never destroyed, since blocks can be freed while the static objects are being destroyed
+		Registry &GetRegistry()
+		{
+			static auto registry = new Registry();
+			return *registry;
+		}
+
+		// Moves up to count blocks from the depot to blocks, returns the number of moved blocks
+		size_t TakeFromDepot(size_t index, std::vector<void *> &blocks, size_t count)
+		{
+			auto &depot = GetRegistry().depots[index];
+			std::lock_guard<std::mutex> lock(depot.mutex);
+
+			count = std::min(count, depot.blocks.size());
+			blocks.insert(blocks.end(), depot.blocks.end() - count, depot.blocks.end());
+			depot.blocks.resize(depot.blocks.size() - count);
+
+			return count;
+		}
+
+		// Moves the last count blocks to the depot, the blocks over the limit of the depot are freed
+		void ReturnToDepot(size_t index, std::vector<void *> &blocks, size_t count)
+		{
+			auto &depot = GetRegistry().depots[index];
+			auto begin = blocks.end() - count;
+
+			{
+				std::lock_guard<std::mutex> lock(depot.mutex);
+
+				auto room = (depot.blocks.size() < DEPOT_LIMITS[index]) ? (DEPOT_LIMITS[index] - depot.blocks.size()) : 0;
+				auto moved = std::min(room, count);
+
+				depot.blocks.insert(depot.blocks.end(), begin, begin + moved);
+				begin += moved;
+			}
+
+			for (auto block = begin; block != blocks.end(); ++block)
+			{
+				::operator delete(*block);
+			}
+
+			blocks.resize(blocks.size() - count);
+		}
+
+		thread_local bool thread_cache_destroyed = false;
+
+		struct ThreadCache
+		{
+			std::array<std::vector<void *>, MemoryPool::ClassCount> blocks;
+			std::array<Counters, MemoryPool::ClassCount> counters;
+			// Bytes of blocks, readable by GetStats() while the thread is running
+			std::array<std::atomic<int64_t>, MemoryPool::ClassCount> cached_bytes{};
+
+			ThreadCache()
+			{
+				for (size_t index = 0; index < MemoryPool::ClassCount; index++)
+				{
+					blocks[index].reserve(THREAD_CACHE_LIMITS[index]);
+				}
+
+				auto &registry = GetRegistry();
+				std::lock_guard<std::mutex> lock(registry.thread_caches_mutex);
+				registry.thread_caches.insert(this);
+			}
+
+			~ThreadCache()
+			{
+				auto &registry = GetRegistry();
+
+				{
+					std::lock_guard<std::mutex> lock(registry.thread_caches_mutex);
+					registry.thread_caches.erase(this);
+
+					for (size_t index = 0; index < MemoryPool::ClassCount; index++)
+					{
+						auto &shared = registry.shared_counters[index];
+
+						shared.allocation_count += counters[index].allocation_count;
+						shared.hit_count += counters[index].hit_count;
+						shared.outstanding_bytes += counters[index].outstanding_bytes;
+					}
+				}
+
+				for (size_t index = 0; index < MemoryPool::ClassCount; index++)
+				{
+					ReturnToDepot(index, blocks[index], blocks[index].size());
+				}
+
+				thread_cache_destroyed = true;
+			}
+		};
+
+		// nullptr while the thread is exiting
+		ThreadCache *GetThreadCache()
+		{
+			if (thread_cache_destroyed)
+			{
+				return nullptr;
+			}
+
+			thread_local ThreadCache thread_cache;
+			return &thread_cache;
+		}
+	}  // namespace
+
+	void *MemoryPool::Allocate(size_t size)
+	{
+		auto index = GetClassIndex(size);
+
+		if (index < 0)
+		{
+			return ::operator new(size);
+		}
+
+		auto thread_cache = GetThreadCache();
+		auto is_owned = (thread_cache != nullptr);
+		auto &counters = is_owned ? thread_cache->counters[index] : GetRegistry().shared_counters[index];
+
+		Counters::Add<uint64_t>(counters.allocation_count, 1, is_owned);
+		Counters::Add<int64_t>(counters.outstanding_bytes, ClassSizes[index], is_owned);
+
+		void *block = nullptr;
+
+		if (thread_cache != nullptr)
+		{
+			auto &blocks = thread_cache->blocks[index];
+
+			if (blocks.empty())
+			{
+				auto count = TakeFromDepot(index, blocks, THREAD_CACHE_LIMITS[index] / 2 + 1);
+				Counters::Add<int64_t>(thread_cache->cached_bytes[index], count * ClassSizes[index], true);
+			}
+
+			if (blocks.empty() == false)
+			{
+				block = blocks.back();
+				blocks.pop_back();
+				Counters::Add<int64_t>(thread_cache->cached_bytes[index], -static_cast<int64_t>(ClassSizes[index]), true);
+			}
+		}
+		else
+		{
+			std::vector<void *> blocks;
+
+			if (TakeFromDepot(index, blocks, 1) > 0)
+			{
+				block = blocks.back();
+			}
+		}
+
+		if (block != nullptr)
+		{
+			Counters::Add<uint64_t>(counters.hit_count, 1, is_owned);
+			return block;
+		}
+
+		return ::operator new(ClassSizes[index]);
+	}
+
+	void MemoryPool::Free(void *pointer, size_t size)
+	{
+		if (pointer == nullptr)
+		{
+			return;
+		}
+
+		auto index = GetClassIndex(size);
+
+		if (index < 0)
+		{
+			::operator delete(pointer);
+			return;
+		}
+
+		auto thread_cache = GetThreadCache();
+		auto is_owned = (thread_cache != nullptr);
+		auto &counters = is_owned ? thread_cache->counters[index] : GetRegistry().shared_counters[index];
+
+		Counters::Add<int64_t>(counters.outstanding_bytes, -static_cast<int64_t>(ClassSizes[index]), is_owned);
+
+		if ((thread_cache != nullptr) && (THREAD_CACHE_LIMITS[index] > 0))
+		{
+			auto &blocks = thread_cache->blocks[index];
+
+			if (blocks.size() >= THREAD_CACHE_LIMITS[index])
+			{
+				auto count = blocks.size() / 2 + 1;
+				ReturnToDepot(index, blocks, count);
+				Counters::Add<int64_t>(thread_cache->cached_bytes[index], -static_cast<int64_t>(count * ClassSizes[index]), true);
+			}
+
+			blocks.push_back(pointer);
+			Counters::Add<int64_t>(thread_cache->cached_bytes[index], ClassSizes[index], true);
+		}
+		else
+		{
+			std::vector<void *> blocks = {pointer};
+			ReturnToDepot(index, blocks, 1);
+		}
+	}
+
+	std::vector<MemoryPool::ClassStats> MemoryPool::GetStats()
+	{
+		auto &registry = GetRegistry();
+		std::vector<ClassStats> stats;
+
+		for (size_t index = 0; index < ClassCount; index++)
+		{
+			auto &shared = registry.shared_counters[index];
+
+			stats.push_back({ClassSizes[index],
+							 shared.allocation_count.load(std::memory_order_relaxed),
+							 shared.hit_count.load(std::memory_order_relaxed),
+							 shared.outstanding_bytes.load(std::memory_order_relaxed),
+							 0,
+							 0});
+
+			std::lock_guard<std::mutex> lock(registry.depots[index].mutex);
+			stats.back().depot_bytes = registry.depots[index].blocks.size() * ClassSizes[index];
+		}
+
+		std::lock_guard<std::mutex> lock(registry.thread_caches_mutex);
+
+		for (auto thread_cache : registry.thread_caches)
+		{
+			for (size_t index = 0; index < ClassCount; index++)
+			{
+				auto &counters = thread_cache->counters[index];
+
+				stats[index].allocation_count += counters.allocation_count.load(std::memory_order_relaxed);
+				stats[index].hit_count += counters.hit_count.load(std::memory_order_relaxed);
+				stats[index].outstanding_bytes += counters.outstanding_bytes.load(std::memory_order_relaxed);
+				stats[index].thread_cache_bytes += thread_cache->cached_bytes[index].load(std::memory_order_relaxed);
+			}
+		}
+
+		return stats;
+	}
+}  // namespace ov
@@ -0,0 +1,97 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ov
+{
+	// Size-classed pool for the buffers and objects of the media hot path (ov::Data, RtpPacket, MediaPacket)
+	//
+	// Each thread caches freed blocks of each class, so most allocations do not touch glibc malloc or any lock.
+	// When a thread cache overflows (or runs out), half of it is moved to (or taken from) the depot shared by all threads,
+	// and blocks over the limit of the depot are returned to malloc. Reusing fixed-size blocks keeps the heap
+	// from fragmenting on long uptimes. Allocations larger than the largest class are not pooled.
+	class MemoryPool
+	{
+	public:
+		// Above 1536 bytes, the classes are powers of two, so a block is less than twice the requested size
+		static constexpr size_t ClassCount = 9;
+		static constexpr std::array<size_t, ClassCount> ClassSizes = {256, 1536, 4 * 1024, 8 * 1024, 16 * 1024, 32 * 1024, 64 * 1024, 128 * 1024, 256 * 1024};
+
+		struct ClassStats
+		{
+			size_t block_size;
+
+			uint64_t allocation_count;
+			// Allocations served by a thread cache or the depot
+			uint64_t hit_count;
+			// Bytes in use (allocated and not freed yet)
+			int64_t outstanding_bytes;
+			// Bytes cached by the depot (not including the thread caches)
+			uint64_t depot_bytes;
+			// Bytes cached by the thread caches of the running threads
+			int64_t thread_cache_bytes;
+		};
+
+		static void *Allocate(size_t size);
+		// size must be the size passed to Allocate()
+		static void Free(void *pointer, size_t size);
+
+		static std::vector<ClassStats> GetStats();
+	};
+
+	// std::allocator compatible allocator of MemoryPool
+	template <typename T>
+	class PoolAllocator
+	{
+	public:
+		using value_type = T;
+
+		PoolAllocator() noexcept = default;
+
+		template <typename U>
+		PoolAllocator(const PoolAllocator<U> &) noexcept
+		{
+		}
+
+		T *allocate(size_t count)
+		{
+			return static_cast<T *>(MemoryPool::Allocate(count * sizeof(T)));
+		}
+
+		void deallocate(T *pointer, size_t count) noexcept
+		{
+			MemoryPool::Free(pointer, count * sizeof(T));
+		}
+
+		template <typename U>
+		bool operator==(const PoolAllocator<U> &) const noexcept
+		{
+			return true;
+		}
+
+		template <typename U>
+		bool operator!=(const PoolAllocator<U> &) const noexcept
+		{
+			return false;
+		}
+	};
+
+	// std::make_shared() with the object and the control block allocated from MemoryPool
+	template <typename T, typename... Args>
+	std::shared_ptr<T> MakePooledShared(Args &&...args)
+	{
+		return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+	}
+}  // namespace ov
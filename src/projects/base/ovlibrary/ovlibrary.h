@@ -23,6 +23,7 @@
 #include "./error.h"
 #include "./json.h"
 #include "./log.h"
+#include "./memory_pool.h"
 #include "./memory_utilities.h"
 #include "./map_utilities.h"
 #include "./ovdata_structure.h"
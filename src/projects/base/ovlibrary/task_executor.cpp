@@ -0,0 +1,369 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./task_executor.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include "./log.h"
+#include "./ovlibrary_private.h"
+#include "./string.h"
+
+// A parked worker wakes up periodically to steal the tasks posted to busy workers
+// without waking it (Post() only wakes a parked worker when the target worker is busy)
+#define TASK_EXECUTOR_PARK_TIMEOUT_MS 50
+#define NUMA_NODE_PATH "/sys/devices/system/node"
+
+namespace ov
+{
+	// "0-3,8-11" => {0, 1, 2, 3, 8, 9, 10, 11}
+	static std::vector<int> ParseCpuList(const std::string &cpu_list)
+	{
+		std::vector<int> cpus;
+		std::stringstream stream(cpu_list);
+		std::string range;
+
+		while (std::getline(stream, range, ','))
+		{
+			int first = 0;
+			int last = 0;
+
+			if (std::sscanf(range.c_str(), "%d-%d", &first, &last) == 2)
+			{
+				for (int cpu = first; cpu <= last; cpu++)
+				{
+					cpus.push_back(cpu);
+				}
+			}
+			else if (std::sscanf(range.c_str(), "%d", &first) == 1)
+			{
+				cpus.push_back(first);
+			}
+		}
+
+		return cpus;
+	}
+
+	// CPU => NUMA node, empty if the system does not expose the NUMA topology
+	static std::map<int, int> GetNumaNodeOfCpus()
+	{
+		std::map<int, int> numa_nodes;
+
+		for (int node = 0;; node++)
+		{
+			std::ifstream file(String::FormatString("%s/node%d/cpulist", NUMA_NODE_PATH, node).CStr());
+
+			if (file.is_open() == false)
+			{
+				break;
+			}
+
+			std::string cpu_list;
+			std::getline(file, cpu_list);
+
+			for (auto cpu : ParseCpuList(cpu_list))
+			{
+				numa_nodes[cpu] = node;
+			}
+		}
+
+		return numa_nodes;
+	}
+
+	TaskExecutor::~TaskExecutor()
+	{
+		Stop();
+	}
+
+	bool TaskExecutor::Start(size_t worker_count, bool pin_workers)
+	{
+		if (IsRunning() || (_workers.empty() == false))
+		{
+			logtw("TaskExecutor is already started");
+			return false;
+		}
+
+		std::vector<int> cpus;
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+
+		if (::sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+		{
+			for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+			{
+				if (CPU_ISSET(cpu, &cpu_set))
+				{
+					cpus.push_back(cpu);
+				}
+			}
+		}
+
+		if (cpus.empty())
+		{
+			for (unsigned int cpu = 0; cpu < std::max(std::thread::hardware_concurrency(), 1U); cpu++)
+			{
+				cpus.push_back(static_cast<int>(cpu));
+			}
+		}
+
+		if (worker_count == 0)
+		{
+			worker_count = cpus.size();
+		}
+
+		auto numa_nodes = GetNumaNodeOfCpus();
+		int numa_node_count = 1;
+
+		for (auto &[cpu, node] : numa_nodes)
+		{
+			numa_node_count = std::max(numa_node_count, node + 1);
+		}
+
+		for (size_t index = 0; index < worker_count; index++)
+		{
+			auto worker = std::make_unique<Worker>();
+			auto cpu = cpus[index % cpus.size()];
+
+			worker->index = index;
+			worker->cpu = pin_workers ? cpu : -1;
+
+			auto node = numa_nodes.find(cpu);
+			worker->numa_node = (node != numa_nodes.end()) ? node->second : 0;
+
+			_workers.push_back(std::move(worker));
+		}
+
+		_running = true;
+
+		for (auto &worker : _workers)
+		{
+			worker->thread = std::thread(&TaskExecutor::WorkerThread, this, worker.get());
+			pthread_setname_np(worker->thread.native_handle(), String::FormatString("TaskExec%zu", worker->index).CStr());
+
+			if (worker->cpu >= 0)
+			{
+				cpu_set_t worker_cpu_set;
+				CPU_ZERO(&worker_cpu_set);
+				CPU_SET(worker->cpu, &worker_cpu_set);
+
+				if (::pthread_setaffinity_np(worker->thread.native_handle(), sizeof(worker_cpu_set), &worker_cpu_set) != 0)
+				{
+					logtw("Could not pin TaskExecutor worker #%zu to CPU %d", worker->index, worker->cpu);
+					worker->cpu = -1;
+				}
+			}
+		}
+
+		logti("TaskExecutor has been started with %zu workers (pinned: %s, NUMA nodes: %d)",
+			  _workers.size(), pin_workers ? "true" : "false",
+			  numa_node_count);
+
+		return true;
+	}
+
+	bool TaskExecutor::Stop()
+	{
+		if (_running.exchange(false) == false)
+		{
+			return true;
+		}
+
+		for (auto &worker : _workers)
+		{
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			worker->condition.notify_all();
+		}
+
+		for (auto &worker : _workers)
+		{
+			if (worker->thread.joinable())
+			{
+				worker->thread.join();
+			}
+
+			// Workers are kept (not restartable) since Post() may still refer to them
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			worker->tasks.clear();
+			worker->queue_depth = 0;
+		}
+
+		logti("TaskExecutor has been stopped");
+
+		return true;
+	}
+
+	bool TaskExecutor::Post(uint64_t affinity_hint, Task task)
+	{
+		if (IsRunning() == false)
+		{
+			return false;
+		}
+
+		auto &worker = _workers[affinity_hint % _workers.size()];
+		bool is_parked = false;
+
+		{
+			std::lock_guard<std::mutex> lock(worker->mutex);
+
+			worker->tasks.push_back(std::move(task));
+			worker->queue_depth.store(worker->tasks.size(), std::memory_order_relaxed);
+
+			is_parked = worker->parked.load(std::memory_order_relaxed);
+		}
+
+		if (is_parked)
+		{
+			worker->condition.notify_one();
+		}
+		else if (_parked_count.load(std::memory_order_relaxed) > 0)
+		{
+			// The worker is busy, so let an idle worker steal the task
+			WakeParkedWorker(worker->numa_node);
+		}
+
+		return true;
+	}
+
+	std::vector<TaskExecutor::WorkerStats> TaskExecutor::GetWorkerStats() const
+	{
+		std::vector<WorkerStats> stats;
+
+		for (auto &worker : _workers)
+		{
+			stats.push_back({worker->cpu,
+							 worker->numa_node,
+							 worker->queue_depth.load(std::memory_order_relaxed),
+							 worker->executed_count.load(std::memory_order_relaxed),
+							 worker->stolen_count.load(std::memory_order_relaxed)});
+		}
+
+		return stats;
+	}
+
+	void TaskExecutor::WorkerThread(Worker *worker)
+	{
+		Task task;
+
+		while (IsRunning())
+		{
+			if (PopTask(worker, &task) || StealTask(worker, &task))
+			{
+				task();
+				task = nullptr;
+
+				worker->executed_count.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(worker->mutex);
+
+			if ((worker->tasks.empty() == false) || (IsRunning() == false))
+			{
+				continue;
+			}
+
+			worker->parked = true;
+			_parked_count++;
+
+			worker->condition.wait_for(lock, std::chrono::milliseconds(TASK_EXECUTOR_PARK_TIMEOUT_MS));
+
+			_parked_count--;
+			worker->parked = false;
+		}
+	}
+
+	bool TaskExecutor::PopTask(Worker *worker, Task *task)
+	{
+		std::lock_guard<std::mutex> lock(worker->mutex);
+
+		if (worker->tasks.empty())
+		{
+			return false;
+		}
+
+		*task = std::move(worker->tasks.front());
+		worker->tasks.pop_front();
+		worker->queue_depth.store(worker->tasks.size(), std::memory_order_relaxed);
+
+		return true;
+	}
+
+	bool TaskExecutor::StealTask(Worker *thief, Task *task)
+	{
+		// Pass 0: the workers on the same NUMA node, Pass 1: the others
+		for (int pass = 0; pass < 2; pass++)
+		{
+			Worker *victim = nullptr;
+			size_t victim_depth = 0;
+
+			for (auto &worker : _workers)
+			{
+				if ((worker.get() == thief) || ((worker->numa_node == thief->numa_node) != (pass == 0)))
+				{
+					continue;
+				}
+
+				auto depth = worker->queue_depth.load(std::memory_order_relaxed);
+				if (depth > victim_depth)
+				{
+					victim = worker.get();
+					victim_depth = depth;
+				}
+			}
+
+			if (victim == nullptr)
+			{
+				continue;
+			}
+
+			std::lock_guard<std::mutex> lock(victim->mutex);
+
+			if (victim->tasks.empty())
+			{
+				continue;
+			}
+
+			// The oldest task, which waited the longest
+			*task = std::move(victim->tasks.front());
+			victim->tasks.pop_front();
+			victim->queue_depth.store(victim->tasks.size(), std::memory_order_relaxed);
+
+			thief->stolen_count.fetch_add(1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void TaskExecutor::WakeParkedWorker(int numa_node)
+	{
+		for (int pass = 0; pass < 2; pass++)
+		{
+			for (auto &worker : _workers)
+			{
+				if ((worker->numa_node == numa_node) != (pass == 0))
+				{
+					continue;
+				}
+
+				if (worker->parked.load(std::memory_order_relaxed))
+				{
+					worker->condition.notify_one();
+					return;
+				}
+			}
+		}
+	}
+}  // namespace ov
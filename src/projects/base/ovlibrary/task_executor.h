@@ -0,0 +1,104 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "./singleton.h"
+
+namespace ov
+{
+	// A pool of per-core workers shared by the whole process, used instead of a thread per object.
+	//
+	// Each worker has its own queue. A task is queued to the worker selected by its affinity hint,
+	// so the tasks of the same object usually run on the same core and its data stays in the cache.
+	// When a worker runs out of tasks, it steals the oldest task from the most loaded worker,
+	// trying the workers on the same NUMA node first.
+	//
+	// Tasks must not block, and tasks with the same affinity hint may run concurrently after being stolen,
+	// so an object that needs ordering must have at most one task queued at a time (see pub::StreamWorker).
+	class TaskExecutor : public Singleton<TaskExecutor>
+	{
+	public:
+		using Task = std::function<void()>;
+
+		struct WorkerStats
+		{
+			// -1 if the worker is not pinned
+			int cpu;
+			int numa_node;
+
+			size_t queue_depth;
+			uint64_t executed_count;
+			// Number of tasks this worker stole from the others
+			uint64_t stolen_count;
+		};
+
+		// worker_count: 0 means the number of CPUs available to the process
+		bool Start(size_t worker_count, bool pin_workers);
+		bool Stop();
+
+		bool IsRunning() const
+		{
+			return _running.load(std::memory_order_relaxed);
+		}
+
+		size_t GetWorkerCount() const
+		{
+			return _workers.size();
+		}
+
+		// Returns false if the executor is not running
+		bool Post(uint64_t affinity_hint, Task task);
+
+		std::vector<WorkerStats> GetWorkerStats() const;
+
+	private:
+		friend class Singleton<TaskExecutor>;
+
+		TaskExecutor() = default;
+		~TaskExecutor() override;
+
+		struct Worker
+		{
+			size_t index = 0;
+			int cpu = -1;
+			int numa_node = 0;
+
+			std::thread thread;
+
+			std::mutex mutex;
+			std::condition_variable condition;
+			std::deque<Task> tasks;
+
+			std::atomic<bool> parked{false};
+
+			std::atomic<size_t> queue_depth{0};
+			std::atomic<uint64_t> executed_count{0};
+			std::atomic<uint64_t> stolen_count{0};
+		};
+
+		void WorkerThread(Worker *worker);
+
+		bool PopTask(Worker *worker, Task *task);
+		bool StealTask(Worker *thief, Task *task);
+		void WakeParkedWorker(int numa_node);
+
+		std::vector<std::unique_ptr<Worker>> _workers;
+		std::atomic<bool> _running{false};
+		std::atomic<size_t> _parked_count{0};
+	};
+}  // namespace ov
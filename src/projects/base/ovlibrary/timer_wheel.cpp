@@ -0,0 +1,112 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./timer_wheel.h"
+
+namespace ov
+{
+	static constexpr int64_t GetLevelSpan(size_t level)
+	{
+		return static_cast<int64_t>(1) << (TimerWheel::LevelBits * (level + 1));
+	}
+
+	static constexpr size_t GetSlotIndex(int64_t tick, size_t level)
+	{
+		return static_cast<size_t>(tick >> (TimerWheel::LevelBits * level)) & (TimerWheel::SlotCount - 1);
+	}
+
+	TimerWheel::TimerWheel(int64_t current_tick)
+		: _current_tick(current_tick)
+	{
+	}
+
+	void TimerWheel::Add(uint64_t key, int64_t tick)
+	{
+		Insert({key, tick});
+		_count++;
+	}
+
+	void TimerWheel::Insert(const Timer &timer)
+	{
+		auto delta = timer.tick - _current_tick;
+
+		if (delta <= 0)
+		{
+			_expired_timers.push_back(timer);
+			return;
+		}
+
+		for (size_t level = 0; level < LevelCount; level++)
+		{
+			if (delta < GetLevelSpan(level))
+			{
+				_slots[level][GetSlotIndex(timer.tick, level)].push_back(timer);
+				return;
+			}
+		}
+
+		// Too far, it will be inserted again when the last slot is cascaded
+		_slots[LevelCount - 1][GetSlotIndex(_current_tick + GetLevelSpan(LevelCount - 1) - 1, LevelCount - 1)].push_back(timer);
+	}
+
+	void TimerWheel::Cascade(size_t level)
+	{
+		auto &slot = _slots[level][GetSlotIndex(_current_tick, level)];
+
+		if (slot.empty())
+		{
+			return;
+		}
+
+		std::vector<Timer> timers;
+		timers.swap(slot);
+
+		for (auto &timer : timers)
+		{
+			Insert(timer);
+		}
+	}
+
+	void TimerWheel::Advance(int64_t tick, std::vector<Timer> &expired_timers)
+	{
+		auto collect_expired_timers = [&](std::vector<Timer> &timers) {
+			_count -= timers.size();
+			expired_timers.insert(expired_timers.end(), timers.begin(), timers.end());
+			timers.clear();
+		};
+
+		collect_expired_timers(_expired_timers);
+
+		while ((_current_tick < tick) && (_count > 0))
+		{
+			_current_tick++;
+
+			// When the lower levels wrap around, cascade the next slot of the upper levels (the highest one first)
+			size_t top_level = 0;
+
+			while ((top_level + 1 < LevelCount) && (GetSlotIndex(_current_tick, top_level) == 0))
+			{
+				top_level++;
+			}
+
+			for (size_t level = top_level; level > 0; level--)
+			{
+				Cascade(level);
+			}
+
+			collect_expired_timers(_slots[0][GetSlotIndex(_current_tick, 0)]);
+			collect_expired_timers(_expired_timers);
+		}
+
+		// Nothing to expire, just jump to the tick
+		if (_current_tick < tick)
+		{
+			_current_tick = tick;
+		}
+	}
+}  // namespace ov
@@ -0,0 +1,66 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ov
+{
+	// Hierarchical timer wheel: adding a timer and advancing a tick are O(1) regardless of the number of timers.
+	//
+	// Level 0 has a slot per tick, and each slot of level N covers all the slots of level N-1.
+	// When level 0 wraps around, the timers of the next slot of level 1 are cascaded down, and so on.
+	// Timers further than all the levels (about 194 days with 1ms ticks) are parked in the last slot and cascaded again.
+	//
+	// Not thread-safe, ticks are counted by the caller (e.g. milliseconds from a start time).
+	class TimerWheel
+	{
+	public:
+		struct Timer
+		{
+			uint64_t key;
+			int64_t tick;
+		};
+
+		static constexpr size_t LevelBits = 8;
+		static constexpr size_t SlotCount = 1 << LevelBits;
+		static constexpr size_t LevelCount = 4;
+
+		explicit TimerWheel(int64_t current_tick = 0);
+
+		// A timer whose tick is not later than the current tick expires at the next Advance()
+		void Add(uint64_t key, int64_t tick);
+
+		// Advances to the tick, the expired timers are appended to expired_timers
+		void Advance(int64_t tick, std::vector<Timer> &expired_timers);
+
+		int64_t GetCurrentTick() const
+		{
+			return _current_tick;
+		}
+
+		size_t GetCount() const
+		{
+			return _count;
+		}
+
+	private:
+		void Insert(const Timer &timer);
+		void Cascade(size_t level);
+
+		int64_t _current_tick;
+		size_t _count = 0;
+
+		std::array<std::array<std::vector<Timer>, SlotCount>, LevelCount> _slots;
+		std::vector<Timer> _expired_timers;
+	};
+}  // namespace ov
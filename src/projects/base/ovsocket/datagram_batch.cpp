@@ -0,0 +1,306 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "datagram_batch.h"
+
+#include <netinet/udp.h>
+
+#include "socket_private.h"
+
+#ifndef SOL_UDP
+#	define SOL_UDP 17
+#endif	// SOL_UDP
+
+#ifndef UDP_SEGMENT
+#	define UDP_SEGMENT 103
+#endif	// UDP_SEGMENT
+
+namespace ov
+{
+	static bool IsSameAddress(const SocketAddress *address1, const SocketAddress *address2)
+	{
+		if ((address1 == nullptr) || (address2 == nullptr))
+		{
+			return address1 == address2;
+		}
+
+		const auto length = address1->GetSockAddrInLength();
+
+		return (length == address2->GetSockAddrInLength()) &&
+			   (::memcmp(address1->ToSockAddr(), address2->ToSockAddr(), length) == 0);
+	}
+
+	DatagramBatch::DatagramBatch(SocketFamily family, bool use_gso)
+		: _family(family),
+		  _use_gso(use_gso)
+	{
+	}
+
+	void DatagramBatch::Clear()
+	{
+		_datagram_count = 0;
+		_message_count = 0;
+	}
+
+	bool DatagramBatch::CanMerge(const Message &message, const SocketAddress *local_address, const SocketAddress &remote_address, size_t length) const
+	{
+		return _use_gso &&
+			   (message.closed == false) &&
+			   (message.iov_count < MaxSegmentCount) &&
+			   (length <= message.segment_size) &&
+			   ((message.total_bytes + length) <= MaxGsoMessageSize) &&
+			   IsSameAddress(message.remote_address, &remote_address) &&
+			   IsSameAddress(message.local_address, local_address);
+	}
+
+	bool DatagramBatch::Append(const SocketAddress *local_address, const SocketAddress &remote_address, const Data *data)
+	{
+		if (IsFull())
+		{
+			return false;
+		}
+
+		const auto length = data->GetLength();
+
+		auto &iov = _iov_list[_datagram_count];
+		// This is intentional conversion
+		iov.iov_base = const_cast<void *>(data->GetData());
+		iov.iov_len = length;
+
+		if ((_message_count > 0) && CanMerge(_message_list[_message_count - 1], local_address, remote_address, length))
+		{
+			auto &message = _message_list[_message_count - 1];
+
+			message.iov_count++;
+			message.total_bytes += length;
+			// Only the last segment can be smaller than the segment size
+			message.closed = (length < message.segment_size);
+		}
+		else
+		{
+			auto &message = _message_list[_message_count];
+
+			message.local_address = local_address;
+			message.remote_address = &remote_address;
+			message.iov_index = _datagram_count;
+			message.iov_count = 1;
+			message.segment_size = length;
+			message.total_bytes = length;
+			message.closed = false;
+
+			_message_count++;
+		}
+
+		_datagram_count++;
+
+		return true;
+	}
+
+	void DatagramBatch::PrepareHeader(size_t message_index)
+	{
+		auto &message = _message_list[message_index];
+		auto &header = _header_list[message_index].msg_hdr;
+		auto control = _control_list[message_index].buffer;
+
+		header = {};
+		_header_list[message_index].msg_len = 0;
+
+		// This is intentional conversion
+		header.msg_name = const_cast<sockaddr *>(message.remote_address->ToSockAddr());
+		header.msg_namelen = message.remote_address->GetSockAddrInLength();
+		header.msg_iov = &(_iov_list[message.iov_index]);
+		header.msg_iovlen = message.iov_count;
+
+		size_t control_length = 0;
+
+		if (message.local_address != nullptr)
+		{
+			header.msg_control = control;
+			header.msg_controllen = ControlSize;
+
+			auto cmsg = CMSG_FIRSTHDR(&header);
+
+			if (_family == SocketFamily::Inet6)
+			{
+				in6_pktinfo pktinfo{};
+				::memcpy(&pktinfo.ipi6_addr, message.local_address->ToIn6Addr(), sizeof(in6_addr));
+
+				cmsg->cmsg_level = IPPROTO_IPV6;
+				cmsg->cmsg_type = IPV6_PKTINFO;
+				cmsg->cmsg_len = CMSG_LEN(sizeof(pktinfo));
+				::memcpy(CMSG_DATA(cmsg), &pktinfo, sizeof(pktinfo));
+
+				control_length += CMSG_SPACE(sizeof(pktinfo));
+			}
+			else
+			{
+				in_pktinfo pktinfo{};
+				pktinfo.ipi_spec_dst.s_addr = message.local_address->ToIn4Addr()->s_addr;
+
+				cmsg->cmsg_level = IPPROTO_IP;
+				cmsg->cmsg_type = IP_PKTINFO;
+				cmsg->cmsg_len = CMSG_LEN(sizeof(pktinfo));
+				::memcpy(CMSG_DATA(cmsg), &pktinfo, sizeof(pktinfo));
+
+				control_length += CMSG_SPACE(sizeof(pktinfo));
+			}
+		}
+
+		if (message.iov_count > 1)
+		{
+			// The kernel splits the payload into segments of segment_size bytes
+			header.msg_control = control;
+			header.msg_controllen = ControlSize;
+
+			auto cmsg = reinterpret_cast<cmsghdr *>(control + control_length);
+			uint16_t segment_size = static_cast<uint16_t>(message.segment_size);
+
+			cmsg->cmsg_level = SOL_UDP;
+			cmsg->cmsg_type = UDP_SEGMENT;
+			cmsg->cmsg_len = CMSG_LEN(sizeof(segment_size));
+			::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+			control_length += CMSG_SPACE(sizeof(segment_size));
+		}
+
+		header.msg_controllen = control_length;
+
+		if (control_length == 0)
+		{
+			header.msg_control = nullptr;
+		}
+	}
+
+	int DatagramBatch::SendMessages(int native_handle, size_t message_index, size_t message_count)
+	{
+		int result;
+
+		do
+		{
+			result = ::sendmmsg(native_handle, &(_header_list[message_index]), message_count, MSG_NOSIGNAL | MSG_DONTWAIT);
+		} while ((result < 0) && (errno == EINTR));
+
+		return result;
+	}
+
+	DatagramBatch::SendResult DatagramBatch::Send(int native_handle)
+	{
+		SendResult result;
+
+		for (size_t index = 0; index < _message_count; index++)
+		{
+			PrepareHeader(index);
+		}
+
+		size_t message_index = 0;
+
+		while (message_index < _message_count)
+		{
+			const auto sent_count = SendMessages(native_handle, message_index, _message_count - message_index);
+			result.syscall_count++;
+
+			if (sent_count < 0)
+			{
+				const auto error = errno;
+				const auto &message = _message_list[message_index];
+
+				if ((error == EAGAIN) || (error == EWOULDBLOCK))
+				{
+					// Socket buffer is full - retry later
+					result.would_block = true;
+					break;
+				}
+
+				if ((message.iov_count > 1) && ((error == EIO) || (error == EINVAL)))
+				{
+					// GSO is not supported (The kernel is too old, or the NIC doesn't support checksum offloading)
+					result.gso_failed = true;
+					break;
+				}
+
+				// Unlike the stream socket, an error of a datagram is related only to that datagram (ECONNREFUSED, EHOSTUNREACH, ...)
+				// So, drop the datagram and try to send the next one
+				logtd("Could not send %zu datagram(s) to %s: %s",
+					  message.iov_count,
+					  message.remote_address->ToString(false).CStr(),
+					  ::strerror(error));
+
+				result.datagram_count += message.iov_count;
+				result.dropped_count += message.iov_count;
+
+				message_index++;
+				continue;
+			}
+
+			for (int index = 0; index < sent_count; index++)
+			{
+				const auto &message = _message_list[message_index + index];
+
+				result.datagram_count += message.iov_count;
+				result.sent_bytes += message.total_bytes;
+
+				if (message.iov_count > 1)
+				{
+					result.gso_datagram_count += message.iov_count;
+				}
+			}
+
+			message_index += sent_count;
+		}
+
+		return result;
+	}
+
+	size_t DatagramReceiveBatch::Prepare()
+	{
+		size_t alloc_count = 0;
+
+		// The slots after _count were not touched by the last recvmmsg(), so they are still ready
+		const size_t prepare_count = _initialized ? _count : MaxDatagramCount;
+
+		_initialized = true;
+		_count = 0;
+
+		for (size_t index = 0; index < prepare_count; index++)
+		{
+			auto &data = _data_list[index];
+
+			if ((data == nullptr) || (data.use_count() > 1))
+			{
+				// The previous buffer is still referenced by an observer
+				data = std::make_shared<Data>(UdpBufferSize);
+				alloc_count++;
+			}
+			else
+			{
+				// If an observer has cloned the buffer, the memory is still shared with it,
+				// and SetLength() would copy the previous payload to detach it.
+				// Clear() drops the memory without copying, the new block is usually the freed one of the memory pool.
+				data->Clear();
+				data->Reserve(UdpBufferSize);
+			}
+
+			data->SetLength(data->GetCapacity());
+
+			auto &iov = _iov_list[index];
+			iov.iov_base = data->GetWritableData();
+			iov.iov_len = data->GetLength();
+
+			auto &header = _header_list[index];
+			header = {};
+			header.msg_hdr.msg_name = &(_remote_list[index]);
+			header.msg_hdr.msg_namelen = sizeof(_remote_list[index]);
+			header.msg_hdr.msg_iov = &iov;
+			header.msg_hdr.msg_iovlen = 1;
+			header.msg_hdr.msg_control = _control_list[index].buffer;
+			header.msg_hdr.msg_controllen = ControlSize;
+		}
+
+		return alloc_count;
+	}
+}  // namespace ov
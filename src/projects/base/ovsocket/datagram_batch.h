@@ -0,0 +1,183 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "socket_address.h"
+#include "socket_address_pair.h"
+#include "socket_datastructure.h"
+
+namespace ov
+{
+	// Collects the datagrams queued in the dispatch queue of the UDP socket and sends them with a single sendmmsg().
+	//
+	// When UDP_SEGMENT (GSO) is enabled, consecutive datagrams which have the same size and are sent to the same peer
+	// are merged into one message, and the kernel splits it into the original datagrams.
+	class DatagramBatch
+	{
+	public:
+		// The maximum number of datagrams that can be sent with one sendmmsg()
+		static constexpr size_t MaxDatagramCount = 64;
+		// UDP_MAX_SEGMENTS of the kernel
+		static constexpr size_t MaxSegmentCount = 64;
+		// The payload of a GSO message must not exceed the maximum size of an IP packet
+		static constexpr size_t MaxGsoMessageSize = 65000;
+
+		// Result of Send()
+		struct SendResult
+		{
+			// The number of datagrams sent (or dropped because of an error)
+			size_t datagram_count = 0;
+			size_t sent_bytes = 0;
+
+			// The number of system calls
+			size_t syscall_count = 0;
+			// The number of datagrams sent using GSO
+			size_t gso_datagram_count = 0;
+
+			// The number of datagrams dropped because of an error (except EAGAIN)
+			size_t dropped_count = 0;
+
+			// true if the socket buffer is full (EAGAIN)
+			bool would_block = false;
+			// true if GSO is not supported by the kernel or the NIC
+			bool gso_failed = false;
+		};
+
+		DatagramBatch(SocketFamily family, bool use_gso);
+
+		void SetGsoEnabled(bool use_gso)
+		{
+			_use_gso = use_gso;
+		}
+
+		bool IsGsoEnabled() const
+		{
+			return _use_gso;
+		}
+
+		void Clear();
+
+		bool IsEmpty() const
+		{
+			return _datagram_count == 0;
+		}
+
+		bool IsFull() const
+		{
+			return _datagram_count >= MaxDatagramCount;
+		}
+
+		size_t GetDatagramCount() const
+		{
+			return _datagram_count;
+		}
+
+		// local_address can be nullptr (SendTo)
+		//
+		// NOTE: The batch holds pointers to the addresses and the data, so they MUST be valid until Send() is called
+		bool Append(const SocketAddress *local_address, const SocketAddress &remote_address, const Data *data);
+
+		SendResult Send(int native_handle);
+
+	protected:
+		struct Message
+		{
+			const SocketAddress *local_address = nullptr;
+			const SocketAddress *remote_address = nullptr;
+
+			// Index of the first datagram in _iov_list
+			size_t iov_index = 0;
+			size_t iov_count = 0;
+
+			// The size of each segment (the last one can be smaller than this)
+			size_t segment_size = 0;
+			size_t total_bytes = 0;
+
+			// The last segment is smaller than segment_size, so no more segments can be merged
+			bool closed = false;
+		};
+
+		bool CanMerge(const Message &message, const SocketAddress *local_address, const SocketAddress &remote_address, size_t length) const;
+		void PrepareHeader(size_t message_index);
+
+		// Send messages from the message_index and returns the number of messages sent (-1 if an error occurred)
+		int SendMessages(int native_handle, size_t message_index, size_t message_count);
+
+	protected:
+		SocketFamily _family;
+		bool _use_gso;
+
+		// CMSG for IP_PKTINFO/IPV6_PKTINFO + UDP_SEGMENT
+		static constexpr size_t ControlSize = CMSG_SPACE(sizeof(in6_pktinfo)) + CMSG_SPACE(sizeof(uint16_t));
+
+		size_t _datagram_count = 0;
+		size_t _message_count = 0;
+
+		Message _message_list[MaxDatagramCount];
+		iovec _iov_list[MaxDatagramCount];
+		mmsghdr _header_list[MaxDatagramCount];
+		struct alignas(cmsghdr) Control
+		{
+			char buffer[ControlSize];
+		} _control_list[MaxDatagramCount];
+	};
+
+	// A reusable set of receive buffers used to read several datagrams with a single recvmmsg().
+	//
+	// The buffers are delivered to the observers as they are (without cloning), and a buffer is reused for the next
+	// recvmmsg() only if nobody holds it anymore. Otherwise, a new buffer is allocated for that slot.
+	class DatagramReceiveBatch
+	{
+	public:
+		friend class Socket;
+
+		// The maximum number of datagrams that can be received with one recvmmsg()
+		static constexpr size_t MaxDatagramCount = 32;
+
+		// Make the slots ready to receive and returns the number of buffers newly allocated
+		size_t Prepare();
+
+		// The number of datagrams received by the last recvmmsg()
+		size_t GetCount() const
+		{
+			return _count;
+		}
+
+		const SocketAddressPair &GetAddressPair(size_t index) const
+		{
+			return _address_pair_list[index];
+		}
+
+		const std::shared_ptr<Data> &GetData(size_t index) const
+		{
+			return _data_list[index];
+		}
+
+	protected:
+		// CMSG for IP_PKTINFO/IPV6_PKTINFO
+		static constexpr size_t ControlSize = CMSG_SPACE(sizeof(in6_pktinfo));
+
+		bool _initialized = false;
+		size_t _count = 0;
+
+		std::shared_ptr<Data> _data_list[MaxDatagramCount];
+		SocketAddressPair _address_pair_list[MaxDatagramCount];
+
+		iovec _iov_list[MaxDatagramCount];
+		mmsghdr _header_list[MaxDatagramCount];
+		sockaddr_storage _remote_list[MaxDatagramCount];
+		struct alignas(cmsghdr) Control
+		{
+			char buffer[ControlSize];
+		} _control_list[MaxDatagramCount];
+	};
+}  // namespace ov
@@ -80,6 +80,30 @@ namespace ov
 		return false;
 	}
 
+	bool DatagramSocket::Prepare(
+		const SocketAddress &address,
+		SetAdditionalOptionsCallback callback,
+		DatagramBatchCallback datagram_batch_callback)
+	{
+		CHECK_STATE(== SocketState::Created, false);
+
+		if (
+			(
+				MakeNonBlocking(GetSharedPtrAs<ov::SocketAsyncInterface>()) &&
+				SetSocketOptions(callback) &&
+				Bind(address)))
+		{
+			_receive_batch = std::make_unique<DatagramReceiveBatch>();
+			_datagram_batch_callback = std::move(datagram_batch_callback);
+
+			return true;
+		}
+
+		Close();
+
+		return false;
+	}
+
 	bool DatagramSocket::CloseInternal(SocketState close_reason)
 	{
 		_callback = nullptr;
@@ -97,6 +121,18 @@ namespace ov
 	{
 		logtp("Trying to read UDP packets...");
 
+		if (_datagram_batch_callback != nullptr)
+		{
+			ReadDatagramBatches();
+		}
+		else
+		{
+			ReadDatagrams();
+		}
+	}
+
+	void DatagramSocket::ReadDatagrams()
+	{
 		auto data = std::make_shared<ov::Data>(UdpBufferSize);
 
 		SocketAddressPair address_pair;
@@ -128,6 +164,36 @@ namespace ov
 		}
 	}
 
+	void DatagramSocket::ReadDatagramBatches()
+	{
+		while (true)
+		{
+			auto error = RecvFromBatch(_receive_batch.get());
+
+			if (error != nullptr)
+			{
+				// An error occurred
+				break;
+			}
+
+			const auto count = _receive_batch->GetCount();
+
+			if (count == 0)
+			{
+				// Try later
+				break;
+			}
+
+			_datagram_batch_callback(GetSharedPtrAs<DatagramSocket>(), *_receive_batch);
+
+			if (count < DatagramReceiveBatch::MaxDatagramCount)
+			{
+				// The socket buffer has been drained, so the next datagram will raise a new (edge-triggered) event
+				break;
+			}
+		}
+	}
+
 	String DatagramSocket::ToString() const
 	{
 		return Socket::ToString("DatagramSocket");
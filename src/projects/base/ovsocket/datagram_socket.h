@@ -8,6 +8,7 @@
 //==============================================================================
 #pragma once
 
+#include "datagram_batch.h"
 #include "socket.h"
 #include "socket_datastructure.h"
 
@@ -31,6 +32,10 @@ namespace ov
 		bool Prepare(const SocketAddress &address,
 					 SetAdditionalOptionsCallback callback,
 					 DatagramCallback datagram_callback);
+		// Bind to the address specified by address, and receive datagrams using recvmmsg()
+		bool Prepare(const SocketAddress &address,
+					 SetAdditionalOptionsCallback callback,
+					 DatagramBatchCallback datagram_batch_callback);
 
 		using Socket::Close;
 		using Socket::Connect;
@@ -65,6 +70,12 @@ namespace ov
 			OV_ASSERT2(false);
 		}
 
+		void ReadDatagrams();
+		void ReadDatagramBatches();
+
 		DatagramCallback _datagram_callback = nullptr;
+
+		DatagramBatchCallback _datagram_batch_callback = nullptr;
+		std::unique_ptr<DatagramReceiveBatch> _receive_batch;
 	};
 }  // namespace ov
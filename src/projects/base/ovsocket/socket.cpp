@@ -10,14 +10,17 @@
 
 #include <arpa/inet.h>
 #include <errno.h>
+#include <netinet/udp.h>
 #include <sys/fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <unistd.h>
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 
+#include "datagram_batch.h"
 #include "epoll_wrapper.h"
 #include "socket_pool/socket_pool.h"
 #include "socket_private.h"
@@ -32,6 +35,30 @@
 #define logae(format, ...) logte("[#%d] [%p] " format, (GetNativeHandle() == -1) ? 0 : GetNativeHandle(), this, ##__VA_ARGS__)
 #define logac(format, ...) logtc("[#%d] [%p] " format, (GetNativeHandle() == -1) ? 0 : GetNativeHandle(), this, ##__VA_ARGS__)
 
+#ifndef SOL_UDP
+#	define SOL_UDP 17
+#endif	// SOL_UDP
+
+#ifndef UDP_SEGMENT
+#	define UDP_SEGMENT 103
+#endif	// UDP_SEGMENT
+
+#ifndef TCP_ULP
+#	define TCP_ULP 31
+#endif	// TCP_ULP
+
+#ifndef SOL_TLS
+#	define SOL_TLS 282
+#endif	// SOL_TLS
+
+#ifndef TLS_TX
+#	define TLS_TX 1
+#endif	// TLS_TX
+
+#ifndef TLS_SET_RECORD_TYPE
+#	define TLS_SET_RECORD_TYPE 1
+#endif	// TLS_SET_RECORD_TYPE
+
 // Debugging purpose
 #include "socket_profiler.h"
 #include "stats_counter.h"
@@ -273,6 +300,40 @@ namespace ov
 		return true;
 	}
 
+	bool Socket::AppendDatagramCommand(DispatchCommand command)
+	{
+		std::lock_guard lock_guard(_dispatch_queue_lock);
+
+		_dispatch_queue.push_back(std::move(command));
+
+		if (_dispatch_queue.size() >= DatagramBatch::MaxDatagramCount)
+		{
+			// Enough datagrams are collected to fill a batch - send them in this thread to keep the queue bounded
+			switch (DispatchEvents())
+			{
+				case DispatchResult::Dispatched:
+					return true;
+
+				case DispatchResult::PartialDispatched:
+					_worker->EnqueueToDispatchLater(GetSharedPtr());
+					return true;
+
+				case DispatchResult::Error:
+					break;
+			}
+
+			return true;
+		}
+
+		if (_batch_dispatch_requested.exchange(true) == false)
+		{
+			// Datagrams enqueued until the worker wakes up are sent together
+			_worker->EnqueueToDispatchSoon(GetSharedPtr());
+		}
+
+		return true;
+	}
+
 	bool Socket::AddToWorker(bool need_to_wait_first_epoll_event)
 	{
 		if (GetType() == SocketType::Srt)
@@ -857,6 +918,33 @@ namespace ov
 				sent_bytes = SendFromToInternal(command.address_pair, data);
 				break;
 
+			case DispatchCommand::Type::SendKtlsRecord:
+				sent_bytes = SendKtlsRecordInternal(command.record_type, data);
+				break;
+
+			case DispatchCommand::Type::SendFile:
+				sent_bytes = SendFileInternal(command.file, command.file_offset, command.file_length);
+
+				if (sent_bytes == static_cast<ssize_t>(command.file_length))
+				{
+					return DispatchResult::Dispatched;
+				}
+
+				if (sent_bytes == -1)
+				{
+					return DispatchResult::Error;
+				}
+
+				if (sent_bytes > 0)
+				{
+					// The rest of the file will be sent later
+					command.UpdateTime();
+					command.file_offset += sent_bytes;
+					command.file_length -= sent_bytes;
+				}
+
+				return DispatchResult::PartialDispatched;
+
 			case DispatchCommand::Type::HalfClose:
 				return HalfClose();
 
@@ -908,6 +996,144 @@ namespace ov
 		return DispatchResult::PartialDispatched;
 	}
 
+	Socket::DispatchResult Socket::DispatchDatagramCommands()
+	{
+		if (_datagram_batch == nullptr)
+		{
+			_datagram_batch = std::make_unique<DatagramBatch>(_family, _gso_enabled);
+		}
+
+		auto &batch = *_datagram_batch;
+
+		while (true)
+		{
+			batch.Clear();
+			batch.SetGsoEnabled(_gso_enabled);
+
+			for (auto &command : _dispatch_queue)
+			{
+				if ((IsDatagramCommand(command) == false) || batch.IsFull())
+				{
+					break;
+				}
+
+				if (command.type == DispatchCommand::Type::SendTo)
+				{
+					batch.Append(nullptr, command.address, command.data.get());
+				}
+				else
+				{
+					batch.Append(&(command.address_pair.GetLocalAddress()), command.address_pair.GetRemoteAddress(), command.data.get());
+				}
+			}
+
+			if (batch.IsEmpty())
+			{
+				return DispatchResult::Dispatched;
+			}
+
+			const auto result = batch.Send(GetNativeHandle());
+
+			_worker->GetStats().OnDatagramsSent(result.syscall_count, result.datagram_count, result.sent_bytes, result.gso_datagram_count, result.dropped_count);
+
+			if (result.sent_bytes > 0)
+			{
+				UpdateLastSentTime();
+			}
+
+			// Sent (or dropped) commands are removed
+			for (size_t index = 0; index < result.datagram_count; index++)
+			{
+				_dispatch_queue.pop_front();
+			}
+
+			if (result.gso_failed)
+			{
+				logaw("UDP GSO is not available for this socket - GSO is disabled");
+				_gso_enabled = false;
+				continue;
+			}
+
+			if (result.would_block)
+			{
+				STATS_COUNTER_INCREASE_RETRY();
+
+				if (_dispatch_queue.empty() == false)
+				{
+					// Since some datagrams have been sent, the time needs to be updated
+					if (result.datagram_count > 0)
+					{
+						_dispatch_queue.front().UpdateTime();
+					}
+
+					return DispatchResult::PartialDispatched;
+				}
+			}
+
+			return DispatchResult::Dispatched;
+		}
+	}
+
+	Socket::DispatchResult Socket::DispatchStreamCommands()
+	{
+		struct iovec iov_list[MAX_STREAM_IOV_COUNT];
+		size_t iov_count = 0;
+		size_t total_bytes = 0;
+
+		for (auto &command : _dispatch_queue)
+		{
+			if ((command.type != DispatchCommand::Type::Send) || (iov_count == MAX_STREAM_IOV_COUNT))
+			{
+				break;
+			}
+
+			iov_list[iov_count].iov_base = const_cast<void *>(command.data->GetData());
+			iov_list[iov_count].iov_len = command.data->GetLength();
+			total_bytes += command.data->GetLength();
+			iov_count++;
+		}
+
+		struct msghdr message = {};
+		message.msg_iov = iov_list;
+		message.msg_iovlen = iov_count;
+
+		logap("Trying to send %zu buffers (%zu bytes)...", iov_count, total_bytes);
+
+		const auto sent = ::sendmsg(GetNativeHandle(), &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+		if (sent < 0L)
+		{
+			// HandleSendError() returns 0 if the socket buffer is full
+			return (HandleSendError(sent, 0) == 0) ? DispatchResult::PartialDispatched : DispatchResult::Error;
+		}
+
+		STATS_COUNTER_INCREASE_PPS();
+		UpdateLastSentTime();
+
+		// Sent commands are removed, and the partially sent one keeps the rest of the data
+		auto remaining_bytes = static_cast<size_t>(sent);
+
+		while (remaining_bytes > 0)
+		{
+			auto &front = _dispatch_queue.front();
+			auto length = front.data->GetLength();
+
+			if (remaining_bytes < length)
+			{
+				front.UpdateTime();
+				front.data = front.data->Subdata(remaining_bytes);
+				break;
+			}
+
+			remaining_bytes -= length;
+			_dispatch_queue.pop_front();
+		}
+
+		logap("%zd bytes sent", sent);
+
+		return (static_cast<size_t>(sent) == total_bytes) ? DispatchResult::Dispatched : DispatchResult::PartialDispatched;
+	}
+
 	Socket::DispatchResult Socket::DispatchEventsInternal()
 	{
 		SOCKET_PROFILER_INIT();
@@ -928,12 +1154,48 @@ namespace ov
 				}
 			});
 
+			// The worker is going to dispatch the queued datagrams, so the next datagram needs to request again
+			_batch_dispatch_requested = false;
+
 			if (_dispatch_queue.empty() == false)
 			{
 				logap("Dispatching events (count: %zu)...", _dispatch_queue.size());
 
 				while (_dispatch_queue.empty() == false)
 				{
+					if ((GetType() == SocketType::Udp) &&
+						_batched_send_mode &&
+						IsDatagramCommand(_dispatch_queue.front()) &&
+						(GetState() != SocketState::Closed))
+					{
+						// Multiple datagrams are sent at once
+						result = DispatchDatagramCommands();
+
+						if (result == DispatchResult::Dispatched)
+						{
+							continue;
+						}
+
+						break;
+					}
+
+					if ((GetType() == SocketType::Tcp) &&
+						(_dispatch_queue.size() > 1) &&
+						(_dispatch_queue[0].type == DispatchCommand::Type::Send) &&
+						(_dispatch_queue[1].type == DispatchCommand::Type::Send) &&
+						(GetState() != SocketState::Closed))
+					{
+						// Multiple buffers are sent at once
+						result = DispatchStreamCommands();
+
+						if (result == DispatchResult::Dispatched)
+						{
+							continue;
+						}
+
+						break;
+					}
+
 					auto front = _dispatch_queue.front();
 					_dispatch_queue.pop_front();
 
@@ -1196,6 +1458,43 @@ namespace ov
 		return -1L;
 	}
 
+	ssize_t Socket::SendFileInternal(const std::shared_ptr<const ReadOnlyFile> &file, off_t offset, size_t length)
+	{
+		size_t remaining_bytes = length;
+		size_t total_sent_bytes = 0L;
+
+		logap("Trying to send file %s (offset: %jd, %zu bytes)...", file->GetPath().CStr(), static_cast<intmax_t>(offset), length);
+
+		while ((remaining_bytes > 0L) && (_force_stop == false))
+		{
+			// sendfile() updates the offset
+			const auto sent = ::sendfile(GetNativeHandle(), file->GetNativeHandle(), &offset, remaining_bytes);
+
+			if (sent < 0L)
+			{
+				return HandleSendError(sent, total_sent_bytes);
+			}
+
+			if (sent == 0L)
+			{
+				// The file has been truncated
+				logaw("Could not send file %s: %zu bytes are left, but EOF is reached", file->GetPath().CStr(), remaining_bytes);
+				STATS_COUNTER_INCREASE_ERROR();
+				return -1L;
+			}
+
+			STATS_COUNTER_INCREASE_PPS();
+
+			remaining_bytes -= sent;
+			total_sent_bytes += sent;
+
+			UpdateLastSentTime();
+		}
+
+		logap("%zu bytes sent", total_sent_bytes);
+		return total_sent_bytes;
+	}
+
 	bool Socket::Send(const std::shared_ptr<const Data> &data)
 	{
 		if (data == nullptr)
@@ -1225,6 +1524,177 @@ namespace ov
 		return Send((data == nullptr) ? nullptr : std::make_shared<Data>(data, length));
 	}
 
+	bool Socket::Send(const std::vector<std::shared_ptr<const Data>> &data_list)
+	{
+		if (data_list.empty())
+		{
+			return true;
+		}
+
+		// Checked before anything is sent, so the peer never receives a part of the list
+		for (const auto &data : data_list)
+		{
+			if (data == nullptr)
+			{
+				OV_ASSERT2(data != nullptr);
+				return false;
+			}
+		}
+
+		switch (_blocking_mode)
+		{
+			case BlockingMode::Blocking:
+				for (const auto &data : data_list)
+				{
+					if (Send(data) == false)
+					{
+						return false;
+					}
+				}
+
+				return true;
+
+			case BlockingMode::NonBlocking: {
+				if (IsSendable() == false)
+				{
+					break;
+				}
+
+				// Enqueue all the buffers first, so that they can be dispatched together
+				std::lock_guard lock_guard(_dispatch_queue_lock);
+
+				auto last = std::prev(data_list.end());
+
+				for (auto data = data_list.begin(); data != data_list.end(); ++data)
+				{
+					AppendCommand({(*data)->Clone()}, data == last);
+				}
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool Socket::SendFile(const std::shared_ptr<const ReadOnlyFile> &file, off_t offset, size_t length)
+	{
+		if (file == nullptr)
+		{
+			OV_ASSERT2(file != nullptr);
+			return false;
+		}
+
+		if (GetType() != SocketType::Tcp)
+		{
+			logae("Could not send file - sendfile() is only supported for TCP");
+			return false;
+		}
+
+		if (length == 0)
+		{
+			return true;
+		}
+
+		switch (_blocking_mode)
+		{
+			case BlockingMode::Blocking:
+				return (SendFileInternal(file, offset, length) == static_cast<ssize_t>(length));
+
+			case BlockingMode::NonBlocking:
+				if (IsSendable())
+				{
+					return AppendCommand({file, offset, length}, true);
+				}
+				break;
+		}
+
+		return false;
+	}
+
+	bool Socket::EnableKtlsSend(const void *crypto_info, socklen_t crypto_info_length)
+	{
+		CHECK_STATE(== SocketState::Connected, false);
+
+		if (GetType() != SocketType::Tcp)
+		{
+			return false;
+		}
+
+		// Prevent the dispatcher from sending while the keys are being installed
+		std::lock_guard lock_guard(_dispatch_queue_lock);
+
+		if (HasCommand())
+		{
+			// These records are already encrypted, so the kernel must not encrypt them again
+			logad("Could not enable kTLS: %zu commands are waiting to be sent", _dispatch_queue.size());
+			return false;
+		}
+
+		if (::setsockopt(GetNativeHandle(), SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0)
+		{
+			// The tls module is not loaded, or the kernel does not support kTLS
+			logad("Could not enable kTLS: %s", Error::CreateErrorFromErrno()->What());
+			return false;
+		}
+
+		if (::setsockopt(GetNativeHandle(), SOL_TLS, TLS_TX, crypto_info, crypto_info_length) != 0)
+		{
+			// The ULP cannot be removed, but the socket keeps working as a plain TCP socket without TLS_TX
+			logad("Could not install kTLS TX keys: %s", Error::CreateErrorFromErrno()->What());
+			return false;
+		}
+
+		logad("kTLS TX is enabled");
+
+		return true;
+	}
+
+	ssize_t Socket::SendKtlsRecord(uint8_t record_type, const void *data, size_t length)
+	{
+		CHECK_STATE(== SocketState::Connected, -1L);
+
+		// Queued behind the application data waiting in the queue, and the rest is sent later if the socket buffer is full.
+		// Records are small (alert, session ticket), so they are copied
+		if (AppendCommand(DispatchCommand(record_type, std::make_shared<Data>(data, length)), true) == false)
+		{
+			return -1L;
+		}
+
+		return length;
+	}
+
+	ssize_t Socket::SendKtlsRecordInternal(uint8_t record_type, const std::shared_ptr<const Data> &data)
+	{
+		char control[CMSG_SPACE(sizeof(record_type))] = {};
+		struct iovec iov = {const_cast<void *>(data->GetData()), data->GetLength()};
+		struct msghdr message = {};
+
+		message.msg_iov = &iov;
+		message.msg_iovlen = 1;
+		message.msg_control = control;
+		message.msg_controllen = sizeof(control);
+
+		auto cmsg = CMSG_FIRSTHDR(&message);
+		cmsg->cmsg_level = SOL_TLS;
+		cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(record_type));
+		::memcpy(CMSG_DATA(cmsg), &record_type, sizeof(record_type));
+
+		// If only a part is sent, the rest is sent as another record of the same type
+		auto sent = ::sendmsg(GetNativeHandle(), &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+		if (sent < 0L)
+		{
+			return HandleSendError(sent, 0);
+		}
+
+		STATS_COUNTER_INCREASE_PPS();
+		UpdateLastSentTime();
+
+		return sent;
+	}
+
 	ssize_t Socket::SendToInternal(const SocketAddress &address, const std::shared_ptr<const Data> &data)
 	{
 		if (GetType() != SocketType::Udp)
@@ -1253,6 +1723,7 @@ namespace ov
 			OV_ASSERT2(static_cast<ssize_t>(remaining_bytes) >= sent);
 
 			STATS_COUNTER_INCREASE_PPS();
+			_worker->GetStats().OnDatagramsSent(1, 1, sent);
 
 			data_to_send += sent;
 			remaining_bytes -= sent;
@@ -1281,6 +1752,11 @@ namespace ov
 			case BlockingMode::NonBlocking:
 				if (IsSendable())
 				{
+					if (_batched_send_mode)
+					{
+						return AppendDatagramCommand(DispatchCommand(address, data->Clone()));
+					}
+
 					return AppendCommand(
 						(GetType() == SocketType::Udp)
 							? DispatchCommand(address, data->Clone())
@@ -1422,6 +1898,7 @@ namespace ov
 
 		if (total_sent_bytes > 0L)
 		{
+			_worker->GetStats().OnDatagramsSent(1, 1, total_sent_bytes);
 			UpdateLastSentTime();
 		}
 
@@ -1454,6 +1931,11 @@ namespace ov
 			case BlockingMode::NonBlocking:
 				if (IsSendable())
 				{
+					if (_batched_send_mode)
+					{
+						return AppendDatagramCommand(DispatchCommand(address_pair, data->Clone()));
+					}
+
 					return AppendCommand(
 						(GetType() == SocketType::Udp)
 							? DispatchCommand(address_pair, data->Clone())
@@ -1470,6 +1952,31 @@ namespace ov
 		return SendFromTo(address_pair, (data == nullptr) ? nullptr : std::make_shared<Data>(data, length));
 	}
 
+	bool Socket::SetBatchedSendMode(bool enabled)
+	{
+		if (enabled)
+		{
+			if ((GetType() != SocketType::Udp) || (_blocking_mode != BlockingMode::NonBlocking))
+			{
+				logaw("Batched send mode is only available for nonblocking UDP socket");
+				return false;
+			}
+
+			// If UDP_SEGMENT option can be read, the kernel supports UDP GSO (Linux 4.18+)
+			int gso_size = 0;
+			socklen_t gso_size_length = sizeof(gso_size);
+			_gso_enabled = (::getsockopt(GetNativeHandle(), SOL_UDP, UDP_SEGMENT, &gso_size, &gso_size_length) == 0);
+
+			logad("Batched send mode is enabled (GSO: %s)", _gso_enabled ? "enabled" : "disabled");
+		}
+
+		std::lock_guard lock_guard(_dispatch_queue_lock);
+
+		_batched_send_mode = enabled;
+
+		return true;
+	}
+
 	std::shared_ptr<const SocketError> Socket::Recv(std::shared_ptr<Data> &data, const bool non_block)
 	{
 		OV_ASSERT2(data != nullptr);
@@ -1788,6 +2295,11 @@ namespace ov
 						address_pair->SetRemoteAddress(SocketAddress("", remote));
 					}
 
+					if (GetType() == SocketType::Udp)
+					{
+						_worker->GetStats().OnDatagramsReceived(1, 1, read_bytes);
+					}
+
 					UpdateLastRecvTime();
 				}
 				break;
@@ -1817,6 +2329,75 @@ namespace ov
 		return socket_error;
 	}
 
+	std::shared_ptr<const SocketError> Socket::RecvFromBatch(DatagramReceiveBatch *batch)
+	{
+		OV_ASSERT2(_socket.IsValid());
+		OV_ASSERT2(batch != nullptr);
+
+		if (GetType() != SocketType::Udp)
+		{
+			OV_ASSERT2(false);
+			return SocketError::CreateError("RecvFromBatch() is only supported for UDP");
+		}
+
+		const auto alloc_count = batch->Prepare();
+
+		logad("Trying to read datagrams from the socket...");
+
+		int read_count;
+
+		do
+		{
+			read_count = ::recvmmsg(GetNativeHandle(), batch->_header_list, DatagramReceiveBatch::MaxDatagramCount, MSG_DONTWAIT, nullptr);
+		} while ((read_count < 0) && (errno == EINTR));
+
+		if (read_count < 0)
+		{
+			auto error = Error::CreateErrorFromErrno();
+
+			_worker->GetStats().OnDatagramsReceived(1, 0, 0, alloc_count);
+
+			if (error->GetCode() == EAGAIN)
+			{
+				// Timed out
+				return nullptr;
+			}
+
+			auto socket_error = SocketError::CreateError(error);
+
+			logae("An error occurred while read datagrams: %s", socket_error->What());
+
+			CloseWithState(SocketState::Error);
+
+			return socket_error;
+		}
+
+		const auto port = GetLocalAddress()->Port();
+		size_t total_bytes = 0;
+
+		for (int index = 0; index < read_count; index++)
+		{
+			auto &header = batch->_header_list[index];
+			auto &address_pair = batch->_address_pair_list[index];
+			const auto &remote = batch->_remote_list[index];
+
+			batch->_data_list[index]->SetLength(header.msg_len);
+			total_bytes += header.msg_len;
+
+			address_pair.SetLocalAddress(QueryLocalAddress(_family, port, remote, &(header.msg_hdr)));
+			address_pair.SetRemoteAddress(SocketAddress("", remote));
+		}
+
+		batch->_count = read_count;
+
+		logad("%d datagrams (%zu bytes) read", read_count, total_bytes);
+
+		_worker->GetStats().OnDatagramsReceived(1, read_count, total_bytes, alloc_count);
+		UpdateLastRecvTime();
+
+		return nullptr;
+	}
+
 	std::chrono::system_clock::time_point Socket::GetLastRecvTime() const
 	{
 		return _last_recv_time;
@@ -11,6 +11,7 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 
+#include "../ovlibrary/files.h"
 #include "socket_address.h"
 #include "socket_address_pair.h"
 #include "socket_wrapper.h"
@@ -36,6 +37,8 @@ namespace ov
 	// Forward declaration
 	class Socket;
 	class SocketPoolWorker;
+	class DatagramBatch;
+	class DatagramReceiveBatch;
 
 	class SocketAsyncInterface
 	{
@@ -178,6 +181,22 @@ namespace ov
 
 		bool Send(const std::shared_ptr<const Data> &data);
 		bool Send(const void *data, size_t length);
+		// Sends the concatenation of data_list without copying them into a buffer
+		// (consecutive buffers of a TCP socket are sent together using sendmsg() with an iovec)
+		bool Send(const std::vector<std::shared_ptr<const Data>> &data_list);
+		// Sends length bytes of the file from offset using sendfile() without reading it into userspace (TCP only).
+		// The data is sent as is, so it must not be used for a socket that encrypts the data in userspace (TLS without kTLS).
+		bool SendFile(const std::shared_ptr<const ReadOnlyFile> &file, off_t offset, size_t length);
+
+		// Kernel TLS (TCP only)
+		//
+		// Installs the TX keys of a TLS session (struct tls12_crypto_info_*) into the socket.
+		// After that, Send() takes plaintext and the kernel encrypts it into TLS records.
+		// Fails if there is data in the dispatch queue, because it was encrypted in userspace.
+		bool EnableKtlsSend(const void *crypto_info, socklen_t crypto_info_length);
+		// Sends a non-application record (handshake, alert) of a kTLS socket in order with the queued data.
+		// Returns the accepted bytes (the rest is sent later if the socket buffer is full), or -1 on error
+		ssize_t SendKtlsRecord(uint8_t record_type, const void *data, size_t length);
 
 		bool SendTo(const SocketAddress &address, const std::shared_ptr<const Data> &data);
 		bool SendTo(const SocketAddress &address, const void *data, size_t length);
@@ -185,6 +204,17 @@ namespace ov
 		bool SendFromTo(const SocketAddressPair &address_pair, const std::shared_ptr<const Data> &data);
 		bool SendFromTo(const SocketAddressPair &address_pair, const void *data, size_t length);
 
+		// Batched send mode (UDP in nonblocking mode only)
+		//
+		// SendTo()/SendFromTo() enqueue the datagram without sending it, and the SocketPoolWorker sends
+		// the queued datagrams with sendmmsg() as soon as it wakes up.
+		// If the kernel supports UDP_SEGMENT (GSO), consecutive datagrams to the same peer are sent as one message.
+		bool SetBatchedSendMode(bool enabled);
+		bool IsBatchedSendMode() const
+		{
+			return _batched_send_mode;
+		}
+
 		// When Recv is called in non-blocking mode,
 		//
 		// 1. return != nullptr: An error occurred (Include disconnecting the client)
@@ -199,6 +229,10 @@ namespace ov
 
 		// If MakeNonBlocking() is called, non_block is ignored
 		std::shared_ptr<const SocketError> RecvFrom(std::shared_ptr<Data> &data, SocketAddressPair *address_pair, const bool non_block = false);
+		// Receives up to DatagramReceiveBatch::MaxDatagramCount datagrams with a single recvmmsg() (Only used when UDP)
+		//
+		// batch->GetCount() == 0 means "Retry later (EAGAIN)"
+		std::shared_ptr<const SocketError> RecvFromBatch(DatagramReceiveBatch *batch);
 
 		std::chrono::system_clock::time_point GetLastRecvTime() const;
 		std::chrono::system_clock::time_point GetLastSentTime() const;
@@ -266,6 +300,10 @@ namespace ov
 				SendTo = 0x02,
 				// Need to send data using sendmsg()
 				SendFromTo = 0x03,
+				// Need to send a file using sendfile()
+				SendFile = 0x04,
+				// Need to send a non-application kTLS record using sendmsg() (TLS_SET_RECORD_TYPE)
+				SendKtlsRecord = 0x05,
 
 				// Need to call shutdown(SHUT_WR) (TCP only)
 				HalfClose = CLOSE_TYPE_MASK | 0x01,
@@ -291,6 +329,12 @@ namespace ov
 					case Type::SendFromTo:
 						return "SendFromTo";
 
+					case Type::SendFile:
+						return "SendFile";
+
+					case Type::SendKtlsRecord:
+						return "SendKtlsRecord";
+
 					case Type::HalfClose:
 						return "HalfClose";
 
@@ -327,6 +371,23 @@ namespace ov
 			{
 			}
 
+			DispatchCommand(const std::shared_ptr<const ReadOnlyFile> &file, off_t file_offset, size_t file_length)
+				: type(Type::SendFile),
+				  file(file),
+				  file_offset(file_offset),
+				  file_length(file_length),
+				  enqueued_time(std::chrono::system_clock::now())
+			{
+			}
+
+			DispatchCommand(uint8_t record_type, const std::shared_ptr<const Data> &data)
+				: type(Type::SendKtlsRecord),
+				  data(data),
+				  record_type(record_type),
+				  enqueued_time(std::chrono::system_clock::now())
+			{
+			}
+
 			DispatchCommand(Type type)
 				: type(type),
 				  enqueued_time(std::chrono::system_clock::now())
@@ -347,6 +408,10 @@ namespace ov
 				  address(another_command.address),
 				  address_pair(another_command.address_pair),
 				  data(another_command.data),
+				  file(another_command.file),
+				  file_offset(another_command.file_offset),
+				  file_length(another_command.file_length),
+				  record_type(another_command.record_type),
 				  enqueued_time(another_command.enqueued_time)
 			{
 			}
@@ -359,6 +424,10 @@ namespace ov
 				std::swap(address, another_command.address);
 				std::swap(address_pair, another_command.address_pair);
 				std::swap(data, another_command.data);
+				std::swap(file, another_command.file);
+				std::swap(file_offset, another_command.file_offset);
+				std::swap(file_length, another_command.file_length);
+				std::swap(record_type, another_command.record_type);
 				std::swap(enqueued_time, another_command.enqueued_time);
 			}
 
@@ -397,11 +466,21 @@ namespace ov
 					description.AppendFormat(", address_pair: %s", address_pair.ToString().CStr());
 				}
 
+				if (type == DispatchCommand::Type::SendKtlsRecord)
+				{
+					description.AppendFormat(", record_type: %d", record_type);
+				}
+
 				if (data != nullptr)
 				{
 					description.AppendFormat(", data: %zu bytes", data->GetLength());
 				}
 
+				if (file != nullptr)
+				{
+					description.AppendFormat(", file: %s (offset: %jd, %zu bytes)", file->GetPath().CStr(), static_cast<intmax_t>(file_offset), file_length);
+				}
+
 				description.Append('>');
 
 				return description;
@@ -412,6 +491,12 @@ namespace ov
 			SocketAddress address;
 			SocketAddressPair address_pair;
 			std::shared_ptr<const Data> data;
+			// Used by SendFile
+			std::shared_ptr<const ReadOnlyFile> file;
+			off_t file_offset = 0;
+			size_t file_length = 0;
+			// Used by SendKtlsRecord
+			uint8_t record_type = 0;
 			std::chrono::time_point<std::chrono::system_clock> enqueued_time;
 		};
 
@@ -424,6 +509,8 @@ namespace ov
 		bool SetBlockingInternal(BlockingMode mode);
 
 		bool AppendCommand(DispatchCommand command, bool dispatch_immediately);
+		// Used in batched send mode
+		bool AppendDatagramCommand(DispatchCommand command);
 
 		//--------------------------------------------------------------------
 		// Implementation of SocketPoolEventInterface
@@ -435,6 +522,16 @@ namespace ov
 
 		DispatchResult DispatchEventInternal(DispatchCommand &command);
 
+		static bool IsDatagramCommand(const DispatchCommand &command)
+		{
+			return (command.type == DispatchCommand::Type::SendTo) || (command.type == DispatchCommand::Type::SendFromTo);
+		}
+
+		// Sends consecutive SendTo/SendFromTo commands in front of _dispatch_queue using sendmmsg()
+		DispatchResult DispatchDatagramCommands();
+		// Sends consecutive Send commands in front of _dispatch_queue using sendmsg() with an iovec (TCP)
+		DispatchResult DispatchStreamCommands();
+
 		bool IsSendable() const;
 		ssize_t HandleSendError(const ssize_t result, const size_t total_sent);
 
@@ -444,6 +541,8 @@ namespace ov
 		ssize_t SendSrtData(const std::shared_ptr<const Data> &data);
 
 		ssize_t SendInternal(const std::shared_ptr<const Data> &data);
+		ssize_t SendFileInternal(const std::shared_ptr<const ReadOnlyFile> &file, off_t offset, size_t length);
+		ssize_t SendKtlsRecordInternal(uint8_t record_type, const std::shared_ptr<const Data> &data);
 		ssize_t SendToInternal(const SocketAddress &address, const std::shared_ptr<const Data> &data);
 		ssize_t SendFromToInternal(const SocketAddressPair &address_pair, const std::shared_ptr<const Data> &data);
 
@@ -540,6 +639,14 @@ namespace ov
 
 		String _stream_id;	// only available for SRT socket
 
+		// Related to batched send mode (only available for UDP socket)
+		bool _batched_send_mode = false;
+		bool _gso_enabled = false;
+		// true if the socket is enqueued to the worker, and the worker hasn't dispatched it yet
+		std::atomic<bool> _batch_dispatch_requested{false};
+		// Protected by _dispatch_queue_lock
+		std::unique_ptr<DatagramBatch> _datagram_batch;
+
 	private:
 		void UpdateLastRecvTime();
 		void UpdateLastSentTime();
@@ -220,6 +220,9 @@ namespace ov
 	class DatagramSocket;
 
 	typedef std::function<void(const std::shared_ptr<DatagramSocket> &client, const SocketAddressPair &address_pair, const std::shared_ptr<Data> &data)> DatagramCallback;
+	// Called with the datagrams received by one recvmmsg()
+	class DatagramReceiveBatch;
+	typedef std::function<void(const std::shared_ptr<DatagramSocket> &client, const DatagramReceiveBatch &batch)> DatagramBatchCallback;
 
 	static String StringFromEpollEvent(const epoll_event &event)
 	{
@@ -123,6 +123,66 @@ namespace ov
 		return UninitializeInternal();
 	}
 
+	void SocketPool::RegisterPool(const std::shared_ptr<SocketPool> &pool)
+	{
+		std::lock_guard lock_guard(_pool_list_mutex);
+
+		// Remove the pools that have already been released
+		_pool_list.erase(
+			std::remove_if(_pool_list.begin(), _pool_list.end(),
+						   [](const std::weak_ptr<SocketPool> &item) {
+							   return item.expired();
+						   }),
+			_pool_list.end());
+
+		_pool_list.push_back(pool);
+	}
+
+	std::vector<std::shared_ptr<SocketPool>> SocketPool::GetPoolList()
+	{
+		std::vector<std::shared_ptr<SocketPool>> pool_list;
+
+		std::lock_guard lock_guard(_pool_list_mutex);
+
+		for (auto &item : _pool_list)
+		{
+			auto pool = item.lock();
+
+			if (pool != nullptr)
+			{
+				pool_list.push_back(pool);
+			}
+		}
+
+		return pool_list;
+	}
+
+	SocketPoolStats::Snapshot SocketPool::GetStatsSnapshot() const
+	{
+		SocketPoolStats::Snapshot snapshot;
+
+		for (auto &worker_snapshot : GetWorkerStatsSnapshots())
+		{
+			snapshot += worker_snapshot;
+		}
+
+		return snapshot;
+	}
+
+	std::vector<SocketPoolStats::Snapshot> SocketPool::GetWorkerStatsSnapshots() const
+	{
+		std::vector<SocketPoolStats::Snapshot> snapshots;
+
+		std::lock_guard lock_guard(_worker_list_mutex);
+
+		for (auto &worker : _worker_list)
+		{
+			snapshots.push_back(worker->GetStatsSnapshot());
+		}
+
+		return snapshots;
+	}
+
 	String SocketPool::ToString() const
 	{
 		String description;
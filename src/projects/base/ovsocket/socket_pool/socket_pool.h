@@ -26,9 +26,16 @@ namespace ov
 
 		static std::shared_ptr<SocketPool> Create(const char *name, SocketType type)
 		{
-			return std::make_shared<SocketPool>(PrivateToken{nullptr}, name, type);
+			auto pool = std::make_shared<SocketPool>(PrivateToken{nullptr}, name, type);
+
+			RegisterPool(pool);
+
+			return pool;
 		}
 
+		// Returns the socket pools that are alive (for statistics)
+		static std::vector<std::shared_ptr<SocketPool>> GetPoolList();
+
 		static std::shared_ptr<SocketPool> GetTcpPool()
 		{
 			static std::shared_ptr<SocketPool> pool;
@@ -117,9 +124,15 @@ namespace ov
 
 		bool Uninitialize();
 
+		// Sum of the stats of all workers
+		SocketPoolStats::Snapshot GetStatsSnapshot() const;
+		std::vector<SocketPoolStats::Snapshot> GetWorkerStatsSnapshots() const;
+
 		String ToString() const;
 
 	protected:
+		static void RegisterPool(const std::shared_ptr<SocketPool> &pool);
+
 		// This method will increase the number of sockets for that worker by 1
 		std::shared_ptr<SocketPoolWorker> GetIdleWorker()
 		{
@@ -149,5 +162,8 @@ namespace ov
 
 		mutable std::mutex _worker_list_mutex;
 		std::vector<std::shared_ptr<SocketPoolWorker>> _worker_list;
+
+		inline static std::mutex _pool_list_mutex;
+		inline static std::vector<std::weak_ptr<SocketPool>> _pool_list;
 	};
 }  // namespace ov
@@ -0,0 +1,132 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+
+namespace ov
+{
+	// Counters of datagram I/O processed by a SocketPoolWorker
+	//
+	// These are updated on the hot path, so only relaxed atomic operations are used
+	class SocketPoolStats
+	{
+	public:
+		struct Snapshot
+		{
+			uint64_t send_syscall_count = 0;
+			uint64_t sent_datagram_count = 0;
+			uint64_t sent_bytes = 0;
+			uint64_t gso_datagram_count = 0;
+			uint64_t dropped_datagram_count = 0;
+
+			uint64_t recv_syscall_count = 0;
+			uint64_t received_datagram_count = 0;
+			uint64_t received_bytes = 0;
+			// The number of receive buffers newly allocated because the previous one was still referenced by an observer
+			uint64_t recv_buffer_alloc_count = 0;
+
+			// CPU time consumed by the worker thread (in microseconds)
+			int64_t worker_cpu_time_us = 0;
+
+			double GetSyscallsPerDatagram() const
+			{
+				return (sent_datagram_count > 0) ? (static_cast<double>(send_syscall_count) / sent_datagram_count) : 0.0;
+			}
+
+			double GetDatagramsPerRecvSyscall() const
+			{
+				return (recv_syscall_count > 0) ? (static_cast<double>(received_datagram_count) / recv_syscall_count) : 0.0;
+			}
+
+			// Bytes sent/received per second of CPU time of the worker thread
+			//
+			// NOTE: Datagrams sent from the caller thread (without batched send mode) are not included in worker_cpu_time_us,
+			//       so the sending part of this value is only meaningful for sockets that use batched send mode
+			uint64_t GetThroughputPerCore() const
+			{
+				return (worker_cpu_time_us > 0) ? ((sent_bytes + received_bytes) * 1000000 / worker_cpu_time_us) : 0;
+			}
+
+			Snapshot &operator+=(const Snapshot &other)
+			{
+				send_syscall_count += other.send_syscall_count;
+				sent_datagram_count += other.sent_datagram_count;
+				sent_bytes += other.sent_bytes;
+				gso_datagram_count += other.gso_datagram_count;
+				dropped_datagram_count += other.dropped_datagram_count;
+				recv_syscall_count += other.recv_syscall_count;
+				received_datagram_count += other.received_datagram_count;
+				received_bytes += other.received_bytes;
+				recv_buffer_alloc_count += other.recv_buffer_alloc_count;
+				worker_cpu_time_us += other.worker_cpu_time_us;
+
+				return *this;
+			}
+		};
+
+		void OnDatagramsSent(size_t syscall_count, size_t datagram_count, size_t bytes, size_t gso_datagram_count = 0, size_t dropped_count = 0)
+		{
+			_send_syscall_count.fetch_add(syscall_count, std::memory_order_relaxed);
+			_sent_datagram_count.fetch_add(datagram_count - dropped_count, std::memory_order_relaxed);
+			_sent_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+			if (gso_datagram_count > 0)
+			{
+				_gso_datagram_count.fetch_add(gso_datagram_count, std::memory_order_relaxed);
+			}
+
+			if (dropped_count > 0)
+			{
+				_dropped_datagram_count.fetch_add(dropped_count, std::memory_order_relaxed);
+			}
+		}
+
+		void OnDatagramsReceived(size_t syscall_count, size_t datagram_count, size_t bytes, size_t buffer_alloc_count = 0)
+		{
+			_recv_syscall_count.fetch_add(syscall_count, std::memory_order_relaxed);
+			_received_datagram_count.fetch_add(datagram_count, std::memory_order_relaxed);
+			_received_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+			if (buffer_alloc_count > 0)
+			{
+				_recv_buffer_alloc_count.fetch_add(buffer_alloc_count, std::memory_order_relaxed);
+			}
+		}
+
+		Snapshot GetSnapshot() const
+		{
+			Snapshot snapshot;
+
+			snapshot.send_syscall_count = _send_syscall_count.load(std::memory_order_relaxed);
+			snapshot.sent_datagram_count = _sent_datagram_count.load(std::memory_order_relaxed);
+			snapshot.sent_bytes = _sent_bytes.load(std::memory_order_relaxed);
+			snapshot.gso_datagram_count = _gso_datagram_count.load(std::memory_order_relaxed);
+			snapshot.dropped_datagram_count = _dropped_datagram_count.load(std::memory_order_relaxed);
+			snapshot.recv_syscall_count = _recv_syscall_count.load(std::memory_order_relaxed);
+			snapshot.received_datagram_count = _received_datagram_count.load(std::memory_order_relaxed);
+			snapshot.received_bytes = _received_bytes.load(std::memory_order_relaxed);
+			snapshot.recv_buffer_alloc_count = _recv_buffer_alloc_count.load(std::memory_order_relaxed);
+
+			return snapshot;
+		}
+
+	protected:
+		std::atomic<uint64_t> _send_syscall_count{0};
+		std::atomic<uint64_t> _sent_datagram_count{0};
+		std::atomic<uint64_t> _sent_bytes{0};
+		std::atomic<uint64_t> _gso_datagram_count{0};
+		std::atomic<uint64_t> _dropped_datagram_count{0};
+
+		std::atomic<uint64_t> _recv_syscall_count{0};
+		std::atomic<uint64_t> _received_datagram_count{0};
+		std::atomic<uint64_t> _received_bytes{0};
+		std::atomic<uint64_t> _recv_buffer_alloc_count{0};
+	};
+}  // namespace ov
@@ -8,6 +8,9 @@
 //==============================================================================
 #include "socket_pool_worker.h"
 
+#include <sys/eventfd.h>
+#include <time.h>
+
 #include "../socket_private.h"
 #include "socket_pool.h"
 
@@ -61,6 +64,9 @@ namespace ov
 
 		::pthread_setname_np(_epoll_thread.native_handle(), name.CStr());
 
+		// Resolved here, so GetStatsSnapshot() does not need the std::thread
+		_has_epoll_thread_clock_id = (::pthread_getcpuclockid(_epoll_thread.native_handle(), &_epoll_thread_clock_id) == 0);
+
 		return true;
 	}
 
@@ -76,6 +82,7 @@ namespace ov
 		_connection_callback_queue.Clear();
 
 		_stop_epoll_thread = true;
+		_has_epoll_thread_clock_id = false;
 
 		if (_epoll_thread.joinable())
 		{
@@ -106,6 +113,7 @@ namespace ov
 		_gc_candidates.clear();
 
 		OV_SAFE_FUNC(_epoll, InvalidSocket, ::close, );
+		OV_SAFE_FUNC(_wake_up_event, InvalidSocket, ::close, );
 		OV_SAFE_FUNC(_srt_epoll, InvalidSocket, ::srt_close, );
 
 		return true;
@@ -133,7 +141,7 @@ namespace ov
 			case SocketType::Tcp:
 				_epoll = ::epoll_create1(0);
 
-				if (_epoll != InvalidSocket)
+				if ((_epoll != InvalidSocket) && PrepareWakeUpEvent())
 				{
 					_epoll_events.resize(EpollMaxEvents);
 				}
@@ -180,6 +188,52 @@ namespace ov
 		return (error == nullptr);
 	}
 
+	bool SocketPoolWorker::PrepareWakeUpEvent()
+	{
+		_wake_up_event = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+		if (_wake_up_event == InvalidSocket)
+		{
+			return false;
+		}
+
+		epoll_event event{};
+		event.events = EPOLLIN;
+		// Sockets use the pointer of ov::Socket, so the pointer of the worker can be used to distinguish the wake up event
+		event.data.ptr = this;
+
+		if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, _wake_up_event, &event) == -1)
+		{
+			OV_SAFE_FUNC(_wake_up_event, InvalidSocket, ::close, );
+			return false;
+		}
+
+		return true;
+	}
+
+	void SocketPoolWorker::WakeUp()
+	{
+		if (_wake_up_event == InvalidSocket)
+		{
+			return;
+		}
+
+		// Avoid calling write() if the worker has already been requested to wake up
+		if (_wake_up_requested.exchange(true) == false)
+		{
+			const uint64_t value = 1;
+			[[maybe_unused]] auto result = ::write(_wake_up_event, &value, sizeof(value));
+		}
+	}
+
+	void SocketPoolWorker::ResetWakeUpEvent()
+	{
+		_wake_up_requested = false;
+
+		uint64_t value;
+		[[maybe_unused]] auto result = ::read(_wake_up_event, &value, sizeof(value));
+	}
+
 	bool SocketPoolWorker::PrepareSocket(std::shared_ptr<Socket> socket, const SocketFamily family)
 	{
 		return socket->Create(GetType(), family);
@@ -289,6 +343,13 @@ namespace ov
 				{
 					auto &event = _epoll_events[index];
 
+					if (event.data.ptr == this)
+					{
+						// Woken up by WakeUp() - sockets to dispatch will be processed in DispatchSocketEventsIfNeeded()
+						ResetWakeUpEvent();
+						continue;
+					}
+
 					auto socket_data = reinterpret_cast<Socket *>(event.data.ptr);
 
 					if (socket_data == nullptr)
@@ -722,6 +783,12 @@ namespace ov
 		_sockets_to_dispatch[socket] = socket;
 	}
 
+	void SocketPoolWorker::EnqueueToDispatchSoon(const std::shared_ptr<Socket> &socket)
+	{
+		EnqueueToDispatchLater(socket);
+		WakeUp();
+	}
+
 	void SocketPoolWorker::EnqueueToCloseCallbackLater(const std::shared_ptr<Socket> &socket, std::shared_ptr<SocketAsyncInterface> callback)
 	{
 		OV_ASSERT2(socket != nullptr);
@@ -898,6 +965,23 @@ namespace ov
 		return socket->Close();
 	}
 
+	SocketPoolStats::Snapshot SocketPoolWorker::GetStatsSnapshot() const
+	{
+		auto snapshot = _stats.GetSnapshot();
+
+		if (_has_epoll_thread_clock_id)
+		{
+			timespec cpu_time{};
+
+			if (::clock_gettime(_epoll_thread_clock_id, &cpu_time) == 0)
+			{
+				snapshot.worker_cpu_time_us = (static_cast<int64_t>(cpu_time.tv_sec) * 1000000) + (cpu_time.tv_nsec / 1000);
+			}
+		}
+
+		return snapshot;
+	}
+
 	String SocketPoolWorker::ToString() const
 	{
 		String description;
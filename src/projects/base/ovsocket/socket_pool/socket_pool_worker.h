@@ -10,6 +10,7 @@
 
 #include "../socket.h"
 #include "../socket_datastructure.h"
+#include "socket_pool_stats.h"
 
 namespace ov
 {
@@ -48,6 +49,14 @@ namespace ov
 
 		bool ReleaseSocket(const std::shared_ptr<Socket> &socket);
 
+		SocketPoolStats &GetStats()
+		{
+			return _stats;
+		}
+
+		// Includes the CPU time consumed by the worker thread
+		SocketPoolStats::Snapshot GetStatsSnapshot() const;
+
 		String ToString() const;
 
 	protected:
@@ -89,12 +98,19 @@ namespace ov
 		void ConvertSrtEventToEpollEvent(const SRT_EPOLL_EVENT &srt_event, epoll_event *event);
 
 		void EnqueueToDispatchLater(const std::shared_ptr<Socket> &socket);
+		// Enqueues the socket to dispatch, and wakes up the worker thread to dispatch it as soon as possible
+		// (Used by batched send mode)
+		void EnqueueToDispatchSoon(const std::shared_ptr<Socket> &socket);
 		void EnqueueToCloseCallbackLater(const std::shared_ptr<Socket> &socket, std::shared_ptr<SocketAsyncInterface> callback);
 		void EnqueueToCheckConnectionTimeOut(const std::shared_ptr<Socket> &socket, int timeout_msec);
 
 		void DispatchSocketEventsIfNeeded();
 		void CallCloseCallbackIfNeeded();
 
+		bool PrepareWakeUpEvent();
+		void WakeUp();
+		void ResetWakeUpEvent();
+
 	protected:
 		std::shared_ptr<SocketPool> _pool;
 
@@ -127,6 +143,9 @@ namespace ov
 		// Common variables
 		std::thread _epoll_thread;
 		bool _stop_epoll_thread = true;
+		// CPU-time clock of _epoll_thread, for the stats
+		clockid_t _epoll_thread_clock_id{};
+		bool _has_epoll_thread_clock_id = false;
 		std::vector<epoll_event> _epoll_events;
 		int _last_epoll_event_count = 0;
 
@@ -141,6 +160,12 @@ namespace ov
 		// Related to epoll
 		socket_t _epoll = InvalidSocket;
 
+		// An eventfd to wake up the worker thread blocked in EpollWait()
+		socket_t _wake_up_event = InvalidSocket;
+		std::atomic<bool> _wake_up_requested{false};
+
+		SocketPoolStats _stats;
+
 		// Related to SRT
 		SRTSOCKET _srt_epoll = InvalidSocket;
 		std::vector<SRT_EPOLL_EVENT> _srt_epoll_events;
@@ -12,6 +12,9 @@
 
 #define MAX_BUFFER_SIZE 4096
 
+// The maximum number of buffers sent with one sendmsg() call (TCP)
+#define MAX_STREAM_IOV_COUNT 64
+
 // If state is not <condition>, returns <return_value>
 #define CHECK_STATE(condition, return_value)                                 \
 	do                                                                       \
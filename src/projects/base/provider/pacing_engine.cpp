@@ -0,0 +1,268 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "pacing_engine.h"
+
+#include "provider_private.h"
+
+// Resolution of the send time
+#define PACING_ENGINE_TICK_US 1000
+
+namespace pvd
+{
+	PacingEngine::Pacer::~Pacer()
+	{
+		if (_is_closed == false)
+		{
+			Close();
+		}
+	}
+
+	void PacingEngine::Pacer::Push(const std::shared_ptr<MediaPacket> &packet, std::chrono::steady_clock::time_point send_time)
+	{
+		auto engine = PacingEngine::GetInstance();
+		auto tick = engine->GetTick(send_time, true);
+		bool need_to_arm = false;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			if (_is_closed)
+			{
+				return;
+			}
+
+			_items.push_back({packet, send_time});
+
+			if (tick < _armed_tick)
+			{
+				_armed_tick = tick;
+				need_to_arm = true;
+			}
+		}
+
+		if (need_to_arm)
+		{
+			engine->Arm(_id, tick);
+		}
+	}
+
+	std::chrono::microseconds PacingEngine::Pacer::GetLead() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_items.empty())
+		{
+			return std::chrono::microseconds(0);
+		}
+
+		return std::max(std::chrono::duration_cast<std::chrono::microseconds>(_items.back().send_time - std::chrono::steady_clock::now()),
+						std::chrono::microseconds(0));
+	}
+
+	void PacingEngine::Pacer::Close()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			_is_closed = true;
+			_items.clear();
+			_armed_tick = NotArmed;
+		}
+
+		PacingEngine::GetInstance()->Unregister(_id);
+	}
+
+	int64_t PacingEngine::Pacer::Release(int64_t tick)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		// The pacer is closed or rearmed to an earlier tick
+		if (_is_closed || (tick != _armed_tick))
+		{
+			return NotArmed;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+
+		while ((_items.empty() == false) && (_items.front().send_time <= now))
+		{
+			auto &item = _items.front();
+
+			if (_pacing_errors != nullptr)
+			{
+				_pacing_errors->Record(std::chrono::duration_cast<std::chrono::microseconds>(now - item.send_time).count());
+			}
+
+			_send_function(item.packet);
+			_items.pop_front();
+		}
+
+		_armed_tick = _items.empty() ? NotArmed : PacingEngine::GetInstance()->GetTick(_items.front().send_time, true);
+
+		return _armed_tick;
+	}
+
+	PacingEngine::~PacingEngine()
+	{
+		Stop();
+	}
+
+	std::shared_ptr<PacingEngine::Pacer> PacingEngine::CreatePacer(const std::shared_ptr<mon::LatencyHistogram> &pacing_errors, SendFunction send_function)
+	{
+		auto pacer = std::make_shared<Pacer>();
+
+		pacer->_pacing_errors = pacing_errors;
+		pacer->_send_function = std::move(send_function);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if ((_is_running == false) && (Start() == false))
+		{
+			return nullptr;
+		}
+
+		pacer->_id = ++_last_pacer_id;
+		_pacers[pacer->_id] = pacer;
+
+		return pacer;
+	}
+
+	// Must be called with _mutex locked
+	bool PacingEngine::Start()
+	{
+		_timer_wheel = ov::TimerWheel(GetTick(std::chrono::steady_clock::now(), false));
+		_is_running = true;
+
+		_thread = std::thread(&PacingEngine::DispatchThread, this);
+		pthread_setname_np(_thread.native_handle(), "PacingEngine");
+
+		logti("PacingEngine has been started");
+
+		return true;
+	}
+
+	void PacingEngine::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			if (_is_running == false)
+			{
+				return;
+			}
+
+			_is_running = false;
+			_condition.notify_all();
+		}
+
+		if (_thread.joinable())
+		{
+			_thread.join();
+		}
+	}
+
+	int64_t PacingEngine::GetTick(std::chrono::steady_clock::time_point time_point, bool round_up) const
+	{
+		auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(time_point - _start_time).count();
+
+		// Rounding up the send time, so a packet is never sent earlier than its send time
+		return (elapsed_us + (round_up ? (PACING_ENGINE_TICK_US - 1) : 0)) / PACING_ENGINE_TICK_US;
+	}
+
+	void PacingEngine::Arm(uint64_t pacer_id, int64_t tick)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_timer_wheel.Add(pacer_id, tick);
+
+		if (_timer_wheel.GetCount() == 1)
+		{
+			_condition.notify_all();
+		}
+	}
+
+	void PacingEngine::Unregister(uint64_t pacer_id)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		// The timers of the pacer are ignored when they expire
+		_pacers.erase(pacer_id);
+	}
+
+	void PacingEngine::DispatchThread()
+	{
+		std::vector<ov::TimerWheel::Timer> expired_timers;
+		std::vector<std::pair<std::shared_ptr<Pacer>, int64_t>> due_pacers;
+
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		while (_is_running)
+		{
+			if (_timer_wheel.GetCount() == 0)
+			{
+				_condition.wait(lock, [this]() -> bool {
+					return (_timer_wheel.GetCount() > 0) || (_is_running == false);
+				});
+
+				continue;
+			}
+
+			// Wait for the next tick
+			auto next_tick_time = _start_time + std::chrono::microseconds((_timer_wheel.GetCurrentTick() + 1) * PACING_ENGINE_TICK_US);
+			_condition.wait_until(lock, next_tick_time, [this]() -> bool {
+				return (_is_running == false);
+			});
+
+			// If this thread was delayed, the timers of all the passed ticks expire at once
+			_timer_wheel.Advance(GetTick(std::chrono::steady_clock::now(), false), expired_timers);
+
+			for (auto &timer : expired_timers)
+			{
+				auto pacer = _pacers.find(timer.key);
+
+				if (pacer != _pacers.end())
+				{
+					due_pacers.emplace_back(pacer->second.lock(), timer.tick);
+				}
+			}
+
+			expired_timers.clear();
+
+			if (due_pacers.empty())
+			{
+				continue;
+			}
+
+			lock.unlock();
+
+			for (auto &[pacer, tick] : due_pacers)
+			{
+				if (pacer == nullptr)
+				{
+					continue;
+				}
+
+				auto next_tick = pacer->Release(tick);
+
+				if (next_tick != Pacer::NotArmed)
+				{
+					std::lock_guard<std::mutex> timer_lock(_mutex);
+					_timer_wheel.Add(pacer->_id, next_tick);
+				}
+			}
+
+			// Release the references outside of the lock, the pacers may be destroyed here
+			due_pacers.clear();
+
+			lock.lock();
+		}
+
+		logti("PacingEngine has been stopped");
+	}
+}  // namespace pvd
@@ -0,0 +1,106 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/mediarouter/media_buffer.h>
+#include <base/ovlibrary/ovlibrary.h>
+#include <base/ovlibrary/timer_wheel.h>
+#include <monitoring/latency_metrics.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+
+namespace pvd
+{
+	// Sends the packets of the streams played out in real time (Scheduled, File) at their send time.
+	//
+	// Instead of each stream sleeping until the DTS of every packet, a stream reads ahead and queues the packets
+	// to its Pacer. A single thread keeps the next send time of each Pacer in a timer wheel
+	// and sends all the due packets of a Pacer at once when its deadline is reached.
+	// The difference between the actual and the target send time is recorded as the pacing error.
+	//
+	// Streams do not block on the pacer either: they read until Pacer::GetLead() reaches their lead and then yield
+	// the thread (Scheduled: ScheduledWorkerPool, File: the PullStream motor) until half of it is sent.
+	class PacingEngine : public ov::Singleton<PacingEngine>
+	{
+	public:
+		using SendFunction = std::function<void(const std::shared_ptr<MediaPacket> &packet)>;
+
+		class Pacer
+		{
+		public:
+			~Pacer();
+
+			// Packets must be queued in the order to be sent
+			void Push(const std::shared_ptr<MediaPacket> &packet, std::chrono::steady_clock::time_point send_time);
+
+			// How far ahead of now the last queued packet is
+			std::chrono::microseconds GetLead() const;
+
+			// Drops the queued packets, no packet is sent after this returns
+			void Close();
+
+		private:
+			friend class PacingEngine;
+
+			struct Item
+			{
+				std::shared_ptr<MediaPacket> packet;
+				std::chrono::steady_clock::time_point send_time;
+			};
+
+			static constexpr int64_t NotArmed = INT64_MAX;
+
+			// Sends the due packets if the timer is not stale, returns the tick of the next send time (or NotArmed)
+			int64_t Release(int64_t tick);
+
+			uint64_t _id = 0;
+			std::shared_ptr<mon::LatencyHistogram> _pacing_errors;
+			SendFunction _send_function;
+
+			mutable std::mutex _mutex;
+			std::deque<Item> _items;
+			int64_t _armed_tick = NotArmed;
+			bool _is_closed = false;
+		};
+
+		// pacing_errors can be nullptr
+		std::shared_ptr<Pacer> CreatePacer(const std::shared_ptr<mon::LatencyHistogram> &pacing_errors, SendFunction send_function);
+
+	private:
+		friend class ov::Singleton<PacingEngine>;
+
+		PacingEngine() = default;
+		~PacingEngine() override;
+
+		bool Start();
+		void Stop();
+
+		int64_t GetTick(std::chrono::steady_clock::time_point time_point, bool round_up) const;
+
+		// Sets the timer of the pacer
+		void Arm(uint64_t pacer_id, int64_t tick);
+		void Unregister(uint64_t pacer_id);
+
+		void DispatchThread();
+
+		const std::chrono::steady_clock::time_point _start_time = std::chrono::steady_clock::now();
+
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		ov::TimerWheel _timer_wheel;
+		// Pacer ID => Pacer
+		std::map<uint64_t, std::weak_ptr<Pacer>> _pacers;
+		uint64_t _last_pacer_id = 0;
+
+		std::thread _thread;
+		bool _is_running = false;
+	};
+}  // namespace pvd
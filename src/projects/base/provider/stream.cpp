@@ -241,6 +241,11 @@ namespace pvd
 		_last_media_timestamp_ms = packet->GetPts() / GetTrack(packet->GetTrackId())->GetTimeBase().GetTimescale() * 1000.0;
 		_elapsed_from_last_media_timestamp.Restart();
 
+		if (MediaTrace::IsEnabled() && packet->GetTrace() == nullptr)
+		{
+			packet->SetTrace(MediaTrace::Sample(MediaTrace::Hop::Provider));
+		}
+
 		return _application->SendFrame(GetSharedPtr(), packet);
 	}
 
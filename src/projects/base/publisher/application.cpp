@@ -132,6 +132,13 @@ namespace pub
 				continue;
 			}
 
+			// The trace is shared by all publishers, so it is not stamped here
+			auto &trace = media_packet->GetTrace();
+			if (trace != nullptr)
+			{
+				stream->RecordLatency(MediaTrace::Hop::Publisher, trace->GetStamp(MediaTrace::Hop::RouterOutbound));
+			}
+
 			if (media_packet->GetMediaType() == cmn::MediaType::Video)
 			{
 				stream->SendVideoFrame(stream_data->_media_packet);
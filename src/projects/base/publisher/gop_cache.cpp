@@ -0,0 +1,101 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "gop_cache.h"
+
+#include "publisher_private.h"
+
+namespace pub
+{
+	GopCache::GopCache(int64_t max_duration_ms, size_t max_size)
+		: _max_duration_ms(max_duration_ms),
+		  _max_size(max_size)
+	{
+	}
+
+	void GopCache::Push(const std::any &packet, uint64_t key, PacketType type, size_t size)
+	{
+		if (type == PacketType::KeyFrame)
+		{
+			_key_frame_indices[key] = _front_index + _items.size();
+		}
+		else if (_key_frame_indices.empty() ||
+				 ((type == PacketType::Dependent) && (_key_frame_indices.find(key) == _key_frame_indices.end())))
+		{
+			// Not decodable until the next keyframe
+			return;
+		}
+
+		auto now_ms = static_cast<int64_t>(ov::Clock::NowMSec());
+
+		_items.push_back({packet, key, type, size, now_ms});
+		_size += size;
+
+		// The packets before the oldest of the last keyframes are not needed anymore
+		uint64_t start_index = _front_index + _items.size();
+		for (const auto &[key_frame_key, key_frame_index] : _key_frame_indices)
+		{
+			start_index = std::min(start_index, key_frame_index);
+		}
+
+		while (_front_index < start_index)
+		{
+			_size -= _items.front().size;
+			_items.pop_front();
+			_front_index++;
+		}
+
+		// A long GOP is not kept growing, the cache starts again from the next keyframe
+		if ((_size > _max_size) || ((now_ms - _items.front().pushed_time_ms) > _max_duration_ms))
+		{
+			logtd("GOP cache is cleared (%zu packets, %zu bytes, %" PRId64 " ms)", _items.size(), _size, now_ms - _items.front().pushed_time_ms);
+			Clear();
+		}
+	}
+
+	std::vector<std::any> GopCache::GetPackets() const
+	{
+		std::vector<std::any> packets;
+		packets.reserve(_items.size());
+
+		auto index = _front_index;
+
+		for (const auto &item : _items)
+		{
+			if (item.type != PacketType::Independent)
+			{
+				// The packets of a key before its last keyframe are kept only for the other keys
+				auto key_frame_index = _key_frame_indices.find(item.key);
+
+				if ((key_frame_index == _key_frame_indices.end()) || (index < key_frame_index->second))
+				{
+					index++;
+					continue;
+				}
+			}
+
+			packets.push_back(item.packet);
+			index++;
+		}
+
+		return packets;
+	}
+
+	size_t GopCache::GetSize() const
+	{
+		return _size;
+	}
+
+	void GopCache::Clear()
+	{
+		_front_index += _items.size();
+		_items.clear();
+		_key_frame_indices.clear();
+		_size = 0;
+	}
+}  // namespace pub
@@ -0,0 +1,73 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <any>
+#include <deque>
+#include <unordered_map>
+
+namespace pub
+{
+	// Keeps the packets broadcast since the last keyframe, so a new session can start from a decodable frame
+	// instead of waiting for the next keyframe of the encoder.
+	//
+	// The packets are the ones of Stream::BroadcastPacket() (RTP, MPEG-TS, OVT, ...), so each publisher tells
+	// which packets start a keyframe. If the GOP exceeds the limits, nothing is cached until the next keyframe.
+	//
+	// GopCache IS NOT thread safe
+	class GopCache
+	{
+	public:
+		enum class PacketType : uint8_t
+		{
+			// Decodable without the others (e.g. audio)
+			Independent,
+			// The first packet of a keyframe
+			KeyFrame,
+			// Needs the last keyframe of the same key
+			Dependent,
+		};
+
+		GopCache(int64_t max_duration_ms, size_t max_size);
+
+		// key: the packets that are decoded together (e.g. a video track, or a MPEG-TS stream)
+		void Push(const std::any &packet, uint64_t key, PacketType type, size_t size);
+
+		// The packets to send to a new session, starting from the keyframes
+		std::vector<std::any> GetPackets() const;
+
+		size_t GetSize() const;
+
+	private:
+		struct Item
+		{
+			std::any packet;
+			uint64_t key;
+			PacketType type;
+			size_t size;
+			int64_t pushed_time_ms;
+		};
+
+		void Clear();
+
+		int64_t _max_duration_ms;
+		size_t _max_size;
+
+		std::deque<Item> _items;
+		// Index of _items.front(), it keeps increasing so the indices of the keyframes are not changed by popping
+		uint64_t _front_index = 0;
+		// key: index of the last keyframe
+		std::unordered_map<uint64_t, uint64_t> _key_frame_indices;
+
+		// Bytes of the cached packets
+		size_t _size = 0;
+	};
+}  // namespace pub
@@ -37,6 +37,10 @@ namespace pub
 
 		virtual void SendOutgoingData(const std::any &packet) {};
 		virtual void OnMessageReceived(const std::any &message) {};
+		// Called before the packets of the GOP cache are sent, they start from a keyframe (see Stream::SendGopCache())
+		virtual void OnGopCacheSending(const std::vector<std::any> &packets) {};
+		// Called after the packets of the GOP cache are sent, the live packets follow
+		virtual void OnGopCacheSent() {};
 
 		enum class SessionState : int8_t
 		{
@@ -1,14 +1,24 @@
 #include "stream.h"
+
+#include <base/ovlibrary/task_executor.h>
+
 #include "application.h"
+#include "monitoring/monitoring.h"
 #include "publisher_private.h"
 
+// The number of dispatches per drain task when running on ov::TaskExecutor
+#define STREAM_WORKER_MAX_DRAIN_COUNT 64
+
 namespace pub
 {
-	StreamWorker::StreamWorker(const std::shared_ptr<Stream> &parent_stream)
+	StreamWorker::StreamWorker(const std::shared_ptr<Stream> &parent_stream, uint32_t worker_index)
 		: _packet_queue(nullptr, 500)
 	{
 		_stop_thread_flag = true;
 		_parent = parent_stream;
+
+		// Spreads the workers of a stream over the executor
+		_affinity_hint = (static_cast<uint64_t>(parent_stream->GetId()) * MAX_STREAM_WORKER_THREAD_COUNT) + worker_index;
 	}
 
 	StreamWorker::~StreamWorker()
@@ -30,6 +40,13 @@ namespace pub
 		_packet_queue.SetUrn(urn);
 		
 		_stop_thread_flag = false;
+
+		if (ov::TaskExecutor::GetInstance()->IsRunning())
+		{
+			_use_task_executor = true;
+			return true;
+		}
+
 		_worker_thread = std::thread(&StreamWorker::WorkerThread, this);
 
 		ov::String thread_name = ov::String::FormatString("SW-%s", _parent->GetApplication()->GetPublisherTypeName());
@@ -59,6 +76,12 @@ namespace pub
 			_worker_thread.join();
 		}
 
+		if (_use_task_executor)
+		{
+			// Wait for the drain task if it is running
+			std::lock_guard<std::mutex> drain_lock(_drain_mutex);
+		}
+
 		logtd("StreamWorker thread of %s has been stopped successfully", worker_name.CStr());
 
 		std::lock_guard<std::shared_mutex> lock(_session_map_mutex);
@@ -70,12 +93,18 @@ namespace pub
 			session->Stop();
 		}
 		_sessions.clear();
+
+		for (auto const &x : _waiting_sessions)
+		{
+			x.second->Stop();
+		}
+		_waiting_sessions.clear();
 		logtd("All sessions(%d) of %s has been stopped successfully", _sessions.size(), worker_name.CStr());
 
 		return true;
 	}
 
-	bool StreamWorker::AddSession(const std::shared_ptr<Session> &session)
+	bool StreamWorker::AddSession(const std::shared_ptr<Session> &session, bool wait_for_gop_cache)
 	{
 		// Cannot add session after StreamWorker is stopped
 		if (_stop_thread_flag)
@@ -84,7 +113,15 @@ namespace pub
 		}
 
 		std::lock_guard<std::shared_mutex> lock(_session_map_mutex);
-		_sessions[session->GetId()] = session;
+
+		if (wait_for_gop_cache)
+		{
+			_waiting_sessions[session->GetId()] = session;
+		}
+		else
+		{
+			_sessions[session->GetId()] = session;
+		}
 
 		return true;
 	}
@@ -98,14 +135,15 @@ namespace pub
 		}
 
 		std::unique_lock<std::shared_mutex> lock(_session_map_mutex);
-		if (_sessions.count(id) <= 0)
+		auto &session_map = (_sessions.count(id) > 0) ? _sessions : _waiting_sessions;
+		if (session_map.count(id) <= 0)
 		{
 			logte("Cannot find session : %u", id);
 			return false;
 		}
 
-		auto session = _sessions[id];
-		_sessions.erase(id);
+		auto session = session_map[id];
+		session_map.erase(id);
 		lock.unlock();
 
 		session->Stop();
@@ -116,29 +154,105 @@ namespace pub
 	std::shared_ptr<Session> StreamWorker::GetSession(session_id_t id)
 	{
 		std::shared_lock<std::shared_mutex> lock(_session_map_mutex);
-		if (_sessions.count(id) <= 0)
+		auto item = _sessions.find(id);
+		if (item == _sessions.end())
 		{
-			// logte("Cannot find session : %u", id);
-			return nullptr;
+			item = _waiting_sessions.find(id);
+			if (item == _waiting_sessions.end())
+			{
+				// logte("Cannot find session : %u", id);
+				return nullptr;
+			}
 		}
 
-		return _sessions[id];
+		return item->second;
 	}
 
 	void StreamWorker::SendPacket(const std::any &packet)
 	{
-		_packet_queue.Enqueue(packet);
-		_queue_event.Notify();
+		_packet_queue.Enqueue(StreamPacket{packet, MediaTrace::IsEnabled() ? MediaTrace::Now() : 0});
+
+		if (_use_task_executor)
+		{
+			ScheduleDrain();
+		}
+		else
+		{
+			_queue_event.Notify();
+		}
+	}
+
+	void StreamWorker::JoinSession(const std::shared_ptr<Session> &session, std::vector<std::any> gop_packets)
+	{
+		StreamPacket stream_packet;
+		stream_packet.join = std::make_shared<SessionJoin>(SessionJoin{session, std::move(gop_packets)});
+
+		_packet_queue.Enqueue(std::move(stream_packet));
+
+		if (_use_task_executor)
+		{
+			ScheduleDrain();
+		}
+		else
+		{
+			_queue_event.Notify();
+		}
 	}
 
 	// Send to a specific session
 	void StreamWorker::SendMessage(const std::shared_ptr<Session> &session, const std::any &message)
 	{
 		_session_message_queue.Enqueue(std::make_shared<SessionMessage>(session, message));
-		_queue_event.Notify();
+
+		if (_use_task_executor)
+		{
+			ScheduleDrain();
+		}
+		else
+		{
+			_queue_event.Notify();
+		}
+	}
+
+	void StreamWorker::ScheduleDrain()
+	{
+		if (_stop_thread_flag || (_drain_scheduled.exchange(true) == true))
+		{
+			return;
+		}
+
+		auto self = GetSharedPtr();
+		if (ov::TaskExecutor::GetInstance()->Post(_affinity_hint, [self]() { self->Drain(); }) == false)
+		{
+			_drain_scheduled = false;
+		}
 	}
 
-	std::optional<std::any> StreamWorker::PopStreamPacket()
+	void StreamWorker::Drain()
+	{
+		{
+			std::lock_guard<std::mutex> drain_lock(_drain_mutex);
+
+			// Bounded, so a busy stream does not hold the executor worker
+			for (int count = 0; (count < STREAM_WORKER_MAX_DRAIN_COUNT) && (_stop_thread_flag == false); count++)
+			{
+				if (DispatchQueuedData() == false)
+				{
+					break;
+				}
+			}
+
+			_drain_scheduled = false;
+		}
+
+		// Remaining data, or data queued after the last dispatch
+		if ((_packet_queue.IsEmpty() == false) || (_session_message_queue.IsEmpty() == false))
+		{
+			ScheduleDrain();
+		}
+	}
+
+	std::optional<StreamWorker::StreamPacket> StreamWorker::PopStreamPacket()
 	{
 		if (_packet_queue.IsEmpty())
 		{
@@ -166,30 +280,80 @@ namespace pub
 
 	void StreamWorker::WorkerThread()
 	{
-		std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex, std::defer_lock);
-
 		while (!_stop_thread_flag)
 		{
 			_queue_event.Wait();
 
-			auto session_message = PopSessionMessage();
-			if (session_message != nullptr && session_message->_session != nullptr && session_message->_message.has_value())
+			DispatchQueuedData();
+		}
+	}
+
+	bool StreamWorker::DispatchQueuedData()
+	{
+		bool dispatched = false;
+
+		auto session_message = PopSessionMessage();
+		if (session_message != nullptr && session_message->_session != nullptr && session_message->_message.has_value())
+		{
+			session_message->_session->OnMessageReceived(session_message->_message);
+			dispatched = true;
+		}
+
+		auto packet = PopStreamPacket();
+		if (packet.has_value() && (packet->join != nullptr))
+		{
+			DispatchSessionJoin(*(packet->join));
+			dispatched = true;
+		}
+		else if (packet.has_value())
+		{
+			if (packet->enqueued_time != 0)
 			{
-				session_message->_session->OnMessageReceived(session_message->_message);
+				_parent->RecordLatency(MediaTrace::Hop::StreamWorker, packet->enqueued_time);
 			}
 
-			auto packet = PopStreamPacket();
-			if (packet.has_value())
-			{		
-				session_lock.lock();
-				for (auto const &x : _sessions)
-				{
-					auto session = x.second;
-					session->SendOutgoingData(packet.value());
-				}
-				session_lock.unlock();
+			std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex);
+			for (auto const &x : _sessions)
+			{
+				auto session = x.second;
+				session->SendOutgoingData(packet->packet);
 			}
+
+			dispatched = true;
 		}
+
+		return dispatched;
+	}
+
+	void StreamWorker::DispatchSessionJoin(const SessionJoin &join)
+	{
+		std::lock_guard<std::shared_mutex> session_lock(_session_map_mutex);
+
+		auto item = _waiting_sessions.find(join.session->GetId());
+		if (item == _waiting_sessions.end())
+		{
+			// Removed while waiting
+			return;
+		}
+
+		auto session = item->second;
+		_waiting_sessions.erase(item);
+		_sessions[session->GetId()] = session;
+
+		if (join.gop_packets.empty())
+		{
+			return;
+		}
+
+		// Sent at once, the pacing of the session (if any) spreads them
+		session->OnGopCacheSending(join.gop_packets);
+
+		for (const auto &gop_packet : join.gop_packets)
+		{
+			session->SendOutgoingData(gop_packet);
+		}
+
+		session->OnGopCacheSent();
 	}
 
 	Stream::Stream(const std::shared_ptr<Application> application, const info::Stream &info)
@@ -198,6 +362,15 @@ namespace pub
 		_application = application;
 		_last_issued_session_id = 100;
 		_state = State::CREATED;
+
+		if (MediaTrace::IsEnabled())
+		{
+			auto stream_metrics = MonitorInstance->GetStreamMetrics(info);
+			if (stream_metrics != nullptr)
+			{
+				_latency_metrics = stream_metrics->GetLatencyMetrics();
+			}
+		}
 	}
 
 	Stream::~Stream()
@@ -257,7 +430,7 @@ namespace pub
 		// Create WorkerThread
 		for (uint32_t i = 0; i < _worker_count; i++)
 		{
-			auto stream_worker = std::make_shared<StreamWorker>(GetSharedPtr());
+			auto stream_worker = std::make_shared<StreamWorker>(GetSharedPtr(), i);
 						
 			if (stream_worker->Start() == false)
 			{
@@ -334,6 +507,16 @@ namespace pub
 		return _started_time;
 	}
 
+	void Stream::RecordLatency(MediaTrace::Hop hop, int64_t since_time)
+	{
+		if ((_latency_metrics == nullptr) || (since_time == 0))
+		{
+			return;
+		}
+
+		_latency_metrics->Record(hop, MediaTrace::Now() - since_time);
+	}
+
 	std::shared_ptr<Application> Stream::GetApplication() const
 	{
 		return _application;
@@ -382,7 +565,8 @@ namespace pub
 				return false;
 			}
 
-			return worker->AddSession(session);
+			// The session receives the packets from SendGopCache()
+			return worker->AddSession(session, (_gop_cache != nullptr));
 		}
 
 		return true;
@@ -461,6 +645,70 @@ namespace pub
 		return true;
 	}
 
+	bool Stream::BroadcastPacket(const std::any &packet, uint64_t gop_key, GopCache::PacketType packet_type, size_t packet_size)
+	{
+		if (_gop_cache == nullptr)
+		{
+			return BroadcastPacket(packet);
+		}
+
+		std::lock_guard<std::mutex> gop_cache_lock(_gop_cache_mutex);
+
+		_gop_cache->Push(packet, gop_key, packet_type, packet_size);
+
+		return BroadcastPacket(packet);
+	}
+
+	void Stream::EnableGopCache()
+	{
+		auto &gop_cache_config = GetApplicationInfo().GetConfig().GetPublishers().GetGopCache();
+
+		if (gop_cache_config.IsEnabled() == false)
+		{
+			return;
+		}
+
+		if (_worker_count == 0)
+		{
+			// The sessions join in the order of the packet queue of the stream worker
+			logtw("[%s(%u)] %s - GOP cache is not available without StreamWorkerCount", GetName().CStr(), GetId(), GetApplicationTypeName());
+			return;
+		}
+
+		_gop_cache = std::make_shared<GopCache>(std::max(gop_cache_config.GetMaxDurationMs(), 0),
+												static_cast<size_t>(std::max(gop_cache_config.GetMaxSizeKB(), 0)) * 1024);
+
+		logti("[%s(%u)] %s - GOP cache is enabled (max %d ms, %d KB)", GetName().CStr(), GetId(), GetApplicationTypeName(),
+			  gop_cache_config.GetMaxDurationMs(), gop_cache_config.GetMaxSizeKB());
+	}
+
+	bool Stream::IsGopCacheEnabled() const
+	{
+		return (_gop_cache != nullptr);
+	}
+
+	bool Stream::SendGopCache(const std::shared_ptr<Session> &session)
+	{
+		if (_gop_cache == nullptr)
+		{
+			return true;
+		}
+
+		auto worker = GetWorkerBySessionID(session->GetId());
+		if (worker == nullptr)
+		{
+			logtw("Cannot find worker for session : %u", session->GetId());
+			return false;
+		}
+
+		std::lock_guard<std::mutex> gop_cache_lock(_gop_cache_mutex);
+
+		// The packets broadcast after this are queued after the GOP cache
+		worker->JoinSession(session, _gop_cache->GetPackets());
+
+		return true;
+	}
+
 	bool Stream::SendMessage(const std::shared_ptr<Session> &session, const std::any &message)
 	{
 		if(_worker_count > 0)
@@ -7,25 +7,36 @@
 #include "base/mediarouter/media_buffer.h"
 #include "base/mediarouter/media_event.h"
 #include "modules/managed_queue/managed_queue.h"
+#include "monitoring/latency_metrics.h"
+#include "gop_cache.h"
 #include "session.h"
 
 #define MAX_STREAM_WORKER_THREAD_COUNT 72
 
 namespace pub
 {
-	class StreamWorker
+	// Delivers the packets of a stream to its sessions.
+	//
+	// It has its own thread, or runs as a task of ov::TaskExecutor when Modules.TaskExecutor is enabled.
+	// In that case, at most one drain task of a worker is queued at a time, so the packets are still sent in order.
+	class StreamWorker : public ov::EnableSharedFromThis<StreamWorker>
 	{
 	public:
-		StreamWorker(const std::shared_ptr<Stream> &parent_stream);
+		StreamWorker(const std::shared_ptr<Stream> &parent_stream, uint32_t worker_index);
 		~StreamWorker();
 
 		bool Start();
 		bool Stop();
 
-		bool AddSession(const std::shared_ptr<Session> &session);
+		// If wait_for_gop_cache is true, the session does not receive the packets until JoinSession()
+		bool AddSession(const std::shared_ptr<Session> &session, bool wait_for_gop_cache = false);
 		bool RemoveSession(session_id_t id);
 		std::shared_ptr<Session> GetSession(session_id_t id);
 
+		// The packets of the GOP cache are sent to the waiting session in the order of the packet queue,
+		// so the session receives the live packets after them without a gap
+		void JoinSession(const std::shared_ptr<Session> &session, std::vector<std::any> gop_packets);
+
 		// Send to a specific session
 		void SendMessage(const std::shared_ptr<Session> &session, const std::any &message);
 
@@ -35,13 +46,38 @@ namespace pub
 	private:
 		void WorkerThread();
 
+		// Sends a queued message and a queued packet, returns false if nothing is queued
+		bool DispatchQueuedData();
+
+		void ScheduleDrain();
+		void Drain();
+
+		struct SessionJoin
+		{
+			std::shared_ptr<Session> session;
+			std::vector<std::any> gop_packets;
+		};
+
+		void DispatchSessionJoin(const SessionJoin &join);
+
 		std::map<session_id_t, std::shared_ptr<Session>> _sessions;
+		// The sessions waiting for JoinSession()
+		std::map<session_id_t, std::shared_ptr<Session>> _waiting_sessions;
 		std::shared_mutex _session_map_mutex;
 		
 		ov::Semaphore _queue_event;
 
-		std::optional<std::any> PopStreamPacket();
-		ov::ManagedQueue<std::any> _packet_queue;
+		struct StreamPacket
+		{
+			std::any packet;
+			// MediaTrace::Now() when enqueued, 0 if latency trace is disabled
+			int64_t enqueued_time = 0;
+			// Not nullptr if a session joins instead of a packet
+			std::shared_ptr<SessionJoin> join;
+		};
+
+		std::optional<StreamPacket> PopStreamPacket();
+		ov::ManagedQueue<StreamPacket> _packet_queue;
 
 		struct SessionMessage
 		{
@@ -61,6 +97,12 @@ namespace pub
 		std::atomic<bool> _stop_thread_flag;
 		std::thread _worker_thread;
 
+		bool _use_task_executor = false;
+		uint64_t _affinity_hint = 0;
+		std::atomic<bool> _drain_scheduled{false};
+		// Held while draining, so Stop() waits for the running task
+		std::mutex _drain_mutex;
+
 		std::shared_ptr<Stream> _parent;
 	};
 
@@ -126,6 +168,14 @@ namespace pub
 
 		// A child call this function to delivery packet to all sessions
 		bool BroadcastPacket(const std::any &packet);
+		// Same as above, and the packet is kept in the GOP cache if it is enabled (see GopCache::Push())
+		bool BroadcastPacket(const std::any &packet, uint64_t gop_key, GopCache::PacketType packet_type, size_t packet_size);
+
+		// If the GOP cache is enabled, a session added by AddSession() does not receive the packets until this is called.
+		// Then it receives the packets since the last keyframe at once, and the live packets after them.
+		// It should be called when the session is ready to send the packets (e.g. DTLS is connected).
+		bool SendGopCache(const std::shared_ptr<Session> &session);
+		bool IsGopCacheEnabled() const;
 
 		bool SendMessage(const std::shared_ptr<Session> &session, const std::any &message);
 
@@ -161,10 +211,16 @@ namespace pub
 
 		const std::chrono::system_clock::time_point &GetStartedTime() const;
 
+		// Records the time elapsed since since_time (MediaTrace::Now()) as the latency of the hop
+		void RecordLatency(MediaTrace::Hop hop, int64_t since_time);
+
 	protected:
 		Stream(const std::shared_ptr<Application> application, const info::Stream &info);
 		virtual ~Stream();
 
+		// Called by a child that supports the GOP cache after CreateStreamWorker() (Publishers.GopCache of the application)
+		void EnableGopCache();
+
 	private:
 		std::shared_ptr<StreamWorker> GetWorkerBySessionID(session_id_t session_id);
 		std::map<session_id_t, std::shared_ptr<Session>> _sessions;
@@ -181,5 +237,13 @@ namespace pub
 		std::chrono::system_clock::time_point _started_time;
 
 		State _state = State::CREATED;
+
+		// nullptr if latency trace is disabled
+		std::shared_ptr<mon::LatencyMetrics> _latency_metrics;
+
+		// nullptr if the GOP cache is disabled
+		std::shared_ptr<GopCache> _gop_cache;
+		// Held while broadcasting a packet, so a joining session receives the live packets right after the GOP cache
+		std::mutex _gop_cache_mutex;
 	};
 }  // namespace pub
\ No newline at end of file
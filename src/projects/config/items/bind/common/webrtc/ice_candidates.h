@@ -21,6 +21,8 @@ namespace cfg
 				std::vector<ov::String> _tcp_relay_list;
 
 				bool _enable_link_local_address = false;
+				// Send datagrams of ICE ports using sendmmsg()/UDP GSO
+				bool _enable_batched_send = false;
 
 				int _tcp_relay_worker_count{};
 				int _ice_worker_count{};
@@ -31,6 +33,7 @@ namespace cfg
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetTcpRelayList, _tcp_relay_list);
 
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetEnableLinkLocalAddress, _enable_link_local_address)
+				CFG_DECLARE_CONST_REF_GETTER_OF(GetEnableBatchedSend, _enable_batched_send)
 
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetTcpRelayWorkerCount, _tcp_relay_worker_count);
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetIceWorkerCount, _ice_worker_count);
@@ -43,6 +46,7 @@ namespace cfg
 					Register<Optional>("TcpRelay", &_tcp_relay_list);
 
 					Register<Optional>("EnableLinkLocalAddress", &_enable_link_local_address);
+					Register<Optional>("EnableBatchedSend", &_enable_batched_send);
 
 					Register<Optional>("TcpRelayWorkerCount", &_tcp_relay_worker_count);
 					Register<Optional>("IceWorkerCount", &_ice_worker_count);
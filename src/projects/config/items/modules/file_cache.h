@@ -0,0 +1,51 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "module_template.h"
+
+namespace cfg
+{
+	namespace modules
+	{
+		struct FileCache : public ModuleTemplate
+		{
+		protected:
+			int _max_size_mb = 256;
+
+		public:
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetMaxSizeMB, _max_size_mb)
+
+		protected:
+			void MakeList() override
+			{
+				// Enabled by default
+				SetEnable(true);
+
+				ModuleTemplate::MakeList();
+
+				/**
+					Hot-segment cache
+
+					The recently served files (e.g. DVR segments) are kept in memory and shared by all the sessions.
+					Responses over plain HTTP/1.1 (or kTLS) are sent using sendfile() without the cache.
+
+					server.xml:
+						<Modules>
+							<FileCache>
+								<Enable>true</Enable>
+								<MaxSizeMB>256</MaxSizeMB>
+							</FileCache>
+						</Modules>
+				*/
+				Register<Optional>("MaxSizeMB", &_max_size_mb);
+			}
+		};
+	}  // namespace modules
+}  // namespace cfg
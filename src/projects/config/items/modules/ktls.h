@@ -0,0 +1,36 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "module_template.h"
+
+namespace cfg
+{
+	namespace modules
+	{
+		// Kernel TLS offload for HTTPS ports.
+		// Requires Linux with the tls module and OpenSSL built with enable-ktls,
+		// otherwise TLS records are encrypted in userspace as before.
+		struct KTLS : public ModuleTemplate
+		{
+		protected:
+
+		public:
+
+		protected:
+			void MakeList() override
+			{
+				// Experimental feature is disabled by default
+				SetEnable(false);
+				
+				ModuleTemplate::MakeList();
+			}
+		};
+	} // namespace modules
+} // namespace cfg
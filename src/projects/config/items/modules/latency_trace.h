@@ -0,0 +1,58 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "module_template.h"
+
+namespace cfg
+{
+	namespace modules
+	{
+		struct LatencyTrace : public ModuleTemplate
+		{
+		protected:
+			int _sample_interval = 100;
+			int _max_sampled_traces = 100;
+
+		public:
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetSampleInterval, _sample_interval)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetMaxSampledTraces, _max_sampled_traces)
+
+		protected:
+			void MakeList() override
+			{
+				// Experimental feature is disabled by default
+				SetEnable(false);
+
+				ModuleTemplate::MakeList();
+
+				/**
+					[Experimental] Per-hop latency trace of media packets
+
+					One of every SampleInterval packets is traced from the provider to the publisher sessions,
+					and the latency of each hop is reported by the REST API.
+						/v1/stats/current/vhosts/{vhost}/apps/{app}/streams/{stream}/latency
+						/v1/stats/current/vhosts/{vhost}/apps/{app}/streams/{stream}/latency/traces
+
+					server.xml:
+						<Modules>
+							<LatencyTrace>
+								<Enable>true</Enable>
+								<SampleInterval>100</SampleInterval>
+								<!-- The number of recent traces kept per stream -->
+								<MaxSampledTraces>100</MaxSampledTraces>
+							</LatencyTrace>
+						</Modules>
+				*/
+				Register<Optional>("SampleInterval", &_sample_interval);
+				Register<Optional>("MaxSampledTraces", &_max_sampled_traces);
+			}
+		};
+	}  // namespace modules
+}  // namespace cfg
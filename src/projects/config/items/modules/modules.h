@@ -14,6 +14,10 @@
 #include "recovery.h"
 #include "dynamic_app_removal.h"
 #include "etag.h"
+#include "ktls.h"
+#include "latency_trace.h"
+#include "task_executor.h"
+#include "file_cache.h"
 
 namespace cfg
 {
@@ -28,6 +32,10 @@ namespace cfg
 			Recovery _recovery;
 			DynamicAppRemoval _dynamic_app_removal;
 			ETag _etag;
+			KTLS _ktls;
+			LatencyTrace _latency_trace;
+			TaskExecutor _task_executor;
+			FileCache _file_cache;
 
 		public:
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetHttp2, _http2)
@@ -36,6 +44,10 @@ namespace cfg
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetRecovery, _recovery)
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetDynamicAppRemoval, _dynamic_app_removal)
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetETag, _etag)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetKTLS, _ktls)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetLatencyTrace, _latency_trace)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetTaskExecutor, _task_executor)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetFileCache, _file_cache)
 
 		protected:
 			void MakeList() override
@@ -46,6 +58,10 @@ namespace cfg
 				Register<Optional>("Recovery", &_recovery);
 				Register<Optional>("DynamicAppRemoval", &_dynamic_app_removal);
 				Register<Optional>("ETag", &_etag);
+				Register<Optional>("KTLS", &_ktls);
+				Register<Optional>("LatencyTrace", &_latency_trace);
+				Register<Optional>("TaskExecutor", &_task_executor);
+				Register<Optional>("FileCache", &_file_cache);
 			}
 		};
 	}  // namespace modules
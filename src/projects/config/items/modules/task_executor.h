@@ -0,0 +1,57 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "module_template.h"
+
+namespace cfg
+{
+	namespace modules
+	{
+		struct TaskExecutor : public ModuleTemplate
+		{
+		protected:
+			int _worker_count = 0;
+			bool _pin_workers = false;
+
+		public:
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetWorkerCount, _worker_count)
+			CFG_DECLARE_CONST_REF_GETTER_OF(IsPinWorkers, _pin_workers)
+
+		protected:
+			void MakeList() override
+			{
+				// Experimental feature is disabled by default
+				SetEnable(false);
+
+				ModuleTemplate::MakeList();
+
+				/**
+					[Experimental] Shared work-stealing executor
+
+					Stream workers of the publishers run as tasks on a per-core worker pool instead of a thread each.
+					If disabled, each object has its own thread as before.
+
+					server.xml:
+						<Modules>
+							<TaskExecutor>
+								<Enable>true</Enable>
+								<!-- 0: the number of CPUs available to the process -->
+								<WorkerCount>0</WorkerCount>
+								<!-- Pin each worker to a CPU -->
+								<PinWorkers>false</PinWorkers>
+							</TaskExecutor>
+						</Modules>
+				*/
+				Register<Optional>("WorkerCount", &_worker_count);
+				Register<Optional>("PinWorkers", &_pin_workers);
+			}
+		};
+	}  // namespace modules
+}  // namespace cfg
@@ -22,6 +22,8 @@ namespace cfg
 				{
 				protected:
                     ov::String _mux_files_dir;
+                    // Number of threads shared by the multiplex channels of the application
+                    int _worker_count = 2;
 
 				public:
 					ProviderType GetType() const override
@@ -30,6 +32,7 @@ namespace cfg
 					}
 
                     CFG_DECLARE_CONST_REF_GETTER_OF(GetMuxFilesDir, _mux_files_dir)
+                    CFG_DECLARE_CONST_REF_GETTER_OF(GetWorkerCount, _worker_count)
 					
 				protected:
 					void MakeList() override
@@ -37,6 +40,7 @@ namespace cfg
 						Provider::MakeList();
 
                         Register("MuxFilesDir", &_mux_files_dir);
+                        Register<Optional>("WorkerCount", &_worker_count);
 					}
 				};
 			}  // namespace pvd
@@ -23,6 +23,8 @@ namespace cfg
 				protected:
                     ov::String _media_root_dir;
                     ov::String _schedule_files_dir;
+                    // Number of threads shared by the scheduled channels of the application
+                    int _worker_count = 4;
 
 				public:
 					ProviderType GetType() const override
@@ -32,6 +34,7 @@ namespace cfg
 
                     CFG_DECLARE_CONST_REF_GETTER_OF(GetMediaRootDir, _media_root_dir)
                     CFG_DECLARE_CONST_REF_GETTER_OF(GetScheduleFilesDir, _schedule_files_dir)
+                    CFG_DECLARE_CONST_REF_GETTER_OF(GetWorkerCount, _worker_count)
 					
 				protected:
 					void MakeList() override
@@ -40,6 +43,7 @@ namespace cfg
 
                         Register("MediaRootDir", &_media_root_dir);
                         Register("ScheduleFilesDir", &_schedule_files_dir);
+                        Register<Optional>("WorkerCount", &_worker_count);
 					}
 				};
 			}  // namespace pvd
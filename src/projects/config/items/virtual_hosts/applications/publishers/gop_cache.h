@@ -0,0 +1,52 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+namespace cfg
+{
+	namespace vhost
+	{
+		namespace app
+		{
+			namespace pub
+			{
+				// The packets since the last keyframe are kept for each stream, and a new WebRTC/SRT/OVT session starts from them
+				// instead of waiting for the next keyframe.
+				//
+				// Latency: the cached packets are as old as the GOP so far (up to MaxDurationMs).
+				//  - WebRTC catches up: the cached frames are sent with their timestamps packed just before the live edge
+				//    and without the cached audio, so the browser shows them at once and then plays live.
+				//  - SRT: the MPEG-TS is sent as it was muxed, so a player that keeps its own clock (e.g. ffplay, VLC)
+				//    stays behind live by the age of the GOP when it joined. Keep MaxDurationMs short if that matters.
+				//  - OVT: the edge forwards the packets as they arrive, so its viewers are not delayed.
+				struct GopCache : public Item
+				{
+				protected:
+					bool _enabled = false;
+					// The GOP is not cached if it is longer than this, or larger than MaxSizeKB
+					int _max_duration_ms = 5000;
+					int _max_size_kb = 8192;
+
+				public:
+					CFG_DECLARE_CONST_REF_GETTER_OF(IsEnabled, _enabled)
+					CFG_DECLARE_CONST_REF_GETTER_OF(GetMaxDurationMs, _max_duration_ms)
+					CFG_DECLARE_CONST_REF_GETTER_OF(GetMaxSizeKB, _max_size_kb)
+
+				protected:
+					void MakeList() override
+					{
+						Register<Optional>("Enable", &_enabled);
+						Register<Optional>("MaxDurationMs", &_max_duration_ms);
+						Register<Optional>("MaxSizeKB", &_max_size_kb);
+					}
+				};
+			}  // namespace pub
+		}  // namespace app
+	}  // namespace vhost
+}  // namespace cfg
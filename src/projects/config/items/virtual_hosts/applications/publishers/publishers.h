@@ -9,6 +9,7 @@
 #pragma once
 
 #include "file_publisher.h"
+#include "gop_cache.h"
 #include "ovt_publisher.h"
 #include "mpegtspush_publisher.h"
 #include "rtmppush_publisher.h"
@@ -51,6 +52,7 @@ namespace cfg
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetAppWorkerCount, _app_worker_count)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetStreamWorkerCount, _stream_worker_count)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetDelayBufferTimeMs, _delay_buffer_time_ms)
+					CFG_DECLARE_CONST_REF_GETTER_OF(GetGopCache, _gop_cache)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetWebrtcPublisher, _webrtc_publisher)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetLLHlsPublisher, _ll_hls_publisher)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetOvtPublisher, _ovt_publisher)
@@ -71,6 +73,7 @@ namespace cfg
 						Register<Optional>("AppWorkerCount", &_app_worker_count);
 						Register<Optional>("StreamWorkerCount", &_stream_worker_count);
 						Register<Optional>("DelayBufferTimeMs", &_delay_buffer_time_ms);
+						Register<Optional>("GopCache", &_gop_cache);
 						Register<Optional>({"WebRTC", "webrtc"}, &_webrtc_publisher);
 						Register<Optional>({"LLHLS", "llhls"}, &_ll_hls_publisher);
 						Register<Optional>({"HLS", "hls"}, &_hls_publisher);
@@ -104,6 +107,7 @@ namespace cfg
 					int _app_worker_count = 1;
 					int _stream_worker_count = 8;
 					int _delay_buffer_time_ms = 0;
+					GopCache _gop_cache;
 
 					MpegtsPushPublisher _mpegtspush_publisher;
 					WebrtcPublisher _webrtc_publisher;
@@ -47,6 +47,7 @@ namespace cfg
 					CFG_DECLARE_CONST_REF_GETTER_OF(IsRtxEnabled, _rtx)
 					CFG_DECLARE_CONST_REF_GETTER_OF(IsUlpfecEnalbed, _ulpfec)
 					CFG_DECLARE_CONST_REF_GETTER_OF(IsJitterBufferEnabled, _jitter_buffer)
+					CFG_DECLARE_CONST_REF_GETTER_OF(IsPacerEnabled, _pacer)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetPlayoutDelay, _playout_delay)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetBandwidthEstimationType, _bandwidth_estimation_type)
 					CFG_DECLARE_CONST_REF_GETTER_OF(ShouldCreateDefaultPlaylist, _create_default_playlist)
@@ -60,6 +61,7 @@ namespace cfg
 						Register<Optional>("JitterBuffer", &_jitter_buffer);
 						Register<Optional>("Rtx", &_rtx);
 						Register<Optional>("Ulpfec", &_ulpfec);
+						Register<Optional>("Pacer", &_pacer);
 						Register<Optional>("PlayoutDelay", &_playout_delay);
 						Register<Optional>("CreateDefaultPlaylist", &_create_default_playlist);
 						Register<Optional>("BandwidthEstimation", &_bwe,	
@@ -71,12 +73,10 @@ namespace cfg
 								{
 									_bandwidth_estimation_type = WebRtcBandwidthEstimationType::REMB;
 								}
-								// Not yet supported
-								// else if (_bwe.UpperCaseString() == "TRANSPORTCC")
-								// {
-								// 	_bandwidth_estimation_type = BandwidthEstimationType::TransportCc;
-									
-								// }
+								else if (_bwe.UpperCaseString() == "TRANSPORTCC")
+								{
+									_bandwidth_estimation_type = WebRtcBandwidthEstimationType::TransportCc;
+								}
 								else
 								{
 									return CreateConfigErrorPtr("Invalid value for BWE. Valid values are 'TransportCC' or 'REMB'");
@@ -90,6 +90,7 @@ namespace cfg
 					bool _rtx = false;
 					bool _ulpfec = false;
 					bool _jitter_buffer = false;
+					bool _pacer = false;
 					ov::String _bwe;
 
 					WebRtcBandwidthEstimationType _bandwidth_estimation_type = WebRtcBandwidthEstimationType::REMB;
@@ -11,7 +11,9 @@
 #include <api_server/api_server.h>
 #include <base/info/ome_version.h>
 #include <base/ovlibrary/daemon.h>
+#include <base/ovlibrary/file_cache.h>
 #include <base/ovlibrary/log_write.h>
+#include <base/ovlibrary/task_executor.h>
 #include <base/ovsocket/ovsocket.h>
 #include <config/config_manager.h>
 #include <mediarouter/mediarouter.h>
@@ -110,6 +112,15 @@ int main(int argc, char *argv[])
 
 	bool succeeded = true;
 
+	auto &task_executor_config = server_config->GetModules().GetTaskExecutor();
+	if (task_executor_config.IsEnabled())
+	{
+		ov::TaskExecutor::GetInstance()->Start(std::max(task_executor_config.GetWorkerCount(), 0), task_executor_config.IsPinWorkers());
+	}
+
+	auto &file_cache_config = server_config->GetModules().GetFileCache();
+	ov::FileCache::GetInstance()->SetMaxSize(file_cache_config.IsEnabled() ? (static_cast<size_t>(std::max(file_cache_config.GetMaxSizeMB(), 0)) * 1024 * 1024) : 0);
+
 	INIT_EXTERNAL_MODULE("FFmpeg", InitializeFFmpeg);
 	INIT_EXTERNAL_MODULE("SRT", InitializeSrt);
 	INIT_EXTERNAL_MODULE("OpenSSL", InitializeOpenSsl);
@@ -331,6 +342,8 @@ static bool Uninitialize()
 	ov::SocketPool::GetTcpPool()->Uninitialize();
 	logti("Uninitializing UDP socket pool...");
 	ov::SocketPool::GetUdpPool()->Uninitialize();
+	logti("Stopping task executor...");
+	ov::TaskExecutor::GetInstance()->Stop();
 
 	logti("OvenMediaEngine will be terminated");
 
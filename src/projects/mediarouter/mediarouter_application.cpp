@@ -16,6 +16,9 @@
 
 #define MIN_APPLICATION_WORKER_COUNT 1
 #define MAX_APPLICATION_WORKER_COUNT 64
+// Bounded size of the inbound indicator ring. A stream has at most one indicator in the ring,
+// so it is only full when a worker has more streams than this
+#define INDICATOR_QUEUE_CAPACITY 8192
 
 #define CONNECTOR(var) MediaRouterApplicationConnector::ConnectorType::var
 #define OBSERVER(var) MediaRouterApplicationObserver::ObserverType::var
@@ -55,7 +58,7 @@ MediaRouteApplication::MediaRouteApplication(const info::Application &applicatio
 	{
 		{
 			auto urn = std::make_shared<info::ManagedQueue::URN>(_application_info.GetVHostAppName(), nullptr, "imr", ov::String::FormatString("aw_%d", worker_id));
-			auto stream_data = std::make_shared<ov::ManagedQueue<std::shared_ptr<MediaRouteStream>>>(urn, 1000);
+			auto stream_data = std::make_shared<ov::ManagedRingQueue<std::shared_ptr<MediaRouteStream>>>(urn, 1000, INDICATOR_QUEUE_CAPACITY);
 			_inbound_stream_indicator.push_back(stream_data);
 		}
 
@@ -751,7 +754,7 @@ bool MediaRouteApplication::OnPacketReceived(const std::shared_ptr<MediaRouterAp
 
 		stream->Push(packet);
 
-		_inbound_stream_indicator[GetWorkerIDByStreamID(stream_info->GetId())]->Enqueue(stream, packet->IsHighPriority());
+		IndicateInboundStream(stream, packet->IsHighPriority());
 	}
 	// Provider(relay), Transcoder => Outbound Stream
 	else if ((IS_CONNECTOR_PROVIDER(connector_type) && IS_REPRENT_RELAY(representation_type)) ||
@@ -855,6 +858,17 @@ uint32_t MediaRouteApplication::GetWorkerIDByStreamID(info::stream_id_t stream_i
 	return stream_id % _max_worker_thread_count;
 }
 
+void MediaRouteApplication::IndicateInboundStream(const std::shared_ptr<MediaRouteStream> &stream, bool urgent)
+{
+	// If the stream is already indicated, the worker will pick up this packet as well
+	if (stream->MarkIndicated() == false)
+	{
+		return;
+	}
+
+	_inbound_stream_indicator[GetWorkerIDByStreamID(stream->GetStream()->GetId())]->Enqueue(stream, urgent);
+}
+
 void MediaRouteApplication::InboundWorkerThread(uint32_t worker_id)
 {
 	logtd("Created Inbound worker thread #%d", worker_id);
@@ -875,13 +889,30 @@ void MediaRouteApplication::InboundWorkerThread(uint32_t worker_id)
 			continue;
 		}
 
+		// Clear the flag before popping so that a packet pushed from now on indicates the stream again
+		stream->ClearIndicated();
+
 		// StreamDeliver media packet to Publisher(observer) of Transcoder(observer)
 		auto media_packet = stream->PopAndNormalize();
+
+		// One packet is processed per wakeup, and the stream goes back to the end of the ring
+		// so that the other streams of this worker are not starved
+		if (stream->HasPackets())
+		{
+			IndicateInboundStream(stream, false);
+		}
+
 		if (media_packet == nullptr)
 		{
 			continue;
 		}
 
+		auto &trace = media_packet->GetTrace();
+		if (trace != nullptr)
+		{
+			trace->Stamp(MediaTrace::Hop::RouterInbound);
+		}
+
 		// When the inbound stream is finished parsing track information,
 		// Notify the Observer that the stream is parsed
 		if (stream->IsStreamPrepared() == false && stream->IsStreamReady() == true)
@@ -969,6 +1000,13 @@ void MediaRouteApplication::OutboundWorkerThread(uint32_t worker_id)
 			continue;
 		}
 
+		auto &trace = media_packet->GetTrace();
+		if (trace != nullptr)
+		{
+			trace->Stamp(MediaTrace::Hop::RouterOutbound);
+			stream->RecordLatency(*trace);
+		}
+
 		if (stream->IsStreamPrepared() == false && stream->IsStreamReady() == true)
 		{
 			NotifyStreamPrepared(stream);
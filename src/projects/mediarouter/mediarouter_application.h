@@ -20,6 +20,7 @@
 #include "base/mediarouter/mediarouter_application_observer.h"
 #include "base/mediarouter/mediarouter_interface.h"
 #include "modules/managed_queue/managed_queue.h"
+#include "modules/managed_queue/managed_ring_queue.h"
 
 #include "mediarouter_stream.h"
 #include "mediarouter_stream_tap.h"
@@ -158,6 +159,7 @@ private:
 
 private:
 	uint32_t GetWorkerIDByStreamID(info::stream_id_t stream_id);
+	void IndicateInboundStream(const std::shared_ptr<MediaRouteStream> &stream, bool urgent);
 	void InboundWorkerThread(uint32_t worker_id);
 	void OutboundWorkerThread(uint32_t worker_id);
 
@@ -168,6 +170,8 @@ private:
 	uint32_t _max_worker_thread_count;
 
 private:
-	std::vector<std::shared_ptr<ov::ManagedQueue<std::shared_ptr<MediaRouteStream>>>> _inbound_stream_indicator;
+	// Streams of all providers notify the inbound worker, so multiple producers are allowed
+	std::vector<std::shared_ptr<ov::ManagedRingQueue<std::shared_ptr<MediaRouteStream>>>> _inbound_stream_indicator;
+	// Outbound indicator uses the buffering delay, which needs the enqueued time of each message
 	std::vector<std::shared_ptr<ov::ManagedQueue<std::shared_ptr<MediaRouteStream>>>> _outbound_stream_indicator;
 };
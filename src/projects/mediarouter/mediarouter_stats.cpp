@@ -130,6 +130,11 @@ void MediaRouterStats::Update(
 									 stream_info->GetMsid(),
 									 max_pts - min_pts);
 
+		// Process-wide
+		stat_stream_str.AppendFormat(", converted data hit/miss: %" PRIu64 "/%" PRIu64,
+									 MediaPacketConvertedData::GetHitCount(),
+									 MediaPacketConvertedData::GetMissCount());
+
 		stat_track_str = stat_stream_str + stat_track_str;
 
 		logtd("%s", stat_track_str.CStr());
@@ -29,6 +29,7 @@
 #include "mediarouter_stream.h"
 
 #include <base/ovlibrary/ovlibrary.h>
+#include "monitoring/monitoring.h"
 
 #include "mediarouter_private.h"
 
@@ -56,6 +57,26 @@ std::shared_ptr<info::Stream> MediaRouteStream::GetStream()
 	return _stream;
 }
 
+void MediaRouteStream::RecordLatency(const MediaTrace &trace)
+{
+	if (_latency_metrics == nullptr)
+	{
+		auto stream_metrics = MonitorInstance->GetStreamMetrics(*_stream);
+		if (stream_metrics == nullptr)
+		{
+			return;
+		}
+
+		_latency_metrics = stream_metrics->GetLatencyMetrics();
+		if (_latency_metrics == nullptr)
+		{
+			return;
+		}
+	}
+
+	_latency_metrics->RecordTrace(trace);
+}
+
 void MediaRouteStream::SetType(cmn::MediaRouterStreamType type)
 {
 	_type = type;
@@ -216,6 +237,21 @@ void MediaRouteStream::Push(const std::shared_ptr<MediaPacket> &media_packet)
 	_packets_queue.Enqueue(media_packet, media_packet->IsHighPriority());
 }
 
+bool MediaRouteStream::HasPackets()
+{
+	return _packets_queue.IsEmpty() == false;
+}
+
+bool MediaRouteStream::MarkIndicated()
+{
+	return _indicated.exchange(true) == false;
+}
+
+void MediaRouteStream::ClearIndicated()
+{
+	_indicated.store(false);
+}
+
 std::shared_ptr<MediaPacket> MediaRouteStream::PopAndNormalize()
 {
 	// Get Media Packet
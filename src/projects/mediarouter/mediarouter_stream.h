@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "mediarouter_event_generator.h"
 #include "mediarouter_alert.h"
 #include "modules/managed_queue/managed_queue.h"
+#include "monitoring/latency_metrics.h"
 
 
 class MediaRouteStream : public MediaRouterNormalize, public MediaRouterStats, public MediaRouterEventGenerator, public MediaRouterAlert
@@ -38,6 +40,12 @@ public:
 	// Queue interfaces
 	void Push(const std::shared_ptr<MediaPacket> &media_packet);
 	std::shared_ptr<MediaPacket> PopAndNormalize();
+	bool HasPackets();
+
+	// The stream is indicated to the worker at most once at a time.
+	// Returns true if the caller has to enqueue the indicator
+	bool MarkIndicated();
+	void ClearIndicated();
 	
 	// Return mirror buffer reference
 	struct MirrorBufferItem
@@ -70,6 +78,9 @@ public:
 	bool IsStreamReady();
 
 	void Flush();
+
+	// Records the latency of each hop of a traced packet to the metrics of the stream
+	void RecordLatency(const MediaTrace &trace);
 	
 private:
 	void DropNonDecodingPackets();
@@ -88,7 +99,11 @@ private:
 
 	// Packets queue
 	ov::ManagedQueue<std::shared_ptr<MediaPacket>> _packets_queue;
+	std::atomic<bool> _indicated = false;
 
 	// Mirror buffer
 	std::vector<std::shared_ptr<MirrorBufferItem>> _mirror_buffer;
+
+	// Resolved on the first traced packet
+	std::shared_ptr<mon::LatencyMetrics> _latency_metrics;
 };
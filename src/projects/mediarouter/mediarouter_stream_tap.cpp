@@ -113,10 +113,46 @@ bool MediaRouterStreamTap::Push(const std::shared_ptr<MediaPacket> &media_packet
 
     _buffer.Enqueue(media_packet->ClonePacket());
 
+    NotifyTapSet();
+
     return true;
 }
 
 void MediaRouterStreamTap::SetState(State state)
 {
     _state = state;
+
+    // Let the consumer know the tap is untapped
+    NotifyTapSet();
+}
+
+void MediaRouterStreamTap::SetTapSet(const std::shared_ptr<MediaRouterStreamTapSet> &tap_set, uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(_tap_set_mutex);
+
+    _tap_set = tap_set;
+    _tap_set_key = key;
+}
+
+bool MediaRouterStreamTap::IsReady() const
+{
+    return (_state != State::Tapped) || (_buffer.IsEmpty() == false);
+}
+
+void MediaRouterStreamTap::NotifyTapSet()
+{
+    std::shared_ptr<MediaRouterStreamTapSet> tap_set;
+    uint64_t key = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(_tap_set_mutex);
+
+        tap_set = _tap_set.lock();
+        key = _tap_set_key;
+    }
+
+    if (tap_set != nullptr)
+    {
+        tap_set->SetReady(key);
+    }
 }
@@ -14,10 +14,12 @@
 
 #include <base/mediarouter/media_buffer.h>
 #include "mediarouter_application.h"
+#include "mediarouter_stream_tap_set.h"
 
 class MediaRouterStreamTap
 {
 friend class MediaRouteApplication;
+friend class MediaRouterStreamTapSet;
 public:
     static std::shared_ptr<MediaRouterStreamTap> Create(size_t buffer_size = 300);
 
@@ -56,6 +58,12 @@ private:
     void SetStreamInfo(const std::shared_ptr<info::Stream> &stream_info);
     void SetState(State state);
 
+    // Called by MediaRouterStreamTapSet
+    void SetTapSet(const std::shared_ptr<MediaRouterStreamTapSet> &tap_set, uint64_t key);
+    // true if Pop() would not block or the state needs to be checked by the consumer
+    bool IsReady() const;
+    void NotifyTapSet();
+
     uint32_t IssueUniqueId();
 
     std::shared_ptr<info::Stream> _tapped_stream_info;
@@ -68,5 +76,9 @@ private:
 
 	bool _need_past_data = false;
 
+    std::mutex _tap_set_mutex;
+    std::weak_ptr<MediaRouterStreamTapSet> _tap_set;
+    uint64_t _tap_set_key = 0;
+
     uint32_t _id = 0;
 };
\ No newline at end of file
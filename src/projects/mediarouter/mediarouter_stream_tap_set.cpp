@@ -0,0 +1,96 @@
+//==============================================================================
+//
+//  MediaRouterStreamTapSet
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#include "mediarouter_stream_tap_set.h"
+
+#include "mediarouter_stream_tap.h"
+
+std::shared_ptr<MediaRouterStreamTapSet> MediaRouterStreamTapSet::Create()
+{
+    return std::make_shared<MediaRouterStreamTapSet>();
+}
+
+bool MediaRouterStreamTapSet::Add(const std::shared_ptr<MediaRouterStreamTap> &tap, uint64_t key)
+{
+    if (tap == nullptr)
+    {
+        return false;
+    }
+
+    tap->SetTapSet(shared_from_this(), key);
+
+    // Packets pushed before the tap was added would not be signaled
+    if (tap->IsReady())
+    {
+        SetReady(key);
+    }
+
+    return true;
+}
+
+void MediaRouterStreamTapSet::Remove(const std::shared_ptr<MediaRouterStreamTap> &tap)
+{
+    if (tap == nullptr)
+    {
+        return;
+    }
+
+    tap->SetTapSet(nullptr, 0);
+}
+
+bool MediaRouterStreamTapSet::Wait(std::chrono::steady_clock::time_point deadline, std::set<uint64_t> &ready_keys)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    auto is_signaled = [this]() -> bool {
+        return (_ready_keys.empty() == false) || _wakeup_requested;
+    };
+
+    if (deadline == std::chrono::steady_clock::time_point::max())
+    {
+        _condition.wait(lock, is_signaled);
+    }
+    else
+    {
+        _condition.wait_until(lock, deadline, is_signaled);
+    }
+
+    _wakeup_requested = false;
+
+    if (_ready_keys.empty())
+    {
+        return false;
+    }
+
+    ready_keys.merge(_ready_keys);
+    _ready_keys.clear();
+
+    return true;
+}
+
+void MediaRouterStreamTapSet::Wakeup()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _wakeup_requested = true;
+    _condition.notify_one();
+}
+
+void MediaRouterStreamTapSet::SetReady(uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Already signaled and not consumed yet
+    if (_ready_keys.insert(key).second == false)
+    {
+        return;
+    }
+
+    _condition.notify_one();
+}
@@ -0,0 +1,47 @@
+//==============================================================================
+//
+//  MediaRouterStreamTapSet
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/common_types.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+
+class MediaRouterStreamTap;
+
+// A readiness set of MediaRouterStreamTaps, like an epoll set for the tap buffers.
+// A tap in the set signals it when a packet is pushed or its state is changed,
+// so one consumer can block across many taps instead of polling each of them.
+class MediaRouterStreamTapSet : public std::enable_shared_from_this<MediaRouterStreamTapSet>
+{
+public:
+    static std::shared_ptr<MediaRouterStreamTapSet> Create();
+
+    // key is reported by Wait() when the tap becomes ready, several taps can share the same key
+    // A tap can be in only one set at a time
+    bool Add(const std::shared_ptr<MediaRouterStreamTap> &tap, uint64_t key);
+    void Remove(const std::shared_ptr<MediaRouterStreamTap> &tap);
+
+    // Waits until any tap becomes ready, Wakeup() is called, or the deadline is reached.
+    // The keys of the ready taps are moved to ready_keys (returns false if there is no ready tap)
+    bool Wait(std::chrono::steady_clock::time_point deadline, std::set<uint64_t> &ready_keys);
+    void Wakeup();
+
+private:
+    friend class MediaRouterStreamTap;
+
+    void SetReady(uint64_t key);
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::set<uint64_t> _ready_keys;
+    bool _wakeup_requested = false;
+};
@@ -0,0 +1,251 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "annexb_scanner.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#	include <immintrin.h>
+#	define ANNEXB_SCANNER_X86 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#	include <arm_neon.h>
+#	define ANNEXB_SCANNER_NEON 1
+#endif
+
+#define OV_LOG_TAG "AnnexBScanner"
+
+// Returns the start code size if there is a start code at offset, otherwise 0
+static inline size_t GetStartCodeSize(const uint8_t *bitstream, size_t length, size_t offset)
+{
+	auto remaining = length - offset;
+	auto data = bitstream + offset;
+
+	if ((remaining >= 3) && (data[0] == 0x00) && (data[1] == 0x00))
+	{
+		if (data[2] == 0x01)
+		{
+			return 3;
+		}
+
+		if ((remaining >= 4) && (data[2] == 0x00) && (data[3] == 0x01))
+		{
+			return 4;
+		}
+	}
+
+	return 0;
+}
+
+// Checks the candidates ("00 00") in the mask in ascending order
+static inline bool CheckCandidates(const uint8_t *bitstream, size_t length, size_t offset, uint32_t mask, size_t &found_offset, size_t &start_code_size)
+{
+	while (mask != 0)
+	{
+		auto candidate = offset + __builtin_ctz(mask);
+
+		start_code_size = GetStartCodeSize(bitstream, length, candidate);
+		if (start_code_size > 0)
+		{
+			found_offset = candidate;
+			return true;
+		}
+
+		// Clear the lowest bit
+		mask &= (mask - 1);
+	}
+
+	return false;
+}
+
+static bool FindStartCodeScalar(const uint8_t *bitstream, size_t length, size_t offset, size_t &found_offset, size_t &start_code_size)
+{
+	while (offset + 3 <= length)
+	{
+		auto data = bitstream + offset;
+
+		// If the 3rd byte isn't 0 or 1, there is no start code in these 3 bytes
+		if (data[2] > 0x01)
+		{
+			offset += 3;
+			continue;
+		}
+
+		start_code_size = GetStartCodeSize(bitstream, length, offset);
+		if (start_code_size > 0)
+		{
+			found_offset = offset;
+			return true;
+		}
+
+		offset++;
+	}
+
+	return false;
+}
+
+#if ANNEXB_SCANNER_X86
+__attribute__((target("avx2"))) static bool FindStartCodeAvx2(const uint8_t *bitstream, size_t length, size_t &offset, size_t &found_offset, size_t &start_code_size)
+{
+	const __m256i zero = _mm256_setzero_si256();
+
+	// data[i] and data[i + 1] are compared, so 33 bytes are needed
+	while (offset + 33 <= length)
+	{
+		auto first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + offset));
+		auto second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + offset + 1));
+
+		auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, zero), _mm256_cmpeq_epi8(second, zero))));
+
+		if ((mask != 0) && CheckCandidates(bitstream, length, offset, mask, found_offset, start_code_size))
+		{
+			return true;
+		}
+
+		offset += 32;
+	}
+
+	return false;
+}
+
+static bool FindStartCodeSse2(const uint8_t *bitstream, size_t length, size_t &offset, size_t &found_offset, size_t &start_code_size)
+{
+	const __m128i zero = _mm_setzero_si128();
+
+	// data[i] and data[i + 1] are compared, so 17 bytes are needed
+	while (offset + 17 <= length)
+	{
+		auto first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + offset));
+		auto second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + offset + 1));
+
+		auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, zero), _mm_cmpeq_epi8(second, zero))));
+
+		if ((mask != 0) && CheckCandidates(bitstream, length, offset, mask, found_offset, start_code_size))
+		{
+			return true;
+		}
+
+		offset += 16;
+	}
+
+	return false;
+}
+#elif ANNEXB_SCANNER_NEON
+static bool FindStartCodeNeon(const uint8_t *bitstream, size_t length, size_t &offset, size_t &found_offset, size_t &start_code_size)
+{
+	while (offset + 17 <= length)
+	{
+		auto first = vld1q_u8(bitstream + offset);
+		auto second = vld1q_u8(bitstream + offset + 1);
+
+		// 0xFF for the "00 00" candidates
+		auto candidates = vandq_u8(vceqzq_u8(first), vceqzq_u8(second));
+
+		if (vmaxvq_u8(candidates) != 0)
+		{
+			// NEON doesn't have movemask, so make it with the bit weights of each lane
+			static const uint8_t bit_weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+			auto bits = vandq_u8(candidates, vld1q_u8(bit_weights));
+
+			uint32_t mask = vaddv_u8(vget_low_u8(bits)) | (static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+
+			if (CheckCandidates(bitstream, length, offset, mask, found_offset, start_code_size))
+			{
+				return true;
+			}
+		}
+
+		offset += 16;
+	}
+
+	return false;
+}
+#endif
+
+int AnnexBScanner::FindStartCode(const uint8_t *bitstream, size_t length, size_t &start_code_size)
+{
+	start_code_size = 0;
+
+	if ((bitstream == nullptr) || (length < 3))
+	{
+		return -1;
+	}
+
+	size_t offset = 0;
+	size_t found_offset = 0;
+
+#if ANNEXB_SCANNER_X86
+	static const bool avx2_supported = __builtin_cpu_supports("avx2");
+
+	if (avx2_supported)
+	{
+		if (FindStartCodeAvx2(bitstream, length, offset, found_offset, start_code_size))
+		{
+			return static_cast<int>(found_offset);
+		}
+	}
+
+	// The remaining bytes (less than 33) of AVX2 are also scanned by SSE2
+	if (FindStartCodeSse2(bitstream, length, offset, found_offset, start_code_size))
+	{
+		return static_cast<int>(found_offset);
+	}
+#elif ANNEXB_SCANNER_NEON
+	if (FindStartCodeNeon(bitstream, length, offset, found_offset, start_code_size))
+	{
+		return static_cast<int>(found_offset);
+	}
+#endif
+
+	if (FindStartCodeScalar(bitstream, length, offset, found_offset, start_code_size))
+	{
+		return static_cast<int>(found_offset);
+	}
+
+	start_code_size = 0;
+	return -1;
+}
+
+std::vector<AnnexBScanner::NalUnit> AnnexBScanner::FindNalUnits(const uint8_t *bitstream, size_t length)
+{
+	std::vector<NalUnit> nal_units;
+
+	size_t offset = 0;
+	while (offset < length)
+	{
+		size_t start_code_size = 0;
+		auto pos = FindStartCode(bitstream + offset, length - offset, start_code_size);
+
+		if (pos == -1)
+		{
+			break;
+		}
+
+		offset += pos;
+
+		if (nal_units.empty() == false)
+		{
+			auto &prev_nal_unit = nal_units.back();
+			prev_nal_unit.payload_size = offset - prev_nal_unit.payload_offset;
+		}
+
+		NalUnit nal_unit;
+		nal_unit.start_offset = offset;
+		nal_unit.payload_offset = offset + start_code_size;
+		nal_units.push_back(nal_unit);
+
+		offset += start_code_size;
+	}
+
+	// Last NAL unit
+	if (nal_units.empty() == false)
+	{
+		auto &last_nal_unit = nal_units.back();
+		last_nal_unit.payload_size = length - last_nal_unit.payload_offset;
+	}
+
+	return nal_units;
+}
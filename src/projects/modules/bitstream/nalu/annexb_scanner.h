@@ -0,0 +1,39 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <stdint.h>
+
+#include <vector>
+
+// Finds the start codes (00 00 01 / 00 00 00 01) of an Annex-B bitstream
+//
+// The bitstream is scanned 16/32 bytes at a time (SSE2/AVX2 or NEON) to find the "00 00" candidates,
+// and only the candidates are checked byte by byte.
+class AnnexBScanner
+{
+public:
+	// Position of a NAL unit in the bitstream
+	struct NalUnit
+	{
+		// Offset of the start code
+		size_t start_offset = 0;
+		// Offset of the NAL unit header (right after the start code)
+		size_t payload_offset = 0;
+		size_t payload_size = 0;
+	};
+
+	// Returns the offset of the first start code and its size (3 or 4)
+	// Returns -1 if there is no start code in the bitstream
+	static int FindStartCode(const uint8_t *bitstream, size_t length, size_t &start_code_size);
+
+	// Returns the positions of the NAL units in the bitstream (the data before the first start code is ignored)
+	static std::vector<NalUnit> FindNalUnits(const uint8_t *bitstream, size_t length);
+};
@@ -538,7 +538,10 @@ namespace bmff
 		}
 		else if (media_packet->GetBitstreamFormat() == cmn::BitstreamFormat::H264_ANNEXB)
 		{
-			auto converted_data = NalStreamConverter::ConvertAnnexbToXvcc(media_packet->GetData(), media_packet->GetFragHeader());
+			// The converted data is shared with the other packagers of the packet
+			auto converted_data = media_packet->GetConvertedData(cmn::BitstreamFormat::H264_AVCC, [&media_packet]() -> std::shared_ptr<const ov::Data> {
+				return NalStreamConverter::ConvertAnnexbToXvcc(media_packet->GetData(), media_packet->GetFragHeader());
+			});
 			if (converted_data == nullptr)
 			{
 				logtw("FMP4Packager::ConvertBitstreamFormat() - Failed to convert annexb to avcc");
@@ -546,7 +549,7 @@ namespace bmff
 			}
 
 			auto new_packet = std::make_shared<MediaPacket>(*media_packet);
-			new_packet->SetData(converted_data);
+			new_packet->SetReadOnlyData(converted_data);
 			new_packet->SetBitstreamFormat(cmn::BitstreamFormat::H264_AVCC);
 			new_packet->SetPacketType(cmn::PacketType::NALU);
 
@@ -554,7 +557,10 @@ namespace bmff
 		}
 		else if (media_packet->GetBitstreamFormat() == cmn::BitstreamFormat::H265_ANNEXB)
 		{
-			auto converted_data = NalStreamConverter::ConvertAnnexbToXvcc(media_packet->GetData(), media_packet->GetFragHeader());
+			// The converted data is shared with the other packagers of the packet
+			auto converted_data = media_packet->GetConvertedData(cmn::BitstreamFormat::HVCC, [&media_packet]() -> std::shared_ptr<const ov::Data> {
+				return NalStreamConverter::ConvertAnnexbToXvcc(media_packet->GetData(), media_packet->GetFragHeader());
+			});
 			if (converted_data == nullptr)
 			{
 				logtw("FMP4Packager::ConvertBitstreamFormat() - Failed to convert annexb to hvcc");
@@ -562,7 +568,7 @@ namespace bmff
 			}
 
 			auto new_packet = std::make_shared<MediaPacket>(*media_packet);
-			new_packet->SetData(converted_data);
+			new_packet->SetReadOnlyData(converted_data);
 			new_packet->SetBitstreamFormat(cmn::BitstreamFormat::HVCC);
 			new_packet->SetPacketType(cmn::PacketType::NALU);
 
@@ -570,7 +576,9 @@ namespace bmff
 		}
 		else if (media_packet->GetBitstreamFormat() == cmn::BitstreamFormat::AAC_ADTS)
 		{
-			auto raw_data = AacConverter::ConvertAdtsToRaw(media_packet->GetData(), nullptr);
+			auto raw_data = media_packet->GetConvertedData(cmn::BitstreamFormat::AAC_RAW, [&media_packet]() -> std::shared_ptr<const ov::Data> {
+				return AacConverter::ConvertAdtsToRaw(media_packet->GetData(), nullptr);
+			});
 			if (raw_data == nullptr)
 			{
 				logtw("FMP4Packager::ConvertBitstreamFormat() - Failed to convert adts to raw");
@@ -578,7 +586,7 @@ namespace bmff
 			}
 
 			auto new_packet = std::make_shared<MediaPacket>(*media_packet);
-			new_packet->SetData(raw_data);
+			new_packet->SetReadOnlyData(raw_data);
 			new_packet->SetBitstreamFormat(cmn::BitstreamFormat::AAC_RAW);
 			new_packet->SetPacketType(cmn::PacketType::RAW);
 
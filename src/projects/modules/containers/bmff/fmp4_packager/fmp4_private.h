@@ -1,3 +1,6 @@
 #pragma once
 
-#define OV_LOG_TAG "FMP4 Packager"
\ No newline at end of file
+#define OV_LOG_TAG "FMP4 Packager"
+
+// Maximum size of a DVR data file
+#define DVR_DATA_FILE_MAX_SIZE (64 * 1024 * 1024)
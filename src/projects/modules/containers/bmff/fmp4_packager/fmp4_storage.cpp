@@ -9,6 +9,9 @@
 
 #include <base/info/media_track.h>
 #include <base/ovlibrary/files.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
 
 #include <modules/data_format/cue_event/cue_event.h>
 
@@ -37,6 +40,8 @@ namespace bmff
 
 	FMP4Storage::~FMP4Storage()
 	{
+		CloseDataFile();
+
 		if (_config.dvr_enabled == true)
 		{
 			// Delete all dvr directory and files
@@ -71,6 +76,8 @@ namespace bmff
 		}
 		
 		auto min_number = _segments.begin()->first;
+		lock.unlock();
+
 		if (segment_number < min_number)
 		{
 			// If the segment is not in the list, try to load it from the file
@@ -181,9 +188,37 @@ namespace bmff
 		return ov::String::FormatString("%s/%s/%d", _config.dvr_storage_path.CStr(), _stream_tag.CStr(), _track->GetId());
 	}
 
-	ov::String FMP4Storage::GetSegmentFilePath(uint32_t segment_number) const
+	ov::String FMP4Storage::GetDataFilePath(uint32_t file_index) const
+	{
+		return ov::String::FormatString("%s/%u.dat", GetDVRDirectory().CStr(), file_index);
+	}
+
+	bool FMP4Storage::OpenDataFile(uint32_t file_index)
+	{
+		CloseDataFile();
+
+		auto file_path = GetDataFilePath(file_index);
+
+		_data_file_fd = ::open(file_path.CStr(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (_data_file_fd < 0)
+		{
+			logte("Could not open DVR data file: %s (%s)", file_path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			return false;
+		}
+
+		_data_file_index = file_index;
+		_data_file_size = 0;
+
+		return true;
+	}
+
+	void FMP4Storage::CloseDataFile()
 	{
-		return ov::String::FormatString("%s/%d.m4s", GetDVRDirectory().CStr(), segment_number);
+		if (_data_file_fd >= 0)
+		{
+			::close(_data_file_fd);
+			_data_file_fd = -1;
+		}
 	}
 
 	bool FMP4Storage::SaveMediaSegmentToFile(const std::shared_ptr<FMP4Segment> &segment)
@@ -193,8 +228,6 @@ namespace bmff
 			return false;
 		}
 
-		// Save to file
-		auto file_path = GetSegmentFilePath(segment->GetNumber());
 		auto dir = GetDVRDirectory();
 
 		// Create directory
@@ -208,14 +241,70 @@ namespace bmff
 			}
 		}
 
-		// Save to file
-		if (ov::DumpToFile(file_path, segment->GetData()) == nullptr)
+		if ((_data_file_fd < 0) || (_data_file_size >= DVR_DATA_FILE_MAX_SIZE))
 		{
-			logte("Could not save segment to file: %s", file_path.CStr());
-			return false;
+			// Start a new data file
+			auto file_index = (_data_file_fd < 0 && _data_file_segment_counts.empty()) ? 0 : (_data_file_index + 1);
+			if (OpenDataFile(file_index) == false)
+			{
+				return false;
+			}
+		}
+
+		// Append the chunks of the segment to the data file without merging them
+		auto data_list = segment->GetDataList();
+		std::vector<struct iovec> iov_list;
+		iov_list.reserve(data_list.size());
+
+		for (const auto &data : data_list)
+		{
+			iov_list.push_back({const_cast<void *>(data->GetData()), data->GetLength()});
+		}
+
+		auto offset = _data_file_size;
+		size_t total_bytes = segment->GetDataLength();
+		size_t written_bytes = 0;
+		size_t iov_index = 0;
+
+		while (written_bytes < total_bytes)
+		{
+			auto iov_count = std::min<size_t>(iov_list.size() - iov_index, IOV_MAX);
+			auto written = ::pwritev(_data_file_fd, &iov_list[iov_index], iov_count, offset + written_bytes);
+
+			if (written < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				logte("Could not write segment %ld to DVR data file: %s (%s)", segment->GetNumber(), GetDataFilePath(_data_file_index).CStr(), ov::Error::CreateErrorFromErrno()->What());
+				return false;
+			}
+
+			written_bytes += written;
+
+			// Skip the buffers that have been written, and adjust the partially written one
+			while ((written > 0) && (iov_index < iov_list.size()))
+			{
+				auto &iov = iov_list[iov_index];
+
+				if (static_cast<size_t>(written) < iov.iov_len)
+				{
+					iov.iov_base = static_cast<uint8_t *>(iov.iov_base) + written;
+					iov.iov_len -= written;
+					break;
+				}
+
+				written -= iov.iov_len;
+				iov_index++;
+			}
 		}
 
-		_dvr_info.AppendSegment(segment->GetNumber(), segment->GetDurationMs(), segment->GetDataLength());
+		_data_file_size += total_bytes;
+		_data_file_segment_counts[_data_file_index]++;
+
+		_dvr_info.AppendSegment(segment->GetNumber(), segment->GetDurationMs(), total_bytes, _data_file_index, offset);
 
 		// Delete old segments until the total duration is less than the maximum DVR duration
 		while (_dvr_info.GetTotalDurationMs() > (_config.dvr_duration_sec * 1000.0))
@@ -226,10 +315,22 @@ namespace bmff
 				break;
 			}
 
-			auto file_path = GetSegmentFilePath(segment_to_delete.segment_number);
-			if (std::remove(file_path) != 0)
+			// The data file is deleted when all of its segments have expired
+			auto count_it = _data_file_segment_counts.find(segment_to_delete.file_index);
+			if ((count_it != _data_file_segment_counts.end()) && (--count_it->second == 0))
 			{
-				logte("Could not delete DVR segment file: %s", file_path.CStr());
+				_data_file_segment_counts.erase(count_it);
+
+				if (segment_to_delete.file_index == _data_file_index)
+				{
+					CloseDataFile();
+				}
+
+				auto file_path = GetDataFilePath(segment_to_delete.file_index);
+				if (std::remove(file_path) != 0)
+				{
+					logte("Could not delete DVR data file: %s", file_path.CStr());
+				}
 			}
 
 			if (_observer != nullptr)
@@ -255,12 +356,45 @@ namespace bmff
 			return nullptr;
 		}
 
-		auto file_path = GetSegmentFilePath(segment_number);
+		auto file_path = GetDataFilePath(info.file_index);
+
+		// The data file may be deleted after the index lookup if the segment expires in the meantime
+		int fd = ::open(file_path.CStr(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+		{
+			logtw("Could not open DVR data file: %s (%s)", file_path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			return nullptr;
+		}
+
+		// Only the requested range is read, and the buffer is released when the response is sent
+		auto data = std::make_shared<ov::Data>(info.segment_size);
+		data->SetLength(info.segment_size);
+
+		auto buffer = data->GetWritableDataAs<uint8_t>();
+		size_t read_bytes = 0;
+
+		while (read_bytes < info.segment_size)
+		{
+			auto result = ::pread(fd, buffer + read_bytes, info.segment_size - read_bytes, info.offset + read_bytes);
+
+			if (result < 0 && errno == EINTR)
+			{
+				continue;
+			}
+
+			if (result <= 0)
+			{
+				break;
+			}
+
+			read_bytes += result;
+		}
+
+		::close(fd);
 
-		auto data = ov::LoadFromFile(file_path);
-		if (data == nullptr)
+		if (read_bytes != info.segment_size)
 		{
-			logte("Could not load segment from file: %s", file_path.CStr());
+			logte("Could not read segment %u from DVR data file: %s (%zu/%zu bytes)", segment_number, file_path.CStr(), read_bytes, info.segment_size);
 			return nullptr;
 		}
 
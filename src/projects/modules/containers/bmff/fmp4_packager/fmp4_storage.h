@@ -69,6 +69,10 @@ namespace bmff
 				double duration_ms = 0;
 				size_t segment_size = 0;
 
+				// Location in the DVR data files
+				uint32_t file_index = 0;
+				off_t offset = 0;
+
 				bool IsAvailable() const
 				{
 					return segment_size != 0;
@@ -87,7 +91,7 @@ namespace bmff
 				return _segments.size();
 			}
 
-			void AppendSegment(uint32_t segment_number, double duration_ms, size_t segment_size)
+			void AppendSegment(uint32_t segment_number, double duration_ms, size_t segment_size, uint32_t file_index, off_t offset)
 			{
 				//lock
 				std::lock_guard<std::shared_mutex> lock(_segments_lock);
@@ -104,7 +108,7 @@ namespace bmff
 					}
 				}
 
-				_segments.push_back({segment_number, duration_ms, segment_size});
+				_segments.push_back({segment_number, duration_ms, segment_size, file_index, offset});
 				_total_dvr_segment_duration_ms += duration_ms;
 			}
 
@@ -116,7 +120,7 @@ namespace bmff
 
 				if(_segments.empty())
 				{
-					return {0, 0, 0};
+					return {};
 				}
 
 				auto segment_info = _segments.front();
@@ -137,13 +141,13 @@ namespace bmff
 
 				if(_segments.empty())
 				{
-					return {0, 0, 0};
+					return {};
 				}
 
 				// Check if the segment number is valid
-				if (_first_segment_number > segment_number)
+				if ((_first_segment_number > segment_number) || ((segment_number - _first_segment_number) >= _segments.size()))
 				{
-					return {0, 0, 0};
+					return {};
 				}
 
 				return _segments[segment_number - _first_segment_number];
@@ -159,8 +163,20 @@ namespace bmff
 
 		DvrInfo _dvr_info;
 
+		// Data file being written
+		int _data_file_fd = -1;
+		uint32_t _data_file_index = 0;
+		off_t _data_file_size = 0;
+		// file index : number of segments in the file that have not expired
+		std::map<uint32_t, uint32_t> _data_file_segment_counts;
+
+		// Segments that age out of the live window are appended to the DVR data files,
+		// and a new data file is started when the current one exceeds DVR_DATA_FILE_MAX_SIZE
+		// so that expired segments can be deleted file by file.
 		ov::String GetDVRDirectory() const;
-		ov::String GetSegmentFilePath(uint32_t segment_number) const;
+		ov::String GetDataFilePath(uint32_t file_index) const;
+		bool OpenDataFile(uint32_t file_index);
+		void CloseDataFile();
 		bool SaveMediaSegmentToFile(const std::shared_ptr<FMP4Segment> &segment);
 		std::shared_ptr<FMP4Segment> LoadMediaSegmentFromFile(uint32_t segment_number) const;
 
@@ -70,16 +70,15 @@ namespace bmff
 		FMP4Segment(uint64_t number, uint64_t target_duration)
 		{
 			_number = number;
-
-			// For performance, reserve memory for 4Mbps * target_duration (sec)
-			_data = std::make_shared<ov::Data>(((1000.0 * 1000.0 * 4.0)/8.0) * (static_cast<double>(target_duration) / 1000.0));
 		}
 
+		// Segment loaded from a file (DVR), which has no chunks
 		FMP4Segment(uint64_t number, double duration_ms, const std::shared_ptr<ov::Data> &data)
 		{
 			_number = number;
 			_duration_ms = duration_ms;
 			_data = data;
+			_data_length = (data != nullptr) ? data->GetLength() : 0;
 
 			SetCompleted();
 		}
@@ -109,27 +108,58 @@ namespace bmff
 				_start_timestamp = start_timestamp;
 			}
 
+			// The segment is the concatenation of its chunks, so the chunk data is not copied into a segment buffer
 			_chunks.emplace_back(std::make_shared<FMP4Chunk>(chunk_data, chunk_number, start_timestamp, duration_ms, independent));
 			_last_chunk_number = chunk_number;
+			_data_length += chunk_data->GetLength();
 
 			lock.unlock();
-			
-			// Append data
+
 			_duration_ms += duration_ms;
-			_data->Append(chunk_data);
 
 			return true;
 		}
 
-		// Get Data
-		std::shared_ptr<ov::Data> GetData() const
+		// Get the slices that make up the segment data in order
+		std::vector<std::shared_ptr<const ov::Data>> GetDataList() const
 		{
-			return _data;
+			std::shared_lock<std::shared_mutex> lock(_chunks_lock);
+
+			std::vector<std::shared_ptr<const ov::Data>> data_list;
+
+			if (_data != nullptr)
+			{
+				data_list.push_back(_data);
+				return data_list;
+			}
+
+			data_list.reserve(_chunks.size());
+
+			for (const auto &chunk : _chunks)
+			{
+				data_list.push_back(chunk->GetData());
+			}
+
+			return data_list;
+		}
+
+		// Build a contiguous copy of the segment data (for dumping only, GetDataList() should be used to serve the segment)
+		std::shared_ptr<ov::Data> CopyData() const
+		{
+			auto data = std::make_shared<ov::Data>(GetDataLength());
+
+			for (const auto &slice : GetDataList())
+			{
+				data->Append(slice);
+			}
+
+			return data;
 		}
 
 		size_t GetDataLength() const
 		{
-			return _data == nullptr ? 0 : _data->GetLength();
+			std::shared_lock<std::shared_mutex> lock(_chunks_lock);
+			return _data_length;
 		}
 
 		// Get Number
@@ -159,7 +189,7 @@ namespace bmff
 
 		size_t GetSize() const
 		{
-			return _data->GetLength();
+			return GetDataLength();
 		}
 
 		// Get Last Chunk Number
@@ -214,7 +244,9 @@ namespace bmff
 
 		int64_t _last_chunk_number = -1;
 
-		// Segment Data
+		// Total length of the chunk data
+		size_t _data_length = 0;
+		// Only used for the segment loaded from a file
 		std::shared_ptr<ov::Data> _data;
 
 		std::vector<std::shared_ptr<Marker>> _markers;
@@ -54,18 +54,6 @@ namespace mpegts
         return _last_segment_id ++;
     }
 
-    std::shared_ptr<ov::Data> Packager::MergeTsPacketData(const std::vector<std::shared_ptr<mpegts::Packet>> &ts_packets)
-    {
-        auto data = std::make_shared<ov::Data>(SEGMENT_BUFFER_SIZE);
-
-        for (const auto &ts_packet : ts_packets)
-        {
-            data->Append(ts_packet->GetData());
-        }
-
-        return data;
-    }
-    
     std::shared_ptr<const MediaTrack> Packager::GetMediaTrack(uint32_t track_id) const
     {
         auto it = _media_tracks.find(track_id);
@@ -88,7 +76,7 @@ namespace mpegts
         return it->second;
     }
 
-    void Packager::OnPsi(const std::vector<std::shared_ptr<const MediaTrack>> &tracks, const std::vector<std::shared_ptr<mpegts::Packet>> &psi_packets)
+    void Packager::OnPsi(const std::vector<std::shared_ptr<const MediaTrack>> &tracks, const std::shared_ptr<const ov::Data> &psi_data)
     {
         logtd("OnPsi %u tracks", tracks.size());
 
@@ -116,8 +104,7 @@ namespace mpegts
             _sample_buffers.emplace(track->GetId(), std::make_shared<SampleBuffer>(track));
         }
 
-        _psi_packets = psi_packets;
-        _psi_packet_data = MergeTsPacketData(psi_packets);
+        _psi_data = psi_data;
     }
 
 	void Packager::Flush()
@@ -165,18 +152,7 @@ namespace mpegts
 		return nullptr;
 	}
 
-	std::shared_ptr<const ov::Data> Packager::GetSegmentData(uint64_t segment_id) const
-	{
-		auto segment = GetSegment(segment_id);
-		if (segment == nullptr)
-		{
-			return nullptr;
-		}
-
-		return segment->GetData();
-	}
-
-    void Packager::OnFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::vector<std::shared_ptr<mpegts::Packet>> &pes_packets)
+    void Packager::OnFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::shared_ptr<const ov::Data> &pes_data)
     {
        //logtd("OnFrame track_id %u", media_packet->GetTrackId());
 
@@ -190,7 +166,7 @@ namespace mpegts
             return;
         }
 
-		auto sample = mpegts::Sample(media_packet, MergeTsPacketData(pes_packets), track->GetTimeBase().GetTimescale());
+		auto sample = mpegts::Sample(media_packet, pes_data, track->GetTimeBase().GetTimescale());
 
 		if (track_id == _main_track_id)
 		{
@@ -338,7 +314,7 @@ namespace mpegts
 		}
 
         // Add PSI packets
-        segment->AddPacketData(_psi_packet_data);
+        segment->AddPacketData(_psi_data);
 
         // Add Samples
         auto main_samples = main_sample_buffer->PopSamplesUntilSegmentBoundary();
@@ -439,7 +415,7 @@ namespace mpegts
 #if 0
         logti("AddSegment segment_id %u", segment->GetId());
         auto file_name = ov::String::FormatString("segment_%u.ts", segment->GetId());
-        ov::DumpToFile(file_name.CStr(), segment->GetData());
+        ov::DumpToFile(file_name.CStr(), segment->GetDataList());
 #endif 
 
 		AddSegmentToBuffer(segment);
@@ -518,7 +494,7 @@ namespace mpegts
 		}
 
 		// Save to file
-		if (ov::DumpToFile(file_path.CStr(), segment->GetData()) == nullptr)
+		if (ov::DumpToFile(file_path.CStr(), segment->GetDataList()) == nullptr)
 		{
 			logte("Failed to save segment to file: %s", file_path.CStr());
 			return;
@@ -587,6 +563,9 @@ namespace mpegts
 	void Packager::DeleteSegmentFile(const std::shared_ptr<Segment> &segment)
 	{
 		auto file_path = segment->GetFilePath();
+
+		ov::FileCache::GetInstance()->Remove(file_path);
+
 		if (ov::DeleteFile(file_path) == false)
 		{
 			logte("Failed to delete segment file: %s", file_path.CStr());
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <base/info/media_track.h>
+#include <base/ovlibrary/file_cache.h>
 #include <base/mediarouter/media_buffer.h>
 
 #include <modules/marker/marker_box.h>
@@ -17,8 +18,6 @@
 
 namespace mpegts
 {
-    constexpr size_t SEGMENT_BUFFER_SIZE = 2000000;
-
     class Segment
     {
     public:
@@ -29,14 +28,18 @@ namespace mpegts
             _duration_ms = duration_ms;
         }
 
+        // The data is referenced as is (PSI or the TS packets of a frame built by the packetizer), not copied
         bool AddPacketData(const std::shared_ptr<const ov::Data> &data)
         {
-            if (_data == nullptr)
-            {
-                _data = std::make_shared<ov::Data>(SEGMENT_BUFFER_SIZE);
-            }
+			if (data == nullptr)
+			{
+				return false;
+			}
+
+			std::lock_guard<std::shared_mutex> lock(_data_lock);
 
-            _data->Append(data);
+			_data_list.push_back(data);
+			_data_length += data->GetLength();
 
 			_is_data_in_memory = true;
 
@@ -87,8 +90,10 @@ namespace mpegts
 
 		void ResetData()
 		{
-			_data.reset();
-			_data = nullptr;
+			std::lock_guard<std::shared_mutex> lock(_data_lock);
+
+			_data_list.clear();
+			_data_length = 0;
 
 			_is_data_in_memory = false;
 		}
@@ -103,25 +108,37 @@ namespace mpegts
 			return _is_data_in_file;
 		}
 
-		std::shared_ptr<const ov::Data> GetData() const
+		// Get the slices that make up the segment data in order
+		std::vector<std::shared_ptr<const ov::Data>> GetDataList() const
 		{
-			if (_is_data_in_memory)
 			{
-				return _data;
+				std::shared_lock<std::shared_mutex> lock(_data_lock);
+
+				if (_is_data_in_memory)
+				{
+					return _data_list;
+				}
 			}
 
 			if (_is_data_in_file)
 			{
-				// Read from file
-				auto data = ov::LoadFromFile(_file_path);
+				// Read from file, the segments requested by many sessions (e.g. DVR) are shared in the cache
+				auto data = ov::FileCache::GetInstance()->Load(_file_path);
 				if (data == nullptr)
 				{
-					loge("MPEG-2 TS", "Segment::GetData - Failed to load data from file(%s)", _file_path.CStr());
+					loge("MPEG-2 TS", "Segment::GetDataList - Failed to load data from file(%s)", _file_path.CStr());
+					return {};
 				}
-				return data;
+				return {data};
 			}
 
-			return nullptr;
+			return {};
+		}
+
+		size_t GetDataLength() const
+		{
+			std::shared_lock<std::shared_mutex> lock(_data_lock);
+			return _data_length;
 		}
 
 		bool HasMarker() const
@@ -146,7 +163,10 @@ namespace mpegts
 		ov::String _url;
         
 		ov::String _file_path;
-        std::shared_ptr<ov::Data> _data;
+
+		mutable std::shared_mutex _data_lock;
+		std::vector<std::shared_ptr<const ov::Data>> _data_list;
+		size_t _data_length = 0;
 
 		bool _is_data_in_memory = false;
 		bool _is_data_in_file = false;
@@ -407,23 +427,20 @@ namespace mpegts
         ////////////////////////////////
 
         // PAT, PMT, ...
-        void OnPsi(const std::vector<std::shared_ptr<const MediaTrack>> &tracks, const std::vector<std::shared_ptr<mpegts::Packet>> &psi_packets) override;
+        void OnPsi(const std::vector<std::shared_ptr<const MediaTrack>> &tracks, const std::shared_ptr<const ov::Data> &psi_data) override;
         // PES packets for a frame
-        void OnFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::vector<std::shared_ptr<mpegts::Packet>> &pes_packets) override;
+        void OnFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::shared_ptr<const ov::Data> &pes_data) override;
 
 		void Flush();
 
 		// Get the segment data
 		std::shared_ptr<Segment> GetSegment(uint64_t segment_id) const;
-		std::shared_ptr<const ov::Data> GetSegmentData(uint64_t segment_id) const;
 
     private:
         const Config &GetConfig() const;
 
         uint64_t GetNextSegmentId();
 
-        std::shared_ptr<ov::Data> MergeTsPacketData(const std::vector<std::shared_ptr<mpegts::Packet>> &ts_packets);
-    
         std::shared_ptr<const MediaTrack> GetMediaTrack(uint32_t track_id) const;
         std::shared_ptr<SampleBuffer> GetSampleBuffer(uint32_t track_id) const;
 
@@ -468,8 +485,7 @@ namespace mpegts
 
         uint32_t _main_track_id = UINT32_MAX;
         std::map<uint32_t, std::shared_ptr<const MediaTrack>> _media_tracks;
-        std::vector<std::shared_ptr<mpegts::Packet>> _psi_packets;
-        std::shared_ptr<ov::Data> _psi_packet_data;
+        std::shared_ptr<const ov::Data> _psi_data;
 
         uint64_t _last_segment_id = 0;
 
@@ -211,6 +211,112 @@ namespace mpegts
 		return packets;
 	}
 
+	std::shared_ptr<ov::Data> Packet::BuildData(const std::shared_ptr<Pes> &pes, bool has_pcr, uint8_t continuity_counter, size_t *packet_count)
+	{
+		if (pes->GetData() == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto pes_data = pes->GetData()->GetDataAs<uint8_t>();
+		size_t pes_data_length = pes->GetData()->GetLength();
+		uint16_t pid = pes->PID();
+
+		// Every packet except the first and the last one carries (MPEGTS_MIN_PACKET_SIZE - MPEGTS_HEADER_SIZE) bytes of the PES
+		size_t max_packet_count = (pes_data_length / (MPEGTS_MIN_PACKET_SIZE - MPEGTS_HEADER_SIZE)) + 2;
+
+		auto data = std::make_shared<ov::Data>(max_packet_count * MPEGTS_MIN_PACKET_SIZE);
+		data->SetLength(max_packet_count * MPEGTS_MIN_PACKET_SIZE);
+		auto buffer = data->GetWritableDataAs<uint8_t>();
+
+		size_t offset = 0;
+		size_t count = 0;
+		bool first_packet = true;
+
+		// Same layout as Build(), but the packets are written directly into one contiguous buffer
+		while (offset < pes_data_length)
+		{
+			size_t remaining_pes_bytes = pes_data_length - offset;
+			size_t payload_buffer_size = MPEGTS_MIN_PACKET_SIZE - MPEGTS_HEADER_SIZE;
+			bool has_adaptation_field = false;
+
+			if (has_pcr)
+			{
+				has_adaptation_field = true;
+				payload_buffer_size -= 8;  // Adaptation field(2) + PCR(6)
+			}
+			else if (first_packet)
+			{
+				has_adaptation_field = true;
+				payload_buffer_size -= 2;  // Adaptation field(2)
+			}
+
+			if ((remaining_pes_bytes < payload_buffer_size) && (has_adaptation_field == false))
+			{
+				// the last packet needs adaptation field
+				has_adaptation_field = true;
+				payload_buffer_size -= 2;
+			}
+
+			size_t payload_size = std::min(payload_buffer_size, remaining_pes_bytes);
+			uint8_t adaptation_field_control = has_adaptation_field ? 0b11 : 0b01;
+
+			auto packet = buffer + (count * MPEGTS_MIN_PACKET_SIZE);
+
+			// Header
+			packet[0] = 0x47;
+			packet[1] = (first_packet ? 0x40 : 0x00) | ((pid >> 8) & 0x1F);
+			packet[2] = pid & 0xFF;
+			packet[3] = (adaptation_field_control << 4) | ((continuity_counter + count) % 16);
+
+			auto current = packet + MPEGTS_HEADER_SIZE;
+
+			if (has_adaptation_field)
+			{
+				size_t stuffing_bytes = payload_buffer_size - payload_size;
+
+				*current++ = 1 + (has_pcr ? 6 : 0) + stuffing_bytes;
+				// random_access_indicator(0x40), PCR_flag(0x10)
+				*current++ = 0x40 | (has_pcr ? 0x10 : 0x00);
+
+				if (has_pcr)
+				{
+					// base(33) + reserved(6) + extension(9)
+					uint64_t pcr_base = (pes->Pcr() / 300) & 0x1FFFFFFFF;
+					uint32_t pcr_ext = (pes->Pcr() % 300) & 0x1FF;
+
+					*current++ = (pcr_base >> 25) & 0xFF;
+					*current++ = (pcr_base >> 17) & 0xFF;
+					*current++ = (pcr_base >> 9) & 0xFF;
+					*current++ = (pcr_base >> 1) & 0xFF;
+					*current++ = ((pcr_base & 0x01) << 7) | 0x7E | ((pcr_ext >> 8) & 0x01);
+					*current++ = pcr_ext & 0xFF;
+				}
+
+				::memset(current, 0xFF, stuffing_bytes);
+				current += stuffing_bytes;
+			}
+
+			::memcpy(current, pes_data + offset, payload_size);
+
+			offset += payload_size;
+			count++;
+
+			// just set the pcr to the first packet
+			has_pcr = false;
+			first_packet = false;
+		}
+
+		data->SetLength(count * MPEGTS_MIN_PACKET_SIZE);
+
+		if (packet_count != nullptr)
+		{
+			*packet_count = count;
+		}
+
+		return data;
+	}
+
 	void Packet::UpdateData()
 	{
 		// Make data
@@ -167,6 +167,9 @@ namespace mpegts
 
 		static std::shared_ptr<Packet> Build(const std::shared_ptr<Section> &section, uint8_t continuity_counter);
 		static std::vector<std::shared_ptr<Packet>> Build(const std::shared_ptr<Pes> &pes, bool has_pcr, uint8_t continuity_counter);
+		// Writes the packets of the PES into one contiguous buffer (MPEGTS_MIN_PACKET_SIZE * packet_count bytes)
+		// instead of creating a Packet for each 188 bytes. The result is the same as concatenating the data of Build().
+		static std::shared_ptr<ov::Data> BuildData(const std::shared_ptr<Pes> &pes, bool has_pcr, uint8_t continuity_counter, size_t *packet_count);
 
 		// Getter
 		uint8_t SyncByte();
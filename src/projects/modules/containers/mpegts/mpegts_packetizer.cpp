@@ -108,6 +108,10 @@ namespace mpegts
             return false;
         }
 
+        _psi_data = std::make_shared<ov::Data>(_pat_packet->GetDataLength() + _pmt_packet->GetDataLength());
+        _psi_data->Append(_pat_packet->GetData());
+        _psi_data->Append(_pmt_packet->GetData());
+
 #if 0
         // Debug
         logtd("PAT : %s", _pat_packet->GetData()->ToHexString().CStr());
@@ -171,8 +175,9 @@ namespace mpegts
 
         auto continuity_counter = GetNextContinuityCounter(pid);
         bool has_pcr = (pid == _pmt._pcr_pid);
-        auto packets = Packet::Build(pes, has_pcr, continuity_counter);
-        if (packets.empty())
+        size_t packet_count = 0;
+        auto pes_data = Packet::BuildData(pes, has_pcr, continuity_counter, &packet_count);
+        if (pes_data == nullptr || packet_count == 0)
         {
             return false;
         }
@@ -181,15 +186,12 @@ namespace mpegts
         // debug print
         logtd("------------------------------------------------------------------------");
         logtd("Track(%u) / MediaPacket(%u)", media_packet->GetTrackId(), media_packet->GetDataLength());
-        for (const auto &packet : packets)
-        {
-            logtd("%s", packet->ToDebugString().CStr());
-        }
+        logtd("%s", pes_data->Dump().CStr());
 #endif
 
-        IncreaseContinuityCounter(pid, static_cast<uint8_t>(packets.size() - 1));
+        IncreaseContinuityCounter(pid, static_cast<uint8_t>(packet_count - 1));
 
-        BroadcastFrame(media_packet, packets);
+        BroadcastFrame(media_packet, pes_data);
 
         return true;
     }
@@ -420,15 +422,15 @@ namespace mpegts
 
         for (const auto &sink : _sinks)
         {
-            sink->OnPsi(tracks, {_pat_packet, _pmt_packet});
+            sink->OnPsi(tracks, _psi_data);
         }
     }
 
-    void Packetizer::BroadcastFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::vector<std::shared_ptr<mpegts::Packet>> &pes_packets)
+    void Packetizer::BroadcastFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::shared_ptr<const ov::Data> &pes_data)
     {
         for (const auto &sink : _sinks)
         {
-            sink->OnFrame(media_packet, pes_packets);
+            sink->OnFrame(media_packet, pes_data);
         }
     }
 }
\ No newline at end of file
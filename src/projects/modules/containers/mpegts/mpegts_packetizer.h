@@ -22,10 +22,11 @@ namespace mpegts
     {
     public:
         virtual ~PacketizerSink() = default;
-        // PAT, PMT, ...
-        virtual void OnPsi(const std::vector<std::shared_ptr<const MediaTrack>> &tracks, const std::vector<std::shared_ptr<mpegts::Packet>> &psi_packets) = 0;
-        // PES packets for a frame
-        virtual void OnFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::vector<std::shared_ptr<mpegts::Packet>> &pes_packets) = 0;
+        // PAT, PMT, ... (188 bytes aligned)
+        virtual void OnPsi(const std::vector<std::shared_ptr<const MediaTrack>> &tracks, const std::shared_ptr<const ov::Data> &psi_data) = 0;
+        // PES packets for a frame in one contiguous buffer (188 bytes aligned)
+        // Sinks may keep references to slices of pes_data instead of copying it, so it must not be modified
+        virtual void OnFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::shared_ptr<const ov::Data> &pes_data) = 0;
     };
 
     // PAT, PMT, PES, PES, PES, ...
@@ -73,7 +74,7 @@ namespace mpegts
         std::shared_ptr<const MediaTrack> GetMediaTrack(uint32_t track_id) const;
 
         void BroadcastPsi();
-        void BroadcastFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::vector<std::shared_ptr<mpegts::Packet>> &pes_packets);
+        void BroadcastFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::shared_ptr<const ov::Data> &pes_data);
 
         Config _config;
         bool _started = false;
@@ -92,6 +93,8 @@ namespace mpegts
         // PMT
         PMT _pmt;
         std::shared_ptr<mpegts::Packet> _pmt_packet;
+        // PAT + PMT, built once at Start()
+        std::shared_ptr<ov::Data> _psi_data;
 
         // PID
         // track id : pid
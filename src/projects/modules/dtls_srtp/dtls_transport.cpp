@@ -118,6 +118,11 @@ bool DtlsTransport::StartDTLS()
 	return true;
 }
 
+bool DtlsTransport::IsConnected() const
+{
+	return (_state == SSL_CONNECTED) && _peer_certificate_verified;
+}
+
 bool DtlsTransport::ContinueSSL()
 {
 	logtd("Continue DTLS...");
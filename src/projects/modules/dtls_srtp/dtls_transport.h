@@ -27,6 +27,8 @@ public:
 
 	// Start DTLS
 	bool StartDTLS();
+	// The handshake is completed and the SRTP keys are ready
+	bool IsConnected() const;
 
 	bool Stop() override;
 	//--------------------------------------------------------------------
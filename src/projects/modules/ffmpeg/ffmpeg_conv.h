@@ -578,7 +578,7 @@ namespace ffmpeg
 
 		static std::shared_ptr<MediaPacket> ToMediaPacket(AVPacket* src, cmn::MediaType media_type, cmn::BitstreamFormat format, cmn::PacketType packet_type)
 		{
-			auto packet_buffer = std::make_shared<MediaPacket>(
+			auto packet_buffer = ov::MakePooledShared<MediaPacket>(
 				0,
 				media_type,
 				0,
@@ -602,7 +602,7 @@ namespace ffmpeg
 
 		static std::shared_ptr<MediaPacket> ToMediaPacket(uint32_t msid, int32_t track_id, AVPacket* src, cmn::MediaType media_type, cmn::BitstreamFormat format, cmn::PacketType packet_type)
 		{
-			auto packet_buffer = std::make_shared<MediaPacket>(
+			auto packet_buffer = ov::MakePooledShared<MediaPacket>(
 				msid,
 				media_type,
 				track_id,
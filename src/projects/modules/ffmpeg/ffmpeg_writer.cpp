@@ -286,7 +286,9 @@ namespace ffmpeg
 					// Do nothing
 					break;
 				case cmn::BitstreamFormat::H264_ANNEXB: {
-					new_data = NalStreamConverter::ConvertAnnexbToXvcc(packet->GetData(), packet->GetFragHeader());
+					new_data = packet->GetConvertedData(cmn::BitstreamFormat::H264_AVCC, [&packet]() -> std::shared_ptr<const ov::Data> {
+						return NalStreamConverter::ConvertAnnexbToXvcc(packet->GetData(), packet->GetFragHeader());
+					});
 					if (new_data == nullptr)
 					{
 						logtw("Failed to convert annexb to avcc");
@@ -299,7 +301,9 @@ namespace ffmpeg
 				case cmn::BitstreamFormat::AAC_RAW:
 					break;
 				case cmn::BitstreamFormat::AAC_ADTS: {
-					new_data = AacConverter::ConvertAdtsToRaw(packet->GetData(), nullptr);
+					new_data = packet->GetConvertedData(cmn::BitstreamFormat::AAC_RAW, [&packet]() -> std::shared_ptr<const ov::Data> {
+						return AacConverter::ConvertAdtsToRaw(packet->GetData(), nullptr);
+					});
 					if (new_data == nullptr)
 					{
 						logtw("Failed to convert adts to raw");
@@ -324,7 +328,9 @@ namespace ffmpeg
 				case cmn::BitstreamFormat::HVCC:
 					break;
 				case cmn::BitstreamFormat::H265_ANNEXB: {
-					new_data = NalStreamConverter::ConvertAnnexbToXvcc(packet->GetData(), packet->GetFragHeader());
+					new_data = packet->GetConvertedData(cmn::BitstreamFormat::HVCC, [&packet]() -> std::shared_ptr<const ov::Data> {
+						return NalStreamConverter::ConvertAnnexbToXvcc(packet->GetData(), packet->GetFragHeader());
+					});
 					if (new_data == nullptr)
 					{
 						logtw("Failed to convert annexb to avcc");
@@ -337,7 +343,9 @@ namespace ffmpeg
 				case cmn::BitstreamFormat::H264_AVCC:
 					break;
 				case cmn::BitstreamFormat::H264_ANNEXB: {
-					new_data = NalStreamConverter::ConvertAnnexbToXvcc(packet->GetData(), packet->GetFragHeader());
+					new_data = packet->GetConvertedData(cmn::BitstreamFormat::H264_AVCC, [&packet]() -> std::shared_ptr<const ov::Data> {
+						return NalStreamConverter::ConvertAnnexbToXvcc(packet->GetData(), packet->GetFragHeader());
+					});
 					if (new_data == nullptr)
 					{
 						logtw("Failed to convert annexb to avcc");
@@ -351,7 +359,9 @@ namespace ffmpeg
 				case cmn::BitstreamFormat::OPUS:
 					break;
 				case cmn::BitstreamFormat::AAC_ADTS: {
-					new_data = AacConverter::ConvertAdtsToRaw(packet->GetData(), nullptr);
+					new_data = packet->GetConvertedData(cmn::BitstreamFormat::AAC_RAW, [&packet]() -> std::shared_ptr<const ov::Data> {
+						return AacConverter::ConvertAdtsToRaw(packet->GetData(), nullptr);
+					});
 					if (new_data == nullptr)
 					{
 						logtw("Failed to convert adts to raw");
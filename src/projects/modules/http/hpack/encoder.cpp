@@ -10,6 +10,9 @@
 #include "huffman_codec.h"
 #include "hpack_private.h"
 
+// Responses of a connection repeat a small set of header fields (content-type, cache-control, CORS, ...)
+#define MAX_CACHED_HEADER_FIELDS 256
+
 namespace http
 {
 	namespace hpack
@@ -22,11 +25,27 @@ namespace http
 			}
 
 			_need_signal_table_size_update = true;
+			_table_version++;
 			return true;
 		}
 
 		std::shared_ptr<ov::Data> Encoder::Encode(const HeaderField &header_fields, EncodingType type)
 		{
+			// The dynamic table size update must be signaled at the beginning of the next header block
+			bool cacheable = (_need_signal_table_size_update == false);
+			auto key = header_fields.ToString();
+
+			if (cacheable)
+			{
+				auto cached_data = GetCachedHeaderField(key, type);
+				if (cached_data != nullptr)
+				{
+					return cached_data;
+				}
+			}
+
+			auto table_version = _table_version;
+
 			std::shared_ptr<ov::Data> encoded_data = std::make_shared<ov::Data>(header_fields.GetSize());
 			ov::ByteStream stream(encoded_data.get());
 
@@ -74,9 +93,45 @@ namespace http
 				return nullptr;
 			}
 
+			if (cacheable && (table_version == _table_version))
+			{
+				CacheHeaderField(key, type, encoded_data);
+			}
+
 			return encoded_data;
 		}
 
+		std::shared_ptr<ov::Data> Encoder::GetCachedHeaderField(const ov::String &key, EncodingType type)
+		{
+			std::lock_guard<std::mutex> lock(_cached_header_fields_lock);
+
+			auto item = _cached_header_fields.find(key);
+			if (item == _cached_header_fields.end())
+			{
+				return nullptr;
+			}
+
+			const auto &cached = item->second;
+			if ((cached.table_version != _table_version) || (cached.type != type))
+			{
+				return nullptr;
+			}
+
+			return cached.encoded_data;
+		}
+
+		void Encoder::CacheHeaderField(const ov::String &key, EncodingType type, const std::shared_ptr<ov::Data> &encoded_data)
+		{
+			std::lock_guard<std::mutex> lock(_cached_header_fields_lock);
+
+			if ((_cached_header_fields.size() >= MAX_CACHED_HEADER_FIELDS) && (_cached_header_fields.find(key) == _cached_header_fields.end()))
+			{
+				_cached_header_fields.clear();
+			}
+
+			_cached_header_fields[key] = {_table_version, type, encoded_data};
+		}
+
 		bool Encoder::EncodeIndexedHeaderField(ov::ByteStream &stream, const HeaderField &header_fields, uint32_t index)
 		{
 			return WriteInteger(stream, 0x80, 7, index);
@@ -92,6 +147,7 @@ namespace http
 			//TODO(h2) : Check the table size
 
 			_table_connector.Index(header_fields);
+			_table_version++;
 
 			return true;
 		}
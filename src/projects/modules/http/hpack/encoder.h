@@ -46,8 +46,28 @@ namespace http
 			// Unsigned Little Endian Base 128
 			bool WriteULEB128(ov::ByteStream &stream, const uint64_t &value);
 
+			// Encoded header fields that did not change the dynamic table (indexed, or literal without indexing).
+			// Since the index of a dynamic table entry changes whenever an entry is inserted or evicted,
+			// they are only reused while _table_version is the same.
+			struct CachedHeaderField
+			{
+				uint64_t table_version = 0;
+				EncodingType type = EncodingType::LiteralWithIndexing;
+				std::shared_ptr<ov::Data> encoded_data;
+			};
+
+			std::shared_ptr<ov::Data> GetCachedHeaderField(const ov::String &key, EncodingType type);
+			void CacheHeaderField(const ov::String &key, EncodingType type, const std::shared_ptr<ov::Data> &encoded_data);
+
 			TableConnector	_table_connector;
 			bool _need_signal_table_size_update = false;
+
+			// Increased whenever the dynamic table is changed
+			uint64_t _table_version = 0;
+
+			std::mutex _cached_header_fields_lock;
+			// HeaderField::ToString() : CachedHeaderField
+			std::unordered_map<ov::String, CachedHeaderField> _cached_header_fields;
 		};
 	} // namespace hpack
 } // namespace http
\ No newline at end of file
@@ -7,7 +7,6 @@
 //
 //==============================================================================
 
-#include <base/ovlibrary/bit_reader.h>
 #include "huffman_codec.h"
 
 namespace http
@@ -274,11 +273,14 @@ namespace http
 			Build(0x7fffff0, 27, 254);
 			Build(0x3ffffee, 26, 255);
 			Build(0x3fffffff, 30, 256); //EOS
+
+			BuildDecodeTable();
 		}
 
 		std::shared_ptr<ov::Data> HuffmanCodec::Encode(const ov::String &str)
 		{
-			uint8_t out_data[str.GetLength() * 2];
+			// The longest code is 30 bits
+			uint8_t out_data[str.GetLength() * 4];
 			size_t out_data_size = 0;
 
 			uint64_t bit_buffer = 0;
@@ -328,59 +330,119 @@ namespace http
 
 		bool HuffmanCodec::Decode(const std::shared_ptr<const ov::Data> &data, ov::String &str)
 		{
-			auto reader = std::make_shared<BitReader>(data->GetDataAs<uint8_t>(), data->GetLength());
-			auto node = _tree;
+			auto bytes = data->GetDataAs<uint8_t>();
+			auto length = data->GetLength();
+
+			// The shortest code is 5 bits
+			str.SetCapacity(str.GetLength() + (length * 8 / 5) + 1);
 
-			while (reader->BytesRemained() > 0)
+			uint8_t state = 0;
+			bool acceptable = true;
+
+			for (size_t i = 0; i < length; i++)
 			{
-				auto b = reader->ReadBit();
-				if (b == 1)
+				for (auto nibble : {static_cast<uint8_t>(bytes[i] >> 4), static_cast<uint8_t>(bytes[i] & 0x0F)})
 				{
-					node = node->GetRight();
-					if (node == nullptr)
+					const auto &entry = _decode_table[state][nibble];
+
+					if (entry.flags & DecodeFlagFail)
 					{
 						return false;
 					}
+
+					if (entry.flags & DecodeFlagEmit)
+					{
+						str.Append(static_cast<char>(entry.symbol));
+					}
+
+					state = entry.next_state;
+					acceptable = (entry.flags & DecodeFlagAccept);
 				}
-				else
+			}
+
+			// https://www.rfc-editor.org/rfc/rfc7541.html#section-5.2
+			// A padding strictly longer than 7 bits MUST be treated as a decoding
+			// error.  A padding not corresponding to the most significant bits of
+			// the code for the EOS symbol MUST be treated as a decoding error.
+			return acceptable;
+		}
+
+		void HuffmanCodec::BuildDecodeTable()
+		{
+			// Assign a state to each internal node in BFS order
+			std::vector<Node *> states;
+			// Whether the path from the root to the node can be the padding (the MSBs of EOS, up to 7 bits)
+			std::vector<bool> acceptable_states;
+			std::vector<uint8_t> depths;
+
+			states.push_back(_tree);
+			acceptable_states.push_back(true);
+			depths.push_back(0);
+			_tree->SetState(0);
+
+			for (size_t index = 0; index < states.size(); index++)
+			{
+				auto node = states[index];
+
+				for (auto child : {node->GetLeft(), node->GetRight()})
 				{
-					node = node->GetLeft();
-					if (node == nullptr)
+					if ((child == nullptr) || child->IsLeaf())
 					{
-						return false;
+						continue;
 					}
+
+					OV_ASSERT2(states.size() < 256);
+
+					child->SetState(static_cast<uint8_t>(states.size()));
+					states.push_back(child);
+					// Only the right(1) path keeps the bits all ones
+					acceptable_states.push_back(acceptable_states[index] && (child == node->GetRight()) && (depths[index] < 7));
+					depths.push_back(depths[index] + 1);
 				}
+			}
 
-				if (node->IsLeaf())
+			for (size_t state = 0; state < states.size(); state++)
+			{
+				for (uint8_t nibble = 0; nibble < 16; nibble++)
 				{
-					if (node->GetValue() == 256)
+					auto &entry = _decode_table[state][nibble];
+					auto node = states[state];
+
+					for (int shift = 3; shift >= 0; shift--)
 					{
-						// EOS
-						return false;
+						node = ((nibble >> shift) & 0x01) ? node->GetRight() : node->GetLeft();
+
+						if ((node == nullptr) || (node->IsLeaf() && (node->GetValue() == 256)))
+						{
+							entry.flags = DecodeFlagFail;
+							break;
+						}
+
+						if (node->IsLeaf())
+						{
+							entry.symbol = static_cast<uint8_t>(node->GetValue());
+							entry.flags |= DecodeFlagEmit;
+							node = _tree;
+						}
 					}
 
-					str.Append(static_cast<uint8_t>(node->GetValue()));
-					node = _tree;
+					if (entry.flags & DecodeFlagFail)
+					{
+						continue;
+					}
 
-					// https://www.rfc-editor.org/rfc/rfc7541.html#section-5.2
-					// As the Huffman-encoded data doesn't always end at an octet boundary,
-					// some padding is inserted after it, up to the next octet boundary.  To
-					// prevent this padding from being misinterpreted as part of the string
-					// literal, the most significant bits of the code corresponding to the
-					// EOS (end-of-string) symbol are used.
+					entry.next_state = node->GetState();
 
-					// So, the symbol (1111111) corresponding to EOS may be included in the 
-					// last 7 bits or less. In this case, no processing is done because it will 
-					// terminate without reaching the leaf naturally.
+					if (acceptable_states[entry.next_state])
+					{
+						entry.flags |= DecodeFlagAccept;
+					}
 				}
 			}
-
-			return true;
 		}
 
 		void HuffmanCodec::BuildTree(uint32_t code, uint8_t length, uint16_t symbol)
 		{
-			//TODO(Getroot): If needed, apply faster algorithm
 			auto node = _tree;
 
 			for (uint16_t i = 0; i < length; i++)
@@ -29,6 +29,8 @@ namespace http
 			void BuildMap(uint32_t code, uint8_t length, uint16_t symbol);
 			// Build Tree for decoding from code to symbol
 			void BuildTree(uint32_t code, uint8_t length, uint16_t symbol);
+			// Build the state table for decoding 4 bits at a time from the tree
+			void BuildDecodeTable();
 
 			class Node
 			{
@@ -68,17 +70,51 @@ namespace http
 				{
 					return _is_leaf;
 				}
+
+				// Index of the internal node in the decode table
+				void SetState(uint8_t state)
+				{
+					_state = state;
+				}
+
+				uint8_t GetState()
+				{
+					return _state;
+				}
 				
 			private:
 				Node* _left = nullptr;
 				Node* _right = nullptr;
 				uint16_t _value = 0;
 				bool _is_leaf = false;
+				uint8_t _state = 0;
+			};
+
+			// A state is an internal node of the tree (257 symbols make 256 internal nodes),
+			// and each entry tells where the next 4 bits lead from that state.
+			// Since the shortest code is 5 bits, at most one symbol is emitted per 4 bits.
+			enum DecodeFlag : uint8_t
+			{
+				// symbol is decoded
+				DecodeFlagEmit = 0x01,
+				// The input can end in the next state (the bits read so far are the padding)
+				DecodeFlagAccept = 0x02,
+				// EOS is decoded or the code is invalid
+				DecodeFlagFail = 0x04,
+			};
+
+			struct DecodeEntry
+			{
+				uint8_t next_state = 0;
+				uint8_t flags = 0;
+				uint8_t symbol = 0;
 			};
 
 			// 
 			Node* _tree = new Node();
-			std::unordered_map<uint8_t, std::pair<uint32_t, uint8_t>> _map;
+			// symbol(0~256, EOS) : (code, length)
+			std::array<std::pair<uint32_t, uint8_t>, 257> _map;
+			DecodeEntry _decode_table[256][16];
 		};
 	}
 }
\ No newline at end of file
@@ -55,6 +55,12 @@ namespace http
 				return _chunked_transfer;
 			}
 
+			bool Http1Response::IsFileSendable() const
+			{
+				// The chunk headers are sent between the data, so the files are read into the chunks
+				return (_chunked_transfer == false) && IsPayloadSentAsIs();
+			}
+
 			int32_t Http1Response::SendHeader()
 			{
 				std::shared_ptr<ov::Data> response = std::make_shared<ov::Data>(65535);
@@ -109,33 +115,42 @@ namespace http
 				logtd("Trying to send datas...");
 
 				uint32_t sent_bytes = 0;
+
+				// The files cannot be sent using sendfile() if it is changed to chunked transfer after AppendFile()
+				if ((GetResponseFileList().empty() == false) && (IsFileSendable() == false) && (LoadResponseFiles() == false))
+				{
+					return -1;
+				}
+
+				if (_chunked_transfer == false)
+				{
+					// The response data (e.g. the chunks of a segment) are sent together without being merged
+					if (SendDataAndFiles() == false)
+					{
+						logte("Could not send data : %zu bytes", GetResponseDataSize());
+						return -1;
+					}
+
+					sent_bytes = GetResponseDataSize();
+
+					ResetResponseData();
+
+					logtd("All datas are sent...");
+
+					return sent_bytes;
+				}
+
 				for (const auto &data : GetResponseDataList())
 				{
-					if (_chunked_transfer)
+					sent &= SendChunkedData(data);
+					if (sent == true)
 					{
-						sent &= SendChunkedData(data);
-						if (sent == true)
-						{
-							sent_bytes += data->GetLength();
-						}
-						else
-						{
-							logte("Could not send chunked data : %d bytes", data->GetLength());
-							return -1;
-						}
+						sent_bytes += data->GetLength();
 					}
 					else
 					{
-						sent &= Send(data);
-						if (sent == true)
-						{
-							sent_bytes += data->GetLength();
-						}
-						else
-						{
-							logte("Could not send data : %d bytes", data->GetLength());
-							return -1;
-						}
+						logte("Could not send chunked data : %d bytes", data->GetLength());
+						return -1;
 					}
 				}
 
@@ -145,6 +160,39 @@ namespace http
 
 				return sent_bytes;
 			}
+
+			bool Http1Response::SendDataAndFiles()
+			{
+				const auto &data_list = GetResponseDataList();
+				size_t data_index = 0;
+
+				for (const auto &response_file : GetResponseFileList())
+				{
+					if (response_file.data_index > data_index)
+					{
+						// The data appended before the file
+						if (Send(std::vector<std::shared_ptr<const ov::Data>>(data_list.begin() + data_index, data_list.begin() + response_file.data_index)) == false)
+						{
+							return false;
+						}
+
+						data_index = response_file.data_index;
+					}
+
+					if (SendFile(response_file.file) == false)
+					{
+						logte("Could not send file : %s", response_file.file->GetPath().CStr());
+						return false;
+					}
+				}
+
+				if (data_index == 0)
+				{
+					return Send(data_list);
+				}
+
+				return Send(std::vector<std::shared_ptr<const ov::Data>>(data_list.begin() + data_index, data_list.end()));
+			}
 		} // namespace h1
 	} // namespace svr
 } // namespace http
\ No newline at end of file
@@ -29,10 +29,16 @@ namespace http
 				bool SendChunkedData(const std::shared_ptr<const ov::Data> &data);
 				bool IsChunkedTransfer() const;
 
+			protected:
+				bool IsFileSendable() const override;
+
 			private:
 				int32_t SendHeader() override;
 				int32_t SendPayload() override;
 
+				// Sends the response data and the files in order
+				bool SendDataAndFiles();
+
 				bool _chunked_transfer = false;
 			};
 		}
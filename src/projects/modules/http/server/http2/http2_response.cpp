@@ -45,6 +45,16 @@ namespace http
 				return Send(frame);
 			}
 
+			bool Http2Response::IsVolatileHeader(const ov::String &lower_name)
+			{
+				return (lower_name == "etag") ||
+					   (lower_name == "date") ||
+					   (lower_name == "last-modified") ||
+					   (lower_name == "content-length") ||
+					   (lower_name == "content-range") ||
+					   (lower_name == "age");
+			}
+
 			int32_t Http2Response::SendHeader()
 			{
 				std::shared_ptr<ov::Data> header_block = std::make_shared<ov::Data>(65535);
@@ -60,7 +70,13 @@ namespace http
 					{
 						// https://httpwg.org/http2-spec/draft-ietf-httpbis-http2bis.html#section-8.2
 						// Field names MUST be converted to lowercase when constructing an HTTP/2 message.
-						auto header_field = _hpack_encoder->Encode({name.LowerCaseString(), value}, hpack::Encoder::EncodingType::LiteralWithIndexing);
+						auto lower_name = name.LowerCaseString();
+
+						// Values that differ in every response are not indexed, so they don't evict the repeated fields
+						// from the dynamic table (and the encoded fields cached by the encoder stay valid)
+						auto encoding_type = IsVolatileHeader(lower_name) ? hpack::Encoder::EncodingType::LiteralWithoutIndexing : hpack::Encoder::EncodingType::LiteralWithIndexing;
+
+						auto header_field = _hpack_encoder->Encode({lower_name, value}, encoding_type);
 						header_block->Append(header_field);
 					}
 				}
@@ -38,6 +38,8 @@ namespace http
 				using HttpResponse::Send;
 
 			private:
+				static bool IsVolatileHeader(const ov::String &lower_name);
+
 				int32_t SendHeader() override;
 				int32_t SendPayload() override;
 
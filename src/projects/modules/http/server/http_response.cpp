@@ -8,6 +8,7 @@
 //==============================================================================
 #include "http_response.h"
 
+#include <base/ovlibrary/file_cache.h>
 #include <base/ovsocket/ovsocket.h>
 
 #include <algorithm>
@@ -43,6 +44,7 @@ namespace http
 			_is_header_sent = http_response->_is_header_sent;
 			_response_header = http_response->_response_header;
 			_response_data_list = http_response->_response_data_list;
+			_response_file_list = http_response->_response_file_list;
 			_response_data_size = http_response->_response_data_size;
 			_default_value = http_response->_default_value;
 			_created_time = http_response->_created_time;
@@ -187,24 +189,34 @@ namespace http
 				return false;
 			}
 
+			return AppendDataInternal(data->Clone());
+		}
+
+		bool HttpResponse::AppendDataInternal(const std::shared_ptr<const ov::Data> &data)
+		{
 			std::lock_guard<decltype(_response_mutex)> lock(_response_mutex);
 
-			auto cloned_data = data->Clone();
+			_response_data_list.push_back(data);
+			_response_data_size += data->GetLength();
 
-			_response_data_list.push_back(cloned_data);
-			_response_data_size += cloned_data->GetLength();
+			UpdateResponseHash(data);
 
+			return true;
+		}
+
+		void HttpResponse::UpdateResponseHash(const std::shared_ptr<const ov::Data> &data)
+		{
 			if (_etag_enabled_by_config == false)
 			{
-				return true;
+				return;
 			}
 
-			auto md5 = ov::MessageDigest::ComputeDigest(ov::CryptoAlgorithm::Md5, cloned_data);
+			auto md5 = ov::MessageDigest::ComputeDigest(ov::CryptoAlgorithm::Md5, data);
 			if (md5 == nullptr || md5->GetLength() != 16)
 			{
 				// Could not compute MD5
 				OV_ASSERT2(md5->GetLength() == 16);
-				return true;
+				return;
 			}
 
 			if (_response_hash == nullptr)
@@ -220,8 +232,6 @@ namespace http
 					ptr[i] ^= md5->At(i);
 				}
 			}
-
-			return true;
 		}
 
 		bool HttpResponse::AppendString(const ov::String &string)
@@ -231,8 +241,36 @@ namespace http
 
 		bool HttpResponse::AppendFile(const ov::String &filename)
 		{
-			OV_ASSERT(false, "Not implemented");
-			return false;
+			std::lock_guard<decltype(_response_mutex)> lock(_response_mutex);
+
+			if (IsFileSendable() == false)
+			{
+				// The cached data is shared with the other sessions without being copied
+				auto data = ov::FileCache::GetInstance()->Load(filename);
+				if (data == nullptr)
+				{
+					logte("Could not read file: %s", filename.CStr());
+					return false;
+				}
+
+				return AppendDataInternal(data);
+			}
+
+			auto file = ov::ReadOnlyFile::Open(filename);
+			if (file == nullptr)
+			{
+				logte("Could not open file: %s", filename.CStr());
+				return false;
+			}
+
+			_response_file_list.push_back({file, _response_data_list.size()});
+			_response_data_size += file->GetSize();
+
+			// The file is not read, so the ETag is computed from its path, size and modified time
+			auto &modified_time = file->GetModifiedTime();
+			UpdateResponseHash(ov::String::FormatString("%s:%zu:%ld.%09ld", filename.CStr(), file->GetSize(), modified_time.tv_sec, modified_time.tv_nsec).ToData(false));
+
+			return true;
 		}
 
 		bool HttpResponse::IsHeaderSent() const
@@ -240,6 +278,16 @@ namespace http
 			return _is_header_sent;
 		}
 
+		bool HttpResponse::IsFileSendable() const
+		{
+			return false;
+		}
+
+		bool HttpResponse::IsPayloadSentAsIs() const
+		{
+			return (_tls_data == nullptr) || _tls_data->IsKtlsSendEnabled();
+		}
+
 		// Get Response Data Size
 		size_t HttpResponse::GetResponseDataSize() const
 		{
@@ -261,9 +309,37 @@ namespace http
 		void HttpResponse::ResetResponseData()
 		{
 			_response_data_list.clear();
+			_response_file_list.clear();
 			_response_data_size = 0ULL;
 		}
 
+		const std::vector<HttpResponse::ResponseFile> &HttpResponse::GetResponseFileList() const
+		{
+			return _response_file_list;
+		}
+
+		bool HttpResponse::LoadResponseFiles()
+		{
+			std::lock_guard<decltype(_response_mutex)> lock(_response_mutex);
+
+			// Inserted from the last one, so the data indices of the others are not changed
+			for (auto response_file = _response_file_list.rbegin(); response_file != _response_file_list.rend(); ++response_file)
+			{
+				auto data = ov::FileCache::GetInstance()->Load(response_file->file->GetPath());
+				if ((data == nullptr) || (data->GetLength() != response_file->file->GetSize()))
+				{
+					logte("Could not read file: %s", response_file->file->GetPath().CStr());
+					return false;
+				}
+
+				_response_data_list.insert(_response_data_list.begin() + response_file->data_index, data);
+			}
+
+			_response_file_list.clear();
+
+			return true;
+		}
+
 		// Get Created Time
 		std::chrono::system_clock::time_point HttpResponse::GetCreatedTime() const
 		{
@@ -379,8 +455,9 @@ namespace http
 
 			std::shared_ptr<const ov::Data> send_data;
 
-			if (_tls_data == nullptr)
+			if ((_tls_data == nullptr) || _tls_data->IsKtlsSendEnabled())
 			{
+				// The kernel encrypts the data if kTLS is enabled
 				send_data = data->Clone();
 			}
 			else
@@ -401,6 +478,36 @@ namespace http
 			return _client_socket->Send(send_data);
 		}
 
+		bool HttpResponse::Send(const std::vector<std::shared_ptr<const ov::Data>> &data_list)
+		{
+			if ((_tls_data != nullptr) && (_tls_data->IsKtlsSendEnabled() == false))
+			{
+				// Each data is encrypted into TLS records
+				for (const auto &data : data_list)
+				{
+					if (Send(data) == false)
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			return _client_socket->Send(data_list);
+		}
+
+		bool HttpResponse::SendFile(const std::shared_ptr<const ov::ReadOnlyFile> &file)
+		{
+			if (IsPayloadSentAsIs() == false)
+			{
+				OV_ASSERT(false, "The file cannot be sent using sendfile() - the data must be encrypted in userspace");
+				return false;
+			}
+
+			return _client_socket->SendFile(file, 0, file->GetSize());
+		}
+
 		bool HttpResponse::Close()
 		{
 			OV_ASSERT2(_client_socket != nullptr);
@@ -56,6 +56,8 @@ namespace http
 			// Can be used for response with content-length
 			bool AppendData(const std::shared_ptr<const ov::Data> &data);
 			bool AppendString(const ov::String &string);
+			// If the payload is sent as is (HTTP/1.1 over TCP or kTLS), the file is sent using sendfile() without being read,
+			// otherwise the content is read through ov::FileCache
 			bool AppendFile(const ov::String &filename);
 
 			int32_t Response();
@@ -74,13 +76,28 @@ namespace http
 			bool Close();
 
 		protected:
+			struct ResponseFile
+			{
+				std::shared_ptr<const ov::ReadOnlyFile> file;
+				// The file is sent after this number of data in the response data list
+				size_t data_index;
+			};
+
 			bool IsHeaderSent() const;
+
+			// Whether the files of AppendFile() can be sent by SendFile()
+			virtual bool IsFileSendable() const;
+			// The data is not encrypted in userspace (no TLS, or kTLS)
+			bool IsPayloadSentAsIs() const;
 			
 			// Get Response Data List
 			const std::vector<std::shared_ptr<const ov::Data>> &GetResponseDataList() const;
 			// Get Response Header
 			const std::unordered_map<ov::String, std::vector<ov::String>, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> &GetResponseHeaderList() const;
 			void ResetResponseData();
+			const std::vector<ResponseFile> &GetResponseFileList() const;
+			// Reads the files of the response into the response data list (e.g. when it is changed to chunked transfer)
+			bool LoadResponseFiles();
 
 			// Can be used for response without content-length
 			template <typename T>
@@ -90,12 +107,18 @@ namespace http
 			}
 			virtual bool Send(const void *data, size_t length);
 			virtual bool Send(const std::shared_ptr<const ov::Data> &data);
+			// Sends the list of data in order without building a contiguous copy
+			bool Send(const std::vector<std::shared_ptr<const ov::Data>> &data_list);
+			bool SendFile(const std::shared_ptr<const ov::ReadOnlyFile> &file);
 			
 		private:
 			virtual int32_t SendHeader();
 			virtual int32_t SendPayload();
 
 			ov::String GetEtag();
+			// The data is not copied
+			bool AppendDataInternal(const std::shared_ptr<const ov::Data> &data);
+			void UpdateResponseHash(const std::shared_ptr<const ov::Data> &data);
 
 			std::shared_ptr<ov::ClientSocket> _client_socket;
 			std::shared_ptr<ov::TlsServerData> _tls_data;
@@ -122,6 +145,8 @@ namespace http
 			// So _response_header is a map of case insentitive header key and value
 			std::unordered_map<ov::String, std::vector<ov::String>, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> _response_header;
 			std::vector<std::shared_ptr<const ov::Data>> _response_data_list;
+			// Files to be sent using sendfile()
+			std::vector<ResponseFile> _response_file_list;
 			size_t _response_data_size = 0;
 
 			std::vector<ov::String> _default_value{};
@@ -120,6 +120,7 @@ namespace http
 			std::shared_ptr<HttpsServer> https_server = nullptr;
 			auto module_config = cfg::ConfigManager::GetInstance()->GetServer()->GetModules();
 			auto http2_enabled = module_config.GetHttp2().IsEnabled();
+			auto ktls_enabled = module_config.GetKTLS().IsEnabled();
 
 			if (disable_http2_force == true)
 			{
@@ -154,6 +155,7 @@ namespace http
 			{
 				// Create a new HTTP server
 				https_server = std::make_shared<HttpsServer>(server_name, server_short_name);
+				https_server->SetKtlsEnabled(ktls_enabled);
 
 				if (https_server->Start(address, worker_count, http2_enabled))
 				{
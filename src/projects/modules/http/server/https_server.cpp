@@ -122,6 +122,18 @@ namespace http
 				return remote->Send(data, length) ? length : -1L;
 			});
 
+			if (_ktls_enabled)
+			{
+				// If the kernel or the negotiated cipher does not support kTLS, records are encrypted in userspace
+				tls_data->EnableKtls(
+					[remote](const void *crypto_info, socklen_t crypto_info_length) -> bool {
+						return remote->EnableKtlsSend(crypto_info, crypto_info_length);
+					},
+					[remote](uint8_t record_type, const void *data, size_t length) -> ssize_t {
+						return remote->SendKtlsRecord(record_type, data, length);
+					});
+			}
+
 			client->SetTlsData(tls_data);
 		}
 
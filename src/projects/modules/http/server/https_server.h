@@ -30,6 +30,12 @@ namespace http
 			// Deprecated
 			std::shared_ptr<const ov::Error> AppendCertificateList(const std::vector<std::shared_ptr<const info::Certificate>> &certificate_list);
 
+			// Offloads the encryption of TLS records to the kernel for new connections (if available)
+			void SetKtlsEnabled(bool enabled)
+			{
+				_ktls_enabled = enabled;
+			}
+
 		protected:
 			struct HttpsCertificate
 			{
@@ -59,6 +65,8 @@ namespace http
 
 			// Certificate Name : HttpsCertificate
 			std::map<ov::String, std::shared_ptr<HttpsCertificate>> _https_certificate_map;
+
+			bool _ktls_enabled = false;
 		};
 	}  // namespace svr
 }  // namespace http
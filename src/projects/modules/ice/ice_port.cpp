@@ -41,7 +41,7 @@ IcePort::~IcePort()
 	Close();
 }
 
-bool IcePort::CreateIceCandidates(const char *server_name, const cfg::Server &server_config, const RtcIceCandidateList &ice_candidate_list, int ice_worker_count)
+bool IcePort::CreateIceCandidates(const char *server_name, const cfg::Server &server_config, const RtcIceCandidateList &ice_candidate_list, int ice_worker_count, bool enable_batched_send)
 {
 	std::lock_guard<std::recursive_mutex> lock_guard(_physical_port_list_mutex);
 
@@ -88,7 +88,7 @@ bool IcePort::CreateIceCandidates(const char *server_name, const cfg::Server &se
 				}
 
 				// Create an ICE port using candidate information
-				auto physical_port = CreatePhysicalPort(ice_address, socket_type, ice_worker_count);
+				auto physical_port = CreatePhysicalPort(ice_address, socket_type, ice_worker_count, enable_batched_send);
 				if (physical_port == nullptr)
 				{
 					logte("Could not create physical port for %s/%s", ice_address.ToString().CStr(), transport.CStr());
@@ -192,9 +192,24 @@ bool IcePort::CreateTurnServer(const ov::SocketAddress &address, ov::SocketType
 	return true;
 }
 
-std::shared_ptr<PhysicalPort> IcePort::CreatePhysicalPort(const ov::SocketAddress &address, ov::SocketType type, int worker_count)
+std::shared_ptr<PhysicalPort> IcePort::CreatePhysicalPort(const ov::SocketAddress &address, ov::SocketType type, int worker_count, bool enable_batched_send)
 {
-	auto physical_port = PhysicalPortManager::GetInstance()->CreatePort("ICE", type, address, worker_count);
+	PhysicalPort::OnSocketCreated on_socket_created = nullptr;
+
+	if (enable_batched_send && (type == ov::SocketType::Udp))
+	{
+		on_socket_created = [](const std::shared_ptr<ov::Socket> &socket) -> std::shared_ptr<ov::Error> {
+			if (socket->SetBatchedSendMode(true) == false)
+			{
+				// Fall back to the normal send mode
+				logtw("Could not enable batched send mode for %s", socket->ToString().CStr());
+			}
+
+			return nullptr;
+		};
+	}
+
+	auto physical_port = PhysicalPortManager::GetInstance()->CreatePort("ICE", type, address, worker_count, 0, 0, on_socket_created);
 	if (physical_port != nullptr)
 	{
 		if (physical_port->AddObserver(this))
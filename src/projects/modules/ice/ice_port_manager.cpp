@@ -63,7 +63,7 @@ bool IcePortManager::CreateIceCandidates(
 	auto ice_worker_count = ice_candidates_config.GetIceWorkerCount(&is_parsed);
 	ice_worker_count = is_parsed ? ice_worker_count : PHYSICAL_PORT_USE_DEFAULT_COUNT;
 
-	if (_ice_port->CreateIceCandidates(server_name, server_config, ice_candidate_list, ice_worker_count) == false)
+	if (_ice_port->CreateIceCandidates(server_name, server_config, ice_candidate_list, ice_worker_count, ice_candidates_config.GetEnableBatchedSend()) == false)
 	{
 		Release(observer);
 
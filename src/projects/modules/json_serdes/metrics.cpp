@@ -6,6 +6,8 @@
 //  Copyright (c) 2020 AirenSoft. All rights reserved.
 //
 //==============================================================================
+#include "metrics.h"
+
 #include "application.h"
 #include "common.h"
 namespace serdes
@@ -95,4 +97,284 @@ namespace serdes
 
 		return value;
 	}
+
+	static void SetSocketPoolStats(Json::Value &value, const ov::SocketPoolStats::Snapshot &stats)
+	{
+		SetInt64(value, "sendSyscalls", stats.send_syscall_count);
+		SetInt64(value, "sentDatagrams", stats.sent_datagram_count);
+		SetInt64(value, "sentBytes", stats.sent_bytes);
+		SetInt64(value, "gsoDatagrams", stats.gso_datagram_count);
+		SetInt64(value, "droppedDatagrams", stats.dropped_datagram_count);
+		SetFloat(value, "syscallsPerDatagram", stats.GetSyscallsPerDatagram());
+		SetInt64(value, "recvSyscalls", stats.recv_syscall_count);
+		SetInt64(value, "receivedDatagrams", stats.received_datagram_count);
+		SetInt64(value, "receivedBytes", stats.received_bytes);
+		SetInt64(value, "recvBufferAllocations", stats.recv_buffer_alloc_count);
+		SetFloat(value, "datagramsPerRecvSyscall", stats.GetDatagramsPerRecvSyscall());
+		SetInt64(value, "workerCpuTime", stats.worker_cpu_time_us);
+		SetInt64(value, "throughputPerCore", stats.GetThroughputPerCore());
+	}
+
+	Json::Value JsonFromSocketPool(const std::shared_ptr<const ov::SocketPool> &socket_pool)
+	{
+		if (socket_pool == nullptr)
+		{
+			return Json::nullValue;
+		}
+
+		Json::Value value;
+
+		SetString(value, "name", socket_pool->GetName(), Optional::False);
+		SetString(value, "type", ov::StringFromSocketType(socket_pool->GetType()), Optional::False);
+		SetInt(value, "workerCount", socket_pool->GetWorkerCount());
+
+		SetSocketPoolStats(value, socket_pool->GetStatsSnapshot());
+
+		Json::Value &workers = value["workers"];
+		workers = Json::arrayValue;
+
+		for (auto &worker_stats : socket_pool->GetWorkerStatsSnapshots())
+		{
+			Json::Value worker;
+
+			SetSocketPoolStats(worker, worker_stats);
+
+			workers.append(worker);
+		}
+
+		return value;
+	}
+
+	Json::Value JsonFromTaskExecutor(const ov::TaskExecutor *task_executor)
+	{
+		Json::Value value;
+
+		SetBool(value, "running", task_executor->IsRunning());
+		SetInt64(value, "workerCount", task_executor->GetWorkerCount());
+
+		int64_t queue_depth = 0;
+		int64_t executed_count = 0;
+		int64_t stolen_count = 0;
+
+		Json::Value &workers = value["workers"];
+		workers = Json::arrayValue;
+
+		for (auto &worker_stats : task_executor->GetWorkerStats())
+		{
+			Json::Value worker;
+
+			SetInt(worker, "cpu", worker_stats.cpu);
+			SetInt(worker, "numaNode", worker_stats.numa_node);
+			SetInt64(worker, "queueDepth", worker_stats.queue_depth);
+			SetInt64(worker, "executedCount", worker_stats.executed_count);
+			SetInt64(worker, "stolenCount", worker_stats.stolen_count);
+
+			queue_depth += worker_stats.queue_depth;
+			executed_count += worker_stats.executed_count;
+			stolen_count += worker_stats.stolen_count;
+
+			workers.append(worker);
+		}
+
+		SetInt64(value, "queueDepth", queue_depth);
+		SetInt64(value, "executedCount", executed_count);
+		SetInt64(value, "stolenCount", stolen_count);
+
+		return value;
+	}
+
+	Json::Value JsonFromMemoryPoolStats(const std::vector<ov::MemoryPool::ClassStats> &stats)
+	{
+		Json::Value value = Json::arrayValue;
+
+		for (auto &class_stats : stats)
+		{
+			Json::Value item;
+
+			SetInt64(item, "blockSize", class_stats.block_size);
+			SetInt64(item, "allocationCount", class_stats.allocation_count);
+			SetInt64(item, "hitCount", class_stats.hit_count);
+			SetFloat(item, "hitRate", (class_stats.allocation_count > 0) ? (static_cast<float>(class_stats.hit_count) / class_stats.allocation_count) : 0.0f);
+			SetInt64(item, "outstandingBytes", class_stats.outstanding_bytes);
+			SetInt64(item, "depotBytes", class_stats.depot_bytes);
+			SetInt64(item, "threadCacheBytes", class_stats.thread_cache_bytes);
+
+			value.append(item);
+		}
+
+		return value;
+	}
+
+	Json::Value JsonFromFileCacheStats(const ov::FileCache::Stats &stats)
+	{
+		Json::Value value;
+		auto request_count = stats.hit_count + stats.miss_count;
+
+		SetInt64(value, "maxSize", stats.max_size);
+		SetInt64(value, "size", stats.size);
+		SetInt64(value, "count", stats.count);
+		SetInt64(value, "hitCount", stats.hit_count);
+		SetInt64(value, "missCount", stats.miss_count);
+		SetFloat(value, "hitRate", (request_count > 0) ? (static_cast<float>(stats.hit_count) / request_count) : 0.0f);
+
+		return value;
+	}
+
+	Json::Value JsonFromConvertedDataStats(uint64_t hit_count, uint64_t miss_count)
+	{
+		Json::Value value;
+		auto request_count = hit_count + miss_count;
+
+		SetInt64(value, "hitCount", hit_count);
+		SetInt64(value, "missCount", miss_count);
+		SetFloat(value, "hitRate", (request_count > 0) ? (static_cast<float>(hit_count) / request_count) : 0.0f);
+
+		return value;
+	}
+
+	Json::Value JsonFromRtpPacerStats(const RtpPacer::Stats &stats)
+	{
+		Json::Value value;
+
+		SetInt64(value, "targetBitrate", stats.target_bitrate);
+		SetInt64(value, "pacingBitrate", stats.pacing_bitrate);
+		SetInt64(value, "queuedPackets", stats.queued_packets);
+		SetInt64(value, "queuedBytes", stats.queued_bytes);
+		SetTimeInterval(value, "queueTime", stats.queue_time_ms);
+		SetTimeInterval(value, "maxQueueTime", stats.max_queue_time_ms);
+		SetInt64(value, "sentPackets", stats.sent_packets);
+		SetInt64(value, "sentBytes", stats.sent_bytes);
+		SetInt64(value, "delayedPackets", stats.delayed_packets);
+
+		return value;
+	}
+
+	Json::Value JsonFromBweStats(const DelayBasedBwe::Stats &stats)
+	{
+		Json::Value value;
+
+		SetInt64(value, "targetBitrate", stats.target_bitrate);
+		SetInt64(value, "delayBasedBitrate", stats.delay_based_bitrate);
+		SetInt64(value, "acknowledgedBitrate", stats.acknowledged_bitrate);
+		SetFloat(value, "lossRatio", stats.loss_ratio);
+		SetString(value, "usage", DelayBasedBwe::StringFromBandwidthUsage(stats.usage), Optional::False);
+		SetString(value, "state", DelayBasedBwe::StringFromRateControlState(stats.state), Optional::False);
+		SetFloat(value, "trend", stats.trend);
+		SetFloat(value, "threshold", stats.threshold);
+		SetInt64(value, "feedbackCount", stats.feedback_count);
+		SetInt64(value, "overuseCount", stats.overuse_count);
+
+		return value;
+	}
+
+	Json::Value JsonFromTranscoderMetrics(const std::shared_ptr<const mon::StreamMetrics> &metrics)
+	{
+		Json::Value value;
+		Json::Value &decoded_frames = value["decodedFrames"];
+
+		// Frames passed to the filters by reference instead of being copied
+		SetInt64(decoded_frames, "sharedCount", metrics->GetSharedDecodedFrameCount());
+		SetInt64(decoded_frames, "sharedBytes", metrics->GetSharedDecodedFrameBytes());
+		// Frames copied to be written (e.g. audio filler)
+		SetInt64(decoded_frames, "copiedCount", metrics->GetCopiedDecodedFrameCount());
+		SetInt64(decoded_frames, "copiedBytes", metrics->GetCopiedDecodedFrameBytes());
+
+		return value;
+	}
+
+	static Json::Value JsonFromLatencyHistogram(const mon::LatencyHistogram &histogram)
+	{
+		Json::Value value;
+
+		SetInt64(value, "count", histogram.GetCount());
+		SetInt64(value, "p50", histogram.GetPercentile(50.0));
+		SetInt64(value, "p99", histogram.GetPercentile(99.0));
+		SetInt64(value, "max", histogram.GetMax());
+
+		return value;
+	}
+
+	Json::Value JsonFromPacingMetrics(const std::shared_ptr<const mon::LatencyHistogram> &pacing_errors)
+	{
+		Json::Value value;
+
+		// Microseconds the packets were sent later than their target send time
+		value["pacingError"] = JsonFromLatencyHistogram(*pacing_errors);
+
+		return value;
+	}
+
+	Json::Value JsonFromItemTransitionMetrics(const std::shared_ptr<const mon::ItemTransitionMetrics> &metrics)
+	{
+		Json::Value value;
+
+		value["gap"] = JsonFromLatencyHistogram(metrics->gap);
+		value["probeTime"] = JsonFromLatencyHistogram(metrics->probe_time);
+		value["prefetchedCount"] = static_cast<Json::UInt64>(metrics->prefetched_count.load());
+		value["notPrefetchedCount"] = static_cast<Json::UInt64>(metrics->not_prefetched_count.load());
+
+		return value;
+	}
+
+	Json::Value JsonFromLatencyMetrics(const std::shared_ptr<const mon::LatencyMetrics> &metrics)
+	{
+		Json::Value value = Json::objectValue;
+
+		for (size_t index = 0; index < MediaTrace::HopCount; index++)
+		{
+			auto hop = static_cast<MediaTrace::Hop>(index);
+			auto &histogram = metrics->GetHistogram(hop);
+
+			if (histogram.GetCount() == 0)
+			{
+				continue;
+			}
+
+			value[MediaTrace::StringFromHop(hop)] = JsonFromLatencyHistogram(histogram);
+		}
+
+		return value;
+	}
+
+	Json::Value JsonFromLatencyTraces(const std::shared_ptr<const mon::StreamMetrics> &stream_metrics, const std::shared_ptr<const mon::LatencyMetrics> &metrics)
+	{
+		Json::Value events = Json::arrayValue;
+		auto pid = stream_metrics->GetId();
+
+		// Shows the name of the stream instead of the pid
+		Json::Value process_name;
+		process_name["name"] = "process_name";
+		process_name["ph"] = "M";
+		process_name["pid"] = pid;
+		process_name["args"]["name"] = stream_metrics->GetName().CStr();
+		events.append(process_name);
+
+		for (const auto &sampled_trace : metrics->GetSampledTraces())
+		{
+			for (size_t index = 0; index < MediaTrace::HopCount; index++)
+			{
+				auto hop = static_cast<MediaTrace::Hop>(index);
+				auto latency = sampled_trace.trace.GetLatency(hop);
+
+				if (latency < 0)
+				{
+					continue;
+				}
+
+				Json::Value event;
+
+				// Complete event, ts and dur are in microseconds
+				event["name"] = MediaTrace::StringFromHop(hop);
+				event["ph"] = "X";
+				event["ts"] = static_cast<double>(sampled_trace.trace.GetStamp(hop) - latency) / 1000.0;
+				event["dur"] = static_cast<double>(latency) / 1000.0;
+				event["pid"] = pid;
+				event["tid"] = static_cast<Json::UInt64>(sampled_trace.sequence);
+
+				events.append(event);
+			}
+		}
+
+		return events;
+	}
 }  // namespace serdes
\ No newline at end of file
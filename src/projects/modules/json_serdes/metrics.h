@@ -8,6 +8,11 @@
 //==============================================================================
 #pragma once
 
+#include <base/ovlibrary/file_cache.h>
+#include <base/ovlibrary/task_executor.h>
+#include <base/ovsocket/ovsocket.h>
+#include <modules/rtp_rtcp/delay_based_bwe.h>
+#include <modules/rtp_rtcp/rtp_pacer.h>
 #include <monitoring/monitoring.h>
 
 namespace serdes
@@ -15,4 +20,20 @@ namespace serdes
 	Json::Value JsonFromMetrics(const std::shared_ptr<const mon::CommonMetrics> &metrics);
 	Json::Value JsonFromStreamMetrics(const std::shared_ptr<const mon::StreamMetrics> &metrics);
 	Json::Value JsonFromQueueMetrics(const std::shared_ptr<const mon::QueueMetrics> &metrics);
+	Json::Value JsonFromSocketPool(const std::shared_ptr<const ov::SocketPool> &socket_pool);
+	Json::Value JsonFromTaskExecutor(const ov::TaskExecutor *task_executor);
+	Json::Value JsonFromMemoryPoolStats(const std::vector<ov::MemoryPool::ClassStats> &stats);
+	Json::Value JsonFromFileCacheStats(const ov::FileCache::Stats &stats);
+	Json::Value JsonFromConvertedDataStats(uint64_t hit_count, uint64_t miss_count);
+	Json::Value JsonFromRtpPacerStats(const RtpPacer::Stats &stats);
+	Json::Value JsonFromBweStats(const DelayBasedBwe::Stats &stats);
+	// Decoded frames of the transcoder delivered to the filters
+	Json::Value JsonFromTranscoderMetrics(const std::shared_ptr<const mon::StreamMetrics> &metrics);
+	Json::Value JsonFromPacingMetrics(const std::shared_ptr<const mon::LatencyHistogram> &pacing_errors);
+	Json::Value JsonFromItemTransitionMetrics(const std::shared_ptr<const mon::ItemTransitionMetrics> &metrics);
+
+	// Percentiles (in microseconds) of each hop
+	Json::Value JsonFromLatencyMetrics(const std::shared_ptr<const mon::LatencyMetrics> &metrics);
+	// Sampled traces of the stream in the Trace Event Format (chrome://tracing, Perfetto)
+	Json::Value JsonFromLatencyTraces(const std::shared_ptr<const mon::StreamMetrics> &stream_metrics, const std::shared_ptr<const mon::LatencyMetrics> &metrics);
 }  // namespace serdes
\ No newline at end of file
@@ -0,0 +1,579 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Keukhan Kwon
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#pragma once
+
+#include <monitoring/monitoring.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <optional>
+#include <shared_mutex>
+
+#include "base/info/managed_queue.h"
+#include "base/ovlibrary/ovlibrary.h"
+#include "managed_queue.h"
+
+#define MANAGED_RING_QUEUE_DEFAULT_CAPACITY 1024
+#define MANAGED_RING_QUEUE_URGENT_CAPACITY 64
+// Only one of N messages records the enqueued time, which is used to calculate the waiting time
+#define MANAGED_RING_QUEUE_TIMESTAMP_SAMPLING_INTERVAL 16
+// The consumer checks whether the metrics should be updated once every N messages
+#define MANAGED_RING_QUEUE_METRICS_CHECK_INTERVAL 64
+#define MANAGED_RING_QUEUE_DROP_LOG_INTERVAL_IN_MSEC 5000
+
+namespace ov
+{
+	// Bounded lock-free version of ov::ManagedQueue
+	//
+	// - Messages are stored in a fixed-size ring (per-slot sequence numbers), so Enqueue()/Dequeue() do not allocate or lock.
+	//   The mutex is only used to sleep/wake up when the queue is empty (consumer) or full (producer with exceed-wait)
+	// - The same info::ManagedQueue metrics are provided, but the enqueued time is sampled and
+	//   the counters are derived from the ring positions and reflected once per MANAGED_QUEUE_METRICS_UPDATE_INTERVAL_IN_MSEC
+	// - Unlike ov::ManagedQueue, if the ring is full (and exceed-wait is disabled), the message is dropped
+	// - Front(), Back() and buffering delay are not supported because they need the state of each message
+	template <typename T>
+	class ManagedRingQueue : public info::ManagedQueue
+	{
+	private:
+		const char *LOG_TAG = "ManagedQueue";
+
+		class Ring
+		{
+		public:
+			explicit Ring(size_t capacity)
+			{
+				// Round up to a power of 2
+				size_t ring_capacity = 2;
+				while (ring_capacity < capacity)
+				{
+					ring_capacity <<= 1;
+				}
+
+				_slots = std::make_unique<Slot[]>(ring_capacity);
+				_mask = ring_capacity - 1;
+
+				for (size_t index = 0; index < ring_capacity; index++)
+				{
+					_slots[index].sequence.store(index, std::memory_order_relaxed);
+				}
+			}
+
+			size_t GetCapacity() const
+			{
+				return _mask + 1;
+			}
+
+			template <typename Titem>
+			bool TryPush(Titem &&item, int64_t enqueued_time_us)
+			{
+				Slot *slot = nullptr;
+				size_t position = _enqueue_position.load(std::memory_order_relaxed);
+
+				while (true)
+				{
+					slot = &_slots[position & _mask];
+
+					auto sequence = slot->sequence.load(std::memory_order_acquire);
+					auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+					if (diff == 0)
+					{
+						if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						{
+							break;
+						}
+					}
+					else if (diff < 0)
+					{
+						// Full
+						return false;
+					}
+					else
+					{
+						position = _enqueue_position.load(std::memory_order_relaxed);
+					}
+				}
+
+				slot->data = std::forward<Titem>(item);
+				slot->enqueued_time_us = enqueued_time_us;
+				slot->sequence.store(position + 1, std::memory_order_release);
+
+				return true;
+			}
+
+			// Multiple consumers are allowed so that Clear() can be called while the consumer thread is running
+			bool TryPop(T &item, int64_t &enqueued_time_us)
+			{
+				Slot *slot = nullptr;
+				size_t position = _dequeue_position.load(std::memory_order_relaxed);
+
+				while (true)
+				{
+					slot = &_slots[position & _mask];
+
+					auto sequence = slot->sequence.load(std::memory_order_acquire);
+					auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+					if (diff == 0)
+					{
+						if (_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						{
+							break;
+						}
+					}
+					else if (diff < 0)
+					{
+						// Empty
+						return false;
+					}
+					else
+					{
+						position = _dequeue_position.load(std::memory_order_relaxed);
+					}
+				}
+
+				item = std::move(slot->data);
+				// Release the reference immediately instead of keeping it until the slot is reused
+				slot->data = T();
+				enqueued_time_us = slot->enqueued_time_us;
+				slot->sequence.store(position + _mask + 1, std::memory_order_release);
+
+				return true;
+			}
+
+			// The number of messages that have been enqueued/dequeued so far
+			size_t GetEnqueuedCount() const
+			{
+				return _enqueue_position.load(std::memory_order_acquire);
+			}
+
+			size_t GetDequeuedCount() const
+			{
+				return _dequeue_position.load(std::memory_order_acquire);
+			}
+
+			size_t GetSize() const
+			{
+				// Load the dequeue position first, so the result is never negative
+				auto dequeued = GetDequeuedCount();
+				auto enqueued = GetEnqueuedCount();
+
+				return (enqueued > dequeued) ? (enqueued - dequeued) : 0;
+			}
+
+		private:
+			struct Slot
+			{
+				std::atomic<size_t> sequence{0};
+				T data{};
+				// 0 if the enqueued time is not sampled
+				int64_t enqueued_time_us = 0;
+			};
+
+			std::unique_ptr<Slot[]> _slots;
+			size_t _mask = 0;
+
+			// Producer and consumer positions are placed in different cache lines to avoid false sharing
+			alignas(64) std::atomic<size_t> _enqueue_position{0};
+			alignas(64) std::atomic<size_t> _dequeue_position{0};
+		};
+
+	public:
+		ManagedRingQueue()
+			: ManagedRingQueue(nullptr) {}
+
+		ManagedRingQueue(std::shared_ptr<info::ManagedQueue::URN> urn, size_t threshold = 0, size_t capacity = MANAGED_RING_QUEUE_DEFAULT_CAPACITY, int log_interval_in_msec = MANAGED_QUEUE_LOG_INTERVAL_IN_MSEC)
+			: info::ManagedQueue(threshold),
+			  _ring(std::max(capacity, threshold)),
+			  _urgent_ring(MANAGED_RING_QUEUE_URGENT_CAPACITY),
+			  _stats_metric_interval(MANAGED_QUEUE_METRICS_UPDATE_INTERVAL_IN_MSEC),
+			  _log_interval(log_interval_in_msec)
+		{
+			info::ManagedQueue::SetUrn(urn, Demangle(typeid(T).name()).CStr());
+
+			// Register to the server metrics
+			// If the Unique id is duplicated or memory allocation failed, retry
+			while (true)
+			{
+				SetId(IssueUniqueQueueId());
+
+				if (MonitorInstance->GetServerMetrics()->OnQueueCreated(*this) == true)
+				{
+					break;
+				}
+			}
+		}
+
+		~ManagedRingQueue()
+		{
+			Clear();
+
+			// Unregister to the server metrics
+			MonitorInstance->GetServerMetrics()->OnQueueDeleted(*this);
+		}
+
+		void SetUrn(std::shared_ptr<info::ManagedQueue::URN> urn)
+		{
+			info::ManagedQueue::SetUrn(urn, Demangle(typeid(T).name()).CStr());
+
+			MonitorInstance->GetServerMetrics()->OnQueueUpdated(*this, true);
+		}
+
+		size_t GetCapacity() const
+		{
+			return _ring.GetCapacity();
+		}
+
+		// Urgent item will be dequeued before the other items
+		void Enqueue(const T &item, bool urgent = false, int timeout = Infinite)
+		{
+			EnqueueInternal(item, urgent, timeout);
+		}
+
+		// Urgent item will be dequeued before the other items
+		void Enqueue(T &&item, bool urgent = false, int timeout = Infinite)
+		{
+			EnqueueInternal(std::move(item), urgent, timeout);
+		}
+
+		std::optional<T> Dequeue(int timeout = Infinite)
+		{
+			if (_stop)
+			{
+				return {};	// Stop is requested
+			}
+
+			T value;
+			int64_t enqueued_time_us = 0;
+
+			if (TryPop(value, enqueued_time_us) == false)
+			{
+				// Reflect the metrics before sleeping, because no message will be dequeued for a while
+				TryUpdateMetrics(true);
+
+				auto unique_lock = std::unique_lock(_mutex);
+				std::chrono::system_clock::time_point expire = (timeout == Infinite) ? std::chrono::system_clock::time_point::max() : std::chrono::system_clock::now() + std::chrono::milliseconds(timeout);
+
+				_waiting_consumer_count.fetch_add(1);
+
+				auto result = _condition.wait_until(unique_lock, expire, [&]() -> bool {
+					return _stop || TryPop(value, enqueued_time_us);
+				});
+
+				_waiting_consumer_count.fetch_sub(1);
+
+				if (!result || _stop)
+				{
+					return {};	// timed out / Stop is requested
+				}
+			}
+
+			// Update statistics of waiting time (microseconds)
+			if (enqueued_time_us > 0)
+			{
+				_waiting_time_in_us = _waiting_time_in_us * 0.9 + (GetMonotonicTimeUs() - enqueued_time_us) * 0.1;
+			}
+
+			if ((++_dequeue_count_since_check % MANAGED_RING_QUEUE_METRICS_CHECK_INTERVAL) == 0)
+			{
+				TryUpdateMetrics(false);
+			}
+
+			// Pairs with the increment of _waiting_producer_count in EnqueueInternal()
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if ((_exceed_threshold_and_wait_enabled == true) && (_waiting_producer_count.load() > 0))
+			{
+				auto lock_guard = std::lock_guard(_mutex);
+				_condition.notify_all();
+			}
+
+			return value;
+		}
+
+		bool IsEmpty() const
+		{
+			return (Size() == 0);
+		}
+
+		// Cleared all items in the queue
+		void Clear()
+		{
+			T value;
+			int64_t enqueued_time_us = 0;
+
+			while (TryPop(value, enqueued_time_us))
+			{
+			}
+
+			ClearMetrics();
+		}
+
+		size_t Size() const
+		{
+			return _urgent_ring.GetSize() + _ring.GetSize();
+		}
+
+		void Stop()
+		{
+			auto lock_guard = std::lock_guard(_mutex);
+
+			_stop = true;
+
+			ClearMetrics();
+
+			_condition.notify_all();
+		}
+
+		bool IsStopped() const
+		{
+			return _stop;
+		}
+
+		void SetExceedWaitEnable(bool enable)
+		{
+			_exceed_threshold_and_wait_enabled = enable;
+		}
+
+		bool IsExceedWaitEnable()
+		{
+			return _exceed_threshold_and_wait_enabled;
+		}
+
+	private:
+		static int64_t GetMonotonicTimeUs()
+		{
+			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		bool TryPop(T &value, int64_t &enqueued_time_us)
+		{
+			return _urgent_ring.TryPop(value, enqueued_time_us) || _ring.TryPop(value, enqueued_time_us);
+		}
+
+		template <typename Titem>
+		void EnqueueInternal(Titem &&item, bool urgent, int timeout)
+		{
+			// Only the sampled messages are used to calculate the waiting time
+			int64_t enqueued_time_us = 0;
+			if ((_sampling_counter.fetch_add(1, std::memory_order_relaxed) % MANAGED_RING_QUEUE_TIMESTAMP_SAMPLING_INTERVAL) == 0)
+			{
+				enqueued_time_us = GetMonotonicTimeUs();
+
+				// If the consumer is stuck, nobody would update the metrics
+				TryUpdateMetrics(false);
+			}
+
+			// timeout works when the queue is full and _exceed_threshold_and_wait_enabled is true
+			// If the queue is full, it waits until the queue is less than the threshold or the timeout expires.
+			// If the timeout expires, the message is dropped.
+			if ((_exceed_threshold_and_wait_enabled == true) && (Size() >= _threshold))
+			{
+				auto unique_lock = std::unique_lock(_mutex);
+				std::chrono::system_clock::time_point expire = (timeout == Infinite) ? std::chrono::system_clock::time_point::max() : std::chrono::system_clock::now() + std::chrono::milliseconds(timeout);
+
+				_waiting_producer_count.fetch_add(1);
+
+				auto result = _condition.wait_until(unique_lock, expire, [this]() -> bool {
+					return (Size() < _threshold) || _stop;
+				});
+
+				_waiting_producer_count.fetch_sub(1);
+
+				if (!result || _stop)
+				{
+					auto shared_lock = std::shared_lock(_name_mutex);
+					loge(LOG_TAG, "[%s] queue is full. q.size(%zu), q.threshold(%zu)", ToString().CStr(), Size(), _threshold);
+					return;
+				}
+			}
+
+			bool pushed = false;
+
+			if (urgent)
+			{
+				pushed = _urgent_ring.TryPush(std::forward<Titem>(item), enqueued_time_us);
+			}
+
+			if ((pushed == false) && (_ring.TryPush(std::forward<Titem>(item), enqueued_time_us) == false))
+			{
+				OnDropped();
+				return;
+			}
+
+			// Pairs with the increment of _waiting_consumer_count in Dequeue() so that the wakeup is not lost
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (_waiting_consumer_count.load() > 0)
+			{
+				auto lock_guard = std::lock_guard(_mutex);
+				_condition.notify_all();
+			}
+		}
+
+		void OnDropped()
+		{
+			auto drop_count = _dropped_count.fetch_add(1, std::memory_order_relaxed) + 1;
+
+			auto current = ov::Time::GetTimestampInMs();
+			auto last_log_time = _last_drop_log_time.load(std::memory_order_relaxed);
+
+			if ((current - last_log_time) > MANAGED_RING_QUEUE_DROP_LOG_INTERVAL_IN_MSEC)
+			{
+				if (_last_drop_log_time.compare_exchange_strong(last_log_time, current, std::memory_order_relaxed))
+				{
+					auto shared_lock = std::shared_lock(_name_mutex);
+					logw(LOG_TAG, "[%u] %s is full and the message is dropped. capacity: %zu, threshold: %zu, total dropped: %" PRIu64, GetId(), ToString().CStr(), GetCapacity(), _threshold, drop_count);
+				}
+			}
+		}
+
+		// The counters and the size are reflected to info::ManagedQueue at most once per _stats_metric_interval.
+		// Both the producer and the consumer may call this, so the one that gets the lock does it and the other skips it.
+		void TryUpdateMetrics(bool force)
+		{
+			auto unique_lock = std::unique_lock(_metrics_mutex, std::try_to_lock);
+
+			if (unique_lock.owns_lock() == false)
+			{
+				return;
+			}
+
+			if (_timer.IsStart() == false)
+			{
+				_timer.Start();
+			}
+
+			if ((force == false) && (_timer.IsElapsed(_stats_metric_interval) == false))
+			{
+				return;
+			}
+
+			ReflectCounters();
+
+			// Update the peak statistics
+			if (_peak < _size)
+			{
+				_peak = _size;
+			}
+
+			if (_timer.IsElapsed(_stats_metric_interval) == false)
+			{
+				return;
+			}
+
+			int elapsed_time = _timer.Elapsed();
+			_timer.Update();
+
+			// Update statistics of message per second
+			_input_message_per_second = (double)(_input_message_count - _last_input_message_count) * (1000.0 / (double)elapsed_time);
+			_output_message_per_second = (double)(_output_message_count - _last_output_message_count) * (1000.0 / (double)elapsed_time);
+			_last_input_message_count = _input_message_count;
+			_last_output_message_count = _output_message_count;
+
+			if ((_threshold > 0) && (_size >= _threshold))
+			{
+				_threshold_exceeded_time_in_us += _stats_metric_interval;
+
+				// Logging
+				_last_logging_time += _stats_metric_interval;
+				if ((_last_logging_time >= _log_interval) && (_last_logged_peak < _peak))
+				{
+					_last_logging_time = 0;
+
+					auto shared_lock = std::shared_lock(_name_mutex);
+					logw(LOG_TAG, "[%u] %s has exceeded the threshold and increased peak. size: %zu, threshold: %zu, peak: %zu", GetId(), ToString().CStr(), _size, _threshold, _peak);
+
+					_last_logged_peak = _peak;
+				}
+			}
+			else
+			{
+				_threshold_exceeded_time_in_us = 0;
+			}
+
+			MonitorInstance->GetServerMetrics()->OnQueueUpdated(*this);
+		}
+
+		// Converts the ring positions into the message counters of info::ManagedQueue
+		void ReflectCounters()
+		{
+			auto enqueued_count = _urgent_ring.GetEnqueuedCount() + _ring.GetEnqueuedCount();
+			auto dequeued_count = _urgent_ring.GetDequeuedCount() + _ring.GetDequeuedCount();
+			auto dropped_count = _dropped_count.load(std::memory_order_relaxed);
+
+			// Dropped messages are counted as input messages like ov::ManagedQueue
+			_input_message_count += (enqueued_count - _reflected_enqueued_count) + (dropped_count - _reflected_dropped_count);
+			_output_message_count += (dequeued_count - _reflected_dequeued_count);
+			_drop_message_count += (dropped_count - _reflected_dropped_count);
+
+			_reflected_enqueued_count = enqueued_count;
+			_reflected_dequeued_count = dequeued_count;
+			_reflected_dropped_count = dropped_count;
+
+			_size = Size();
+		}
+
+		void ClearMetrics()
+		{
+			auto lock_guard = std::lock_guard(_metrics_mutex);
+
+			// Skip the counts so far
+			ReflectCounters();
+
+			_peak = 0;
+			_input_message_per_second = 0;
+			_output_message_per_second = 0;
+			_input_message_count = 0;
+			_output_message_count = 0;
+			_last_input_message_count = 0;
+			_last_output_message_count = 0;
+			_threshold_exceeded_time_in_us = 0;
+
+			MonitorInstance->GetServerMetrics()->OnQueueUpdated(*this);
+		}
+
+	private:
+		Ring _ring;
+		// Urgent messages are kept in a separate ring, since a message cannot be pushed to the front of the ring
+		Ring _urgent_ring;
+
+		// Used only to sleep/wake up
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::atomic<int> _waiting_consumer_count{0};
+		std::atomic<int> _waiting_producer_count{0};
+
+		std::atomic<bool> _stop{false};
+
+		std::atomic<uint32_t> _sampling_counter{0};
+		uint32_t _dequeue_count_since_check = 0;
+
+		std::atomic<uint64_t> _dropped_count{0};
+		std::atomic<int64_t> _last_drop_log_time{0};
+
+		// Metrics
+		std::mutex _metrics_mutex;
+		StopWatch _timer;
+		int _stats_metric_interval = 0;
+		int _log_interval = 0;
+		int64_t _last_logging_time = 0;
+		size_t _last_logged_peak = 0;
+
+		// The positions of the rings that have been reflected to the counters
+		size_t _reflected_enqueued_count = 0;
+		size_t _reflected_dequeued_count = 0;
+		uint64_t _reflected_dropped_count = 0;
+
+		// Prevent exceed threshold. If true, the queue will not exceed the threshold
+		// Wait until the queue falls below the threshold
+		bool _exceed_threshold_and_wait_enabled = false;
+	};
+}  // namespace ov
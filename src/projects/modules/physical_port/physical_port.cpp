@@ -181,8 +181,8 @@ bool PhysicalPort::CreateDatagramSocket(
 				if (socket->Prepare(
 							 address,
 							 on_socket_created,
-							 std::bind(&PhysicalPort::OnDatagram, this,
-									   std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)))
+							 ov::DatagramBatchCallback(std::bind(&PhysicalPort::OnDatagrams, this,
+																  std::placeholders::_1, std::placeholders::_2))))
 				{
 					_type = type;
 					_datagram_socket = socket;
@@ -273,12 +273,12 @@ void PhysicalPort::OnClientData(const std::shared_ptr<ov::ClientSocket> &client,
 	}
 }
 
-void PhysicalPort::OnDatagram(const std::shared_ptr<ov::DatagramSocket> &client, const ov::SocketAddressPair &address_pair, const std::shared_ptr<ov::Data> &data)
+void PhysicalPort::OnDatagrams(const std::shared_ptr<ov::DatagramSocket> &client, const ov::DatagramReceiveBatch &batch)
 {
 	// Notify observers
 	for (auto &observer : _observer_list)
 	{
-		observer->OnDatagramReceived(client, address_pair, data);
+		observer->OnDatagramsReceived(client, batch);
 	}
 }
 
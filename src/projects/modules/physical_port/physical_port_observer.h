@@ -48,6 +48,18 @@ public:
 	// Called when the packet is received (Only used when UDP)
 	virtual void OnDatagramReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddressPair &address_pair, const std::shared_ptr<const ov::Data> &data) {}
 
+	// Called with the datagrams received by one recvmmsg() (Only used when UDP)
+	//
+	// The data of the batch is reused by the next recvmmsg() if it is not referenced anymore,
+	// so keep the std::shared_ptr (or Clone() it) if the data is needed after returning
+	virtual void OnDatagramsReceived(const std::shared_ptr<ov::Socket> &remote, const ov::DatagramReceiveBatch &batch)
+	{
+		for (size_t index = 0; index < batch.GetCount(); index++)
+		{
+			OnDatagramReceived(remote, batch.GetAddressPair(index), batch.GetData(index));
+		}
+	}
+
 	// Called when the client is disconnected
 	virtual void OnDisconnected(const std::shared_ptr<ov::Socket> &remote, PhysicalPortDisconnectReason reason, const std::shared_ptr<const ov::Error> &error) {}
 
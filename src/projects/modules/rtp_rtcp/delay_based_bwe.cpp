@@ -0,0 +1,455 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#include "delay_based_bwe.h"
+
+#include <cmath>
+
+#define OV_LOG_TAG "DelayBasedBwe"
+
+// Packets sent within this interval are regarded as one group
+#define BWE_BURST_INTERVAL_US				5000
+// Trendline filter
+#define BWE_TRENDLINE_WINDOW_SIZE			20
+#define BWE_TRENDLINE_SMOOTHING_COEFF		0.9
+#define BWE_TRENDLINE_THRESHOLD_GAIN		4.0
+#define BWE_MAX_NUM_DELTAS					60
+// Overuse detector
+#define BWE_OVERUSING_TIME_THRESHOLD_MS		10.0
+#define BWE_THRESHOLD_K_UP					0.0087
+#define BWE_THRESHOLD_K_DOWN				0.039
+#define BWE_MIN_THRESHOLD					6.0
+#define BWE_MAX_THRESHOLD					600.0
+#define BWE_MAX_THRESHOLD_UPDATE_MS			100
+// Acknowledged bitrate
+#define BWE_ACKNOWLEDGED_WINDOW_US			500000
+#define BWE_MIN_ACKNOWLEDGED_WINDOW_US		100000
+// AIMD rate control
+#define BWE_DECREASE_FACTOR					0.85
+#define BWE_MULTIPLICATIVE_INCREASE_FACTOR	1.08
+#define BWE_RESPONSE_TIME_MS				200
+#define BWE_AVERAGE_PACKET_BITS				(1200 * 8)
+// Loss-based control
+#define BWE_HIGH_LOSS_RATIO					0.1
+#define BWE_LOW_LOSS_RATIO					0.02
+#define BWE_LOSS_DECREASE_INTERVAL_MS		300
+
+DelayBasedBwe::DelayBasedBwe(uint64_t start_bitrate, uint64_t min_bitrate, uint64_t max_bitrate)
+{
+	_min_bitrate = min_bitrate;
+	_max_bitrate = std::max(min_bitrate, max_bitrate);
+
+	_delay_based_bitrate = std::clamp(start_bitrate, _min_bitrate, _max_bitrate);
+	_target_bitrate = _delay_based_bitrate;
+}
+
+void DelayBasedBwe::OnTransportFeedback(const std::vector<PacketResult> &results, int64_t now_ms)
+{
+	if (results.empty())
+	{
+		return;
+	}
+
+	_feedback_count++;
+
+	for (const auto &result : results)
+	{
+		if (result.arrival_time_us < 0)
+		{
+			continue;
+		}
+
+		double send_delta_ms = 0.0;
+		double arrival_delta_ms = 0.0;
+
+		if (AddToGroup(result, &send_delta_ms, &arrival_delta_ms))
+		{
+			UpdateTrendline(send_delta_ms, arrival_delta_ms, _previous_group.last_arrival_time_us / 1000);
+			DetectOveruse(send_delta_ms, now_ms);
+		}
+	}
+
+	UpdateAcknowledgedBitrate(results);
+	UpdateLossRatio(results);
+	UpdateRate(now_ms);
+}
+
+bool DelayBasedBwe::AddToGroup(const PacketResult &result, double *send_delta_ms, double *arrival_delta_ms)
+{
+	if (_current_group.IsValid() == false)
+	{
+		_current_group.first_send_time_us = result.send_time_us;
+		_current_group.last_send_time_us = result.send_time_us;
+		_current_group.last_arrival_time_us = result.arrival_time_us;
+		return false;
+	}
+
+	if (result.send_time_us < _current_group.first_send_time_us)
+	{
+		// Reordered packet
+		return false;
+	}
+
+	if ((result.send_time_us - _current_group.first_send_time_us) <= BWE_BURST_INTERVAL_US)
+	{
+		_current_group.last_send_time_us = std::max(_current_group.last_send_time_us, result.send_time_us);
+		_current_group.last_arrival_time_us = std::max(_current_group.last_arrival_time_us, result.arrival_time_us);
+		return false;
+	}
+
+	bool completed = false;
+
+	if (_previous_group.IsValid())
+	{
+		*send_delta_ms = (_current_group.last_send_time_us - _previous_group.last_send_time_us) / 1000.0;
+		*arrival_delta_ms = (_current_group.last_arrival_time_us - _previous_group.last_arrival_time_us) / 1000.0;
+		completed = true;
+	}
+
+	_previous_group = _current_group;
+
+	_current_group.first_send_time_us = result.send_time_us;
+	_current_group.last_send_time_us = result.send_time_us;
+	_current_group.last_arrival_time_us = result.arrival_time_us;
+
+	return completed;
+}
+
+void DelayBasedBwe::UpdateTrendline(double send_delta_ms, double arrival_delta_ms, int64_t arrival_time_ms)
+{
+	_num_deltas = std::min<uint32_t>(_num_deltas + 1, 1000);
+
+	if (_first_arrival_time_ms < 0)
+	{
+		_first_arrival_time_ms = arrival_time_ms;
+	}
+
+	_accumulated_delay_ms += (arrival_delta_ms - send_delta_ms);
+	_smoothed_delay_ms = (BWE_TRENDLINE_SMOOTHING_COEFF * _smoothed_delay_ms) + ((1.0 - BWE_TRENDLINE_SMOOTHING_COEFF) * _accumulated_delay_ms);
+
+	_trendline_samples.push_back({static_cast<double>(arrival_time_ms - _first_arrival_time_ms), _smoothed_delay_ms});
+
+	if (_trendline_samples.size() > BWE_TRENDLINE_WINDOW_SIZE)
+	{
+		_trendline_samples.pop_front();
+	}
+
+	if (_trendline_samples.size() < BWE_TRENDLINE_WINDOW_SIZE)
+	{
+		return;
+	}
+
+	// Linear regression: slope of the smoothed delay over the arrival time
+	double sum_x = 0.0;
+	double sum_y = 0.0;
+
+	for (const auto &sample : _trendline_samples)
+	{
+		sum_x += sample.arrival_time_ms;
+		sum_y += sample.smoothed_delay_ms;
+	}
+
+	double avg_x = sum_x / _trendline_samples.size();
+	double avg_y = sum_y / _trendline_samples.size();
+
+	double numerator = 0.0;
+	double denominator = 0.0;
+
+	for (const auto &sample : _trendline_samples)
+	{
+		double x = sample.arrival_time_ms - avg_x;
+
+		numerator += x * (sample.smoothed_delay_ms - avg_y);
+		denominator += x * x;
+	}
+
+	if (denominator != 0.0)
+	{
+		_trend = numerator / denominator;
+	}
+}
+
+void DelayBasedBwe::DetectOveruse(double send_delta_ms, int64_t now_ms)
+{
+	double modified_trend = std::min<uint32_t>(_num_deltas, BWE_MAX_NUM_DELTAS) * _trend * BWE_TRENDLINE_THRESHOLD_GAIN;
+
+	if (modified_trend > _threshold)
+	{
+		if (_time_over_using_ms < 0.0)
+		{
+			// Assume that the overuse started halfway through the interval
+			_time_over_using_ms = send_delta_ms / 2.0;
+		}
+		else
+		{
+			_time_over_using_ms += send_delta_ms;
+		}
+
+		_overuse_counter++;
+
+		if ((_time_over_using_ms > BWE_OVERUSING_TIME_THRESHOLD_MS) && (_overuse_counter > 1) && (_trend >= _previous_trend))
+		{
+			_time_over_using_ms = 0.0;
+			_overuse_counter = 0;
+
+			if (_usage != BandwidthUsage::Overusing)
+			{
+				_overuse_count++;
+			}
+
+			_usage = BandwidthUsage::Overusing;
+		}
+	}
+	else if (modified_trend < -_threshold)
+	{
+		_time_over_using_ms = -1.0;
+		_overuse_counter = 0;
+		_usage = BandwidthUsage::Underusing;
+	}
+	else
+	{
+		_time_over_using_ms = -1.0;
+		_overuse_counter = 0;
+		_usage = BandwidthUsage::Normal;
+	}
+
+	_previous_trend = _trend;
+
+	UpdateThreshold(modified_trend, now_ms);
+}
+
+void DelayBasedBwe::UpdateThreshold(double modified_trend, int64_t now_ms)
+{
+	if (_last_threshold_update_ms < 0)
+	{
+		_last_threshold_update_ms = now_ms;
+	}
+
+	double abs_trend = std::fabs(modified_trend);
+
+	if (abs_trend > (_threshold + 15.0))
+	{
+		// Avoid adapting the threshold to a sudden spike (e.g. a route change)
+		_last_threshold_update_ms = now_ms;
+		return;
+	}
+
+	double k = (abs_trend < _threshold) ? BWE_THRESHOLD_K_DOWN : BWE_THRESHOLD_K_UP;
+	int64_t elapsed_ms = std::min<int64_t>(now_ms - _last_threshold_update_ms, BWE_MAX_THRESHOLD_UPDATE_MS);
+
+	_threshold += k * (abs_trend - _threshold) * elapsed_ms;
+	_threshold = std::clamp(_threshold, BWE_MIN_THRESHOLD, BWE_MAX_THRESHOLD);
+
+	_last_threshold_update_ms = now_ms;
+}
+
+void DelayBasedBwe::UpdateAcknowledgedBitrate(const std::vector<PacketResult> &results)
+{
+	for (const auto &result : results)
+	{
+		if (result.arrival_time_us < 0)
+		{
+			continue;
+		}
+
+		_received_window.push_back({result.arrival_time_us, result.size});
+		_received_window_bytes += result.size;
+	}
+
+	if (_received_window.empty())
+	{
+		return;
+	}
+
+	auto newest_arrival_time_us = _received_window.back().arrival_time_us;
+
+	while ((_received_window.empty() == false) && (_received_window.front().arrival_time_us < (newest_arrival_time_us - BWE_ACKNOWLEDGED_WINDOW_US)))
+	{
+		_received_window_bytes -= _received_window.front().size;
+		_received_window.pop_front();
+	}
+
+	auto span_us = newest_arrival_time_us - _received_window.front().arrival_time_us;
+
+	if (span_us >= BWE_MIN_ACKNOWLEDGED_WINDOW_US)
+	{
+		_acknowledged_bitrate = static_cast<uint64_t>(_received_window_bytes * 8.0 * 1000000.0 / span_us);
+	}
+}
+
+void DelayBasedBwe::UpdateLossRatio(const std::vector<PacketResult> &results)
+{
+	size_t lost_count = 0;
+
+	for (const auto &result : results)
+	{
+		if (result.arrival_time_us < 0)
+		{
+			lost_count++;
+		}
+	}
+
+	_loss_ratio = static_cast<double>(lost_count) / results.size();
+}
+
+void DelayBasedBwe::UpdateRate(int64_t now_ms)
+{
+	switch (_usage)
+	{
+		case BandwidthUsage::Normal:
+			if (_state == RateControlState::Hold)
+			{
+				_state = RateControlState::Increase;
+			}
+			break;
+
+		case BandwidthUsage::Overusing:
+			if (_state != RateControlState::Decrease)
+			{
+				_state = RateControlState::Decrease;
+			}
+			break;
+
+		case BandwidthUsage::Underusing:
+			_state = RateControlState::Hold;
+			break;
+	}
+
+	int64_t elapsed_ms = (_last_rate_update_ms < 0) ? 0 : (now_ms - _last_rate_update_ms);
+	_last_rate_update_ms = now_ms;
+
+	double current_bitrate = _delay_based_bitrate;
+	double new_bitrate = current_bitrate;
+
+	switch (_state)
+	{
+		case RateControlState::Hold:
+			break;
+
+		case RateControlState::Increase: {
+			if ((_link_capacity_bps > 0.0) && (_acknowledged_bitrate > (_link_capacity_bps * 1.5)))
+			{
+				// The link capacity seems to have changed
+				_link_capacity_bps = -1.0;
+			}
+
+			double increase = 0.0;
+
+			if (_link_capacity_bps > 0.0)
+			{
+				// Near the link capacity: increase slowly (about one packet per response time)
+				increase = static_cast<double>(BWE_AVERAGE_PACKET_BITS) * elapsed_ms / BWE_RESPONSE_TIME_MS;
+			}
+			else
+			{
+				double factor = std::pow(BWE_MULTIPLICATIVE_INCREASE_FACTOR, std::min(elapsed_ms / 1000.0, 1.0));
+				increase = std::max(current_bitrate * (factor - 1.0), 1000.0);
+			}
+
+			new_bitrate = current_bitrate + increase;
+
+			if (_acknowledged_bitrate > 0)
+			{
+				// Do not go too far beyond what the receiver actually gets (but never decrease while increasing)
+				new_bitrate = std::min(new_bitrate, std::max(current_bitrate, (1.5 * _acknowledged_bitrate) + 10000.0));
+			}
+			break;
+		}
+
+		case RateControlState::Decrease: {
+			double base_bitrate = (_acknowledged_bitrate > 0) ? _acknowledged_bitrate : current_bitrate;
+
+			new_bitrate = std::min(current_bitrate, BWE_DECREASE_FACTOR * base_bitrate);
+
+			if (_acknowledged_bitrate > 0)
+			{
+				_link_capacity_bps = (_link_capacity_bps < 0.0) ? _acknowledged_bitrate : ((0.95 * _link_capacity_bps) + (0.05 * _acknowledged_bitrate));
+			}
+
+			_state = RateControlState::Hold;
+			break;
+		}
+	}
+
+	_delay_based_bitrate = std::clamp(static_cast<uint64_t>(new_bitrate), _min_bitrate, _max_bitrate);
+
+	// Loss-based control caps the delay-based estimate
+	uint64_t target_bitrate = std::min(_target_bitrate, _delay_based_bitrate);
+
+	if (_loss_ratio > BWE_HIGH_LOSS_RATIO)
+	{
+		if ((_last_loss_decrease_ms < 0) || ((now_ms - _last_loss_decrease_ms) >= BWE_LOSS_DECREASE_INTERVAL_MS))
+		{
+			target_bitrate = static_cast<uint64_t>(_target_bitrate * (1.0 - (0.5 * _loss_ratio)));
+			_last_loss_decrease_ms = now_ms;
+		}
+	}
+	else if (_loss_ratio < BWE_LOW_LOSS_RATIO)
+	{
+		target_bitrate = _delay_based_bitrate;
+	}
+
+	_target_bitrate = std::clamp(target_bitrate, _min_bitrate, _max_bitrate);
+}
+
+uint64_t DelayBasedBwe::GetTargetBitrate() const
+{
+	return _target_bitrate;
+}
+
+DelayBasedBwe::Stats DelayBasedBwe::GetStats() const
+{
+	Stats stats;
+
+	stats.target_bitrate = _target_bitrate;
+	stats.delay_based_bitrate = _delay_based_bitrate;
+	stats.acknowledged_bitrate = _acknowledged_bitrate;
+	stats.loss_ratio = _loss_ratio;
+
+	stats.usage = _usage;
+	stats.state = _state;
+
+	stats.trend = _trend;
+	stats.threshold = _threshold;
+
+	stats.feedback_count = _feedback_count;
+	stats.overuse_count = _overuse_count;
+
+	return stats;
+}
+
+const char *DelayBasedBwe::StringFromBandwidthUsage(BandwidthUsage usage)
+{
+	switch (usage)
+	{
+		case BandwidthUsage::Normal:
+			return "Normal";
+		case BandwidthUsage::Underusing:
+			return "Underusing";
+		case BandwidthUsage::Overusing:
+			return "Overusing";
+	}
+
+	return "Unknown";
+}
+
+const char *DelayBasedBwe::StringFromRateControlState(RateControlState state)
+{
+	switch (state)
+	{
+		case RateControlState::Hold:
+			return "Hold";
+		case RateControlState::Increase:
+			return "Increase";
+		case RateControlState::Decrease:
+			return "Decrease";
+	}
+
+	return "Unknown";
+}
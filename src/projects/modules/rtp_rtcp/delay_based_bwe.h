@@ -0,0 +1,155 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <deque>
+
+// Send-side bandwidth estimator driven by transport-wide congestion control feedback
+//
+// Follows the design of Google Congestion Control (draft-ietf-rmcat-gcc-02 and libwebrtc):
+//  - Packets sent within a short burst are grouped, and the one-way delay variation between groups is computed
+//  - A trendline filter estimates whether the queuing delay is increasing
+//  - An adaptive threshold detects overuse/underuse
+//  - AIMD rate control adjusts the estimate, and the loss ratio caps it
+class DelayBasedBwe
+{
+public:
+	static constexpr uint64_t DefaultStartBitrate = 1000000;
+	static constexpr uint64_t DefaultMinBitrate = 100000;
+	static constexpr uint64_t DefaultMaxBitrate = 30000000;
+
+	struct PacketResult
+	{
+		int64_t send_time_us = 0;
+		// -1 if the packet was lost
+		int64_t arrival_time_us = -1;
+		size_t size = 0;
+	};
+
+	enum class BandwidthUsage : uint8_t
+	{
+		Normal,
+		Underusing,
+		Overusing
+	};
+
+	enum class RateControlState : uint8_t
+	{
+		Hold,
+		Increase,
+		Decrease
+	};
+
+	struct Stats
+	{
+		uint64_t target_bitrate = 0;
+		uint64_t delay_based_bitrate = 0;
+		uint64_t acknowledged_bitrate = 0;
+		double loss_ratio = 0.0;
+
+		BandwidthUsage usage = BandwidthUsage::Normal;
+		RateControlState state = RateControlState::Hold;
+
+		double trend = 0.0;
+		double threshold = 0.0;
+
+		uint64_t feedback_count = 0;
+		uint64_t overuse_count = 0;
+	};
+
+	DelayBasedBwe(uint64_t start_bitrate = DefaultStartBitrate, uint64_t min_bitrate = DefaultMinBitrate, uint64_t max_bitrate = DefaultMaxBitrate);
+
+	// results must be sorted by the (transport-wide) sequence number
+	void OnTransportFeedback(const std::vector<PacketResult> &results, int64_t now_ms);
+
+	uint64_t GetTargetBitrate() const;
+	Stats GetStats() const;
+
+	static const char *StringFromBandwidthUsage(BandwidthUsage usage);
+	static const char *StringFromRateControlState(RateControlState state);
+
+private:
+	struct PacketGroup
+	{
+		int64_t first_send_time_us = -1;
+		int64_t last_send_time_us = -1;
+		int64_t last_arrival_time_us = -1;
+
+		bool IsValid() const
+		{
+			return first_send_time_us >= 0;
+		}
+	};
+
+	// Returns true and the deltas if a group has been completed
+	bool AddToGroup(const PacketResult &result, double *send_delta_ms, double *arrival_delta_ms);
+	void UpdateTrendline(double send_delta_ms, double arrival_delta_ms, int64_t arrival_time_ms);
+	void DetectOveruse(double send_delta_ms, int64_t now_ms);
+	void UpdateThreshold(double modified_trend, int64_t now_ms);
+
+	void UpdateAcknowledgedBitrate(const std::vector<PacketResult> &results);
+	void UpdateLossRatio(const std::vector<PacketResult> &results);
+	void UpdateRate(int64_t now_ms);
+
+	uint64_t _min_bitrate;
+	uint64_t _max_bitrate;
+
+	// Inter-arrival
+	PacketGroup _current_group;
+	PacketGroup _previous_group;
+
+	// Trendline filter
+	struct TrendlineSample
+	{
+		double arrival_time_ms;
+		double smoothed_delay_ms;
+	};
+	std::deque<TrendlineSample> _trendline_samples;
+	int64_t _first_arrival_time_ms = -1;
+	double _accumulated_delay_ms = 0.0;
+	double _smoothed_delay_ms = 0.0;
+	uint32_t _num_deltas = 0;
+	double _trend = 0.0;
+	double _previous_trend = 0.0;
+
+	// Overuse detector
+	BandwidthUsage _usage = BandwidthUsage::Normal;
+	double _threshold = 12.5;
+	int64_t _last_threshold_update_ms = -1;
+	double _time_over_using_ms = -1.0;
+	uint32_t _overuse_counter = 0;
+
+	// Acknowledged bitrate
+	struct ReceivedBytes
+	{
+		int64_t arrival_time_us;
+		size_t size;
+	};
+	std::deque<ReceivedBytes> _received_window;
+	size_t _received_window_bytes = 0;
+	uint64_t _acknowledged_bitrate = 0;
+
+	// Loss-based control
+	double _loss_ratio = 0.0;
+	int64_t _last_loss_decrease_ms = -1;
+
+	// AIMD rate control
+	RateControlState _state = RateControlState::Hold;
+	uint64_t _delay_based_bitrate;
+	uint64_t _target_bitrate;
+	int64_t _last_rate_update_ms = -1;
+	// Average of the acknowledged bitrate at the moments of decrease (-1 if unknown)
+	double _link_capacity_bps = -1.0;
+
+	uint64_t _feedback_count = 0;
+	uint64_t _overuse_count = 0;
+};
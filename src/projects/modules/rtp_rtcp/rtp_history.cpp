@@ -52,7 +52,7 @@ std::shared_ptr<RtxRtpPacket> RtpHistory::GetRtxRtpPacket(uint16_t seq_no)
 		if(rtp_packet->SequenceNumber() == seq_no)
 		{
 			// Create Rtx Packet and store it
-			auto rtx_packet = std::make_shared<RtxRtpPacket>(GetRtxSsrc(), GetRtxPayloadType(), *rtp_packet);
+			auto rtx_packet = ov::MakePooledShared<RtxRtpPacket>(GetRtxSsrc(), GetRtxPayloadType(), *rtp_packet);
 
 			std::lock_guard<std::shared_mutex> cache_write_guard(_history_cache_lock);
 			_history_cache[index] = rtx_packet;
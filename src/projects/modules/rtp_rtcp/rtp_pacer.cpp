@@ -0,0 +1,140 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#include "rtp_pacer.h"
+
+#define OV_LOG_TAG "RtpPacer"
+
+// The budget always allows at least one full-size packet
+#define MIN_BURST_BYTES RTP_DEFAULT_MAX_PACKET_SIZE
+
+RtpPacer::RtpPacer(double pacing_factor)
+{
+	_pacing_factor = pacing_factor;
+}
+
+void RtpPacer::SetTargetBitrate(uint64_t target_bitrate)
+{
+	_target_bitrate = target_bitrate;
+	_pacing_bitrate = std::max(static_cast<uint64_t>(target_bitrate * _pacing_factor), MinPacingBitrate);
+}
+
+uint64_t RtpPacer::GetPacingBitrate() const
+{
+	return _pacing_bitrate;
+}
+
+void RtpPacer::UpdateBudget(int64_t now_ms)
+{
+	if (_last_update_time_ms < 0)
+	{
+		_last_update_time_ms = now_ms;
+		_budget_bytes = MIN_BURST_BYTES;
+		return;
+	}
+
+	auto elapsed_ms = now_ms - _last_update_time_ms;
+	if (elapsed_ms <= 0)
+	{
+		return;
+	}
+
+	_last_update_time_ms = now_ms;
+
+	double pacing_bitrate = _pacing_bitrate;
+
+	if (_queue.empty() == false)
+	{
+		// Send faster if the queued packets cannot be sent within MaxQueueTimeMs at the pacing bitrate
+		auto queue_time_ms = now_ms - _queue.front().enqueued_time_ms;
+		auto remaining_ms = std::max<int64_t>(MaxQueueTimeMs - queue_time_ms, 1);
+
+		pacing_bitrate = std::max(pacing_bitrate, static_cast<double>(_queued_bytes) * 8.0 * 1000.0 / remaining_ms);
+	}
+
+	double max_budget_bytes = std::max(pacing_bitrate / 8.0 * MaxBurstMs / 1000.0, static_cast<double>(MIN_BURST_BYTES));
+
+	_budget_bytes = std::min(_budget_bytes + (pacing_bitrate / 8.0 * elapsed_ms / 1000.0), max_budget_bytes);
+}
+
+void RtpPacer::Enqueue(const std::shared_ptr<RtpPacket> &packet, int64_t now_ms)
+{
+	_queue.push_back({packet, now_ms});
+	_queued_bytes += packet->GetDataLength();
+}
+
+std::shared_ptr<RtpPacket> RtpPacer::Dequeue(int64_t now_ms)
+{
+	UpdateBudget(now_ms);
+
+	if (_queue.empty())
+	{
+		return nullptr;
+	}
+
+	auto &front = _queue.front();
+	auto queue_time_ms = now_ms - front.enqueued_time_ms;
+
+	if ((_budget_bytes <= 0.0) && (queue_time_ms < MaxQueueTimeMs))
+	{
+		return nullptr;
+	}
+
+	auto packet = front.packet;
+	auto bytes = packet->GetDataLength();
+
+	_queue.pop_front();
+	_queued_bytes -= bytes;
+	_budget_bytes -= bytes;
+
+	_sent_packets++;
+	_sent_bytes += bytes;
+
+	if (queue_time_ms > 0)
+	{
+		_delayed_packets++;
+		_max_queue_time_ms = std::max(_max_queue_time_ms, queue_time_ms);
+	}
+
+	return packet;
+}
+
+void RtpPacer::OnPacketSent(size_t bytes, int64_t now_ms)
+{
+	UpdateBudget(now_ms);
+
+	_budget_bytes -= bytes;
+
+	_sent_packets++;
+	_sent_bytes += bytes;
+}
+
+bool RtpPacer::IsEmpty() const
+{
+	return _queue.empty();
+}
+
+RtpPacer::Stats RtpPacer::GetStats(int64_t now_ms) const
+{
+	Stats stats;
+
+	stats.target_bitrate = _target_bitrate;
+	stats.pacing_bitrate = _pacing_bitrate;
+
+	stats.queued_packets = _queue.size();
+	stats.queued_bytes = _queued_bytes;
+	stats.queue_time_ms = _queue.empty() ? 0 : (now_ms - _queue.front().enqueued_time_ms);
+	stats.max_queue_time_ms = _max_queue_time_ms;
+
+	stats.sent_packets = _sent_packets;
+	stats.sent_bytes = _sent_bytes;
+	stats.delayed_packets = _delayed_packets;
+
+	return stats;
+}
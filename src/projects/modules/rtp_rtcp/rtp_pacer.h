@@ -0,0 +1,92 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <deque>
+
+#include "rtp_packet.h"
+
+// Leaky bucket pacer that spreads a burst of RTP packets (e.g. a keyframe) over time
+//
+// The pacer only decides when a packet can be sent. The caller sends the packet returned by Dequeue(),
+// so RtpPacer is not thread-safe and the caller must serialize the calls.
+class RtpPacer
+{
+public:
+	// Like libwebrtc, packets are paced at a multiple of the target bitrate, so the pacer doesn't become the bottleneck
+	static constexpr double DefaultPacingFactor = 2.5;
+	// Pacing bitrate used until the target bitrate is known
+	static constexpr uint64_t DefaultPacingBitrate = 2500000;
+	static constexpr uint64_t MinPacingBitrate = 300000;
+	// Bytes that can be sent at once after an idle period
+	static constexpr int64_t MaxBurstMs = 5;
+	// If the oldest packet stays in the queue longer than this, the pacer sends faster so that the queue is drained in time
+	static constexpr int64_t MaxQueueTimeMs = 500;
+
+	struct Stats
+	{
+		uint64_t target_bitrate = 0;
+		uint64_t pacing_bitrate = 0;
+
+		size_t queued_packets = 0;
+		size_t queued_bytes = 0;
+		// How long the oldest packet has been waiting in the queue
+		int64_t queue_time_ms = 0;
+		// The longest time a packet has waited in the queue
+		int64_t max_queue_time_ms = 0;
+
+		uint64_t sent_packets = 0;
+		uint64_t sent_bytes = 0;
+		// The number of packets that were sent later than they were enqueued
+		uint64_t delayed_packets = 0;
+	};
+
+	RtpPacer(double pacing_factor = DefaultPacingFactor);
+
+	void SetTargetBitrate(uint64_t target_bitrate);
+	uint64_t GetPacingBitrate() const;
+
+	void Enqueue(const std::shared_ptr<RtpPacket> &packet, int64_t now_ms);
+	// Returns the packet that can be sent now (nullptr if there is no such packet)
+	std::shared_ptr<RtpPacket> Dequeue(int64_t now_ms);
+
+	// Packets sent without passing through the queue (audio, RTX) also consume the budget
+	void OnPacketSent(size_t bytes, int64_t now_ms);
+
+	bool IsEmpty() const;
+	Stats GetStats(int64_t now_ms) const;
+
+private:
+	struct QueuedPacket
+	{
+		std::shared_ptr<RtpPacket> packet;
+		int64_t enqueued_time_ms;
+	};
+
+	void UpdateBudget(int64_t now_ms);
+
+	double _pacing_factor;
+	uint64_t _target_bitrate = 0;
+	uint64_t _pacing_bitrate = DefaultPacingBitrate;
+
+	// Bytes that can be sent now (negative means the pacer sent more than the pacing bitrate allows)
+	double _budget_bytes = 0.0;
+	int64_t _last_update_time_ms = -1;
+
+	std::deque<QueuedPacket> _queue;
+	size_t _queued_bytes = 0;
+
+	int64_t _max_queue_time_ms = 0;
+	uint64_t _sent_packets = 0;
+	uint64_t _sent_bytes = 0;
+	uint64_t _delayed_packets = 0;
+};
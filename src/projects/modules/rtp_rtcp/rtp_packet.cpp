@@ -219,6 +219,19 @@ std::shared_ptr<ov::Data> RtpPacket::GetData() const
 	return _data;
 }
 
+std::shared_ptr<ov::Data> RtpPacket::CloneData(size_t tailroom) const
+{
+	if (_data == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto data = std::make_shared<ov::Data>(_data->GetLength() + tailroom);
+	data->Append(_data->GetData(), _data->GetLength());
+
+	return data;
+}
+
 size_t RtpPacket::GetDataLength() const
 {
 	return _data == nullptr ? 0 : _data->GetLength();
@@ -498,6 +511,17 @@ uint8_t* RtpPacket::Extension(uint8_t id) const
 	return &_buffer[offset];
 }
 
+off_t RtpPacket::ExtensionOffset(uint8_t id) const
+{
+	auto it = _extension_buffer_offset.find(id);
+	if (it == _extension_buffer_offset.end())
+	{
+		return -1;
+	}
+
+	return it->second;
+}
+
 std::chrono::system_clock::time_point RtpPacket::GetCreatedTime()
 {
 	return _created_time;
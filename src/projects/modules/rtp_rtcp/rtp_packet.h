@@ -105,9 +105,13 @@ public:
 	uint8_t*	Header() const;
 	uint8_t*	Payload() const;
 	uint8_t* 	Extension(uint8_t id) const;
+	// Returns the offset of the extension in the buffer (-1 if not exists)
+	off_t		ExtensionOffset(uint8_t id) const;
 
 	// Data
 	std::shared_ptr<ov::Data> GetData() const;
+	// Copies only the packet data (not the parsed fields) into a new buffer that has tailroom bytes of spare capacity
+	std::shared_ptr<ov::Data> CloneData(size_t tailroom) const;
 	size_t GetDataLength() const;
 
 	// Created time
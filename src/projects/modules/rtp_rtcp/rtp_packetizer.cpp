@@ -180,7 +180,7 @@ bool RtpPacketizer::PacketizeVideo(cmn::MediaCodecId video_type,
 	for(size_t i = 0; i < num_packets; ++i)
 	{
 		bool last = (i + 1) == num_packets;
-		auto packet = last ? std::move(last_rtp_header) : std::make_shared<RtpPacket>(*rtp_header_template);
+		auto packet = last ? std::move(last_rtp_header) : ov::MakePooledShared<RtpPacket>(*rtp_header_template);
 
 		if(!AssignSequenceNumber(packet.get()))
 		{
@@ -319,14 +319,14 @@ bool RtpPacketizer::PacketizeAudio(FrameType frame_type,
 
 std::shared_ptr<RedRtpPacket> RtpPacketizer::PackageAsRed(std::shared_ptr<RtpPacket> rtp_packet)
 {
-	return std::make_shared<RedRtpPacket>(_red_payload_type, *rtp_packet);
+	return ov::MakePooledShared<RedRtpPacket>(_red_payload_type, *rtp_packet);
 }
 
 std::shared_ptr<RtpPacket> RtpPacketizer::AllocatePacket(bool ulpfec)
 {
 	if(ulpfec)
 	{
-		auto red_packet = std::make_shared<RedRtpPacket>();
+		auto red_packet = ov::MakePooledShared<RedRtpPacket>();
 		red_packet->SetSsrc(_ssrc);
 		red_packet->SetCsrcs(_csrcs);
 		red_packet->SetPayloadType(_ulpfec_payload_type);
@@ -337,7 +337,7 @@ std::shared_ptr<RtpPacket> RtpPacketizer::AllocatePacket(bool ulpfec)
 	}
 	else
 	{
-		auto rtp_packet = std::make_shared<RtpPacket>();
+		auto rtp_packet = ov::MakePooledShared<RtpPacket>();
 		rtp_packet->SetSsrc(_ssrc);
 		rtp_packet->SetCsrcs(_csrcs);
 		rtp_packet->SetPayloadType(_payload_type);
@@ -62,6 +62,8 @@ public:
 	bool Stop() override;
 
 	bool SendRtpPacket(const std::shared_ptr<RtpPacket> &packet);
+	// Sends data instead of packet->GetData() (e.g. the data of the packet rewritten for a session)
+	bool SendRtpPacket(const std::shared_ptr<RtpPacket> &packet, const std::shared_ptr<ov::Data> &data);
 	bool SendPLI(uint32_t track_id);
 	bool SendFIR(uint32_t track_id);
 
@@ -29,7 +29,7 @@ void UlpfecGenerator::SetHighRateProtection(bool high_level)
 
 bool UlpfecGenerator::AddRtpPacketAndGenerateFec(std::shared_ptr<RedRtpPacket> packet)
 {
-	auto copy_packet = std::make_shared<RedRtpPacket>(*packet);
+	auto copy_packet = ov::MakePooledShared<RedRtpPacket>(*packet);
 	_media_packets.push_back(copy_packet);
 
 	if(copy_packet->Marker())
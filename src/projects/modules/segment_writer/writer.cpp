@@ -791,8 +791,9 @@ bool Writer::WritePacket(const std::shared_ptr<const MediaPacket> &packet)
 			break;
 
 		case cmn::BitstreamFormat::H264_ANNEXB:
-			data = packet->GetData();
-			data = NalStreamConverter::ConvertAnnexbToXvcc(data, packet->GetFragHeader());
+			data = packet->GetConvertedData(cmn::BitstreamFormat::H264_AVCC, [&packet]() -> std::shared_ptr<const ov::Data> {
+				return NalStreamConverter::ConvertAnnexbToXvcc(packet->GetData(), packet->GetFragHeader());
+			});
 			if (data == nullptr)
 			{
 				logte("Could not convert packet: %d (writer type: %d)",
@@ -805,8 +806,9 @@ bool Writer::WritePacket(const std::shared_ptr<const MediaPacket> &packet)
 			break;
 
 		case cmn::BitstreamFormat::H265_ANNEXB:
-			data = packet->GetData();
-			data = NalStreamConverter::ConvertAnnexbToXvcc(data, packet->GetFragHeader());
+			data = packet->GetConvertedData(cmn::BitstreamFormat::HVCC, [&packet]() -> std::shared_ptr<const ov::Data> {
+				return NalStreamConverter::ConvertAnnexbToXvcc(packet->GetData(), packet->GetFragHeader());
+			});
 			if (data == nullptr)
 			{
 				logte("Could not convert packet: %d (writer type: %d)",
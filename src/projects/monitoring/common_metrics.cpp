@@ -8,11 +8,21 @@
 namespace mon
 {
 #define THROUGHPUT_MEASURE_INTERVAL 1
+#define LAST_TIME_UPDATE_INTERVAL_MS 100
+
+	static int64_t NowMSec()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	static std::chrono::system_clock::time_point ToTimePoint(int64_t time_ms)
+	{
+		return std::chrono::system_clock::time_point(std::chrono::milliseconds(time_ms));
+	}
 
 	CommonMetrics::CommonMetrics()
 	{
 		_total_bytes_in = 0;
-		_total_bytes_out = 0;
 		_total_connections = 0;
 		_max_total_connections = 0;
 
@@ -29,12 +39,11 @@ namespace mon
 		_last_throughput_measure_time = std::chrono::system_clock::now();
 
 		_max_total_connection_time = std::chrono::system_clock::now();
-		_last_recv_time = std::chrono::system_clock::now();
-		_last_sent_time = std::chrono::system_clock::now();
+		_last_recv_time_ms = NowMSec();
+		_last_sent_time_ms = NowMSec();
 
 		for (int i = 0; i < static_cast<int8_t>(PublisherType::NumberOfPublishers); i++)
 		{
-			_publisher_metrics[i]._bytes_out = 0;
 			_publisher_metrics[i]._connections = 0;
 		}
 		_created_time = std::chrono::system_clock::now();
@@ -91,9 +100,9 @@ namespace mon
 		return _created_time;
 	}
 
-	const std::chrono::system_clock::time_point& CommonMetrics::GetLastUpdatedTime() const
+	std::chrono::system_clock::time_point CommonMetrics::GetLastUpdatedTime() const
 	{
-		return _last_updated_time;
+		return ToTimePoint(_last_updated_time_ms.load(std::memory_order_relaxed));
 	}
 
 	uint64_t CommonMetrics::GetTotalBytesIn() const
@@ -102,7 +111,7 @@ namespace mon
 	}
 	uint64_t CommonMetrics::GetTotalBytesOut() const
 	{
-		return _total_bytes_out;
+		return _total_bytes_out.Load();
 	}
 
 	uint64_t CommonMetrics::GetAvgThroughputIn() const
@@ -151,17 +160,17 @@ namespace mon
 
 	std::chrono::system_clock::time_point CommonMetrics::GetLastRecvTime() const
 	{
-		return _last_recv_time;
+		return ToTimePoint(_last_recv_time_ms.load(std::memory_order_relaxed));
 	}
 
 	std::chrono::system_clock::time_point CommonMetrics::GetLastSentTime() const
 	{
-		return _last_sent_time;
+		return ToTimePoint(_last_sent_time_ms.load(std::memory_order_relaxed));
 	}
 
 	uint64_t CommonMetrics::GetBytesOut(PublisherType type) const
 	{
-		return _publisher_metrics[static_cast<int8_t>(type)]._bytes_out;
+		return _publisher_metrics[static_cast<int8_t>(type)]._bytes_out.Load();
 	}
 	uint64_t CommonMetrics::GetConnections(PublisherType type) const
 	{
@@ -170,14 +179,16 @@ namespace mon
 
 	void CommonMetrics::IncreaseBytesIn(uint64_t value)
 	{
+		auto now_ms = NowMSec();
+
 		_total_bytes_in += value;
-		_last_recv_time = std::chrono::system_clock::now();
+		UpdateTime(_last_recv_time_ms, now_ms);
 
 		// If there are no clients of the publisher, output throughput is not calculated.
 		// So, In/Oout throughput calculations are handled here.
 		UpdateThroughput();
 
-		UpdateDate();
+		UpdateTime(_last_updated_time_ms, now_ms);
 	}
 
 	void CommonMetrics::IncreaseBytesOut(PublisherType type, uint64_t value)
@@ -187,11 +198,16 @@ namespace mon
 			return;
 		}
 
-		_publisher_metrics[static_cast<int8_t>(type)]._bytes_out += value;
-		_total_bytes_out += value;
-		_last_sent_time = std::chrono::system_clock::now();
+		AddBytesOut(type, value, NowMSec());
+	}
 
-		UpdateDate();
+	void CommonMetrics::AddBytesOut(PublisherType type, uint64_t value, int64_t now_ms)
+	{
+		_publisher_metrics[static_cast<int8_t>(type)]._bytes_out.Add(value);
+		_total_bytes_out.Add(value);
+
+		UpdateTime(_last_sent_time_ms, now_ms);
+		UpdateTime(_last_updated_time_ms, now_ms);
 	}
 
 	void CommonMetrics::OnSessionConnected(PublisherType type)
@@ -226,7 +242,16 @@ namespace mon
 	// Renew last updated time
 	void CommonMetrics::UpdateDate()
 	{
-		_last_updated_time = std::chrono::system_clock::now();
+		_last_updated_time_ms.store(NowMSec(), std::memory_order_relaxed);
+	}
+
+	void CommonMetrics::UpdateTime(std::atomic<int64_t> &time_ms, int64_t now_ms)
+	{
+		// Only loaded for most packets
+		if ((now_ms - time_ms.load(std::memory_order_relaxed)) >= LAST_TIME_UPDATE_INTERVAL_MS)
+		{
+			time_ms.store(now_ms, std::memory_order_relaxed);
+		}
 	}
 
 	void CommonMetrics::UpdateThroughput()
@@ -248,15 +273,15 @@ namespace mon
 			_last_total_bytes_in.store(_total_bytes_in);
 
 			// Calculate last second throughput of publisher
-			_last_throughtput_out = (_total_bytes_out.load() - _last_total_bytes_out.load());
+			_last_throughtput_out = (_total_bytes_out.Load() - _last_total_bytes_out.load());
 
 			// Calculate average throughput of publisher
-			_avg_throughtput_out = (_total_bytes_out.load() - _last_total_bytes_out.load()) * 8 / THROUGHPUT_MEASURE_INTERVAL;
+			_avg_throughtput_out = (_total_bytes_out.Load() - _last_total_bytes_out.load()) * 8 / THROUGHPUT_MEASURE_INTERVAL;
 			if (_avg_throughtput_out.load() > _max_throughtput_out.load())
 			{
 				_max_throughtput_out.store(_avg_throughtput_out);
 			}
-			_last_total_bytes_out.store(_total_bytes_out);
+			_last_total_bytes_out.store(_total_bytes_out.Load());
 		}
 	}
 }  // namespace mon
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "base/common_types.h"
 #include "base/info/info.h"
 #include "base/info/stream.h"
+#include "sharded_counter.h"
 
 namespace mon
 {
@@ -18,7 +19,7 @@ namespace mon
 
 		uint32_t GetUnusedTimeSec() const;
 		const std::chrono::system_clock::time_point& GetCreatedTime() const;
-		const std::chrono::system_clock::time_point& GetLastUpdatedTime() const;
+		std::chrono::system_clock::time_point GetLastUpdatedTime() const;
 		
 		virtual uint64_t GetTotalBytesIn() const;
 		virtual uint64_t GetTotalBytesOut() const;
@@ -38,6 +39,8 @@ namespace mon
 		
 		virtual void IncreaseBytesIn(uint64_t value);
 		virtual void IncreaseBytesOut(PublisherType type, uint64_t value);
+		// Only updates this metrics (does not propagate to the linked metrics), used by StreamMetricsHandle
+		void AddBytesOut(PublisherType type, uint64_t value, int64_t now_ms);
 		virtual void OnSessionConnected(PublisherType type);
 		virtual void OnSessionDisconnected(PublisherType type);
 		virtual void OnSessionsDisconnected(PublisherType type, uint64_t number_of_sessions);
@@ -50,22 +53,29 @@ namespace mon
 		void UpdateDate();
 		void UpdateThroughput();
 
+		// The last updated/recv/sent times are written for every packet by many threads,
+		// so they are stored at most once per LAST_TIME_UPDATE_INTERVAL_MS to keep the cache line shared
+		static void UpdateTime(std::atomic<int64_t> &time_ms, int64_t now_ms);
+
 		std::chrono::system_clock::time_point _created_time;
-		std::chrono::system_clock::time_point _last_updated_time;
+		// Milliseconds since epoch
+		std::atomic<int64_t> _last_updated_time_ms;
 
 		// From Provider
 		std::atomic<uint64_t> _total_bytes_in;
 
 		// From Publishers
-		std::atomic<uint64_t> _total_bytes_out;
+		// Increased for every packet sent to every session, so it is sharded per thread
+		ShardedCounter _total_bytes_out;
 
 		std::atomic<uint32_t> _total_connections;
 		std::atomic<uint32_t> _max_total_connections;
 		// Time to reach maximum number of connections. 
 		// TODO(Getroot): Does it need mutex? Check!
 		std::chrono::system_clock::time_point	_max_total_connection_time;
-		std::chrono::system_clock::time_point	_last_recv_time;
-		std::chrono::system_clock::time_point	_last_sent_time;
+		// Milliseconds since epoch
+		std::atomic<int64_t> _last_recv_time_ms;
+		std::atomic<int64_t> _last_sent_time_ms;
 
 		// Throughput from Provider
 		std::atomic<uint64_t> _avg_throughtput_in;
@@ -87,7 +97,7 @@ namespace mon
 		class PublisherMetrics
 		{
 		public:
-			std::atomic<uint64_t> _bytes_out;
+			ShardedCounter _bytes_out;
 			std::atomic<uint32_t> _connections;
 		};
 
@@ -0,0 +1,143 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "latency_metrics.h"
+
+#include <cmath>
+
+#include "monitoring_private.h"
+
+namespace mon
+{
+	size_t LatencyHistogram::GetBucketIndex(uint64_t value)
+	{
+		if (value < SubBucketCount)
+		{
+			return static_cast<size_t>(value);
+		}
+
+		value = std::min<uint64_t>(value, UINT32_MAX);
+
+		size_t exponent = 63 - __builtin_clzll(value);
+		size_t sub_index = (value >> (exponent - SubBucketBits)) & (SubBucketCount - 1);
+
+		return SubBucketCount + ((exponent - SubBucketBits) * SubBucketCount) + sub_index;
+	}
+
+	int64_t LatencyHistogram::GetBucketValue(size_t index)
+	{
+		if (index < SubBucketCount)
+		{
+			return static_cast<int64_t>(index);
+		}
+
+		size_t shift = (index - SubBucketCount) / SubBucketCount;
+		size_t sub_index = (index - SubBucketCount) % SubBucketCount;
+
+		int64_t lower = static_cast<int64_t>(SubBucketCount + sub_index) << shift;
+		int64_t width = static_cast<int64_t>(1) << shift;
+
+		return lower + (width / 2);
+	}
+
+	void LatencyHistogram::Record(int64_t latency_us)
+	{
+		latency_us = std::max<int64_t>(latency_us, 0);
+
+		_buckets[GetBucketIndex(latency_us)].fetch_add(1, std::memory_order_relaxed);
+		_count.fetch_add(1, std::memory_order_relaxed);
+
+		auto max = _max.load(std::memory_order_relaxed);
+		while ((latency_us > max) && (_max.compare_exchange_weak(max, latency_us, std::memory_order_relaxed) == false))
+		{
+		}
+	}
+
+	uint64_t LatencyHistogram::GetCount() const
+	{
+		return _count.load(std::memory_order_relaxed);
+	}
+
+	int64_t LatencyHistogram::GetPercentile(double percentile) const
+	{
+		auto count = GetCount();
+		if (count == 0)
+		{
+			return 0;
+		}
+
+		auto target = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(count * percentile / 100.0)), 1);
+		uint64_t accumulated = 0;
+
+		for (size_t index = 0; index < BucketCount; index++)
+		{
+			accumulated += _buckets[index].load(std::memory_order_relaxed);
+
+			if (accumulated >= target)
+			{
+				return std::min(GetBucketValue(index), GetMax());
+			}
+		}
+
+		return GetMax();
+	}
+
+	int64_t LatencyHistogram::GetMax() const
+	{
+		return _max.load(std::memory_order_relaxed);
+	}
+
+	LatencyMetrics::LatencyMetrics(size_t max_sampled_traces)
+		: _max_sampled_traces(max_sampled_traces)
+	{
+	}
+
+	void LatencyMetrics::Record(MediaTrace::Hop hop, int64_t latency_ns)
+	{
+		_histograms[static_cast<size_t>(hop)].Record(latency_ns / 1000);
+	}
+
+	void LatencyMetrics::RecordTrace(const MediaTrace &trace)
+	{
+		for (size_t index = 0; index < MediaTrace::HopCount; index++)
+		{
+			auto hop = static_cast<MediaTrace::Hop>(index);
+			auto latency = trace.GetLatency(hop);
+
+			if (latency >= 0)
+			{
+				Record(hop, latency);
+			}
+		}
+
+		if (_max_sampled_traces == 0)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(_sampled_traces_lock);
+
+		if (_sampled_traces.size() >= _max_sampled_traces)
+		{
+			_sampled_traces.pop_front();
+		}
+
+		_sampled_traces.push_back({++_last_sequence, trace});
+	}
+
+	const LatencyHistogram &LatencyMetrics::GetHistogram(MediaTrace::Hop hop) const
+	{
+		return _histograms[static_cast<size_t>(hop)];
+	}
+
+	std::vector<LatencyMetrics::SampledTrace> LatencyMetrics::GetSampledTraces() const
+	{
+		std::lock_guard<std::mutex> lock(_sampled_traces_lock);
+		return std::vector<SampledTrace>(_sampled_traces.begin(), _sampled_traces.end());
+	}
+}  // namespace mon
@@ -0,0 +1,77 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/mediarouter/media_trace.h>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace mon
+{
+	// Histogram of latencies in microseconds
+	//
+	// Values under 8us have their own buckets, and each power of two above is split into 8 buckets,
+	// so a percentile is accurate within about 6%. Recording is a few relaxed atomic operations.
+	class LatencyHistogram
+	{
+	public:
+		static constexpr size_t SubBucketBits = 3;
+		static constexpr size_t SubBucketCount = 1 << SubBucketBits;
+		// Up to 2^32us (about 71 minutes)
+		static constexpr size_t BucketCount = SubBucketCount + (32 - SubBucketBits) * SubBucketCount;
+
+		void Record(int64_t latency_us);
+
+		uint64_t GetCount() const;
+		// percentile: 0 ~ 100
+		int64_t GetPercentile(double percentile) const;
+		int64_t GetMax() const;
+
+	private:
+		static size_t GetBucketIndex(uint64_t value);
+		// Middle of the bucket
+		static int64_t GetBucketValue(size_t index);
+
+		std::array<std::atomic<uint64_t>, BucketCount> _buckets{};
+		std::atomic<uint64_t> _count{0};
+		std::atomic<int64_t> _max{0};
+	};
+
+	// Latency of each hop of the media pipeline (see MediaTrace) of a stream, and the recently sampled traces
+	class LatencyMetrics
+	{
+	public:
+		struct SampledTrace
+		{
+			uint64_t sequence;
+			MediaTrace trace;
+		};
+
+		LatencyMetrics(size_t max_sampled_traces);
+
+		void Record(MediaTrace::Hop hop, int64_t latency_ns);
+		// Records the latency of each hop stamped in the trace and keeps the trace for GetSampledTraces()
+		void RecordTrace(const MediaTrace &trace);
+
+		const LatencyHistogram &GetHistogram(MediaTrace::Hop hop) const;
+		std::vector<SampledTrace> GetSampledTraces() const;
+
+	private:
+		std::array<LatencyHistogram, MediaTrace::HopCount> _histograms;
+
+		size_t _max_sampled_traces = 0;
+		mutable std::mutex _sampled_traces_lock;
+		std::deque<SampledTrace> _sampled_traces;
+		uint64_t _last_sequence = 0;
+	};
+}  // namespace mon
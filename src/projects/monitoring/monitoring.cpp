@@ -59,6 +59,62 @@ namespace mon
 		return stream_metric;
 	}
 
+	std::vector<std::shared_ptr<CommonMetrics>> Monitoring::ResolveStreamMetricsList(const info::Stream &stream_info)
+	{
+		auto host_metric = _server_metric->GetHostMetrics(stream_info.GetApplicationInfo().GetHostInfo());
+		if (host_metric == nullptr)
+		{
+			return {};
+		}
+		auto app_metric = host_metric->GetApplicationMetrics(stream_info.GetApplicationInfo());
+		if (app_metric == nullptr)
+		{
+			return {};
+		}
+		auto stream_metric = app_metric->GetStreamMetrics(stream_info);
+		if (stream_metric == nullptr)
+		{
+			return {};
+		}
+
+		std::vector<std::shared_ptr<CommonMetrics>> metrics_list = {_server_metric, host_metric, app_metric, stream_metric};
+
+		// Same as StreamMetrics::IncreaseBytesOut(), the bytes are also counted in the origin streams
+		auto origin_stream_info = stream_metric->GetLinkedInputStream();
+		while (origin_stream_info != nullptr)
+		{
+			auto origin_stream_metric = app_metric->GetStreamMetrics(*origin_stream_info);
+			if (origin_stream_metric == nullptr)
+			{
+				break;
+			}
+
+			metrics_list.push_back(origin_stream_metric);
+			origin_stream_info = origin_stream_metric->GetLinkedInputStream();
+		}
+
+		return metrics_list;
+	}
+
+	std::shared_ptr<StreamMetricsHandle> Monitoring::GetStreamMetricsHandle(const std::shared_ptr<const info::Stream> &stream_info, PublisherType type)
+	{
+		if (stream_info == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto handle = std::make_shared<StreamMetricsHandle>(type, _stream_metrics_generation, [this, stream_info]() {
+			return ResolveStreamMetricsList(*stream_info);
+		});
+
+		if (handle->IsResolved() == false)
+		{
+			return nullptr;
+		}
+
+		return handle;
+	}
+
 	void Monitoring::SetLogPath(const ov::String &log_path)
 	{
 		_logger.SetLogPath(log_path);
@@ -72,6 +128,15 @@ namespace mon
 
 		_alert.Start(server_config);
 
+		auto &latency_trace_config = server_config->GetModules().GetLatencyTrace();
+		if (latency_trace_config.IsEnabled())
+		{
+			MediaTrace::Enable(latency_trace_config.GetSampleInterval(), latency_trace_config.GetMaxSampledTraces());
+
+			logti("Latency trace is enabled - sample interval: %d, max sampled traces: %d",
+				  latency_trace_config.GetSampleInterval(), latency_trace_config.GetMaxSampledTraces());
+		}
+
 		logti("%s(%s) ServerMetric has been started for monitoring - %s",
 			server_config->GetName().CStr(), server_config->GetID().CStr(),
 			ov::Converter::ToISO8601String(_server_metric->GetServerStartedTime()).CStr());
@@ -200,6 +265,8 @@ namespace mon
 			return false;
 		}
 
+		_stream_metrics_generation++;
+
 		// Writes events only based on the input stream.
 		std::shared_ptr<StreamMetrics> stream_metrics = nullptr;
 		EventType event_type = EventType::StreamCreated;
@@ -269,6 +336,8 @@ namespace mon
 			{
 				return false;
 			}
+
+			_stream_metrics_generation++;
 		}
 		
 		if(IsAnalyticsOn())
@@ -7,6 +7,7 @@
 #include "base/ovlibrary/delay_queue.h"
 #include "base/info/info.h"
 #include "server_metrics.h"
+#include "stream_metrics_handle.h"
 #include "event_logger.h"
 #include "event_forwarder.h"
 #include "./alert/alert.h"
@@ -41,6 +42,8 @@ namespace mon
 		std::shared_ptr<HostMetrics> GetHostMetrics(const info::Host &host_info);
         std::shared_ptr<ApplicationMetrics> GetApplicationMetrics(const info::Application &app_info);
         std::shared_ptr<StreamMetrics>  GetStreamMetrics(const info::Stream &stream_info);
+		// Returns nullptr if the metrics of the stream is not found
+		std::shared_ptr<StreamMetricsHandle> GetStreamMetricsHandle(const std::shared_ptr<const info::Stream> &stream_info, PublisherType type);
 
 		// Events
 		void OnServerStarted(const std::shared_ptr<const cfg::Server> &server_config);
@@ -59,6 +62,9 @@ namespace mon
 		void OnSessionsDisconnected(const info::Stream &stream_info, PublisherType type, uint64_t number_of_sessions);
 
 	private:
+		// server, host, application, stream and its origin streams
+		std::vector<std::shared_ptr<CommonMetrics>> ResolveStreamMetricsList(const info::Stream &stream_info);
+
 		ov::DelayQueue _timer{"MonLogTimer"};
 		std::shared_ptr<ServerMetrics> _server_metric = nullptr;
 		EventLogger	_logger;
@@ -66,5 +72,8 @@ namespace mon
 		alrt::Alert _alert;
 		bool _is_analytics_on = false;
 
+		// Increased when a stream metrics is created or deleted, so StreamMetricsHandle resolves the origin chain again
+		std::atomic<uint64_t> _stream_metrics_generation{0};
+
 	};
 }  // namespace mon
\ No newline at end of file
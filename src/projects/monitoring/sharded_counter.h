@@ -0,0 +1,74 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace mon
+{
+	// Counter that is increased by many threads and read rarely (REST API, EventForwarder, logging)
+	//
+	// Each thread increases its own cache-line-padded shard, so the threads do not bounce the same cache line.
+	// The shards are summed only when the value is read.
+	class ShardedCounter
+	{
+	public:
+		static constexpr size_t ShardCount = 16;
+
+		ShardedCounter() = default;
+		ShardedCounter(const ShardedCounter &) = delete;
+		ShardedCounter &operator=(const ShardedCounter &) = delete;
+
+		void Add(uint64_t value)
+		{
+			_shards[GetShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		uint64_t Load() const
+		{
+			uint64_t sum = 0;
+
+			for (const auto &shard : _shards)
+			{
+				sum += shard.value.load(std::memory_order_relaxed);
+			}
+
+			return sum;
+		}
+
+		operator uint64_t() const
+		{
+			return Load();
+		}
+
+		ShardedCounter &operator+=(uint64_t value)
+		{
+			Add(value);
+			return *this;
+		}
+
+	private:
+		static size_t GetShardIndex()
+		{
+			static std::atomic<size_t> next_index{0};
+			// Threads are assigned to the shards in a round-robin manner when they increase a counter for the first time
+			thread_local size_t index = next_index.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+
+			return index;
+		}
+
+		struct alignas(64) Shard
+		{
+			std::atomic<uint64_t> value{0};
+		};
+
+		Shard _shards[ShardCount];
+	};
+}  // namespace mon
@@ -63,6 +63,88 @@ namespace mon
 		UpdateDate();
 	}
 
+	void StreamMetrics::OnDecodedFrameShared(uint32_t count, uint64_t bytes)
+	{
+		_shared_decoded_frame_count += count;
+		_shared_decoded_frame_bytes += bytes;
+	}
+
+	void StreamMetrics::OnDecodedFrameCopied(uint64_t bytes)
+	{
+		_copied_decoded_frame_count++;
+		_copied_decoded_frame_bytes += bytes;
+	}
+
+	uint64_t StreamMetrics::GetSharedDecodedFrameCount() const
+	{
+		return _shared_decoded_frame_count;
+	}
+
+	uint64_t StreamMetrics::GetSharedDecodedFrameBytes() const
+	{
+		return _shared_decoded_frame_bytes;
+	}
+
+	uint64_t StreamMetrics::GetCopiedDecodedFrameCount() const
+	{
+		return _copied_decoded_frame_count;
+	}
+
+	uint64_t StreamMetrics::GetCopiedDecodedFrameBytes() const
+	{
+		return _copied_decoded_frame_bytes;
+	}
+
+	std::shared_ptr<LatencyMetrics> StreamMetrics::GetLatencyMetrics()
+	{
+		if (MediaTrace::IsEnabled() == false)
+		{
+			return nullptr;
+		}
+
+		std::call_once(_latency_metrics_once, [this]() {
+			_latency_metrics = std::make_shared<LatencyMetrics>(MediaTrace::GetMaxSampledTraces());
+		});
+
+		return _latency_metrics;
+	}
+
+	std::shared_ptr<LatencyHistogram> StreamMetrics::GetPacingErrorHistogram()
+	{
+		std::lock_guard<std::mutex> lock(_lazy_metrics_mutex);
+
+		if (_pacing_error_histogram == nullptr)
+		{
+			_pacing_error_histogram = std::make_shared<LatencyHistogram>();
+		}
+
+		return _pacing_error_histogram;
+	}
+
+	std::shared_ptr<const LatencyHistogram> StreamMetrics::PeekPacingErrorHistogram() const
+	{
+		std::lock_guard<std::mutex> lock(_lazy_metrics_mutex);
+		return _pacing_error_histogram;
+	}
+
+	std::shared_ptr<ItemTransitionMetrics> StreamMetrics::GetItemTransitionMetrics()
+	{
+		std::lock_guard<std::mutex> lock(_lazy_metrics_mutex);
+
+		if (_item_transition_metrics == nullptr)
+		{
+			_item_transition_metrics = std::make_shared<ItemTransitionMetrics>();
+		}
+
+		return _item_transition_metrics;
+	}
+
+	std::shared_ptr<const ItemTransitionMetrics> StreamMetrics::PeekItemTransitionMetrics() const
+	{
+		std::lock_guard<std::mutex> lock(_lazy_metrics_mutex);
+		return _item_transition_metrics;
+	}
+
 	void StreamMetrics::IncreaseBytesIn(uint64_t value)
 	{
 		CommonMetrics::IncreaseBytesIn(value);
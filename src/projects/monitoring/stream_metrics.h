@@ -9,10 +9,24 @@
 #include "base/info/info.h"
 #include "base/info/stream.h"
 #include "common_metrics.h"
+#include "latency_metrics.h"
 
 namespace mon
 {
 	class ApplicationMetrics;
+
+	// Transitions between the items of a Scheduled channel
+	struct ItemTransitionMetrics
+	{
+		// Wall time from the last packet of an item to the first packet of the next item queued (us)
+		LatencyHistogram gap;
+		// Time to open and probe a file item (us)
+		LatencyHistogram probe_time;
+		// File items opened ahead by the prefetcher, and the ones opened when the transition began
+		std::atomic<uint64_t> prefetched_count{0};
+		std::atomic<uint64_t> not_prefetched_count{0};
+	};
+
 	class StreamMetrics : public info::Stream, public CommonMetrics
 	{
 	public:
@@ -47,6 +61,26 @@ namespace mon
 		void SetOriginConnectionTimeMSec(int64_t value);
 		void SetOriginSubscribeTimeMSec(int64_t value);
 
+		// nullptr if Modules.LatencyTrace is disabled
+		std::shared_ptr<LatencyMetrics> GetLatencyMetrics();
+
+		// Decoded frames of the transcoder shared by the filters (by reference) or copied
+		void OnDecodedFrameShared(uint32_t count, uint64_t bytes);
+		void OnDecodedFrameCopied(uint64_t bytes);
+		uint64_t GetSharedDecodedFrameCount() const;
+		uint64_t GetSharedDecodedFrameBytes() const;
+		uint64_t GetCopiedDecodedFrameCount() const;
+		uint64_t GetCopiedDecodedFrameBytes() const;
+
+		// Actual send time - target send time (us) of the packets paced by PacingEngine (Scheduled, File)
+		std::shared_ptr<LatencyHistogram> GetPacingErrorHistogram();
+		// nullptr if the stream has never been paced
+		std::shared_ptr<const LatencyHistogram> PeekPacingErrorHistogram() const;
+
+		std::shared_ptr<ItemTransitionMetrics> GetItemTransitionMetrics();
+		// nullptr if the stream has never played an item of a schedule
+		std::shared_ptr<const ItemTransitionMetrics> PeekItemTransitionMetrics() const;
+
 		// Overriding from CommonMetrics 
 		void IncreaseBytesIn(uint64_t value) override;
 		void IncreaseBytesOut(PublisherType type, uint64_t value) override;
@@ -61,6 +95,18 @@ namespace mon
 		// If this stream is from Provider(input stream) it has multiple output streams
 		std::vector<std::shared_ptr<StreamMetrics>> _output_stream_metrics;
 
+		std::atomic<uint64_t> _shared_decoded_frame_count = 0;
+		std::atomic<uint64_t> _shared_decoded_frame_bytes = 0;
+		std::atomic<uint64_t> _copied_decoded_frame_count = 0;
+		std::atomic<uint64_t> _copied_decoded_frame_bytes = 0;
+
+		std::once_flag _latency_metrics_once;
+		std::shared_ptr<LatencyMetrics> _latency_metrics;
+
+		mutable std::mutex _lazy_metrics_mutex;
+		std::shared_ptr<LatencyHistogram> _pacing_error_histogram;
+		std::shared_ptr<ItemTransitionMetrics> _item_transition_metrics;
+
 		std::shared_ptr<ApplicationMetrics>	_app_metrics;
 	};
 }
\ No newline at end of file
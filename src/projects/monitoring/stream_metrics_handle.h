@@ -0,0 +1,85 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+#include "base/common_types.h"
+#include "common_metrics.h"
+
+namespace mon
+{
+	// Pre-resolved metrics of a stream for a publisher session
+	//
+	// Monitoring::IncreaseBytesOut() looks up the host, application and stream metrics (and the linked origin streams) on every call.
+	// A session that sends many packets gets this handle once and increases the counters of all of them directly.
+	// When a stream is created or deleted (the origin stream may have been relinked), the list is resolved again.
+	class StreamMetricsHandle
+	{
+	public:
+		// Returns the metrics of the server, host, application, stream and its origin streams
+		using Resolver = std::function<std::vector<std::shared_ptr<CommonMetrics>>()>;
+
+		StreamMetricsHandle(PublisherType type, const std::atomic<uint64_t> &generation, Resolver resolver)
+			: _type(type),
+			  _generation(generation),
+			  _resolver(std::move(resolver))
+		{
+			Resolve();
+		}
+
+		PublisherType GetPublisherType() const
+		{
+			return _type;
+		}
+
+		bool IsResolved() const
+		{
+			return _metrics_list.empty() == false;
+		}
+
+		// Called from the thread of the session
+		void IncreaseBytesOut(uint64_t value)
+		{
+			if (value == 0)
+			{
+				return;
+			}
+
+			if (_generation.load(std::memory_order_acquire) != _resolved_generation)
+			{
+				Resolve();
+			}
+
+			auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+			for (const auto &metrics : _metrics_list)
+			{
+				metrics->AddBytesOut(_type, value, now_ms);
+			}
+		}
+
+	private:
+		void Resolve()
+		{
+			// Loaded before resolving, so a change during resolving is picked up by the next call
+			_resolved_generation = _generation.load(std::memory_order_acquire);
+			_metrics_list = _resolver();
+		}
+
+		PublisherType _type;
+
+		const std::atomic<uint64_t> &_generation;
+		uint64_t _resolved_generation = 0;
+		Resolver _resolver;
+
+		std::vector<std::shared_ptr<CommonMetrics>> _metrics_list;
+	};
+}  // namespace mon
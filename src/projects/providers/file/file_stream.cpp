@@ -17,6 +17,9 @@
 #include "file_private.h"
 #include "file_provider.h"
 
+// How far ahead of the real time the packets are read and queued to the pacer
+#define FILE_PACING_LEAD_MS 200
+
 namespace pvd
 {
 	std::shared_ptr<FileStream> FileStream::Create(const std::shared_ptr<pvd::PullApplication> &application,
@@ -51,6 +54,11 @@ namespace pvd
 	{
 		PullStream::Stop();
 		Release();
+
+		if (_pacer != nullptr)
+		{
+			_pacer->Close();
+		}
 	}
 
 	std::shared_ptr<pvd::FileProvider> FileStream::GetFileProvider()
@@ -111,6 +119,21 @@ namespace pvd
 			_stream_metrics->SetOriginSubscribeTimeMSec(_origin_response_time_msec);
 		}
 
+		if (_pacer == nullptr)
+		{
+			_pacer = PacingEngine::GetInstance()->CreatePacer(
+				(_stream_metrics != nullptr) ? _stream_metrics->GetPacingErrorHistogram() : nullptr,
+				[this](const std::shared_ptr<MediaPacket> &packet) {
+					SendFrame(packet);
+				});
+
+			if (_pacer == nullptr)
+			{
+				SetState(State::ERROR);
+				return false;
+			}
+		}
+
 		return true;
 	}
 
@@ -275,7 +298,7 @@ namespace pvd
 			if (codec_id == cmn::MediaCodecId::H264)
 			{
 				// @extradata == AVCDecoderConfigurationRecord
-				auto media_packet = std::make_shared<MediaPacket>(
+				auto media_packet = ov::MakePooledShared<MediaPacket>(
 					GetMsid(),
 					media_type,
 					track->GetId(),
@@ -290,7 +313,7 @@ namespace pvd
 			else if (codec_id == cmn::MediaCodecId::Aac)
 			{
 				// @extradata == AudioSpecificConfig
-				auto media_packet = std::make_shared<MediaPacket>(
+				auto media_packet = ov::MakePooledShared<MediaPacket>(
 					GetMsid(),
 					media_type,
 					track->GetId(),
@@ -416,11 +439,15 @@ namespace pvd
 
 			UpdateNextTimestamp(media_packet);
 
-			// Send to MediaRouter
-			SendFrame(std::move(media_packet));
-
 			// Real-time processing - It treats the packet the same as the real time.
-			if (_play_request_time.Elapsed() < (static_cast<int64_t>(static_cast<double>(media_packet->GetDts()) * track->GetTimeBase().GetExpr() * 1000)))
+			auto dts_us = static_cast<int64_t>(static_cast<double>(media_packet->GetDts()) * track->GetTimeBase().GetExpr() * 1000000);
+			auto wait_time_us = std::max<int64_t>(dts_us - _play_request_time.ElapsedUs(), 0);
+
+			// Send to MediaRouter when the real time reaches the DTS
+			_pacer->Push(media_packet, std::chrono::steady_clock::now() + std::chrono::microseconds(wait_time_us));
+
+			// Read ahead up to the lead, the rest is read at the next interval
+			if (wait_time_us > (FILE_PACING_LEAD_MS * 1000))
 			{
 				break;
 			}
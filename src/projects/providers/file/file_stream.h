@@ -14,6 +14,7 @@
 #include <base/ovlibrary/lip_sync_clock.h>
 #include <base/provider/pull_provider/application.h>
 #include <base/provider/pull_provider/stream.h>
+#include <base/provider/pacing_engine.h>
 #include <modules/rtp_rtcp/rtp_depacketizing_manager.h>
 #include <modules/rtp_rtcp/rtp_rtcp.h>
 #include <modules/rtsp/header_fields/rtsp_header_fields.h>
@@ -76,6 +77,8 @@ namespace pvd
 		AVFormatContext *_format_context;
 
 		ov::StopWatch _play_request_time;
+		// Sends the packets at the time of their DTS
+		std::shared_ptr<PacingEngine::Pacer> _pacer;
 
 		bool _sent_sequence_header = false;
 		
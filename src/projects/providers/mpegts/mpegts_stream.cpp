@@ -144,7 +144,7 @@ namespace pvd
 					}
 
 					auto data = std::make_shared<ov::Data>(es->Payload(), es->PayloadLength());
-					auto media_packet = std::make_shared<MediaPacket>(GetMsid(),
+					auto media_packet = ov::MakePooledShared<MediaPacket>(GetMsid(),
 																	  cmn::MediaType::Video,
 																	  es->PID(),
 																	  data,
@@ -160,7 +160,7 @@ namespace pvd
 					auto payload_length = es->PayloadLength();
 
 					auto data = std::make_shared<ov::Data>(payload, payload_length);
-					auto media_packet = std::make_shared<MediaPacket>(GetMsid(),
+					auto media_packet = ov::MakePooledShared<MediaPacket>(GetMsid(),
 																	  cmn::MediaType::Audio,
 																	  es->PID(),
 																	  data,
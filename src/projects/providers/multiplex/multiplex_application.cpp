@@ -39,13 +39,28 @@ namespace pvd
 
         _multiplex_files_path = ov::GetDirPath(config.GetMuxFilesDir(), cfg::ConfigManager::GetInstance()->GetConfigPath());
         _multiplex_file_name_regex = ov::Regex::CompiledRegex(ov::Regex::WildCardRegex(ov::String::FormatString("*.%s", MultiplexFileExtension)));
-        
+
+        if (_worker_pool->Start(std::max(config.GetWorkerCount(), 1)) == false)
+        {
+            logte("Could not start multiplex workers: %s", GetVHostAppName().CStr());
+            return false;
+        }
+
         return Application::Start();
     }
 
     bool MultiplexApplication::Stop()
     {
-        return Application::Stop();
+        auto result = Application::Stop();
+
+        _worker_pool->Stop();
+
+        return result;
+    }
+
+    std::shared_ptr<MultiplexWorkerPool> MultiplexApplication::GetWorkerPool() const
+    {
+        return _worker_pool;
     }
 
     std::map<ov::String, std::shared_ptr<MultiplexStream>> MultiplexApplication::GetMultiplexStreams()
@@ -14,6 +14,7 @@
 
 #include "multiplex_profile.h"
 #include "multiplex_stream.h"
+#include "multiplex_worker_pool.h"
 
 namespace pvd
 {
@@ -30,6 +31,8 @@ namespace pvd
 
         void OnMultiplexWatcherTick();
 
+        std::shared_ptr<MultiplexWorkerPool> GetWorkerPool() const;
+
         // Get mux stream
         std::shared_ptr<MultiplexStream> GetMultiplexStream(const ov::String &stream_name);
         std::map<ov::String, std::shared_ptr<MultiplexStream>> GetMultiplexStreams();
@@ -59,5 +62,7 @@ namespace pvd
 
         std::map<ov::String, std::shared_ptr<MultiplexStream>> _multiplex_streams;
         std::shared_mutex _multiplex_streams_mutex;
+
+        std::shared_ptr<MultiplexWorkerPool> _worker_pool = std::make_shared<MultiplexWorkerPool>();
     };
 }
\ No newline at end of file
@@ -8,10 +8,16 @@
 //==============================================================================
 
 #include "multiplex_stream.h"
+#include "multiplex_application.h"
 #include "multiplex_private.h"
 
 #include <base/provider/application.h>
 
+// Maximum time to wait for the packets of an idle source before sending the packets of the others
+#define MULTIPLEX_INTERLEAVING_WINDOW_MS 100
+// The packets are sent regardless of the window if too many packets are pending
+#define MULTIPLEX_MAX_PENDING_PACKET_COUNT 1000
+
 namespace pvd
 {
     // Implementation of MultiplexStream
@@ -33,10 +39,23 @@ namespace pvd
 
     bool MultiplexStream::Start()
     {
-        // Create Worker
-        _worker_thread_running = true;
-        _worker_thread = std::thread(&MultiplexStream::WorkerThread, this);
-        pthread_setname_np(_worker_thread.native_handle(), "Multiplex");
+        auto application = std::dynamic_pointer_cast<MultiplexApplication>(GetApplication());
+        if (application == nullptr)
+        {
+            return false;
+        }
+
+        // Run by the worker pool of the application
+        _worker_pool = application->GetWorkerPool();
+        _next_pull_time = std::chrono::steady_clock::now();
+
+        if (_worker_pool->Attach(std::static_pointer_cast<MultiplexStream>(GetSharedPtr())) == false)
+        {
+            logte("Multiplex Channel : %s/%s: Could not attach to the worker pool", GetApplicationName(), GetName().CStr());
+            return false;
+        }
+
+        _is_attached = true;
 
         return Stream::Start();
     }
@@ -45,17 +64,15 @@ namespace pvd
     {
         ReleaseSourceStreams();
 
-        if (_worker_thread_running == false)
+        if (_is_attached == false)
         {
             return true;
         }
 
-        _worker_thread_running = false;
+        _is_attached = false;
+        _worker_pool->Detach(this);
 
-        if (_worker_thread.joinable())
-        {
-            _worker_thread.join();
-        }
+        logti("Multiplex Channel : %s/%s: Worker stopped", GetApplicationName(), GetName().CStr());
 
         return Stream::Stop();
     }
@@ -100,42 +117,56 @@ namespace pvd
         return _multiplex_profile;
     }
 
-    void MultiplexStream::WorkerThread()
+    std::chrono::steady_clock::time_point MultiplexStream::Run(const std::shared_ptr<MediaRouterStreamTapSet> &tap_set)
     {
-        while (_worker_thread_running)
+        auto now = std::chrono::steady_clock::now();
+
+        if (_mux_state == MuxState::Stopped)
         {
+            return std::chrono::steady_clock::time_point::max();
+        }
+
+        if (_mux_state != MuxState::Playing)
+        {
+            if (now < _next_pull_time)
+            {
+                return _next_pull_time;
+            }
+
             _mux_state = MuxState::Pulling;
-            if (PullSourceStreams() == false)
+            if (PullSourceStreams(tap_set) == false)
             {
-                // sleep and retry
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-                continue;
+                // retry later
+                _next_pull_time = now + std::chrono::seconds(1);
+                return _next_pull_time;
             }
 
-            break;
+            _mux_state = MuxState::Playing;
         }
 
-        while (_worker_thread_running)
+        // Move the packets from the taps to the source queues
+        auto source_streams = _multiplex_profile->GetSourceStreams();
+        for (auto &source_stream : source_streams)
         {
-            _mux_state = MuxState::Playing;
-            bool break_loop = false;
-            // Get Streams and Push
-            auto source_streams = _multiplex_profile->GetSourceStreams();
-            for (auto &source_stream : source_streams)
+            auto stream_tap = source_stream->GetStreamTap();
+            if (stream_tap == nullptr || stream_tap->GetState() != MediaRouterStreamTap::State::Tapped)
             {
-                auto stream_tap = source_stream->GetStreamTap();
-                if (stream_tap == nullptr || stream_tap->GetState() != MediaRouterStreamTap::State::Tapped)
-                {
-                    logte("Multiplex Channel : %s/%s: Stream [%s] is untapped", GetApplicationName(), GetName().CStr(), source_stream->GetUrlStr().CStr());
-                    Terminate();
-                    break_loop = true;
-                    break;
-                }
+                logte("Multiplex Channel : %s/%s: Stream [%s] is untapped", GetApplicationName(), GetName().CStr(), source_stream->GetUrlStr().CStr());
+                Terminate();
 
+                _mux_state = MuxState::Stopped;
+                return std::chrono::steady_clock::time_point::max();
+            }
+
+            auto &source_queue = _source_queues[stream_tap->GetId()];
+            auto stream_info = stream_tap->GetStreamInfo();
+
+            while (true)
+            {
                 auto media_packet = stream_tap->Pop(0);
                 if (media_packet == nullptr)
                 {
-                    continue;
+                    break;
                 }
 
                 auto source_track_id = MakeSourceTrackIdUnique(stream_tap->GetId(), media_packet->GetTrackId());
@@ -145,18 +176,71 @@ namespace pvd
                     continue;
                 }
 
+                auto source_track = (stream_info != nullptr) ? stream_info->GetTrack(media_packet->GetTrackId()) : nullptr;
+                auto time_base = (source_track != nullptr) ? source_track->GetTimeBase().GetExpr() : 0.0;
+                auto dts_us = static_cast<int64_t>(media_packet->GetDts() * time_base * 1000000.0);
+                auto arrival_us = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+
+                // Sources start at different timestamps, so the DTS of each source is mapped to the time its first packet arrived
+                if (source_queue.is_anchored == false)
+                {
+                    source_queue.is_anchored = true;
+                    source_queue.first_dts_us = dts_us;
+                    source_queue.first_arrival_us = arrival_us;
+                }
+
                 media_packet->SetTrackId(new_track_id);
 
-                SendFrame(media_packet);
+                source_queue.packets.push_back({media_packet, source_queue.first_arrival_us + (dts_us - source_queue.first_dts_us), now});
+                _pending_packet_count++;
             }
+        }
+
+        return SendInterleavedPackets();
+    }
 
-            if (break_loop)
+    std::chrono::steady_clock::time_point MultiplexStream::SendInterleavedPackets()
+    {
+        while (_pending_packet_count > 0)
+        {
+            SourceQueue *earliest_queue = nullptr;
+            bool has_empty_queue = false;
+
+            for (auto &[tap_id, source_queue] : _source_queues)
             {
-                break;
+                if (source_queue.packets.empty())
+                {
+                    has_empty_queue = true;
+                    continue;
+                }
+
+                if ((earliest_queue == nullptr) || (source_queue.packets.front().order_time_us < earliest_queue->packets.front().order_time_us))
+                {
+                    earliest_queue = &source_queue;
+                }
             }
+
+            auto &pending_packet = earliest_queue->packets.front();
+
+            // If a source has no packet yet, a packet that should precede this one may still arrive.
+            // Wait for it only up to the interleaving window, so an idle source doesn't stall the others.
+            if (has_empty_queue && (_pending_packet_count <= MULTIPLEX_MAX_PENDING_PACKET_COUNT))
+            {
+                auto send_time = pending_packet.arrival_time + std::chrono::milliseconds(MULTIPLEX_INTERLEAVING_WINDOW_MS);
+
+                if (std::chrono::steady_clock::now() < send_time)
+                {
+                    return send_time;
+                }
+            }
+
+            SendFrame(pending_packet.packet);
+
+            earliest_queue->packets.pop_front();
+            _pending_packet_count--;
         }
 
-        logti("Multiplex Channel : %s/%s: Worker thread stopped", GetApplicationName(), GetName().CStr());
+        return std::chrono::steady_clock::time_point::max();
     }
 
     uint64_t MultiplexStream::MakeSourceTrackIdUnique(uint32_t tap_id, uint32_t track_id) const
@@ -175,7 +259,7 @@ namespace pvd
         return it->second;
     }
 
-    bool MultiplexStream::PullSourceStreams()
+    bool MultiplexStream::PullSourceStreams(const std::shared_ptr<MediaRouterStreamTapSet> &tap_set)
     {
         auto source_streams = _multiplex_profile->GetSourceStreams();
         for (auto &source_stream : source_streams)
@@ -285,6 +369,21 @@ namespace pvd
             return false;
         }
 
+        // Wake up the worker when the taps receive packets
+        _tap_set = tap_set;
+
+        for (auto &source_stream : source_streams)
+        {
+            auto stream_tap = source_stream->GetStreamTap();
+            if (stream_tap == nullptr)
+            {
+                continue;
+            }
+
+            _source_queues[stream_tap->GetId()] = {};
+            tap_set->Add(stream_tap, GetId());
+        }
+
         logti("Multiplex Channel : %s/%s: Started\n%s", GetApplicationName(), GetName().CStr(), _multiplex_profile->InfoStr().CStr());
 
         return true;
@@ -301,6 +400,11 @@ namespace pvd
                 continue;
             }
 
+            if (_tap_set != nullptr)
+            {
+                _tap_set->Remove(stream_tap);
+            }
+
             if (stream_tap->GetState() != MediaRouterStreamTap::State::Tapped)
             {
                 continue;
@@ -14,6 +14,7 @@
 #include <base/provider/stream.h>
 
 #include "multiplex_profile.h"
+#include "multiplex_worker_pool.h"
 
 namespace pvd
 {
@@ -44,9 +45,34 @@ namespace pvd
         ov::String GetPullingStateMsg() const;
 
     private:
-        void WorkerThread();
+        friend class MultiplexWorkerPool;
 
-        bool PullSourceStreams();
+        // A packet waiting for the packets of the other sources to be interleaved
+        struct PendingPacket
+        {
+            std::shared_ptr<MediaPacket> packet;
+
+            // DTS mapped to the arrival clock of the source (microseconds)
+            int64_t order_time_us;
+            std::chrono::steady_clock::time_point arrival_time;
+        };
+
+        struct SourceQueue
+        {
+            std::deque<PendingPacket> packets;
+
+            bool is_anchored = false;
+            int64_t first_dts_us = 0;
+            int64_t first_arrival_us = 0;
+        };
+
+        // Called by MultiplexWorkerPool when the taps are ready or the returned time is reached
+        std::chrono::steady_clock::time_point Run(const std::shared_ptr<MediaRouterStreamTapSet> &tap_set);
+
+        // Sends the pending packets in order of order_time_us, returns the time to send the next one
+        std::chrono::steady_clock::time_point SendInterleavedPackets();
+
+        bool PullSourceStreams(const std::shared_ptr<MediaRouterStreamTapSet> &tap_set);
         bool ReleaseSourceStreams();
 
         uint64_t MakeSourceTrackIdUnique(uint32_t tap_id, uint32_t track_id) const;
@@ -56,8 +82,14 @@ namespace pvd
 
         std::map<uint64_t, uint32_t> _source_track_id_to_new_id_map;
 
-        std::thread _worker_thread;
-        bool _worker_thread_running = false;
+        std::shared_ptr<MultiplexWorkerPool> _worker_pool;
+        bool _is_attached = false;
+        std::shared_ptr<MediaRouterStreamTapSet> _tap_set;
+        std::chrono::steady_clock::time_point _next_pull_time;
+
+        // Tap ID => Packets
+        std::map<uint32_t, SourceQueue> _source_queues;
+        size_t _pending_packet_count = 0;
 
         MuxState _mux_state = MuxState::None;
         ov::String _pulling_state_msg;
@@ -0,0 +1,60 @@
+//==============================================================================
+//
+//  MultiplexWorkerPool
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <mediarouter/mediarouter_stream_tap_set.h>
+
+namespace pvd
+{
+    class MultiplexStream;
+
+    // Threads shared by the multiplex channels of an application.
+    // Each worker blocks on one MediaRouterStreamTapSet holding the taps of all its channels,
+    // and runs a channel only when its taps are ready or its deadline (retry/interleaving window) is reached.
+    class MultiplexWorkerPool
+    {
+    public:
+        ~MultiplexWorkerPool();
+
+        bool Start(size_t worker_count);
+        bool Stop();
+
+        // The stream is run by the least loaded worker until Detach() is called
+        bool Attach(const std::shared_ptr<MultiplexStream> &stream);
+        // Waits for the stream to finish running if it is running on another thread
+        void Detach(const MultiplexStream *stream);
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<MultiplexStream> stream;
+            std::chrono::steady_clock::time_point next_run_time;
+        };
+
+        struct Worker
+        {
+            size_t index = 0;
+            std::thread thread;
+
+            std::shared_ptr<MediaRouterStreamTapSet> tap_set;
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            // Stream ID => Entry
+            std::map<uint32_t, Entry> entries;
+            const MultiplexStream *running_stream = nullptr;
+        };
+
+        void WorkerThread(Worker *worker);
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+        std::atomic<bool> _running{false};
+    };
+}  // namespace pvd
@@ -137,6 +137,22 @@ namespace pvd
                 return item;
             }
 
+            // Returns the item that GetNextItem() will return, without moving to it
+            std::shared_ptr<Item> PeekNextItem() const
+            {
+                if (items.empty())
+                {
+                    return nullptr;
+                }
+
+                if (size_t(current_item_index) >= items.size())
+                {
+                    return repeat ? items[0] : nullptr;
+                }
+
+                return items[current_item_index];
+            }
+
             bool IsOffAir() const
             {
                 return off_air;
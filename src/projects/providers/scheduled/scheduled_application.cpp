@@ -40,13 +40,28 @@ namespace pvd
         _schedule_files_path = ov::GetDirPath(config.GetScheduleFilesDir(), cfg::ConfigManager::GetInstance()->GetConfigPath());
 
         _schedule_file_name_regex = ov::Regex::CompiledRegex(ov::Regex::WildCardRegex(ov::String::FormatString("*.%s", ScheduleFileExtension)));
+
+        if (_worker_pool->Start(std::max(config.GetWorkerCount(), 1)) == false)
+        {
+            logte("Could not start scheduled workers: %s", GetVHostAppName().CStr());
+            return false;
+        }
         
         return Application::Start();
     }
 
     bool ScheduledApplication::Stop()
     {
-        return Application::Stop();
+        auto result = Application::Stop();
+
+        _worker_pool->Stop();
+
+        return result;
+    }
+
+    std::shared_ptr<ScheduledWorkerPool> ScheduledApplication::GetWorkerPool() const
+    {
+        return _worker_pool;
     }
 
     // Called by ScheduledProvider thread every 500ms 
@@ -13,6 +13,7 @@
 #include <base/provider/stream.h>
 
 #include "schedule.h"
+#include "scheduled_worker_pool.h"
 
 namespace pvd
 {
@@ -29,6 +30,8 @@ namespace pvd
 
         void OnScheduleWatcherTick();
 
+        std::shared_ptr<ScheduledWorkerPool> GetWorkerPool() const;
+
         ov::String GetRootDir() const
         {
             return _media_root_dir;
@@ -57,5 +60,8 @@ namespace pvd
 
         // File name hash -> ScheduleFileInfo
         std::map<size_t, ScheduleFileInfo> _schedule_file_info_db;
+
+        // Runs the scheduled channels of the application
+        std::shared_ptr<ScheduledWorkerPool> _worker_pool = std::make_shared<ScheduledWorkerPool>();
     };
 }
\ No newline at end of file
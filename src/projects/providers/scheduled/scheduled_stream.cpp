@@ -10,8 +10,23 @@
 #include "scheduled_stream.h"
 #include "schedule_private.h"
 
+#include "scheduled_application.h"
+
 #include <base/provider/application.h>
 
+// How far ahead of the real time the packets are read and queued to the pacer
+#define SCHEDULED_PACING_LEAD_MS 200
+// Maximum number of the packets read in a run, so that the other channels of the worker are not starved
+#define SCHEDULED_MAX_PACKETS_PER_RUN 100
+// Interval to check the schedule while waiting (file opening, no packet of the stream item)
+#define SCHEDULED_CHECK_INTERVAL_MS 100
+// Interval to check the schedule while there is no fallback item to play
+#define SCHEDULED_FALLBACK_WAIT_MS 1000
+// Time to wait after too many errors
+#define SCHEDULED_ERROR_WAIT_MS 1000
+// Maximum number of the packets of the next item read ahead by the prefetcher
+#define SCHEDULED_PREFETCH_MAX_PACKET_COUNT 500
+
 namespace pvd
 {
     // Implementation of ScheduledStream
@@ -33,29 +48,65 @@ namespace pvd
 
     bool ScheduledStream::Start()
     {
-        // Create Worker
-        _worker_thread_running = true;
-        _worker_thread = std::thread(&ScheduledStream::WorkerThread, this);
-        pthread_setname_np(_worker_thread.native_handle(), "Scheduled");
+        auto application = std::dynamic_pointer_cast<ScheduledApplication>(GetApplication());
+        if (application == nullptr)
+        {
+            return false;
+        }
+
+        auto stream_metrics = MonitorInstance->GetStreamMetrics(*this);
+
+        _pacer = PacingEngine::GetInstance()->CreatePacer(
+            (stream_metrics != nullptr) ? stream_metrics->GetPacingErrorHistogram() : nullptr,
+            [this](const std::shared_ptr<MediaPacket> &packet) {
+                SendFrame(packet);
+            });
+
+        if (_pacer == nullptr)
+        {
+            logte("Scheduled Channel %s/%s: Could not create a pacer", GetApplicationName(), GetName().CStr());
+            return false;
+        }
+
+        _item_transition_metrics = (stream_metrics != nullptr) ? stream_metrics->GetItemTransitionMetrics() : nullptr;
+
+        // Run by the worker pool of the application
+        _worker_pool = application->GetWorkerPool();
+        _run_state = RunState::SelectProgram;
+        _is_running = true;
+
+        if (_worker_pool->Attach(std::static_pointer_cast<ScheduledStream>(GetSharedPtr())) == false)
+        {
+            logte("Scheduled Channel %s/%s: Could not attach to the worker pool", GetApplicationName(), GetName().CStr());
+            _is_running = false;
+            return false;
+        }
+
+        _is_attached = true;
 
         return Stream::Start();
     }
 
     bool ScheduledStream::Stop()
     {
-        if (_worker_thread_running == false)
+        if (_is_running.exchange(false) == false)
         {
             return true;
         }
 
-        _worker_thread_running = false;
-        _schedule_updated.SetEvent();
+        // Drop the queued packets
+        _pacer->Close();
 
-        if (_worker_thread.joinable())
+        // Waits for the worker if the channel is running
+        if (_is_attached)
         {
-            _worker_thread.join();
+            _is_attached = false;
+            _worker_pool->Detach(this);
         }
 
+        StopPlayback();
+        CancelPrefetch();
+
         return Stream::Stop();
     }
 
@@ -73,7 +124,6 @@ namespace pvd
     std::shared_ptr<Schedule> ScheduledStream::GetSchedule() const
     {
         std::shared_lock<std::shared_mutex> lock(_schedule_mutex);
-        _schedule_updated.Reset();
         return _schedule;
     }
 
@@ -89,10 +139,17 @@ namespace pvd
 
     bool ScheduledStream::UpdateSchedule(const std::shared_ptr<Schedule> &schedule)
     {
-        std::lock_guard<std::shared_mutex> lock(_schedule_mutex);
-        _schedule = schedule;
+        {
+            std::lock_guard<std::shared_mutex> lock(_schedule_mutex);
+            _schedule = schedule;
+        }
+
+        // Let the worker check the new schedule
+        if (_is_running)
+        {
+            _worker_pool->Wakeup(this);
+        }
 
-        _schedule_updated.SetEvent();
         return true;
     }
 
@@ -194,246 +251,399 @@ namespace pvd
         return false;
     }
 
-    void ScheduledStream::WorkerThread()
+    std::chrono::steady_clock::time_point ScheduledStream::Run(const std::shared_ptr<MediaRouterStreamTapSet> &tap_set)
     {
-        while (_worker_thread_running)
-        {
-            // Schedule
-            std::unique_lock<std::shared_mutex> guard(_current_mutex);
-            _current_schedule = GetSchedule();
-            _current_program = nullptr;
-            _current_item = nullptr;
-            _current_item_position_ms = 0;
-            guard.unlock();
+        auto now = std::chrono::steady_clock::now();
 
-            if (_current_schedule == nullptr)
+        while (_is_running)
+        {
+            switch (_run_state)
             {
-                _realtime_clock.Pause();
-                // Wait for schedule update
-                _schedule_updated.Wait();
-                continue;
-            }
+                case RunState::SelectProgram: {
+                    // Schedule
+                    std::unique_lock<std::shared_mutex> guard(_current_mutex);
+                    _current_schedule = GetSchedule();
+                    _current_program = nullptr;
+                    _current_item = nullptr;
+                    _current_item_position_ms = 0;
+                    guard.unlock();
+
+                    if (_current_schedule == nullptr)
+                    {
+                        _realtime_clock.Pause();
+                        // Wait for schedule update (UpdateSchedule() wakes up the channel)
+                        return std::chrono::steady_clock::time_point::max();
+                    }
 
-            // Programs
-            guard.lock();
-            _current_program = _current_schedule->GetCurrentProgram();
-            _fallback_program = _current_schedule->GetFallbackProgram();
-            guard.unlock();
-            if (_current_program == nullptr)
-            {
-                PlayFallbackOrWait();
-                continue;
-            }
+                    // Programs
+                    guard.lock();
+                    _current_program = _current_schedule->GetCurrentProgram();
+                    _fallback_program = _current_schedule->GetFallbackProgram();
+                    guard.unlock();
+                    if (_current_program == nullptr)
+                    {
+                        EnterFallback(false);
+                        break;
+                    }
 
-            logti("Scheduled Channel %s/%s: Start %s program", GetApplicationName(), GetName().CStr(), _current_program->name.CStr());
+                    logti("Scheduled Channel %s/%s: Start %s program", GetApplicationName(), GetName().CStr(), _current_program->name.CStr());
 
-            // Items
-            int err_count = 0;
-            while (_worker_thread_running)
-            {
-                guard.lock();
-                _current_item = nullptr;
-                guard.unlock();
-                
-                if (CheckCurrentProgramChanged() == true)
-                {
-                    logti("Scheduled Channel %s/%s: Program changed", GetApplicationName(), GetName().CStr());
+                    // Items
+                    _err_count = 0;
+                    _run_state = RunState::SelectItem;
                     break;
                 }
 
-                guard.lock();
-                _current_item = _current_program->GetNextItem();
-                guard.unlock();
-                if (_current_item == nullptr)
-                {
-                    logti("Scheduled Channel %s/%s: Program ended", GetApplicationName(), GetName().CStr());
-                    PlayFallbackOrWait();
+                case RunState::SelectItem: {
+                    std::unique_lock<std::shared_mutex> guard(_current_mutex);
+                    _current_item = nullptr;
+                    guard.unlock();
+
+                    if (CheckCurrentProgramChanged() == true)
+                    {
+                        logti("Scheduled Channel %s/%s: Program changed", GetApplicationName(), GetName().CStr());
+                        _run_state = RunState::SelectProgram;
+                        break;
+                    }
+
+                    guard.lock();
+                    _current_item = _current_program->GetNextItem();
+                    guard.unlock();
+                    if (_current_item == nullptr)
+                    {
+                        logti("Scheduled Channel %s/%s: Program ended", GetApplicationName(), GetName().CStr());
+                        EnterFallback(false);
+                        break;
+                    }
+
+                    StartPlayback(_current_item, false, tap_set);
                     break;
                 }
-                
-                bool need_break = false;
-                do
-                {
-                    auto result = PlayItem(_current_item);
-                    if (result == PlaybackResult::PLAY_NEXT_ITEM)
+
+                case RunState::Fallback: {
+                    if (CheckCurrentProgramChanged() == true)
                     {
-                        // PLAY_NEXT_ITEM
-                        err_count = 0;
+                        logti("Scheduled Channel %s/%s: Program changed", GetApplicationName(), GetName().CStr());
+                        _run_state = RunState::SelectProgram;
+                        break;
                     }
-                    else if (result == PlaybackResult::PLAY_NEXT_PROGRAM)
+
+                    if (CheckCurrentFallbackProgramChanged() == true)
                     {
-                        err_count = 0;
-                        need_break = true;
+                        logti("Scheduled Channel %s/%s: Fallback program changed", GetApplicationName(), GetName().CStr());
+                        _run_state = RunState::SelectProgram;
                         break;
                     }
-                    else if (result == PlaybackResult::ERROR)
-                    {
-                        if (_current_item->fallback_on_err == true)
-                        {
-                            if (PlayFallbackOrWait() == PlaybackResult::FAILBACK)
-                            {
-                                continue;
-                            }
 
-							need_break = true;
-							break;
-                        }
-                        // Play next item
-                        else
+                    if (_fallback_program == nullptr || _fallback_program->items.empty() == true)
+                    {
+                        if (CheckCurrentItemAvailable() == true)
                         {
-                            _realtime_clock.Pause();
-
-                            // Too many errors
-                            err_count ++;
-                            if (err_count > 3)
-                            {
-                                logte("Scheduled Channel %s/%s: Too many errors. Sleep for %lld milliseconds", GetApplicationName(), GetName().CStr(), 1000);
-                                std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-                            }
+                            _run_state = _resume_item_on_failback ? RunState::SelectItem : RunState::SelectProgram;
+                            break;
                         }
+
+                        _realtime_clock.Pause();
+                        return now + std::chrono::milliseconds(SCHEDULED_FALLBACK_WAIT_MS);
+                    }
+
+                    StartPlayback(_fallback_program->GetNextItem(), true, tap_set);
+                    break;
+                }
+
+                case RunState::PlayItem: {
+                    PlaybackResult result = PlaybackResult::PLAY_NEXT_ITEM;
+                    auto next_run_time = now;
+
+                    bool finished = (_playback->item->file == true) ? ContinueFilePlayback(result, next_run_time) : ContinueStreamPlayback(result, next_run_time);
+                    if (finished == false)
+                    {
+                        return next_run_time;
+                    }
+
+                    auto resume_time = FinishPlayback(result);
+
+                    // The next item is played in this run unless the item failed, so a failing item does not hold the worker
+                    if ((result == PlaybackResult::ERROR) || (resume_time > now))
+                    {
+                        return resume_time;
                     }
-                } while (0);
 
-                if (need_break == true)
-                {
                     break;
                 }
             }
         }
+
+        return std::chrono::steady_clock::time_point::max();
     }
 
-    ScheduledStream::PlaybackResult ScheduledStream::PlayFallbackOrWait()
+    void ScheduledStream::EnterFallback(bool resume_item_on_failback)
     {
         logti("Scheduled Channel %s/%s: Start fallback program", GetApplicationName(), GetName().CStr());
 
-        PlaybackResult result = PlaybackResult::PLAY_NEXT_ITEM;
+        _resume_item_on_failback = resume_item_on_failback;
+        _run_state = RunState::Fallback;
+    }
+
+    void ScheduledStream::StartPlayback(const std::shared_ptr<Schedule::Item> &item, bool fallback_item, const std::shared_ptr<MediaRouterStreamTapSet> &tap_set)
+    {
+        _playback = std::make_shared<Playback>();
+        _playback->item = item;
+        _playback->fallback_item = fallback_item;
+
+        _run_state = RunState::PlayItem;
 
-        // Fallback
-        while (_worker_thread_running)
+        if (item == nullptr)
+        {
+            FinishPlayback(PlaybackResult::ERROR);
+            return;
+        }
+
+        if (item->file == true)
+        {
+            // The file is opened by ContinueFilePlayback()
+            logti("Scheduled Channel : %s/%s: Play file %s", GetApplicationName(), GetName().CStr(), item->file_path.CStr());
+            return;
+        }
+
+        logti("Scheduled Channel : %s/%s: Play stream %s", GetApplicationName(), GetName().CStr(), item->url.CStr());
+
+        auto stream_tap = PrepareStreamPlayback(item);
+        if (stream_tap == nullptr)
         {
-            if (CheckCurrentProgramChanged() == true)
+            logte("Scheduled Channel : %s/%s: Failed to prepare stream playback. Try to play next item", GetApplicationName(), GetName().CStr());
+            FinishPlayback(PlaybackResult::ERROR);
+            return;
+        }
+
+        if (_realtime_clock.IsStart() == false)
+        {
+            _realtime_clock.Start();
+        }
+
+        if (_realtime_clock.IsPaused() == true)
+        {
+            _realtime_clock.Resume();
+        }
+
+        // The worker runs the channel when a packet is pushed to the tap
+        _tap_set = tap_set;
+        _tap_set->Add(stream_tap, GetId());
+
+        _playback->stream_tap = stream_tap;
+        _playback->last_packet_time = std::chrono::steady_clock::now();
+    }
+
+    std::chrono::steady_clock::time_point ScheduledStream::FinishPlayback(PlaybackResult result)
+    {
+        bool fallback_item = _playback->fallback_item;
+        auto resume_time = std::chrono::steady_clock::now();
+
+        StopPlayback();
+
+        // Measures the gap until the first packet of the next item is queued
+        _item_transition_clock.Start();
+
+        if (fallback_item)
+        {
+            switch (result)
             {
-                logti("Scheduled Channel %s/%s: Program changed", GetApplicationName(), GetName().CStr());
-                break;
+                case PlaybackResult::FAILBACK:
+                    _run_state = _resume_item_on_failback ? RunState::SelectItem : RunState::SelectProgram;
+                    break;
+                case PlaybackResult::PLAY_NEXT_ITEM:
+                    _run_state = RunState::Fallback;
+                    break;
+                case PlaybackResult::PLAY_NEXT_PROGRAM:
+                    _run_state = RunState::SelectProgram;
+                    break;
+                case PlaybackResult::ERROR:
+                    logtw("Scheduled Channel %s/%s: Failed to play fallback program.", GetApplicationName(), GetName().CStr());
+                    _run_state = RunState::Fallback;
+                    break;
             }
 
-            if (CheckCurrentFallbackProgramChanged() == true)
-            {
-                logti("Scheduled Channel %s/%s: Fallback program changed", GetApplicationName(), GetName().CStr());
+            return resume_time;
+        }
+
+        switch (result)
+        {
+            case PlaybackResult::PLAY_NEXT_ITEM:
+            case PlaybackResult::FAILBACK:
+                _err_count = 0;
+                _run_state = RunState::SelectItem;
                 break;
-            }
 
-            if (_fallback_program == nullptr || _fallback_program->items.empty() == true)
-            {
-                if (CheckCurrentItemAvailable() == true)
+            case PlaybackResult::PLAY_NEXT_PROGRAM:
+                _err_count = 0;
+                _run_state = RunState::SelectProgram;
+                break;
+
+            case PlaybackResult::ERROR:
+                if (_current_item != nullptr && _current_item->fallback_on_err == true)
                 {
-                    return PlaybackResult::FAILBACK;
+                    EnterFallback(true);
+                    break;
                 }
 
+                // Play next item
                 _realtime_clock.Pause();
-                _schedule_updated.Wait(1000);
-
-                continue;
-            }
+                _run_state = RunState::SelectItem;
 
-            auto item = _fallback_program->GetNextItem();
-            result = PlayItem(item, true);
-            if (result == PlaybackResult::FAILBACK)
-            {
-                break;
-            }
-            else if (result == PlaybackResult::PLAY_NEXT_ITEM)
-            {
-                
-            }
-            else if (result == PlaybackResult::PLAY_NEXT_PROGRAM)
-            {
+                // Too many errors
+                _err_count++;
+                if (_err_count > 3)
+                {
+                    logte("Scheduled Channel %s/%s: Too many errors. Sleep for %d milliseconds", GetApplicationName(), GetName().CStr(), SCHEDULED_ERROR_WAIT_MS);
+                    resume_time += std::chrono::milliseconds(SCHEDULED_ERROR_WAIT_MS);
+                }
                 break;
-            }
-            else if (result == PlaybackResult::ERROR)
-            {
-                logtw("Scheduled Channel %s/%s: Failed to play fallback program.", GetApplicationName(), GetName().CStr());
-            }
         }
 
-        return result;
+        return resume_time;
     }
 
-    ScheduledStream::PlaybackResult ScheduledStream::PlayItem(const std::shared_ptr<Schedule::Item> &item, bool fallback_item)
+    void ScheduledStream::StopPlayback()
     {
-        if (item == nullptr)
+        if (_playback == nullptr)
         {
-            return PlaybackResult::ERROR;
+            return;
         }
 
-        if (item->file == true)
+        if (_playback->stream_tap != nullptr)
         {
-            return PlayFile(item, fallback_item);
+            if (_tap_set != nullptr)
+            {
+                _tap_set->Remove(_playback->stream_tap);
+            }
+
+            ocst::Orchestrator::GetInstance()->UnmirrorStream(_playback->stream_tap);
         }
-        
-        return PlayStream(item, fallback_item);
+
+        _playback = nullptr;
+
+        std::unique_lock<std::shared_mutex> lock(_current_mutex);
+        _current_item_position_ms = 0;
+        lock.unlock();
+
+        logti("Scheduled Channel : %s/%s: Playback stopped", GetApplicationName(), GetName().CStr());
     }
 
-    ScheduledStream::PlaybackResult ScheduledStream::PlayFile(const std::shared_ptr<Schedule::Item> &item, bool fallback_item)
+    bool ScheduledStream::CheckPlaybackInterrupted(PlaybackResult &result)
     {
-        logti("Scheduled Channel : %s/%s: Play file %s", GetApplicationName(), GetName().CStr(), item->file_path.CStr());
-
-        ScheduledStream::PlaybackResult result = PlaybackResult::PLAY_NEXT_ITEM;
+        if (CheckCurrentProgramChanged() == true)
+        {
+            result = PlaybackResult::PLAY_NEXT_PROGRAM;
+            return true;
+        }
 
-        auto context = PrepareFilePlayback(item);
-        if (context == nullptr)
+        if (_playback->fallback_item)
         {
-            logte("Scheduled Channel : %s/%s: Failed to prepare file playback. Try to play next item", GetApplicationName(), GetName().CStr());
-            return PlaybackResult::ERROR;
+            if (CheckCurrentItemAvailable() == true)
+            {
+                result = PlaybackResult::FAILBACK;
+                return true;
+            }
         }
 
-        if (_realtime_clock.IsStart() == false)
+        return false;
+    }
+
+    bool ScheduledStream::ContinueFilePlayback(PlaybackResult &result, std::chrono::steady_clock::time_point &next_run_time)
+    {
+        auto &playback = *_playback;
+        auto &item = playback.item;
+
+        if (CheckPlaybackInterrupted(result) == true)
         {
-            _realtime_clock.Start();
+            return true;
         }
 
-        if (_realtime_clock.IsPaused() == true)
+        if (playback.file == nullptr)
         {
-            _realtime_clock.Resume();
+            if (playback.open_requested == false)
+            {
+                playback.open_requested = true;
+                playback.prefetched = (_prefetch_item == item);
+
+                if (playback.prefetched == false)
+                {
+                    StartPrefetch(item);
+                }
+            }
+
+            if (_prefetch_done == false)
+            {
+                // The prefetch thread wakes up the channel when the file is opened
+                next_run_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(SCHEDULED_CHECK_INTERVAL_MS);
+                return false;
+            }
+
+            auto file = TakePrefetchedFile(item);
+            if ((file == nullptr) && playback.prefetched)
+            {
+                // The prefetch failed, the item is opened again and the error is handled then
+                playback.prefetched = false;
+                StartPrefetch(item);
+
+                next_run_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(SCHEDULED_CHECK_INTERVAL_MS);
+                return false;
+            }
+
+            if ((file == nullptr) || (PrepareFilePlayback(file, playback.prefetched) == false))
+            {
+                logte("Scheduled Channel : %s/%s: Failed to prepare file playback. Try to play next item", GetApplicationName(), GetName().CStr());
+                result = PlaybackResult::ERROR;
+                return true;
+            }
+
+            playback.file = file;
+            playback.is_mpegts = (std::strncmp(file->context->iformat->name, "mpegts", 6) == 0);
+
+            // Open the next item while this item is playing
+            PrefetchNextItem(item, playback.fallback_item);
+
+            if (_realtime_clock.IsStart() == false)
+            {
+                _realtime_clock.Start();
+            }
+
+            if (_realtime_clock.IsPaused() == true)
+            {
+                _realtime_clock.Resume();
+            }
         }
 
+        auto &file = playback.file;
+        auto context = file->context;
+
         // Play
         AVPacket packet = { 0 };
-        std::map<int, bool> track_first_packet_map;
-        std::map<int, int64_t> track_single_file_dts_offset_map;
-        std::map<int, bool> end_of_track_map;
+        auto &track_first_packet_map = playback.track_first_packet_map;
+        auto &track_single_file_dts_offset_map = playback.track_single_file_dts_offset_map;
+        auto &end_of_track_map = playback.end_of_track_map;
 
-        bool is_mpegts { std::strncmp(context->iformat->name, "mpegts", 6) == 0 };
+        bool is_mpegts = playback.is_mpegts;
 
-        while (_worker_thread_running)
+        for (size_t packet_count = 0; packet_count < SCHEDULED_MAX_PACKETS_PER_RUN; packet_count++)
         {
-            if (CheckCurrentProgramChanged() == true)
+            if ((packet_count > 0) && (CheckPlaybackInterrupted(result) == true))
             {
-                result = PlaybackResult::PLAY_NEXT_PROGRAM;
-                break;
-            }
-
-            if (fallback_item)
-            {
-                if (CheckCurrentItemAvailable() == true)
-                {
-                    result = PlaybackResult::FAILBACK;
-                    break;
-                }
+                return true;
             }
 
-            int32_t ret = ::av_read_frame(context, &packet);
+            int32_t ret = ReadFrame(*file, &packet);
             if (ret == AVERROR(EAGAIN))
             {
                 logtw("Scheduled Channel : %s/%s: Failed to read frame. Error (%d, %s)", GetApplicationName(), GetName().CStr(), ret, "EAGAIN");
-                continue;
+                break;
             }
-            else if (ret == AVERROR_EOF || ::avio_feof(context->pb))
+            else if (ret == AVERROR_EOF)
             {
                 // End of file
                 logti("Scheduled Channel : %s/%s: End of file. Try to play next item", GetApplicationName(), GetName().CStr());
                 result = PlaybackResult::PLAY_NEXT_ITEM;
-                break;
+                return true;
             }
             else if (ret < 0)
             {
@@ -444,7 +654,7 @@ namespace pvd
                 logte("%s/%s: Failed to read frame. Error (%d, %s). Try to play next item", GetApplicationName(), GetName().CStr(), ret, errbuf);
 
                 result = PlaybackResult::PLAY_NEXT_ITEM;
-                break;
+                return true;
             }
 
             auto track_id = FindTrackIdByOriginId(packet.stream_index);
@@ -548,7 +758,12 @@ namespace pvd
 
             logtd("Scheduled Channel Send Packet : %s/%s: Track %d, origin dts : %lld, pts %lld, dts %lld, duration %lld, tb %f, dts_ms %f, dts_gap %lld", GetApplicationName(), GetName().CStr(), track_id, single_file_dts, pts, dts, duration, track->GetTimeBase().GetExpr(), time_ms, dts_gap);
 
-            SendFrame(media_packet);
+            // The pacer sends the packet when the real time reaches the DTS
+            double elapsed = _realtime_clock.ElapsedUs();
+            double dts_us = static_cast<double>(dts) * 1000.0 * 1000.0 * track->GetTimeBase().GetExpr();
+            auto wait_time = std::max<int64_t>(static_cast<int64_t>(dts_us - elapsed), 0);
+
+            PushPacket(media_packet, std::chrono::steady_clock::now() + std::chrono::microseconds(wait_time));
 
             _last_packet_map[track_id] = media_packet;
 
@@ -584,25 +799,23 @@ namespace pvd
                     // End of item
                     logti("Scheduled Channel : %s/%s: End of item (Current Pos : %.0f ms Duration : %lld ms). Try to play next item", GetApplicationName(), GetName().CStr(), single_file_duration_ms, item->duration_ms);
                     result = PlaybackResult::PLAY_NEXT_ITEM;
-                    break;
+                    return true;
                 }
             }
-            
-            double elapsed = _realtime_clock.ElapsedUs();
-            double dts_us = static_cast<double>(dts) * 1000.0 * 1000.0 * track->GetTimeBase().GetExpr();
-            if (elapsed < dts_us)
+
+
+            // Read ahead up to the lead, then yield until half of it is sent
+            auto lead = _pacer->GetLead();
+            if (lead > std::chrono::milliseconds(SCHEDULED_PACING_LEAD_MS))
             {
-                int64_t wait_time = dts_us - elapsed;
-                logtd("Scheduled Channel : %s/%s: Current(%f) Dts(%f) Wait(%lld)", GetApplicationName(), GetName().CStr(), elapsed, dts_us, wait_time);
-                std::this_thread::sleep_for(std::chrono::microseconds(wait_time));
+                next_run_time = std::chrono::steady_clock::now() + (lead - std::chrono::milliseconds(SCHEDULED_PACING_LEAD_MS / 2));
+                return false;
             }
         }
 
-        _current_item_position_ms = 0;
-        ::avformat_close_input(&context);
-        logti("Scheduled Channel : %s/%s: Playback stopped", GetApplicationName(), GetName().CStr());
-
-        return result;
+        // Continued after the other channels of the worker
+        next_run_time = std::chrono::steady_clock::now();
+        return false;
     }
 
     bool ScheduledStream::CheckFileItemAvailable(const std::shared_ptr<Schedule::Item> &item)
@@ -687,12 +900,93 @@ namespace pvd
         return true;
     }
 
-    AVFormatContext *ScheduledStream::PrepareFilePlayback(const std::shared_ptr<Schedule::Item> &item)
+    ScheduledStream::OpenedFile::~OpenedFile()
     {
-        AVFormatContext *format_context = nullptr;
+        for (auto &packet : packets)
+        {
+            ::av_packet_free(&packet);
+        }
+
+        if (context != nullptr)
+        {
+            ::avformat_close_input(&context);
+        }
+    }
+
+    // A packet read at the end of the file is also treated as the end of the file
+    static int32_t ReadFrameFromContext(AVFormatContext *context, AVPacket *packet)
+    {
+        int32_t ret = ::av_read_frame(context, packet);
+
+        if ((ret != AVERROR(EAGAIN)) && ::avio_feof(context->pb))
+        {
+            if (ret >= 0)
+            {
+                ::av_packet_unref(packet);
+            }
+
+            return AVERROR_EOF;
+        }
+
+        return ret;
+    }
+
+    int32_t ScheduledStream::ReadFrame(OpenedFile &file, AVPacket *packet)
+    {
+        if (file.packets.empty() == false)
+        {
+            auto read_packet = file.packets.front();
+            file.packets.pop_front();
+
+            ::av_packet_move_ref(packet, read_packet);
+            ::av_packet_free(&read_packet);
+
+            return 0;
+        }
+
+        if (file.end_of_file)
+        {
+            return AVERROR_EOF;
+        }
+
+        return ReadFrameFromContext(file.context, packet);
+    }
+
+    int ScheduledStream::InterruptCallback(void *opaque)
+    {
+        auto stream = static_cast<ScheduledStream *>(opaque);
+
+        return (stream->_is_running == false) ? 1 : 0;
+    }
+
+    int ScheduledStream::PrefetchInterruptCallback(void *opaque)
+    {
+        auto stream = static_cast<ScheduledStream *>(opaque);
+
+        return ((stream->_is_running == false) || stream->_prefetch_cancelled) ? 1 : 0;
+    }
+
+    std::shared_ptr<ScheduledStream::OpenedFile> ScheduledStream::OpenFile(const std::shared_ptr<Schedule::Item> &item, AVIOInterruptCB interrupt_callback)
+    {
+        auto file = std::make_shared<OpenedFile>();
+        file->item = item;
+
+        ov::StopWatch probe_watch;
+        probe_watch.Start();
+
+        file->context = ::avformat_alloc_context();
+        if (file->context == nullptr)
+        {
+            logte("%s/%s: Failed to allocate the format context of %s item", GetApplicationName(), GetName().CStr(), item->file_path.CStr());
+            return nullptr;
+        }
+
+        // So that opening a slow (remote) file can be aborted
+        file->context->interrupt_callback = interrupt_callback;
 
         int err = 0;
-        err = ::avformat_open_input(&format_context, item->file_path.CStr(), nullptr, nullptr);
+        // The context is freed on failure
+        err = ::avformat_open_input(&file->context, item->file_path.CStr(), nullptr, nullptr);
         if (err < 0)
         {
             char errbuf[AV_ERROR_MAX_STRING_SIZE] = { 0 };
@@ -703,18 +997,53 @@ namespace pvd
             return nullptr;
         }
 
-        err = ::avformat_find_stream_info(format_context, nullptr);
+        err = ::avformat_find_stream_info(file->context, nullptr);
         if (err < 0)
         {
             char errbuf[AV_ERROR_MAX_STRING_SIZE] = { 0 };
 
             ::av_strerror(err, errbuf, sizeof(errbuf));
 
-            logte("%s/%s: Failed to find stream info. Error (%d, %s)", GetApplicationName(), GetName().CStr(), item->file_path.CStr(), err, errbuf);
-            ::avformat_close_input(&format_context);
+            logte("%s/%s: Failed to find stream info of %s item. Error (%d, %s)", GetApplicationName(), GetName().CStr(), item->file_path.CStr(), err, errbuf);
             return nullptr;
         }
 
+        file->probe_time_us = probe_watch.ElapsedUs();
+
+        // Seek to start position
+        if (item->start_time_ms > 0)
+        {
+            int64_t seek_target = item->start_time_ms * 1000;
+            int64_t seek_min = 0;
+            int64_t seek_max = (file->context->duration > 0) ? file->context->duration : std::numeric_limits<int64_t>::max();
+
+            int seek_ret = ::avformat_seek_file(file->context, -1, seek_min, seek_target, seek_max, 0);
+            if (seek_ret < 0)
+            {
+                logte("%s/%s: Failed to seek to start position %d, err:%d", GetApplicationName(), GetName().CStr(), item->start_time_ms, seek_ret);
+            }
+        }
+
+        return file;
+    }
+
+    bool ScheduledStream::PrepareFilePlayback(const std::shared_ptr<OpenedFile> &file, bool prefetched)
+    {
+        auto &item = file->item;
+
+        if (prefetched)
+        {
+            logti("%s/%s: %s item has been prefetched (probe time: %lld us, read ahead: %zu packets)", GetApplicationName(), GetName().CStr(), item->file_path.CStr(), file->probe_time_us, file->packets.size());
+        }
+
+        if (_item_transition_metrics != nullptr)
+        {
+            _item_transition_metrics->probe_time.Record(file->probe_time_us);
+            (prefetched ? _item_transition_metrics->prefetched_count : _item_transition_metrics->not_prefetched_count)++;
+        }
+
+        auto format_context = file->context;
+
         bool video_track_needed = _channel_info.video_track;
         bool audio_track_needed = _channel_info.audio_track;
 
@@ -808,8 +1137,7 @@ namespace pvd
             logte("%s/%s: Failed to find %s track(s) from file %s", GetApplicationName(), GetName().CStr(), 
                 video_track_needed&& audio_track_needed == true ? "video and audio" :
                 video_track_needed == true ? "video" : "audio", item->file_path.CStr());
-            ::avformat_close_input(&format_context);
-            return nullptr;
+            return false;
         }
 
         // If there is no data track, add a dummy data track
@@ -829,90 +1157,221 @@ namespace pvd
             item->duration_ms = total_duration_ms;
         }
 
-        // Seek to start position
-        if (item->start_time_ms > 0)
+        if (UpdateStream() == false)
         {
-            int64_t seek_target = item->start_time_ms * 1000;
-            int64_t seek_min = 0;
-            int64_t seek_max = total_duration_ms * 1000;
+            logte("%s/%s: Failed to update stream", GetApplicationName(), GetName().CStr());
+            return false;
+        }
 
-            int seek_ret = ::avformat_seek_file(format_context, -1, seek_min, seek_target, seek_max, 0);
-            if (seek_ret < 0)
+        return true;
+    }
+
+    void ScheduledStream::PrefetchNextItem(const std::shared_ptr<Schedule::Item> &current_item, bool fallback_item)
+    {
+        auto program = fallback_item ? _fallback_program : _current_program;
+
+        // If the next program begins before the current item ends, its first item is played next
+        if ((fallback_item == false) && (_current_schedule != nullptr) && (current_item->duration_ms > 0))
+        {
+            auto next_program = _current_schedule->GetNextProgram();
+            auto current_item_end_time = std::chrono::system_clock::now() + std::chrono::milliseconds(current_item->duration_ms);
+
+            if ((next_program != nullptr) && (next_program->scheduled_time <= current_item_end_time))
             {
-                logte("%s/%s: Failed to seek to start position %d, err:%d", GetApplicationName(), GetName().CStr(), item->start_time_ms, seek_ret);
+                program = next_program;
             }
         }
 
-        if (UpdateStream() == false)
+        auto next_item = (program != nullptr) ? program->PeekNextItem() : nullptr;
+
+        // Stream items are not prefetched, their source is already running
+        if ((next_item == nullptr) || (next_item->file == false) || (next_item == _prefetch_item))
         {
-            logte("%s/%s: Failed to update stream", GetApplicationName(), GetName().CStr());
-            return nullptr;
+            return;
         }
 
-        return format_context;
+        StartPrefetch(next_item);
     }
 
-    ScheduledStream::PlaybackResult ScheduledStream::PlayStream(const std::shared_ptr<Schedule::Item> &item, bool fallback_item)
+    void ScheduledStream::StartPrefetch(const std::shared_ptr<Schedule::Item> &item)
     {
-        logti("Scheduled Channel : %s/%s: Play stream %s", GetApplicationName(), GetName().CStr(), item->url.CStr());
+        CancelPrefetch();
 
-        ScheduledStream::PlaybackResult result = PlaybackResult::PLAY_NEXT_ITEM;
+        _prefetch_item = item;
+        _prefetch_done = false;
+        _prefetch_thread = std::thread(&ScheduledStream::PrefetchThread, this, item);
+        pthread_setname_np(_prefetch_thread.native_handle(), "SchedPrefetch");
+    }
 
-        auto stream_tap = PrepareStreamPlayback(item);
-        if (stream_tap == nullptr)
-        {
-            logte("Scheduled Channel : %s/%s: Failed to prepare stream playback. Try to play next item", GetApplicationName(), GetName().CStr());
-            return PlaybackResult::ERROR;
-        }
+    void ScheduledStream::PrefetchThread(std::shared_ptr<Schedule::Item> item)
+    {
+        // Taken by the worker after joining this thread
+        _prefetched_file = PrefetchFile(item);
+        _prefetch_done = true;
 
-        if (_realtime_clock.IsStart() == false)
+        _worker_pool->Wakeup(this);
+    }
+
+    std::shared_ptr<ScheduledStream::OpenedFile> ScheduledStream::PrefetchFile(const std::shared_ptr<Schedule::Item> &item)
+    {
+        auto file = OpenFile(item, {&ScheduledStream::PrefetchInterruptCallback, this});
+        if (file == nullptr)
         {
-            _realtime_clock.Start();
+            // If it is the next item, it is opened again when it is played, and the error is handled there
+            return nullptr;
         }
 
-        if (_realtime_clock.IsPaused() == true)
+        int video_stream_index = -1;
+        for (uint32_t index = 0; index < file->context->nb_streams; index++)
         {
-            _realtime_clock.Resume();
+            if (file->context->streams[index]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+            {
+                video_stream_index = index;
+                break;
+            }
         }
 
-        std::map<int, bool> track_first_packet_map;
-        std::map<int, int64_t> track_single_file_dts_offset_map;
-        std::map<int, bool> end_of_track_map;
+        // Read the first GOP, so the first keyframe can be sent as soon as the item begins
+        bool key_frame_read = false;
 
-        // Play
-        while (_worker_thread_running)
+        while ((_prefetch_cancelled == false) && (file->packets.size() < SCHEDULED_PREFETCH_MAX_PACKET_COUNT))
         {
-            if (CheckCurrentProgramChanged() == true)
+            auto packet = ::av_packet_alloc();
+            if (packet == nullptr)
             {
-                result = PlaybackResult::PLAY_NEXT_PROGRAM;
                 break;
             }
 
-            if (fallback_item)
+            int32_t ret = ReadFrameFromContext(file->context, packet);
+            if (ret < 0)
             {
-                if (CheckCurrentItemAvailable() == true)
+                ::av_packet_free(&packet);
+
+                if (ret == AVERROR(EAGAIN))
                 {
-                    result = PlaybackResult::FAILBACK;
-                    break;
+                    continue;
                 }
+
+                // The other errors are handled when the item is played
+                file->end_of_file = (ret == AVERROR_EOF);
+                break;
             }
-			
-            auto media_packet = stream_tap->Pop(_channel_info.error_tolerance_duration_ms);
+
+            bool next_gop = (packet->stream_index == video_stream_index) && (packet->flags & AV_PKT_FLAG_KEY) && key_frame_read;
+
+            key_frame_read |= (packet->stream_index == video_stream_index) && (packet->flags & AV_PKT_FLAG_KEY);
+            file->packets.push_back(packet);
+
+            if (next_gop)
+            {
+                break;
+            }
+        }
+
+        return file;
+    }
+
+    std::shared_ptr<ScheduledStream::OpenedFile> ScheduledStream::TakePrefetchedFile(const std::shared_ptr<Schedule::Item> &item)
+    {
+        if (_prefetch_item != item)
+        {
+            // The schedule has been changed since the prefetch began
+            CancelPrefetch();
+            return nullptr;
+        }
+
+        // Called after the prefetch is done, so it does not block
+        if (_prefetch_thread.joinable())
+        {
+            _prefetch_thread.join();
+        }
+
+        auto file = std::move(_prefetched_file);
+        _prefetch_item = nullptr;
+
+        if (file != nullptr)
+        {
+            // The playback must not be aborted by CancelPrefetch() of the next prefetch
+            file->context->interrupt_callback = {&ScheduledStream::InterruptCallback, this};
+        }
+
+        return file;
+    }
+
+    void ScheduledStream::CancelPrefetch()
+    {
+        if (_prefetch_thread.joinable())
+        {
+            _prefetch_cancelled = true;
+            _prefetch_thread.join();
+            _prefetch_cancelled = false;
+        }
+
+        _prefetch_item = nullptr;
+        _prefetched_file = nullptr;
+    }
+
+    void ScheduledStream::PushPacket(const std::shared_ptr<MediaPacket> &packet, std::chrono::steady_clock::time_point send_time)
+    {
+        if (_item_transition_clock.IsStart())
+        {
+            if (_item_transition_metrics != nullptr)
+            {
+                _item_transition_metrics->gap.Record(_item_transition_clock.ElapsedUs());
+            }
+
+            _item_transition_clock.Stop();
+        }
+
+        _pacer->Push(packet, send_time);
+    }
+
+    bool ScheduledStream::ContinueStreamPlayback(PlaybackResult &result, std::chrono::steady_clock::time_point &next_run_time)
+    {
+        auto &playback = *_playback;
+        auto &item = playback.item;
+        auto &stream_tap = playback.stream_tap;
+
+        auto &track_first_packet_map = playback.track_first_packet_map;
+        auto &track_single_file_dts_offset_map = playback.track_single_file_dts_offset_map;
+        auto &end_of_track_map = playback.end_of_track_map;
+
+        // Play
+        for (size_t packet_count = 0; packet_count < SCHEDULED_MAX_PACKETS_PER_RUN; packet_count++)
+        {
+            if (CheckPlaybackInterrupted(result) == true)
+            {
+                return true;
+            }
+
+            auto media_packet = stream_tap->Pop(0);
             if (media_packet == nullptr)
             {
+                auto now = std::chrono::steady_clock::now();
+                auto timeout = playback.last_packet_time + std::chrono::milliseconds(_channel_info.error_tolerance_duration_ms);
+
+                if ((stream_tap->GetState() == MediaRouterStreamTap::State::Tapped) && (now < timeout))
+                {
+                    // The tap wakes up the channel when a packet is pushed
+                    next_run_time = std::min(timeout, now + std::chrono::milliseconds(SCHEDULED_CHECK_INTERVAL_MS));
+                    return false;
+                }
+
                 if (CheckCurrentProgramChanged() == true)
                 {
                     result = PlaybackResult::PLAY_NEXT_PROGRAM;
-                    break;
                 }
                 else
                 {
                     logtw("Scheduled Channel : %s/%s: Failed to pop packet until %d ms. Try to play next item", GetApplicationName(), GetName().CStr(), _channel_info.error_tolerance_duration_ms);
                     result = PlaybackResult::ERROR;
-                    break;
                 }
+
+                return true;
             }
-			
+
+            playback.last_packet_time = std::chrono::steady_clock::now();
+
 			auto origin_track_id = media_packet->GetTrackId();
             auto track_id = FindTrackIdByOriginId(origin_track_id);
             if (track_id < 0)
@@ -987,7 +1446,8 @@ namespace pvd
 
             logtd("Scheduled Channel Send Packet : %s/%s: Track %d, origin dts : %lld, pts %lld, dts %lld, tb %f, dts_ms %f", GetApplicationName(), GetName().CStr(), track_id, single_file_dts, pts, dts, track->GetTimeBase().GetExpr(), time_ms);
 
-            SendFrame(media_packet);
+            // Live packets are sent immediately, but through the pacer to keep the order with the packets of the previous item
+            PushPacket(media_packet, std::chrono::steady_clock::now());
 
             // dts to real time (ms)
             auto single_file_dts_ms = static_cast<double>(single_file_dts) * track->GetTimeBase().GetExpr() * static_cast<double>(1000);
@@ -1020,18 +1480,14 @@ namespace pvd
                     // End of item
                     logti("Scheduled Channel : %s/%s: End of item (Current Pos : %.0f ms Duration : %lld ms). Try to play next item", GetApplicationName(), GetName().CStr(), single_file_dts_ms, item->duration_ms);
                     result = PlaybackResult::PLAY_NEXT_ITEM;
-                    break;
+                    return true;
                 }
             }
         }
 
-        _current_item_position_ms = 0;
-
-        ocst::Orchestrator::GetInstance()->UnmirrorStream(stream_tap);
-
-        logti("Scheduled Channel : %s/%s: Playback stopped", GetApplicationName(), GetName().CStr());
-
-        return result;
+        // Continued after the other channels of the worker
+        next_run_time = std::chrono::steady_clock::now();
+        return false;
     }
 
     bool ScheduledStream::CheckStreamItemAvailable(const std::shared_ptr<Schedule::Item> &item)
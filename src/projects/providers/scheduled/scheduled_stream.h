@@ -12,8 +12,10 @@
 #include <orchestrator/orchestrator.h>
 #include <mediarouter/mediarouter_stream_tap.h>
 #include <base/provider/stream.h>
+#include <base/provider/pacing_engine.h>
 
 #include "schedule.h"
+#include "scheduled_worker_pool.h"
 
 namespace pvd
 {
@@ -44,7 +46,7 @@ namespace pvd
         bool GetCurrentProgram(std::shared_ptr<Schedule::Program> &curr_program, std::shared_ptr<Schedule::Item> &curr_item, int64_t &curr_item_pos) const;
 
     private:
-        void WorkerThread();
+        friend class ScheduledWorkerPool;
 
         enum class PlaybackResult
         {
@@ -54,6 +56,56 @@ namespace pvd
             FAILBACK
         };
 
+        // Where the channel is in its schedule.
+        // Run() resumes from here and returns whenever it has to wait, so the channel does not need a thread of its own.
+        enum class RunState
+        {
+            // Selects the current program of the schedule
+            SelectProgram,
+            // Selects the next item of the current program
+            SelectItem,
+            // Selects the next item of the fallback program
+            Fallback,
+            // Plays _playback
+            PlayItem
+        };
+
+        // A file item opened and probed, with the packets read ahead of its playback
+        struct OpenedFile
+        {
+            ~OpenedFile();
+
+            std::shared_ptr<Schedule::Item> item;
+            AVFormatContext *context = nullptr;
+            std::deque<AVPacket *> packets;
+            bool end_of_file = false;
+            int64_t probe_time_us = 0;
+        };
+
+        // The item being played
+        struct Playback
+        {
+            std::shared_ptr<Schedule::Item> item;
+            bool fallback_item = false;
+
+            // File item, it is opened by the prefetch thread so that a slow (remote) file does not block the worker
+            std::shared_ptr<OpenedFile> file;
+            bool open_requested = false;
+            bool prefetched = false;
+            bool is_mpegts = false;
+
+            // Stream item
+            std::shared_ptr<MediaRouterStreamTap> stream_tap;
+            std::chrono::steady_clock::time_point last_packet_time;
+
+            std::map<int, bool> track_first_packet_map;
+            std::map<int, int64_t> track_single_file_dts_offset_map;
+            std::map<int, bool> end_of_track_map;
+        };
+
+        // Called by ScheduledWorkerPool when the returned time is reached, the tap of the stream item is ready, or the stream is woken up
+        std::chrono::steady_clock::time_point Run(const std::shared_ptr<MediaRouterStreamTapSet> &tap_set);
+
         // If there is no current program
         //      ==> Continue playing until the current program changes
         // If there is no current item
@@ -64,17 +116,45 @@ namespace pvd
         // If there is an error in the fallback
         //     ==> Keep attempting
         // If the fallback ends (program change, item change, item duration ends)
-        //     ==> return true
-        // If there is no fallback (not configured)
-        //     ==> return false
-        PlaybackResult PlayFallbackOrWait();
-
-        PlaybackResult PlayItem(const std::shared_ptr<Schedule::Item> &item, bool fallback_item = false);
-
-        PlaybackResult PlayFile(const std::shared_ptr<Schedule::Item> &item, bool fallback_item);
-        AVFormatContext *PrepareFilePlayback(const std::shared_ptr<Schedule::Item> &item);
+        //     ==> Select the program again
+        // If the current item returns to a normal state (only if the fallback is entered by the error of the item)
+        //     ==> Play the next item
+        void EnterFallback(bool resume_item_on_failback);
+
+        void StartPlayback(const std::shared_ptr<Schedule::Item> &item, bool fallback_item, const std::shared_ptr<MediaRouterStreamTapSet> &tap_set);
+        // Selects what to do after the item, returns the time to continue
+        std::chrono::steady_clock::time_point FinishPlayback(PlaybackResult result);
+        void StopPlayback();
+
+        // Returns true if the item has to be stopped (program changed, or the failed item is available again)
+        bool CheckPlaybackInterrupted(PlaybackResult &result);
+        // Read/pop the packets of the item up to the lead.
+        // Return true when the item is finished (result is set), otherwise next_run_time is set to the time to continue
+        bool ContinueFilePlayback(PlaybackResult &result, std::chrono::steady_clock::time_point &next_run_time);
+        bool ContinueStreamPlayback(PlaybackResult &result, std::chrono::steady_clock::time_point &next_run_time);
+
+        bool PrepareFilePlayback(const std::shared_ptr<OpenedFile> &file, bool prefetched);
+        std::shared_ptr<OpenedFile> OpenFile(const std::shared_ptr<Schedule::Item> &item, AVIOInterruptCB interrupt_callback);
+        // Returns the packets read ahead first
+        int32_t ReadFrame(OpenedFile &file, AVPacket *packet);
+
+        // Opens the item to be played after current_item and reads its first GOP in the background,
+        // so it is ready to be played when current_item ends (or the next program begins)
+        void PrefetchNextItem(const std::shared_ptr<Schedule::Item> &current_item, bool fallback_item);
+        // Opens the item in the prefetch thread, the stream is woken up when it is done
+        void StartPrefetch(const std::shared_ptr<Schedule::Item> &item);
+        void PrefetchThread(std::shared_ptr<Schedule::Item> item);
+        std::shared_ptr<OpenedFile> PrefetchFile(const std::shared_ptr<Schedule::Item> &item);
+        // nullptr if the item is not prefetched
+        std::shared_ptr<OpenedFile> TakePrefetchedFile(const std::shared_ptr<Schedule::Item> &item);
+        void CancelPrefetch();
+
+        static int InterruptCallback(void *opaque);
+        static int PrefetchInterruptCallback(void *opaque);
+
+        // Records the transition gap when the first packet of an item is queued
+        void PushPacket(const std::shared_ptr<MediaPacket> &packet, std::chrono::steady_clock::time_point send_time);
         
-        PlaybackResult PlayStream(const std::shared_ptr<Schedule::Item> &item, bool fallback_item);
         std::shared_ptr<MediaRouterStreamTap> PrepareStreamPlayback(const std::shared_ptr<Schedule::Item> &item);
         
         std::shared_ptr<Schedule> GetSchedule() const;
@@ -90,10 +170,17 @@ namespace pvd
         std::shared_ptr<Schedule> _schedule;
         mutable std::shared_mutex _schedule_mutex;
 
-        std::thread _worker_thread;
-        bool _worker_thread_running = false;
+        // Runs the channel, it reads ahead of the pacer and yields until the lead is half sent
+        std::shared_ptr<ScheduledWorkerPool> _worker_pool;
+        bool _is_attached = false;
+        std::atomic<bool> _is_running = false;
 
-        mutable ov::Event _schedule_updated;
+        RunState _run_state = RunState::SelectProgram;
+        bool _resume_item_on_failback = false;
+        int _err_count = 0;
+        std::shared_ptr<Playback> _playback;
+        // The set that the tap of the stream item is added to
+        std::shared_ptr<MediaRouterStreamTapSet> _tap_set;
 
         // Current
         const Schedule::Stream _channel_info;
@@ -115,6 +202,20 @@ namespace pvd
         ov::StopWatch _realtime_clock;
         ov::StopWatch _failback_check_clock;
 
+        // Sends the packets at the time of their DTS
+        std::shared_ptr<PacingEngine::Pacer> _pacer;
+
+        // Opens the file items off the worker: the next item ahead of time, or the current one if it was not prefetched
+        std::thread _prefetch_thread;
+        std::shared_ptr<Schedule::Item> _prefetch_item;
+        std::shared_ptr<OpenedFile> _prefetched_file;
+        std::atomic<bool> _prefetch_cancelled = false;
+        std::atomic<bool> _prefetch_done = false;
+
+        std::shared_ptr<mon::ItemTransitionMetrics> _item_transition_metrics;
+        // Started when an item ends, stopped when the first packet of the next item is queued
+        ov::StopWatch _item_transition_clock;
+
         std::map<uint32_t, std::shared_ptr<MediaPacket>> _last_packet_map;
     };
 }
\ No newline at end of file
@@ -0,0 +1,241 @@
+//==============================================================================
+//
+//  ScheduledWorkerPool
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#include "scheduled_worker_pool.h"
+#include "schedule_private.h"
+#include "scheduled_stream.h"
+
+namespace pvd
+{
+    ScheduledWorkerPool::~ScheduledWorkerPool()
+    {
+        Stop();
+    }
+
+    bool ScheduledWorkerPool::Start(size_t worker_count)
+    {
+        if (_running || (_workers.empty() == false))
+        {
+            return false;
+        }
+
+        worker_count = std::max<size_t>(worker_count, 1);
+
+        for (size_t index = 0; index < worker_count; index++)
+        {
+            auto worker = std::make_unique<Worker>();
+
+            worker->index = index;
+            worker->tap_set = MediaRouterStreamTapSet::Create();
+
+            _workers.push_back(std::move(worker));
+        }
+
+        _running = true;
+
+        for (auto &worker : _workers)
+        {
+            worker->thread = std::thread(&ScheduledWorkerPool::WorkerThread, this, worker.get());
+            pthread_setname_np(worker->thread.native_handle(), ov::String::FormatString("Scheduled%zu", worker->index).CStr());
+        }
+
+        return true;
+    }
+
+    bool ScheduledWorkerPool::Stop()
+    {
+        if (_running.exchange(false) == false)
+        {
+            return true;
+        }
+
+        for (auto &worker : _workers)
+        {
+            worker->tap_set->Wakeup();
+        }
+
+        for (auto &worker : _workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+
+            // Workers are kept since Detach() may still refer to them
+            std::map<uint32_t, Entry> entries;
+
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                entries.swap(worker->entries);
+            }
+
+            // The streams may be destroyed (and detach themselves) here, so the lock must not be held
+            entries.clear();
+        }
+
+        return true;
+    }
+
+    bool ScheduledWorkerPool::Attach(const std::shared_ptr<ScheduledStream> &stream)
+    {
+        if (_running == false)
+        {
+            return false;
+        }
+
+        Worker *selected_worker = nullptr;
+        size_t selected_count = 0;
+
+        for (auto &worker : _workers)
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+
+            if ((selected_worker == nullptr) || (worker->entries.size() < selected_count))
+            {
+                selected_worker = worker.get();
+                selected_count = worker->entries.size();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(selected_worker->mutex);
+            selected_worker->entries[stream->GetId()] = {stream, std::chrono::steady_clock::now()};
+        }
+
+        selected_worker->tap_set->Wakeup();
+
+        return true;
+    }
+
+    void ScheduledWorkerPool::Detach(const ScheduledStream *stream)
+    {
+        for (auto &worker : _workers)
+        {
+            std::unique_lock<std::mutex> lock(worker->mutex);
+
+            auto entry = worker->entries.find(stream->GetId());
+            if ((entry == worker->entries.end()) || (entry->second.stream.get() != stream))
+            {
+                continue;
+            }
+
+            worker->entries.erase(entry);
+
+            // A stream can detach itself while it is running (e.g. it is released by the worker)
+            if (std::this_thread::get_id() != worker->thread.get_id())
+            {
+                worker->condition.wait(lock, [&]() -> bool {
+                    return worker->running_stream != stream;
+                });
+            }
+
+            return;
+        }
+    }
+
+    void ScheduledWorkerPool::Wakeup(const ScheduledStream *stream)
+    {
+        for (auto &worker : _workers)
+        {
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+
+                auto entry = worker->entries.find(stream->GetId());
+                if ((entry == worker->entries.end()) || (entry->second.stream.get() != stream))
+                {
+                    continue;
+                }
+
+                entry->second.next_run_time = std::chrono::steady_clock::now();
+
+                if (worker->running_stream == stream)
+                {
+                    worker->running_stream_woken_up = true;
+                }
+            }
+
+            worker->tap_set->Wakeup();
+
+            return;
+        }
+    }
+
+    void ScheduledWorkerPool::WorkerThread(Worker *worker)
+    {
+        std::set<uint64_t> ready_keys;
+        std::vector<std::shared_ptr<ScheduledStream>> streams_to_run;
+
+        while (_running)
+        {
+            auto now = std::chrono::steady_clock::now();
+
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+
+                for (auto &[stream_id, entry] : worker->entries)
+                {
+                    if ((entry.next_run_time <= now) || (ready_keys.find(stream_id) != ready_keys.end()))
+                    {
+                        streams_to_run.push_back(entry.stream);
+                    }
+                }
+            }
+
+            ready_keys.clear();
+
+            for (auto &stream : streams_to_run)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(worker->mutex);
+
+                    // Detached while running the other streams
+                    if (worker->entries.find(stream->GetId()) == worker->entries.end())
+                    {
+                        continue;
+                    }
+
+                    worker->running_stream = stream.get();
+                    worker->running_stream_woken_up = false;
+                }
+
+                auto next_run_time = stream->Run(worker->tap_set);
+
+                std::lock_guard<std::mutex> lock(worker->mutex);
+
+                worker->running_stream = nullptr;
+                worker->condition.notify_all();
+
+                auto entry = worker->entries.find(stream->GetId());
+                if (entry != worker->entries.end())
+                {
+                    // If the stream was woken up while running, the wakeup must not be lost
+                    entry->second.next_run_time = worker->running_stream_woken_up ? std::chrono::steady_clock::now() : next_run_time;
+                }
+            }
+
+            // Release the references outside of the lock, the stream may be destroyed here
+            streams_to_run.clear();
+
+            auto deadline = std::chrono::steady_clock::time_point::max();
+
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+
+                for (auto &[stream_id, entry] : worker->entries)
+                {
+                    deadline = std::min(deadline, entry.next_run_time);
+                }
+            }
+
+            worker->tap_set->Wait(deadline, ready_keys);
+        }
+
+        logti("Scheduled worker #%zu has been stopped", worker->index);
+    }
+}  // namespace pvd
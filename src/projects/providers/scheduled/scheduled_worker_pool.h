@@ -0,0 +1,65 @@
+//==============================================================================
+//
+//  ScheduledWorkerPool
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <mediarouter/mediarouter_stream_tap_set.h>
+
+namespace pvd
+{
+    class ScheduledStream;
+
+    // Threads shared by the scheduled channels of an application.
+    // A channel reads its packets ahead of the pacer up to the lead and then yields, so a worker runs a channel
+    // only when its deadline (lead/wait) is reached, its stream item tap is ready, or it is woken up (schedule update, file opened).
+    class ScheduledWorkerPool
+    {
+    public:
+        ~ScheduledWorkerPool();
+
+        bool Start(size_t worker_count);
+        bool Stop();
+
+        // The stream is run by the least loaded worker until Detach() is called
+        bool Attach(const std::shared_ptr<ScheduledStream> &stream);
+        // Waits for the stream to finish running if it is running on another thread
+        void Detach(const ScheduledStream *stream);
+
+        // Runs the stream as soon as possible
+        void Wakeup(const ScheduledStream *stream);
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<ScheduledStream> stream;
+            std::chrono::steady_clock::time_point next_run_time;
+        };
+
+        struct Worker
+        {
+            size_t index = 0;
+            std::thread thread;
+
+            std::shared_ptr<MediaRouterStreamTapSet> tap_set;
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            // Stream ID => Entry
+            std::map<uint32_t, Entry> entries;
+            const ScheduledStream *running_stream = nullptr;
+            // Woken up while running, so it must be run again
+            bool running_stream_woken_up = false;
+        };
+
+        void WorkerThread(Worker *worker);
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+        std::atomic<bool> _running{false};
+    };
+}  // namespace pvd
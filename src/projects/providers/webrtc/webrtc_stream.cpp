@@ -570,7 +570,7 @@ namespace pvd
 		logtd("Payload Type(%d) Timestamp(%u) PTS(%u) Time scale(%f) Adjust Timestamp(%f)",
 			  first_rtp_packet->PayloadType(), first_rtp_packet->Timestamp(), adjusted_timestamp, track->GetTimeBase().GetExpr(), static_cast<double>(adjusted_timestamp) * track->GetTimeBase().GetExpr());
 
-		auto frame = std::make_shared<MediaPacket>(GetMsid(),
+		auto frame = ov::MakePooledShared<MediaPacket>(GetMsid(),
 												   track->GetMediaType(),
 												   track->GetId(),
 												   bitstream,
@@ -633,7 +633,7 @@ namespace pvd
 			if (_h26x_extradata_nalu.find(track->GetId()) != _h26x_extradata_nalu.end() && _h26x_extradata_nalu[track->GetId()] != nullptr)
 			{
 				auto bitstream_format = (track->GetCodecId() == cmn::MediaCodecId::H264) ? cmn::BitstreamFormat::H264_ANNEXB : cmn::BitstreamFormat::H265_ANNEXB;
-				auto sps_pps_packet = std::make_shared<MediaPacket>(GetMsid(),
+				auto sps_pps_packet = ov::MakePooledShared<MediaPacket>(GetMsid(),
 																	track->GetMediaType(),
 																	track->GetId(),
 																	_h26x_extradata_nalu[track->GetId()],
@@ -391,12 +391,37 @@ void HlsSession::ResponseSegment(const std::shared_ptr<http::svr::HttpExchange>
 
 	auto response = exchange->GetResponse();
 
-	auto [result, segment] = stream->GetSegmentData(variant_name, number);
+	auto [result, segment] = stream->GetSegment(variant_name, number);
 	if (result == HlsStream::RequestResult::Success)
 	{
-		response->SetStatusCode(http::StatusCode::OK);
-		response->SetHeader("Content-Type", "video/mp2t");
-		response->AppendData(segment);
+		bool appended = false;
+
+		if ((segment->IsDataInMemory() == false) && segment->IsDataInFile())
+		{
+			// The segment stored in a file (e.g. DVR) is sent using sendfile() or shared in ov::FileCache
+			appended = response->AppendFile(segment->GetFilePath());
+		}
+		else
+		{
+			auto data_list = segment->GetDataList();
+
+			for (const auto &data : data_list)
+			{
+				response->AppendData(data);
+			}
+
+			appended = (data_list.empty() == false);
+		}
+
+		if (appended)
+		{
+			response->SetStatusCode(http::StatusCode::OK);
+			response->SetHeader("Content-Type", "video/mp2t");
+		}
+		else
+		{
+			response->SetStatusCode(http::StatusCode::NotFound);
+		}
 	}
 	else if (result == HlsStream::RequestResult::NotFound)
 	{
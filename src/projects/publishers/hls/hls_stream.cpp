@@ -827,7 +827,7 @@ std::tuple<HlsStream::RequestResult, std::shared_ptr<const ov::Data>> HlsStream:
 	return std::make_tuple(RequestResult::Success, data);
 }
 
-std::tuple<HlsStream::RequestResult, std::shared_ptr<const ov::Data>> HlsStream::GetSegmentData(const ov::String &variant_name, uint32_t number)
+std::tuple<HlsStream::RequestResult, std::shared_ptr<mpegts::Segment>> HlsStream::GetSegment(const ov::String &variant_name, uint32_t number)
 {
 	auto packager = GetPackager(variant_name);
 	if (packager == nullptr)
@@ -835,11 +835,11 @@ std::tuple<HlsStream::RequestResult, std::shared_ptr<const ov::Data>> HlsStream:
 		return std::make_tuple(RequestResult::NotFound, nullptr);
 	}
 
-	auto segment_data = packager->GetSegmentData(number);
-	if (segment_data == nullptr)
+	auto segment = packager->GetSegment(number);
+	if (segment == nullptr)
 	{
 		return std::make_tuple(RequestResult::NotFound, nullptr);
 	}
 
-	return std::make_tuple(RequestResult::Success, segment_data);
+	return std::make_tuple(RequestResult::Success, segment);
 }
\ No newline at end of file
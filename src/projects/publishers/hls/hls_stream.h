@@ -57,7 +57,7 @@ public:
 	// Interface for HLS Session
 	std::tuple<RequestResult, std::shared_ptr<const ov::Data>> GetMasterPlaylistData(const ov::String &playlist_name, bool rewind);
 	std::tuple<RequestResult, std::shared_ptr<const ov::Data>> GetMediaPlaylistData(const ov::String &variant_name, bool rewind);
-	std::tuple<RequestResult, std::shared_ptr<const ov::Data>> GetSegmentData(const ov::String &variant_name, uint32_t number);
+	std::tuple<RequestResult, std::shared_ptr<mpegts::Segment>> GetSegment(const ov::String &variant_name, uint32_t number);
 
 	ov::String GetStreamId() const;
 
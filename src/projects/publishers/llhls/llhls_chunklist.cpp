@@ -131,6 +131,14 @@ bool LLHlsChunklist::AppendPartialSegmentInfo(uint32_t segment_sequence, const S
 			segment->SetCompleted();
 			_last_completed_segment_sequence = segment_sequence;
 			_first_segment = false;
+
+			// Partial segments are only output for the last few segments, so the partial segment info of older segments
+			// is no longer needed. Without this, a long DVR window would keep the info of every partial segment in memory.
+			auto old_segment_it = _segments.find(static_cast<int64_t>(segment_sequence) - 4);
+			if (old_segment_it != _segments.end())
+			{
+				old_segment_it->second->ClearPartialSegments();
+			}
 		}
 	
 		_last_segment_sequence = segment_sequence;
@@ -171,19 +179,52 @@ bool LLHlsChunklist::RemoveSegmentInfo(uint32_t segment_sequence)
 
 void LLHlsChunklist::UpdateCacheForDefaultChunklist()
 {
-	// no query string, no skip, no legacy, all segments
-	ov::String chunklist = MakeChunklist("", false, false, true);
+	// no legacy, all segments - most of the requests
+	auto default_template = std::make_shared<LLHlsChunklistTemplate>(MakeChunklist(LLHlsChunklistTemplate::QueryPlaceholder, false, false, true));
+
+	// lock
+	std::lock_guard<std::shared_mutex> lock(_cached_chunklist_templates_guard);
+
+	_cached_chunklist_version++;
+
+	// The others are rendered again when they are requested
+	for (auto &chunklist_template : _cached_chunklist_templates)
+	{
+		chunklist_template = nullptr;
+	}
+	_cached_chunklist_templates[1] = default_template;
+}
+
+std::shared_ptr<const LLHlsChunklistTemplate> LLHlsChunklist::GetChunklistTemplate(bool legacy, bool rewind) const
+{
+	auto index = (legacy ? 2 : 0) + (rewind ? 1 : 0);
+	uint64_t version = 0;
+
 	{
-		// lock 
-		std::lock_guard<std::shared_mutex> lock(_cached_default_chunklist_guard);
-		_cached_default_chunklist = chunklist;
+		std::shared_lock<std::shared_mutex> lock(_cached_chunklist_templates_guard);
+		if (_cached_chunklist_templates[index] != nullptr)
+		{
+			return _cached_chunklist_templates[index];
+		}
+
+		version = _cached_chunklist_version;
 	}
 
+	auto chunklist_template = std::make_shared<LLHlsChunklistTemplate>(MakeChunklist(LLHlsChunklistTemplate::QueryPlaceholder, false, legacy, rewind));
+
+	std::lock_guard<std::shared_mutex> lock(_cached_chunklist_templates_guard);
+	// Do not cache it if the chunklist has been updated while rendering
+	if (version == _cached_chunklist_version)
 	{
-		// lock 
-		std::lock_guard<std::shared_mutex> lock(_cached_default_chunklist_gzip_guard);
-		_cached_default_chunklist_gzip = ov::Zip::CompressGzip(chunklist.ToData(false));
+		if (_cached_chunklist_templates[index] == nullptr)
+		{
+			_cached_chunklist_templates[index] = chunklist_template;
+		}
+
+		return _cached_chunklist_templates[index];
 	}
+
+	return chunklist_template;
 }
 
 bool LLHlsChunklist::SaveOldSegmentInfo(std::shared_ptr<SegmentInfo> &segment_info)
@@ -447,7 +488,7 @@ ov::String LLHlsChunklist::MakeChunklist(const ov::String &query_string, bool sk
 			continue;
 		}
 
-		if (segment->GetPartialSegmentsCount() == 0)
+		if (segment->IsCompleted() == false && segment->GetPartialSegmentsCount() == 0)
 		{
 			continue;
 		}
@@ -582,11 +623,9 @@ ov::String LLHlsChunklist::ToString(const ov::String &query_string, bool skip, b
 		return "";
 	}
 
-	if (query_string.IsEmpty() && skip == false && legacy == false && rewind == true && vod == false && vod_start_segment_number == 0 && !_cached_default_chunklist.IsEmpty())
+	if (vod == false && vod_start_segment_number == 0)
 	{
-		// return cached chunklist for default chunklist
-		std::shared_lock<std::shared_mutex> lock(_cached_default_chunklist_guard);
-		return _cached_default_chunklist;
+		return GetChunklistTemplate(legacy, rewind)->Render(query_string);
 	}
 
 	return MakeChunklist(query_string, skip, legacy, rewind, vod, vod_start_segment_number);
@@ -594,11 +633,5 @@ ov::String LLHlsChunklist::ToString(const ov::String &query_string, bool skip, b
 
 std::shared_ptr<const ov::Data> LLHlsChunklist::ToGzipData(const ov::String &query_string, bool skip, bool legacy, bool rewind) const
 {
-	if (query_string.IsEmpty() && skip == false && legacy == false && _cached_default_chunklist_gzip != nullptr && rewind == true)
-	{
-		std::shared_lock<std::shared_mutex> lock(_cached_default_chunklist_gzip_guard);
-		return _cached_default_chunklist_gzip;
-	}
-
-	return ov::Zip::CompressGzip(ToString(query_string, skip, legacy, rewind).ToData(false));
+	return GetChunklistTemplate(legacy, rewind)->RenderGzip(query_string);
 }
@@ -14,6 +14,7 @@
 #include <modules/marker/marker_box.h>
 
 #include "modules/containers/bmff/cenc.h"
+#include "llhls_chunklist_template.h"
 
 class LLHlsChunklist
 {
@@ -255,6 +256,9 @@ private:
 
 	ov::String MakeExtXKey() const;
 
+	// Returns the template of the chunklist for (legacy, rewind), it is rendered on the first request after an update
+	std::shared_ptr<const LLHlsChunklistTemplate> GetChunklistTemplate(bool legacy, bool rewind) const;
+
 	ov::String MakeMarkers(const std::vector<std::shared_ptr<Marker>> &markers) const;
 
 	std::shared_ptr<const MediaTrack> _track;
@@ -287,11 +291,12 @@ private:
 	std::map<int32_t, std::shared_ptr<LLHlsChunklist>> _renditions;
 	mutable std::shared_mutex _renditions_guard;
 
-	ov::String _cached_default_chunklist;
-	mutable std::shared_mutex _cached_default_chunklist_guard;
-
-	std::shared_ptr<ov::Data> _cached_default_chunklist_gzip;
-	mutable std::shared_mutex _cached_default_chunklist_gzip_guard;
+	// Templates for each (legacy, rewind), index = (legacy ? 2 : 0) + (rewind ? 1 : 0)
+	// _HLS_skip is not implemented by MakeChunklist() yet, so skip shares the template.
+	mutable std::shared_ptr<const LLHlsChunklistTemplate> _cached_chunklist_templates[4];
+	// Increased on every update, a template rendered before the update is not cached
+	mutable uint64_t _cached_chunklist_version = 0;
+	mutable std::shared_mutex _cached_chunklist_templates_guard;
 
 	bmff::CencProperty _cenc_property;
 
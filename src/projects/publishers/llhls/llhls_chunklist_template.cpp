@@ -0,0 +1,71 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+
+#include "llhls_chunklist_template.h"
+
+#include <base/ovlibrary/zip.h>
+
+#include "llhls_private.h"
+
+LLHlsChunklistTemplate::LLHlsChunklistTemplate(const ov::String &chunklist)
+{
+	ov::String separator = ov::String::FormatString("?%s", QueryPlaceholder);
+
+	if (chunklist.IsEmpty())
+	{
+		_fragments.emplace_back("");
+	}
+	else
+	{
+		_fragments = chunklist.Split(separator.CStr());
+	}
+
+	for (const auto &fragment : _fragments)
+	{
+		_fragments_length += fragment.GetLength();
+	}
+
+	_default_chunklist = ov::String::Join(_fragments, "");
+	_default_chunklist_gzip = ov::Zip::CompressGzip(_default_chunklist.ToData(false));
+}
+
+ov::String LLHlsChunklistTemplate::Render(const ov::String &query_string) const
+{
+	if (query_string.IsEmpty() || _fragments.size() == 1)
+	{
+		return _default_chunklist;
+	}
+
+	ov::String chunklist(_fragments_length + ((query_string.GetLength() + 1) * (_fragments.size() - 1)) + 1);
+
+	for (size_t index = 0; index < _fragments.size(); index++)
+	{
+		if (index > 0)
+		{
+			chunklist.Append("?");
+			chunklist.Append(query_string.CStr(), query_string.GetLength());
+		}
+
+		chunklist.Append(_fragments[index].CStr(), _fragments[index].GetLength());
+	}
+
+	return chunklist;
+}
+
+std::shared_ptr<const ov::Data> LLHlsChunklistTemplate::RenderGzip(const ov::String &query_string) const
+{
+	if (query_string.IsEmpty() || _fragments.size() == 1)
+	{
+		return _default_chunklist_gzip;
+	}
+
+	// The whole chunklist is compressed as one stream. Fragments compressed separately cannot refer to each other,
+	// and the fragments are a single line each (they end at every URI), so that output is larger than the plain text
+	return ov::Zip::CompressGzip(Render(query_string).ToData(false));
+}
@@ -0,0 +1,38 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2025 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+// A chunklist rendered once per update with a placeholder at each position where the query string of a request goes.
+// Requests with different query strings (session key, signed policy, ...) are rendered by splicing the query string
+// between the immutable fragments instead of building the whole playlist again.
+//
+// Gzip is only cached for the chunklist without the query string. With a query string, the rendered chunklist is
+// compressed per request, since the back-references of deflate cannot cross the spliced query strings.
+class LLHlsChunklistTemplate
+{
+public:
+	// LLHlsChunklist::MakeChunklist() is called with this as the query string,
+	// so each query string position becomes "?" + QueryPlaceholder
+	static constexpr const char *QueryPlaceholder = "\x01";
+
+	explicit LLHlsChunklistTemplate(const ov::String &chunklist);
+
+	ov::String Render(const ov::String &query_string) const;
+	std::shared_ptr<const ov::Data> RenderGzip(const ov::String &query_string) const;
+
+private:
+	std::vector<ov::String> _fragments;
+	size_t _fragments_length = 0;
+
+	// Rendered without the query string
+	ov::String _default_chunklist;
+	std::shared_ptr<const ov::Data> _default_chunklist_gzip;
+};
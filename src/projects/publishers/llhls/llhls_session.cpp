@@ -91,7 +91,9 @@ bool LLHlsSession::Start()
 
 bool LLHlsSession::Stop()
 {
-	logtd("LLHlsSession(%u) : Pending request size(%d)", GetId(), _pending_requests.size());
+	logtd("LLHlsSession(%u) : Pending request size(%d)", GetId(), _pending_request_count.load());
+
+	RemovePendingRequests(false);
 
 	return Session::Stop();
 }
@@ -135,6 +137,11 @@ void LLHlsSession::OnConnectionDisconnected(uint32_t connection_id)
 	logtd("LLHlsSession(%u) : Disconnected from %u : size(%d)", GetId(), connection_id, _last_request_time.size());
 }
 
+bool LLHlsSession::IsExpired() const
+{
+	return (_session_life_time != 0) && (_session_life_time < ov::Clock::NowMSec());
+}
+
 bool LLHlsSession::IsNoConnection() const
 {
 	std::shared_lock<std::shared_mutex> lock(_last_request_time_guard);
@@ -142,34 +149,20 @@ bool LLHlsSession::IsNoConnection() const
 }
 
 // pub::Session Interface
-void LLHlsSession::SendOutgoingData(const std::any &notification)
+void LLHlsSession::OnMessageReceived(const std::any &message)
 {
-	// Check expired time
-	if(_session_life_time != 0 && _session_life_time < ov::Clock::NowMSec())
+	// A pending request resumed by the stream
+	if (message.type() == typeid(std::shared_ptr<LLHlsStream::PendingRequest>))
 	{
-		return;
-	}
-
-	std::shared_ptr<LLHlsStream::PlaylistUpdatedEvent> event;
-	try
-	{
-		event = std::any_cast<std::shared_ptr<LLHlsStream::PlaylistUpdatedEvent>>(notification);
-		if (event == nullptr)
+		auto request = std::any_cast<std::shared_ptr<LLHlsStream::PendingRequest>>(message);
+		if (request != nullptr)
 		{
-			return;
+			ResumePendingRequest(request);
 		}
-	}
-	catch (const std::bad_any_cast& e)
-	{
-		logtc("LLHlsSession : Invalid notification type : %s", e.what());
+
 		return;
 	}
 
-	OnPlaylistUpdated(event->track_id, event->msn, event->part);
-}
-
-void LLHlsSession::OnMessageReceived(const std::any &message)
-{
 	std::shared_ptr<http::svr::HttpExchange> exchange = nullptr;
 	try 
 	{
@@ -188,8 +181,10 @@ void LLHlsSession::OnMessageReceived(const std::any &message)
 	auto response = exchange->GetResponse();
 
 	// Check expired time
-	if(_session_life_time != 0 && _session_life_time < ov::Clock::NowMSec())
+	if (IsExpired())
 	{
+		RemovePendingRequests(true);
+
 		response->SetStatusCode(http::StatusCode::Unauthorized);
 		ResponseData(exchange);
 		return;
@@ -425,7 +420,7 @@ bool LLHlsSession::ParseFileName(const ov::String &file_name, RequestType &type,
 	return true;
 }
 
-void LLHlsSession::ResponsePlaylist(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, bool legacy, bool rewind, bool holdIfAccepted /*= true*/)
+void LLHlsSession::ResponsePlaylist(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, bool legacy, bool rewind)
 {
 	auto llhls_stream = std::static_pointer_cast<LLHlsStream>(GetStream());
 	if (llhls_stream == nullptr)
@@ -434,21 +429,32 @@ void LLHlsSession::ResponsePlaylist(const std::shared_ptr<http::svr::HttpExchang
 	}
 
 	auto request = exchange->GetRequest();
-	auto response = exchange->GetResponse();
 	auto request_uri = exchange->GetRequest()->GetParsedUri();
 
-	ov::String content_encoding = "identity";
 	bool gzip = false;
 	auto encodings = request->GetHeader("Accept-Encoding");
 	if (encodings.IndexOf("gzip") >= 0 || encodings.IndexOf("*") >= 0)
 	{
 		gzip = true;
-		content_encoding = "gzip";
 	}
 
 	// Get the playlist
 	auto query_string = MakeQueryStringToPropagate(request_uri);
 	auto [result, playlist] = llhls_stream->GetMasterPlaylist(file_name, query_string, gzip, legacy, rewind);
+	if (result == LLHlsStream::RequestResult::Accepted)
+	{
+		// llhls.m3u8 is transmitted when more than one segment (any track) is created.
+		AddPendingRequest(exchange, LLHlsStream::PendingRequestType::Playlist, file_name, query_string, gzip, 0, 1, 0, false, legacy, rewind);
+		return ;
+	}
+
+	SendPlaylistResponse(exchange, file_name, result, playlist, gzip, false);
+}
+
+void LLHlsSession::SendPlaylistResponse(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, LLHlsStream::RequestResult result, const std::shared_ptr<const ov::Data> &playlist, bool gzip, bool resumed)
+{
+	auto response = exchange->GetResponse();
+
 	if (result == LLHlsStream::RequestResult::Success)
 	{
 		// Send the playlist
@@ -456,7 +462,7 @@ void LLHlsSession::ResponsePlaylist(const std::shared_ptr<http::svr::HttpExchang
 		// Set Content-Type header
 		response->SetHeader("Content-Type", "application/vnd.apple.mpegurl");
 		// gzip compression
-		response->SetHeader("Content-Encoding", content_encoding);
+		response->SetHeader("Content-Encoding", gzip ? "gzip" : "identity");
 
 		// Cache-Control header
 		// When the stream is recreated, llhls.m3u8 file is changed.
@@ -484,27 +490,21 @@ void LLHlsSession::ResponsePlaylist(const std::shared_ptr<http::svr::HttpExchang
 			_number_of_players += 1;
 		}
 	}
-	else if (result == LLHlsStream::RequestResult::Accepted && holdIfAccepted == true)
-	{
-		// llhls.m3u8 is transmitted when more than one segment (any track) is created.
-		AddPendingRequest(exchange, RequestType::Playlist, file_name, 0, 1, 0, false, legacy, rewind);
-		return ;
-	}
 	else
 	{
-		if (holdIfAccepted == false)
+		if (resumed == true)
 		{
 			logtw("%s/%s/%s Failed to respond to pending request.", GetApplication()->GetVHostAppName().CStr(), GetStream()->GetName().CStr(), file_name.CStr());
 		}
 
 		// Send error response
-		response->SetStatusCode(http::StatusCode::NotFound);
+		response->SetStatusCode((result == LLHlsStream::RequestResult::BadRequest) ? http::StatusCode::BadRequest : http::StatusCode::NotFound);
 	}
 
 	ResponseData(exchange);
 }
 
-void LLHlsSession::ResponseChunklist(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, int64_t msn, int64_t part, bool skip, bool legacy, bool rewind, bool holdIfAccepted /*= true*/)
+void LLHlsSession::ResponseChunklist(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, int64_t msn, int64_t part, bool skip, bool legacy, bool rewind)
 {
 	auto llhls_stream = std::static_pointer_cast<LLHlsStream>(GetStream());
 	if (llhls_stream == nullptr)
@@ -514,8 +514,6 @@ void LLHlsSession::ResponseChunklist(const std::shared_ptr<http::svr::HttpExchan
 
 	auto request = exchange->GetRequest();
 	auto request_uri = request->GetParsedUri();
-	auto response = exchange->GetResponse();
-	bool has_delivery_directives = request_uri->HasQueryKey("_HLS_msn");
 
 	if (msn == -1 && part == -1)
 	{
@@ -525,19 +523,36 @@ void LLHlsSession::ResponseChunklist(const std::shared_ptr<http::svr::HttpExchan
 		part = 0;
 	}
 
-	ov::String content_encoding = "identity";
 	bool gzip = false;
 	auto encodings = request->GetHeader("Accept-Encoding");
 	if (encodings.IndexOf("gzip") >= 0 || encodings.IndexOf("*") >= 0)
 	{
 		gzip = true;
-		content_encoding = "gzip";
 	}
 
 	// Get the chunklist
 	auto query_string = MakeQueryStringToPropagate(request_uri);
 
 	auto [result, chunklist] = llhls_stream->GetChunklist(query_string, track_id, msn, part, skip, gzip, legacy, rewind);
+	if (result == LLHlsStream::RequestResult::Accepted)
+	{
+		// Hold
+		//TODO(Getroot): EXT-X-SKIP is under debugging
+
+		skip = false;
+		AddPendingRequest(exchange, LLHlsStream::PendingRequestType::Chunklist, file_name, query_string, gzip, track_id, msn, part, skip, legacy, rewind);
+		return ;
+	}
+
+	SendChunklistResponse(exchange, file_name, result, chunklist, gzip, false);
+}
+
+void LLHlsSession::SendChunklistResponse(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, LLHlsStream::RequestResult result, const std::shared_ptr<const ov::Data> &chunklist, bool gzip, bool resumed)
+{
+	auto request_uri = exchange->GetRequest()->GetParsedUri();
+	auto response = exchange->GetResponse();
+	bool has_delivery_directives = request_uri->HasQueryKey("_HLS_msn");
+
 	if (result == LLHlsStream::RequestResult::Success)
 	{
 		// Send the chunklist
@@ -545,7 +560,7 @@ void LLHlsSession::ResponseChunklist(const std::shared_ptr<http::svr::HttpExchan
 		// Set Content-Type header
 		response->SetHeader("Content-Type", "application/vnd.apple.mpegurl");
 		// gzip compression
-		response->SetHeader("Content-Encoding", content_encoding);
+		response->SetHeader("Content-Encoding", gzip ? "gzip" : "identity");
 
 		// Cache-Control header
 		ov::String cache_control;
@@ -589,24 +604,15 @@ void LLHlsSession::ResponseChunklist(const std::shared_ptr<http::svr::HttpExchan
 			_number_of_players += 1;
 		}
 	}
-	else if (result == LLHlsStream::RequestResult::Accepted && holdIfAccepted == true)
-	{
-		// Hold
-		//TODO(Getroot): EXT-X-SKIP is under debugging
-
-		skip = false;
-		AddPendingRequest(exchange, RequestType::Chunklist, file_name, track_id, msn, part, skip, legacy, rewind);
-		return ;
-	}
 	else
 	{
-		if (holdIfAccepted == false)
+		if (resumed == true)
 		{
 			logtw("%s/%s/%s Failed to respond to pending request.", GetApplication()->GetVHostAppName().CStr(), GetStream()->GetName().CStr(), file_name.CStr());
 		}
 
 		// Send error response
-		response->SetStatusCode(http::StatusCode::NotFound);
+		response->SetStatusCode((result == LLHlsStream::RequestResult::BadRequest) ? http::StatusCode::BadRequest : http::StatusCode::NotFound);
 	}
 
 	ResponseData(exchange);
@@ -704,7 +710,10 @@ void LLHlsSession::ResponseSegment(const std::shared_ptr<http::svr::HttpExchange
 			response->SetHeader("Cache-Control", cache_control);
 		}
 
-		response->AppendData(segment);
+		for (const auto &data : segment)
+		{
+			response->AppendData(data);
+		}
 	}
 	else
 	{
@@ -715,7 +724,7 @@ void LLHlsSession::ResponseSegment(const std::shared_ptr<http::svr::HttpExchange
 	ResponseData(exchange);
 }
 
-void LLHlsSession::ResponsePartialSegment(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, const int64_t &segment_number, const int64_t &partial_number, bool holdIfAccepted /*= true*/)
+void LLHlsSession::ResponsePartialSegment(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, const int64_t &segment_number, const int64_t &partial_number)
 {
 	auto llhls_stream = std::static_pointer_cast<LLHlsStream>(GetStream());
 	if (llhls_stream == nullptr)
@@ -723,10 +732,22 @@ void LLHlsSession::ResponsePartialSegment(const std::shared_ptr<http::svr::HttpE
 		return;
 	}
 
-	auto response = exchange->GetResponse();
-
 	// Get the partial segment
 	auto [result, partial_segment] = llhls_stream->GetChunk(track_id, segment_number, partial_number);
+	if (result == LLHlsStream::RequestResult::Accepted)
+	{
+		// Hold
+		AddPendingRequest(exchange, LLHlsStream::PendingRequestType::PartialSegment, file_name, "", false, track_id, segment_number, partial_number, false, false, false);
+		return ;
+	}
+
+	SendPartialSegmentResponse(exchange, file_name, track_id, result, partial_segment, false);
+}
+
+void LLHlsSession::SendPartialSegmentResponse(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, LLHlsStream::RequestResult result, const std::shared_ptr<const ov::Data> &partial_segment, bool resumed)
+{
+	auto response = exchange->GetResponse();
+
 	if (result == LLHlsStream::RequestResult::Success)
 	{
 		// Send the partial segment
@@ -757,21 +778,15 @@ void LLHlsSession::ResponsePartialSegment(const std::shared_ptr<http::svr::HttpE
 
 		response->AppendData(partial_segment);
 	}
-	else if (result == LLHlsStream::RequestResult::Accepted && holdIfAccepted == true)
-	{
-		// Hold
-		AddPendingRequest(exchange, RequestType::PartialSegment, file_name, track_id, segment_number, partial_number, false, false, false);
-		return ;
-	}
 	else
 	{
-		if (holdIfAccepted == false)
+		if (resumed == true)
 		{
 			logtw("%s/%s/%s Failed to respond to pending request.", GetApplication()->GetVHostAppName().CStr(), GetStream()->GetName().CStr(), file_name.CStr());
 		}
 
 		// Send error response
-		response->SetStatusCode(http::StatusCode::NotFound);
+		response->SetStatusCode((result == LLHlsStream::RequestResult::BadRequest) ? http::StatusCode::BadRequest : http::StatusCode::NotFound);
 	}
 
 	ResponseData(exchange);
@@ -793,82 +808,114 @@ void LLHlsSession::ResponseData(const std::shared_ptr<http::svr::HttpExchange> &
 	exchange->Release();
 }
 
-void LLHlsSession::OnPlaylistUpdated(const int32_t &track_id, const int64_t &msn, const int64_t &part)
+void LLHlsSession::ResumePendingRequest(const std::shared_ptr<LLHlsStream::PendingRequest> &request)
 {
-	logtd("LLHlsSession::OnPlaylistUpdated track_id: %d, msn: %lld, part: %lld", track_id, msn, part);
-	// Find the pending request
+	_pending_request_count--;
 
-	auto it = _pending_requests.begin();
-	while (it != _pending_requests.end())
+	auto llhls_stream = std::static_pointer_cast<LLHlsStream>(GetStream());
+	if (llhls_stream == nullptr)
 	{
-		if ( (it->type == RequestType::Playlist) &&
-			 ((it->segment_number < msn) || (it->segment_number <= msn && it->partial_number <= part)) )
-		{
-			// Send the playlist
-			auto exchange = it->exchange;
-			ResponsePlaylist(exchange, it->file_name, it->legacy, it->rewind, false);
-			it = _pending_requests.erase(it);
-		}
-		else if ( (it->track_id == track_id) && 
-			 ((it->segment_number < msn) || (it->segment_number <= msn && it->partial_number <= part)) )
-		{
-			// Resume the request
-			switch (it->type)
-			{
-			case RequestType::Chunklist:
-				ResponseChunklist(it->exchange, it->file_name, it->track_id, it->segment_number, it->partial_number, it->skip, it->legacy, it->rewind, false);
-				break;
-			case RequestType::PartialSegment:
-				ResponsePartialSegment(it->exchange, it->file_name, it->track_id, it->segment_number, it->partial_number, false);
-				break;
-			case RequestType::Segment:
-				ResponseSegment(it->exchange, it->file_name, it->track_id, it->segment_number);
-				break;
-			case RequestType::Playlist:
-				// Playlist is processed already above
-			case RequestType::InitializationSegment:
-				// Initialization segment request is not pending 
-			default:
-				// Assertion
-				OV_ASSERT2(false);
-				break;
-			}
+		return;
+	}
 
-			// Remove the request
-			it = _pending_requests.erase(it);
-		}
-		else
-		{
-			// Next
-			++it;
-		}
+	// Check expired time
+	if (IsExpired())
+	{
+		RemovePendingRequests(true);
+
+		request->exchange->GetResponse()->SetStatusCode(http::StatusCode::Unauthorized);
+		ResponseData(request->exchange);
+		return;
+	}
+
+	// The same response is shared by the requests resumed by the same update
+	auto [result, data] = llhls_stream->GetPendingResponse(request);
+
+	switch (request->type)
+	{
+		case LLHlsStream::PendingRequestType::Playlist:
+			SendPlaylistResponse(request->exchange, request->file_name, result, data, request->gzip, true);
+			break;
+		case LLHlsStream::PendingRequestType::Chunklist:
+			SendChunklistResponse(request->exchange, request->file_name, result, data, request->gzip, true);
+			break;
+		case LLHlsStream::PendingRequestType::PartialSegment:
+			SendPartialSegmentResponse(request->exchange, request->file_name, request->track_id, result, data, true);
+			break;
+		default:
+			// Assertion
+			OV_ASSERT2(false);
+			break;
+	}
+}
+
+void LLHlsSession::RemovePendingRequests(bool respond)
+{
+	auto llhls_stream = std::static_pointer_cast<LLHlsStream>(GetStream());
+	if (llhls_stream == nullptr)
+	{
+		return;
+	}
+
+	auto removed_requests = llhls_stream->RemovePendingRequests(GetId());
+	if (removed_requests.empty())
+	{
+		return;
+	}
+
+	_pending_request_count -= removed_requests.size();
+	logtd("LLHlsSession(%u) : %zu pending requests are removed", GetId(), removed_requests.size());
+
+	if (respond == false)
+	{
+		return;
+	}
+
+	for (const auto &request : removed_requests)
+	{
+		request->exchange->GetResponse()->SetStatusCode(http::StatusCode::Unauthorized);
+		ResponseData(request->exchange);
 	}
 }
 
-bool LLHlsSession::AddPendingRequest(const std::shared_ptr<http::svr::HttpExchange> &exchange, const RequestType &type, const ov::String &file_name, const int32_t &track_id, const int64_t &segment_number, const int64_t &partial_number, const bool &skip, const bool &legacy, const bool &rewind)
+bool LLHlsSession::AddPendingRequest(const std::shared_ptr<http::svr::HttpExchange> &exchange, const LLHlsStream::PendingRequestType &type, const ov::String &file_name, const ov::String &query_string, const bool &gzip, const int32_t &track_id, const int64_t &segment_number, const int64_t &partial_number, const bool &skip, const bool &legacy, const bool &rewind)
 {
-	// Add the request to the pending list
-	PendingRequest request;
-	request.type = type;
-	request.file_name = file_name;
-	request.track_id = track_id;
-	request.segment_number = segment_number;
-	request.partial_number = partial_number;
-	request.skip = skip;
-	request.legacy = legacy;
-	request.rewind = rewind;
-	request.exchange = exchange;
-
-	// Add the request to the pending list
-	_pending_requests.push_back(request);
-
-	if (_pending_requests.size() > MAX_PENDING_REQUESTS)
+	auto llhls_stream = std::static_pointer_cast<LLHlsStream>(GetStream());
+	if (llhls_stream == nullptr)
+	{
+		return false;
+	}
+
+	auto request = std::make_shared<LLHlsStream::PendingRequest>();
+	request->type = type;
+	request->session = GetSharedPtrAs<pub::Session>();
+	request->session_id = GetId();
+	request->exchange = exchange;
+	request->file_name = file_name;
+	request->query_string = query_string;
+	request->track_id = track_id;
+	request->msn = segment_number;
+	request->part = partial_number;
+	request->gzip = gzip;
+	request->skip = skip;
+	request->legacy = legacy;
+	request->rewind = rewind;
+
+	// The request waits in the stream, and it is resumed in the worker thread of this session
+	if (llhls_stream->AddPendingRequest(request) == false)
+	{
+		return false;
+	}
+
+	_pending_request_count++;
+
+	if (_pending_request_count > MAX_PENDING_REQUESTS)
 	{
 		logtd("[%s/%s/%u] Too many pending requests (%u)", 
 				GetApplication()->GetVHostAppName().CStr(),
 				GetStream()->GetName().CStr(),
 				GetId(),
-				_pending_requests.size());
+				_pending_request_count.load());
 	}
 
 	return true;
@@ -13,6 +13,8 @@
 
 #include <modules/access_control/access_controller.h>
 
+#include "llhls_stream.h"
+
 #define MAX_PENDING_REQUESTS 10
 
 class LLHlsSession : public pub::Session
@@ -47,7 +49,6 @@ public:
 	bool Stop() override;
 
 	// pub::Session Interface
-	void SendOutgoingData(const std::any &packet) override;
 	void OnMessageReceived(const std::any &message) override;
 
 	void UpdateLastRequest(uint32_t connection_id);
@@ -73,36 +74,30 @@ private:
 
 	bool ParseFileName(const ov::String &file_name, RequestType &type, int32_t &track_id, int64_t &segment_number, int64_t &partial_number, ov::String &stream_key) const;
 
-	void ResponsePlaylist(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, bool legacy, bool rewind, bool holdIfAccepted = true);
-	void ResponseChunklist(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, int64_t msn, int64_t part, bool skip, bool legacy, bool rewind, bool holdIfAccepted = true);
+	void ResponsePlaylist(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, bool legacy, bool rewind);
+	void ResponseChunklist(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, int64_t msn, int64_t part, bool skip, bool legacy, bool rewind);
 	void ResponseInitializationSegment(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id);
 	void ResponseSegment(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, const int64_t &segment_number);
-	void ResponsePartialSegment(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, const int64_t &segment_number, const int64_t &partial_number, bool holdIfAccepted = true);
+	void ResponsePartialSegment(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, const int64_t &segment_number, const int64_t &partial_number);
 
-	void ResponseData(const std::shared_ptr<http::svr::HttpExchange> &exchange);
+	// resumed: true if the request has been pending in the stream
+	void SendPlaylistResponse(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, LLHlsStream::RequestResult result, const std::shared_ptr<const ov::Data> &playlist, bool gzip, bool resumed);
+	void SendChunklistResponse(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, LLHlsStream::RequestResult result, const std::shared_ptr<const ov::Data> &chunklist, bool gzip, bool resumed);
+	void SendPartialSegmentResponse(const std::shared_ptr<http::svr::HttpExchange> &exchange, const ov::String &file_name, const int32_t &track_id, LLHlsStream::RequestResult result, const std::shared_ptr<const ov::Data> &partial_segment, bool resumed);
 
-	void OnPlaylistUpdated(const int32_t &track_id, const int64_t &msn, const int64_t &part);
+	void ResponseData(const std::shared_ptr<http::svr::HttpExchange> &exchange);
 
 	ov::String MakeQueryStringToPropagate(const std::shared_ptr<ov::Url> &request_uri);
 
-	// Pending requests
-	struct PendingRequest
-	{
-		RequestType type;
-		ov::String file_name;
-		int32_t track_id;
-		int64_t segment_number = -1;
-		int64_t partial_number = -1;
-		bool skip = false;
-		bool legacy = false;
-		bool rewind = false;
-
-		std::shared_ptr<http::svr::HttpExchange> exchange;
-	};
+	// Pending requests wait in the stream (LLHlsStream::AddPendingRequest) until the partial segment is ready
+	bool AddPendingRequest(const std::shared_ptr<http::svr::HttpExchange> &exchange, const LLHlsStream::PendingRequestType &type, const ov::String &file_name, const ov::String &query_string, const bool &gzip, const int32_t &track_id, const int64_t &segment_number, const int64_t &partial_number, const bool &skip, const bool &legacy, const bool &rewind);
+	void ResumePendingRequest(const std::shared_ptr<LLHlsStream::PendingRequest> &request);
+	// respond: true to answer the removed requests with 401 (the session has expired)
+	void RemovePendingRequests(bool respond);
 
-	bool AddPendingRequest(const std::shared_ptr<http::svr::HttpExchange> &exchange, const RequestType &type, const ov::String &file_name, const int32_t &track_id, const int64_t &segment_number, const int64_t &partial_number, const bool &skip, const bool &legacy, const bool &rewind);
+	bool IsExpired() const;
 
-	std::list<PendingRequest> _pending_requests;
+	std::atomic<uint32_t> _pending_request_count = 0;
 
 	// ID list of connections requesting this session
 	// Connection ID : last request time
@@ -23,6 +23,11 @@
 #include "llhls_private.h"
 #include "llhls_session.h"
 
+// Requests for the master playlist wait for any track
+#define PENDING_PLAYLIST_TRACK_ID -1
+// RFC 8216bis 6.2.5.2 - A blocking request for _HLS_msn more than two segments ahead of the last one is answered with 400
+#define MAX_BLOCKING_SEGMENTS_AHEAD 2
+
 std::shared_ptr<LLHlsStream> LLHlsStream::Create(const std::shared_ptr<pub::Application> application, const info::Stream &info, uint32_t worker_count)
 {
 	auto stream = std::make_shared<LLHlsStream>(application, info, worker_count);
@@ -264,6 +269,8 @@ bool LLHlsStream::Stop()
 {
 	logtd("LLHlsStream(%s) has been stopped", GetName().CStr());
 
+	ClearPendingRequests();
+
 	{
 		std::scoped_lock lock{_packager_map_lock, _storage_map_lock, _chunklist_map_lock, _master_playlists_lock, _dumps_lock};
 
@@ -729,7 +736,7 @@ bool LLHlsStream::DumpSegment(const std::shared_ptr<mdl::Dump> &item, const int3
 		return false;
 	}
 
-	auto segment_data = segment->GetData();
+	auto segment_data = segment->CopyData();
 
 	// Get updated chunklist
 	auto chunklist = GetChunklistWriter(track_id);
@@ -841,6 +848,12 @@ std::tuple<LLHlsStream::RequestResult, std::shared_ptr<const ov::Data>> LLHlsStr
 			return {RequestResult::NotFound, nullptr};
 		}
 
+		if (msn > last_msn + MAX_BLOCKING_SEGMENTS_AHEAD)
+		{
+			logtd("Rejected chunklist for track_id = %d, msn = %ld, psn = %ld (last_msn = %ld, last_psn = %ld)", track_id, msn, psn, last_msn, last_psn);
+			return {RequestResult::BadRequest, nullptr};
+		}
+
 		if (msn > last_msn || (msn >= last_msn && psn > last_psn))
 		{
 			// Hold the request until a Playlist contains a Segment with the requested Sequence Number
@@ -873,23 +886,23 @@ std::tuple<LLHlsStream::RequestResult, std::shared_ptr<ov::Data>> LLHlsStream::G
 	return {RequestResult::Success, storage->GetInitializationSection()};
 }
 
-std::tuple<LLHlsStream::RequestResult, std::shared_ptr<ov::Data>> LLHlsStream::GetSegment(const int32_t &track_id, const int64_t &segment_number) const
+std::tuple<LLHlsStream::RequestResult, std::vector<std::shared_ptr<const ov::Data>>> LLHlsStream::GetSegment(const int32_t &track_id, const int64_t &segment_number) const
 {
 	auto storage = GetStorage(track_id);
 	if (storage == nullptr)
 	{
 		logtw("Could not find storage for track_id = %d", track_id);
-		return {RequestResult::NotFound, nullptr};
+		return {RequestResult::NotFound, {}};
 	}
 
 	auto segment = storage->GetMediaSegment(segment_number);
 	if (segment == nullptr)
 	{
 		logtw("Could not find segment for track_id = %d, segment = %ld (last_segment = %ld)", track_id, segment_number, storage->GetLastSegmentNumber());
-		return {RequestResult::NotFound, nullptr};
+		return {RequestResult::NotFound, {}};
 	}
 
-	return {RequestResult::Success, segment->GetData()};
+	return {RequestResult::Success, segment->GetDataList()};
 }
 
 std::tuple<LLHlsStream::RequestResult, std::shared_ptr<ov::Data>> LLHlsStream::GetChunk(const int32_t &track_id, const int64_t &segment_number, const int64_t &chunk_number) const
@@ -905,6 +918,12 @@ std::tuple<LLHlsStream::RequestResult, std::shared_ptr<ov::Data>> LLHlsStream::G
 
 	auto [last_segment_number, last_chunk_number] = storage->GetLastChunkNumber();
 
+	if (segment_number > last_segment_number + MAX_BLOCKING_SEGMENTS_AHEAD)
+	{
+		logtd("Rejected chunk for track_id = %d, segment = %ld, chunk = %ld (last_segment = %ld, last_chunk = %ld)", track_id, segment_number, chunk_number, last_segment_number, last_chunk_number);
+		return {RequestResult::BadRequest, nullptr};
+	}
+
 	if ((segment_number > last_segment_number) || (segment_number == last_segment_number && chunk_number > last_chunk_number))
 	{
 		logtd("Accepted chunk for track_id = %d, segment = %ld, chunk = %ld (last_segment = %ld, last_chunk = %ld)", track_id, segment_number, chunk_number, last_segment_number, last_chunk_number);
@@ -1722,11 +1741,220 @@ void LLHlsStream::OnMediaSegmentDeleted(const int32_t &track_id, const uint32_t
 
 void LLHlsStream::NotifyPlaylistUpdated(const int32_t &track_id, const int64_t &msn, const int64_t &part)
 {
-	// Make std::any for broadcast
-	// I think make_shared is better than copy sizeof(PlaylistUpdatedEvent) to all sessions
-	auto event = std::make_shared<PlaylistUpdatedEvent>(track_id, msn, part);
-	auto notification = std::make_any<std::shared_ptr<PlaylistUpdatedEvent>>(event);
-	BroadcastPacket(notification);
+	std::vector<std::shared_ptr<PendingRequest>> resumed_requests;
+
+	{
+		std::lock_guard<std::mutex> lock(_pending_requests_lock);
+
+		// The keys are ordered by (track id, msn, part), so the requests waiting for (msn, part) or earlier of the track are a range
+		for (auto waiting_track_id : {track_id, PENDING_PLAYLIST_TRACK_ID})
+		{
+			auto begin = _pending_requests.lower_bound({waiting_track_id, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::min()});
+			auto end = _pending_requests.upper_bound({waiting_track_id, msn, part});
+
+			for (auto it = begin; it != end; ++it)
+			{
+				for (const auto &request : it->second)
+				{
+					resumed_requests.push_back(request);
+					RemovePendingRequestPosition(request->session_id, it);
+				}
+			}
+
+			_pending_requests.erase(begin, end);
+		}
+	}
+
+	if (resumed_requests.empty())
+	{
+		return;
+	}
+
+	logtd("Resume %zu pending requests : track_id = %d, msn = %lld, part = %lld", resumed_requests.size(), track_id, msn, part);
+
+	auto response_cache = std::make_shared<PendingResponseCache>();
+	auto now_ms = ov::Clock::NowMSec();
+
+	for (auto &request : resumed_requests)
+	{
+		_pending_time_histograms[static_cast<size_t>(request->type)].Add(now_ms - request->pending_time_ms);
+
+		auto session = request->session.lock();
+		if (session == nullptr)
+		{
+			// The session has been closed while waiting
+			continue;
+		}
+
+		request->response_cache = response_cache;
+
+		// The response is rendered and sent in the worker thread of the session
+		SendMessage(session, std::make_any<std::shared_ptr<PendingRequest>>(request));
+	}
+}
+
+bool LLHlsStream::AddPendingRequest(const std::shared_ptr<PendingRequest> &request)
+{
+	if (request == nullptr)
+	{
+		return false;
+	}
+
+	request->pending_time_ms = ov::Clock::NowMSec();
+
+	auto waiting_track_id = (request->type == PendingRequestType::Playlist) ? PENDING_PLAYLIST_TRACK_ID : request->track_id;
+
+	std::lock_guard<std::mutex> lock(_pending_requests_lock);
+
+	auto it = _pending_requests.try_emplace({waiting_track_id, request->msn, request->part}).first;
+	auto request_it = it->second.insert(it->second.end(), request);
+
+	_pending_request_positions[request->session_id].emplace_back(it, request_it);
+
+	return true;
+}
+
+// Must be called with _pending_requests_lock held, before the requests of it are erased
+void LLHlsStream::RemovePendingRequestPosition(session_id_t session_id, PendingRequestMap::iterator it)
+{
+	auto positions_it = _pending_request_positions.find(session_id);
+	if (positions_it == _pending_request_positions.end())
+	{
+		return;
+	}
+
+	auto &positions = positions_it->second;
+
+	positions.erase(std::remove_if(positions.begin(), positions.end(),
+								   [&it](const PendingRequestPosition &position) {
+									   return position.first == it;
+								   }),
+					positions.end());
+
+	if (positions.empty())
+	{
+		_pending_request_positions.erase(positions_it);
+	}
+}
+
+std::vector<std::shared_ptr<LLHlsStream::PendingRequest>> LLHlsStream::RemovePendingRequests(session_id_t session_id)
+{
+	std::vector<std::shared_ptr<PendingRequest>> removed_requests;
+
+	std::lock_guard<std::mutex> lock(_pending_requests_lock);
+
+	auto positions_it = _pending_request_positions.find(session_id);
+	if (positions_it == _pending_request_positions.end())
+	{
+		return removed_requests;
+	}
+
+	// Only the requests of the session are touched
+	for (auto &[it, request_it] : positions_it->second)
+	{
+		removed_requests.push_back(*request_it);
+
+		it->second.erase(request_it);
+		if (it->second.empty())
+		{
+			_pending_requests.erase(it);
+		}
+	}
+
+	_pending_request_positions.erase(positions_it);
+
+	return removed_requests;
+}
+
+std::tuple<LLHlsStream::RequestResult, std::shared_ptr<const ov::Data>> LLHlsStream::GetPendingResponse(const std::shared_ptr<PendingRequest> &request)
+{
+	ov::String key = ov::String::FormatString("%d/%s/%d/%lld/%lld/%d%d%d%d?%s",
+											  static_cast<int>(request->type), request->file_name.CStr(), request->track_id, request->msn, request->part,
+											  request->gzip, request->skip, request->legacy, request->rewind, request->query_string.CStr());
+
+	auto response_cache = request->response_cache;
+	if (response_cache != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(response_cache->mutex);
+		auto it = response_cache->responses.find(key);
+		if (it != response_cache->responses.end())
+		{
+			return it->second;
+		}
+	}
+
+	std::tuple<RequestResult, std::shared_ptr<const ov::Data>> response = {RequestResult::NotFound, nullptr};
+
+	switch (request->type)
+	{
+		case PendingRequestType::Playlist:
+			response = GetMasterPlaylist(request->file_name, request->query_string, request->gzip, request->legacy, request->rewind);
+			break;
+		case PendingRequestType::Chunklist:
+			response = GetChunklist(request->query_string, request->track_id, request->msn, request->part, request->skip, request->gzip, request->legacy, request->rewind);
+			break;
+		case PendingRequestType::PartialSegment:
+			response = GetChunk(request->track_id, request->msn, request->part);
+			break;
+		default:
+			break;
+	}
+
+	if (response_cache != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(response_cache->mutex);
+		// If another session has rendered it in the meantime, use it
+		auto [it, inserted] = response_cache->responses.emplace(key, response);
+		return it->second;
+	}
+
+	return response;
+}
+
+void LLHlsStream::ClearPendingRequests()
+{
+	std::lock_guard<std::mutex> lock(_pending_requests_lock);
+
+	for (size_t index = 0; index < static_cast<size_t>(PendingRequestType::Count); index++)
+	{
+		logti("LLHlsStream(%s/%s) - Pending time of %s requests : %s",
+			  GetApplication()->GetVHostAppName().CStr(), GetName().CStr(),
+			  (index == static_cast<size_t>(PendingRequestType::Playlist)) ? "playlist" : (index == static_cast<size_t>(PendingRequestType::Chunklist)) ? "chunklist" : "partial segment",
+			  _pending_time_histograms[index].ToString().CStr());
+	}
+
+	_pending_requests.clear();
+	_pending_request_positions.clear();
+}
+
+void LLHlsStream::PendingTimeHistogram::Add(int64_t pending_time_ms)
+{
+	size_t index = 0;
+	while (index < BucketCount - 1 && pending_time_ms > BucketBoundsMs[index])
+	{
+		index++;
+	}
+
+	_buckets[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+ov::String LLHlsStream::PendingTimeHistogram::ToString() const
+{
+	ov::String str;
+
+	for (size_t index = 0; index < BucketCount; index++)
+	{
+		if (index < BucketCount - 1)
+		{
+			str.AppendFormat("<=%lldms: %llu, ", BucketBoundsMs[index], _buckets[index].load(std::memory_order_relaxed));
+		}
+		else
+		{
+			str.AppendFormat(">%lldms: %llu", BucketBoundsMs[index - 1], _buckets[index].load(std::memory_order_relaxed));
+		}
+	}
+
+	return str;
 }
 
 int64_t LLHlsStream::GetMinimumLastSegmentNumber() const
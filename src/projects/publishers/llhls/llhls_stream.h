@@ -12,9 +12,13 @@
 #include <base/publisher/stream.h>
 #include <base/info/dump.h>
 #include <modules/dump/dump.h>
+#include <modules/http/server/http_exchange.h>
 
 #include "monitoring/monitoring.h"
 
+#include <list>
+#include <unordered_map>
+
 #include "modules/containers/bmff/fmp4_packager/fmp4_packager.h"
 #include "llhls_master_playlist.h"
 #include "llhls_chunklist.h"
@@ -50,23 +54,72 @@ public:
 		Success, // Success
 		Accepted, // The request is accepted but not yet processed, it will be processed later
 		NotFound, // The request is not found
+		BadRequest, // The blocking request is too far ahead of the live edge
 		UnknownError,
 	};
 
-	struct PlaylistUpdatedEvent
+	// Blocking requests (playlist reload with _HLS_msn/_HLS_part, preload hint) wait for a partial segment in the stream.
+	// When a partial segment is updated, only the matching requests are resumed in the worker threads of their sessions.
+	enum class PendingRequestType : uint8_t
+	{
+		Playlist,
+		Chunklist,
+		PartialSegment,
+
+		Count
+	};
+
+	// Responses rendered for the requests resumed by the same update.
+	// Requests with the same parameters get the same immutable data.
+	struct PendingResponseCache
+	{
+		std::mutex mutex;
+		std::map<ov::String, std::tuple<RequestResult, std::shared_ptr<const ov::Data>>> responses;
+	};
+
+	struct PendingRequest
+	{
+		PendingRequestType type = PendingRequestType::Chunklist;
+
+		std::weak_ptr<pub::Session> session;
+		session_id_t session_id = 0;
+		std::shared_ptr<http::svr::HttpExchange> exchange;
+
+		ov::String file_name;
+		ov::String query_string;
+		int32_t track_id = 0;
+		int64_t msn = -1;
+		int64_t part = -1;
+		bool gzip = false;
+		bool skip = false;
+		bool legacy = false;
+		bool rewind = false;
+
+		int64_t pending_time_ms = 0;
+
+		std::shared_ptr<PendingResponseCache> response_cache;
+	};
+
+	// Distribution of the time that the requests wait in the stream
+	class PendingTimeHistogram
 	{
-		PlaylistUpdatedEvent(const int32_t &id, const int64_t &new_msn, const int64_t &new_part)
-		{
-			track_id = id;
-			msn = new_msn;
-			part = new_part;
-		}
-
-		int32_t track_id;
-		int64_t msn;
-		int64_t part;
+	public:
+		static constexpr int64_t BucketBoundsMs[] = {50, 100, 200, 500, 1000, 3000};
+		static constexpr size_t BucketCount = sizeof(BucketBoundsMs) / sizeof(BucketBoundsMs[0]) + 1;
+
+		void Add(int64_t pending_time_ms);
+		ov::String ToString() const;
+
+	private:
+		std::atomic<uint64_t> _buckets[BucketCount] = {};
 	};
-	
+
+	bool AddPendingRequest(const std::shared_ptr<PendingRequest> &request);
+	// Removes and returns the requests of the session (stopped or expired)
+	std::vector<std::shared_ptr<PendingRequest>> RemovePendingRequests(session_id_t session_id);
+	// Called in the worker thread of the session when the request is resumed
+	std::tuple<RequestResult, std::shared_ptr<const ov::Data>> GetPendingResponse(const std::shared_ptr<PendingRequest> &request);
+
 	const ov::String &GetStreamKey() const;
 
 	uint64_t GetMaxChunkDurationMS() const;
@@ -74,7 +127,8 @@ public:
 	std::tuple<RequestResult, std::shared_ptr<const ov::Data>> GetMasterPlaylist(const ov::String &file_name, const ov::String &chunk_query_string, bool gzip, bool legacy, bool rewind, bool include_path=true);
 	std::tuple<RequestResult, std::shared_ptr<const ov::Data>> GetChunklist(const ov::String &chunk_query_string, const int32_t &track_id, int64_t msn, int64_t psn, bool skip, bool gzip, bool legacy, bool rewind) const;
 	std::tuple<RequestResult, std::shared_ptr<ov::Data>> GetInitializationSegment(const int32_t &track_id) const;
-	std::tuple<RequestResult, std::shared_ptr<ov::Data>> GetSegment(const int32_t &track_id, const int64_t &segment_number) const;
+	// The segment is returned as a list of slices (chunks) to avoid building a contiguous copy
+	std::tuple<RequestResult, std::vector<std::shared_ptr<const ov::Data>>> GetSegment(const int32_t &track_id, const int64_t &segment_number) const;
 	std::tuple<RequestResult, std::shared_ptr<ov::Data>> GetChunk(const int32_t &track_id, const int64_t &segment_number, const int64_t &chunk_number) const;
 
 	//////////////////////////
@@ -103,6 +157,7 @@ private:
 	bool IsSupportedCodec(cmn::MediaCodecId codec_id) const; 
 
 	void NotifyPlaylistUpdated(const int32_t &track_id, const int64_t &msn, const int64_t &part);
+	void ClearPendingRequests();
 
 	// bmff::FMp4StorageObserver implementation
 	void OnFMp4StorageInitialized(const int32_t &track_id) override;
@@ -207,6 +262,18 @@ private:
 	bool _first_chunk = true;
 	int64_t _wallclock_offset_ms = 0;
 
+	// Pending requests
+	// (track id, msn, part) : requests, requests for the master playlist wait for any track with the track id of -1
+	using PendingRequestMap = std::map<std::tuple<int32_t, int64_t, int64_t>, std::list<std::shared_ptr<PendingRequest>>>;
+	// Position of a pending request in _pending_requests (the iterators of std::map/std::list stay valid until erased)
+	using PendingRequestPosition = std::pair<PendingRequestMap::iterator, std::list<std::shared_ptr<PendingRequest>>::iterator>;
+	PendingRequestMap _pending_requests;
+	// session id : positions of the requests of the session, so that a session removes its requests without scanning all of them
+	std::unordered_map<session_id_t, std::vector<PendingRequestPosition>> _pending_request_positions;
+	std::mutex _pending_requests_lock;
+	void RemovePendingRequestPosition(session_id_t session_id, PendingRequestMap::iterator it);
+	PendingTimeHistogram _pending_time_histograms[static_cast<size_t>(PendingRequestType::Count)];
+
 	// ConcludeLive
 	// Append #EXT-X-ENDLIST all chunklists, and no more update segment and chunklist
 	bool _concluded = false;
@@ -366,6 +366,7 @@ void OvtPublisher::HandlePlayRequest(const std::shared_ptr<ov::Socket> &remote,
 	ResponseResult(remote, session->GetId(), "play", request_id, 200, "ok");
 
 	stream->AddSession(session);
+	stream->SendGopCache(session);
 }
 
 void OvtPublisher::HandleStopRequest(const std::shared_ptr<ov::Socket> &remote, uint32_t session_id, uint32_t request_id, const std::shared_ptr<const ov::Url> &url)
@@ -95,6 +95,12 @@ const std::shared_ptr<ov::Socket> OvtSession::GetConnector()
 	return _connector;
 }
 
+void OvtSession::OnGopCacheSending(const std::vector<std::any> &packets)
+{
+	// The GOP cache starts from the first packet of a keyframe
+	_sent_ready = true;
+}
+
 void OvtSession::OnMessageReceived(const std::any &message)
 {
 	// NOTHING YET
@@ -23,6 +23,7 @@ public:
 
 	void SendOutgoingData(const std::any &packet) override;
 	void OnMessageReceived(const std::any &message) override;
+	void OnGopCacheSending(const std::vector<std::any> &packets) override;
 
 	const std::shared_ptr<ov::Socket> GetConnector();
 
@@ -54,6 +54,8 @@ bool OvtStream::Start()
 		return false;
 	}
 
+	EnableGopCache();
+
 	logtd("OvtStream(%d) has been started", GetId());
 	_packetizer = std::make_shared<OvtPacketizer>(OvtPacketizerInterface::GetSharedPtr());
 
@@ -203,6 +205,9 @@ void OvtStream::SendVideoFrame(const std::shared_ptr<MediaPacket> &media_packet)
 	std::shared_lock<std::shared_mutex> mlock(_packetizer_lock);
 	if(_packetizer != nullptr)
 	{
+		_packetizing_track_id = media_packet->GetTrackId();
+		_packetizing_packet_type = media_packet->IsKeyFrame() ? pub::GopCache::PacketType::KeyFrame : pub::GopCache::PacketType::Dependent;
+
 		_packetizer->PacketizeMediaPacket(media_packet->GetPts(), media_packet);
 	}
 }
@@ -218,6 +223,9 @@ void OvtStream::SendAudioFrame(const std::shared_ptr<MediaPacket> &media_packet)
 	std::shared_lock<std::shared_mutex> mlock(_packetizer_lock);
 	if(_packetizer != nullptr)
 	{
+		_packetizing_track_id = media_packet->GetTrackId();
+		_packetizing_packet_type = pub::GopCache::PacketType::Independent;
+
 		_packetizer->PacketizeMediaPacket(media_packet->GetPts(), media_packet);
 	}
 }
@@ -226,7 +234,13 @@ bool OvtStream::OnOvtPacketized(std::shared_ptr<OvtPacket> &packet)
 {
 	// Broadcasting
 	auto stream_packet = std::make_any<std::shared_ptr<OvtPacket>>(packet);
-	BroadcastPacket(stream_packet);
+	BroadcastPacket(stream_packet, _packetizing_track_id, _packetizing_packet_type, packet->GetDataLength());
+
+	// The other packets of the keyframe depend on the first one
+	if (_packetizing_packet_type == pub::GopCache::PacketType::KeyFrame)
+	{
+		_packetizing_packet_type = pub::GopCache::PacketType::Dependent;
+	}
 	
 	
 	MonitorInstance->IncreaseBytesOut(*pub::Stream::GetSharedPtrAs<info::Stream>(), PublisherType::Ovt, packet->GetDataLength() * GetSessionCount());
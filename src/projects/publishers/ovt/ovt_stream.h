@@ -39,4 +39,8 @@ private:
 	Json::Value							_description;
 	std::shared_mutex					_packetizer_lock;
 	std::shared_ptr<OvtPacketizer>		_packetizer;
+
+	// The media packet being packetized, for the GOP cache
+	uint32_t							_packetizing_track_id = 0;
+	pub::GopCache::PacketType			_packetizing_packet_type = pub::GopCache::PacketType::Independent;
 };
@@ -88,7 +88,7 @@ namespace pub
 		}
 	}
 
-	void SrtPlaylist::SendData(const std::vector<std::shared_ptr<mpegts::Packet>> &packets)
+	void SrtPlaylist::SendData(const std::shared_ptr<const ov::Data> &data, bool is_key_frame)
 	{
 		if (_sink == nullptr)
 		{
@@ -97,55 +97,66 @@ namespace pub
 
 		auto self = GetSharedPtrAs<SrtPlaylist>();
 
-		for (auto &packet : packets)
+		constexpr size_t payload_size = SRT_LIVE_DEF_PLSIZE;
+		auto buffer = data->GetDataAs<uint8_t>();
+		size_t remaining = data->GetLength();
+		off_t offset = 0;
+
+		if (is_key_frame && (_data_to_send->GetLength() > 0))
 		{
-			auto size = _data_to_send->GetLength();
-			const auto &data = packet->GetData();
+			// Send the pending payload as is
+			_sink->OnSrtPlaylistData(self, _data_to_send, _is_key_frame_to_send);
+			_data_to_send = std::make_shared<ov::Data>(payload_size);
+		}
 
-			// Broadcast if the data size exceeds the SRT's payload length
-			if ((size + data->GetLength()) > SRT_LIVE_DEF_PLSIZE)
-			{
-				_sink->OnSrtPlaylistData(self, _data_to_send);
-				_data_to_send = data->Clone();
-			}
-			else
+		// Complete the pending payload first
+		if (_data_to_send->GetLength() > 0)
+		{
+			auto length = std::min(payload_size - _data_to_send->GetLength(), remaining);
+
+			_data_to_send->Append(buffer, length);
+			offset += length;
+			remaining -= length;
+
+			if (_data_to_send->GetLength() < payload_size)
 			{
-				_data_to_send->Append(packet->GetData());
+				return;
 			}
+
+			_sink->OnSrtPlaylistData(self, _data_to_send, _is_key_frame_to_send);
+			_data_to_send = std::make_shared<ov::Data>(payload_size);
 		}
-	}
 
-	void SrtPlaylist::OnPsi(const std::vector<std::shared_ptr<const MediaTrack>> &tracks, const std::vector<std::shared_ptr<mpegts::Packet>> &psi_packets)
-	{
-		std::shared_ptr<ov::Data> psi_data = std::make_shared<ov::Data>();
+		// The TS packets of the packetizer are not modified after being built,
+		// so each SRT payload refers to a slice of them without copying
+		while (remaining >= payload_size)
+		{
+			_sink->OnSrtPlaylistData(self, data->Subdata(offset, payload_size), is_key_frame && (offset == 0));
+			offset += payload_size;
+			remaining -= payload_size;
+		}
 
-		// Concatenate PSI packets
-		for (const auto &packet : psi_packets)
+		if (remaining > 0)
 		{
-			psi_data->Append(packet->GetData());
+			// _data_to_send is empty here
+			_is_key_frame_to_send = is_key_frame && (offset == 0);
+			_data_to_send->Append(buffer + offset, remaining);
 		}
+	}
 
-		logap("OnPsi - %zu packets (total %zu bytes)", psi_packets.size(), psi_data->GetLength());
+	void SrtPlaylist::OnPsi(const std::vector<std::shared_ptr<const MediaTrack>> &tracks, const std::shared_ptr<const ov::Data> &psi_data)
+	{
+		logap("OnPsi - %zu packets (total %zu bytes)", psi_data->GetLength() / mpegts::MPEGTS_MIN_PACKET_SIZE, psi_data->GetLength());
 
-		_psi_data = std::move(psi_data);
+		_psi_data = psi_data;
 
-		SendData(psi_packets);
+		SendData(psi_data, false);
 	}
 
-	void SrtPlaylist::OnFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::vector<std::shared_ptr<mpegts::Packet>> &pes_packets)
+	void SrtPlaylist::OnFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::shared_ptr<const ov::Data> &pes_data)
 	{
-#if DEBUG
-		// Since adding up the total packet size is costly, it is calculated only in debug mode
-		size_t total_packet_size = 0;
-
-		for (const auto &packet : pes_packets)
-		{
-			total_packet_size += packet->GetDataLength();
-		}
-
-		logap("OnFrame - %zu packets (total %zu bytes)", pes_packets.size(), total_packet_size);
-#endif	// DEBUG
+		logap("OnFrame - %zu packets (total %zu bytes)", pes_data->GetLength() / mpegts::MPEGTS_MIN_PACKET_SIZE, pes_data->GetLength());
 
-		SendData(pes_packets);
+		SendData(pes_data, (media_packet->GetMediaType() == cmn::MediaType::Video) && media_packet->IsKeyFrame());
 	}
 }  // namespace pub
@@ -24,9 +24,11 @@ namespace pub
 	public:
 		virtual ~SrtPlaylistSink() = default;
 
+		// is_key_frame: the data starts with a video keyframe
 		virtual void OnSrtPlaylistData(
 			const std::shared_ptr<SrtPlaylist> &playlist,
-			const std::shared_ptr<const ov::Data> &data) = 0;
+			const std::shared_ptr<const ov::Data> &data,
+			bool is_key_frame) = 0;
 	};
 
 	struct SrtData
@@ -67,10 +69,10 @@ namespace pub
 		// Implementation of mpegts::PacketizerSink
 		//--------------------------------------------------------------------
 		// Do not need to lock _packetizer_mutex inside OnPsi() because it will be called only once when the packetizer starts
-		void OnPsi(const std::vector<std::shared_ptr<const MediaTrack>> &tracks, const std::vector<std::shared_ptr<mpegts::Packet>> &psi_packets) override;
+		void OnPsi(const std::vector<std::shared_ptr<const MediaTrack>> &tracks, const std::shared_ptr<const ov::Data> &psi_data) override;
 		// Do not need to lock _packetizer_mutex inside OnFrame() because it's called after acquiring the lock in EnqueuePacket()
 		// (It's called in the thread that calls EnqueuePacket())
-		void OnFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::vector<std::shared_ptr<mpegts::Packet>> &pes_packets) override;
+		void OnFrame(const std::shared_ptr<const MediaPacket> &media_packet, const std::shared_ptr<const ov::Data> &pes_data) override;
 		//--------------------------------------------------------------------
 
 		const std::shared_ptr<const ov::Data> &GetPsiData() const
@@ -92,7 +94,9 @@ namespace pub
 		};
 
 	private:
-		void SendData(const std::vector<std::shared_ptr<mpegts::Packet>> &packets);
+		// Split the TS packets into SRT payloads (SRT_LIVE_DEF_PLSIZE bytes)
+		// A keyframe starts a new payload, so a session can start from it (GOP cache of the stream)
+		void SendData(const std::shared_ptr<const ov::Data> &data, bool is_key_frame);
 
 	private:
 		std::shared_ptr<const info::Stream> _stream_info;
@@ -106,5 +110,7 @@ namespace pub
 
 		std::shared_ptr<const ov::Data> _psi_data;
 		std::shared_ptr<ov::Data> _data_to_send = std::make_shared<ov::Data>();
+		// _data_to_send starts with a keyframe
+		bool _is_key_frame_to_send = false;
 	};
 }  // namespace pub
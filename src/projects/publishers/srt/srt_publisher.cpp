@@ -492,6 +492,7 @@ namespace pub
 		session->SetFinalUrl(final_url);
 
 		stream->AddSession(session);
+		stream->SendGopCache(session);
 	}
 
 	void SrtPublisher::OnDataReceived(const std::shared_ptr<ov::Socket> &remote,
@@ -240,6 +240,8 @@ namespace pub
 			return false;
 		}
 
+		EnableGopCache();
+
 		auto config = GetApplication()->GetConfig();
 		auto srt_config = config.GetPublishers().GetSrtPublisher();
 
@@ -447,11 +449,16 @@ namespace pub
 
 	void SrtStream::OnSrtPlaylistData(
 		const std::shared_ptr<SrtPlaylist> &playlist,
-		const std::shared_ptr<const ov::Data> &data)
+		const std::shared_ptr<const ov::Data> &data,
+		bool is_key_frame)
 	{
 		auto srt_data = std::make_shared<const SrtData>(playlist, data);
 
-		BroadcastPacket(std::make_any<std::shared_ptr<const SrtData>>(srt_data));
+		// Each playlist is a MPEG-TS stream that can be decoded from its keyframe
+		BroadcastPacket(std::make_any<std::shared_ptr<const SrtData>>(srt_data),
+						reinterpret_cast<uintptr_t>(playlist.get()),
+						is_key_frame ? GopCache::PacketType::KeyFrame : GopCache::PacketType::Dependent,
+						data->GetLength());
 
 		MonitorInstance->IncreaseBytesOut(
 			*GetSharedPtrAs<info::Stream>(),
@@ -48,7 +48,8 @@ namespace pub
 		//--------------------------------------------------------------------
 		void OnSrtPlaylistData(
 			const std::shared_ptr<SrtPlaylist> &playlist,
-			const std::shared_ptr<const ov::Data> &data) override;
+			const std::shared_ptr<const ov::Data> &data,
+			bool is_key_frame) override;
 		//--------------------------------------------------------------------
 
 	private:
@@ -1,3 +1,6 @@
 #pragma once
 
 #define OV_LOG_TAG                      "WebRTC Publisher"
+
+// Interval of the timer that sends the packets queued in the pacers of the sessions
+#define PACING_INTERVAL_MS              5
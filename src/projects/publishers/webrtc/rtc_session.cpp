@@ -20,6 +20,9 @@
 
 #include <utility>
 
+// Interval of the frames of the GOP cache in the 90 kHz video clock (1 ms)
+#define RTC_GOP_CACHE_FRAME_INTERVAL 90
+
 std::shared_ptr<RtcSession> RtcSession::Create(const std::shared_ptr<WebRtcPublisher> &publisher,
 											   const std::shared_ptr<pub::Application> &application,
                                                const std::shared_ptr<pub::Stream> &stream,
@@ -101,6 +104,8 @@ bool RtcSession::Start()
 	_dtls_transport->SetLocalCertificate(application->GetCertificate());
 	_dtls_transport->StartDTLS();
 
+	_metrics_handle = MonitorInstance->GetStreamMetricsHandle(GetStream(), PublisherType::Webrtc);
+
 	// RFC3264
 	// For each "m=" line in the offer, there MUST be a corresponding "m=" line in the answer.
 	for(size_t i = 0; i < peer_media_desc_list.size(); i++)
@@ -192,6 +197,11 @@ bool RtcSession::Start()
 	RegisterNextNode(nullptr);
 	ov::Node::Start();
 
+	if (application->GetConfig().GetPublishers().GetWebrtcPublisher().IsPacerEnabled())
+	{
+		_pacer = std::make_shared<RtpPacer>();
+	}
+
 	_abr_test_watch.Start();
 	_bitrate_estimate_watch.Start();
 
@@ -385,6 +395,71 @@ void RtcSession::OnMessageReceived(const std::any &message)
 
 	// RTP_RTCP -> SRTP -> DTLS -> Edge Node(RtcSession)
 	SendDataToPrevNode(data);
+
+	// The packets are dropped until the SRTP keys are ready, so the GOP cache is sent after that
+	if ((_gop_cache_requested == false) && _dtls_transport->IsConnected())
+	{
+		_gop_cache_requested = true;
+		GetStream()->SendGopCache(info::Session::GetSharedPtrAs<RtcSession>());
+	}
+}
+
+void RtcSession::OnGopCacheSending(const std::vector<std::any> &packets)
+{
+	std::shared_lock<std::shared_mutex> change_lock(_change_rendition_lock);
+	auto current_rendition = _current_rendition;
+	change_lock.unlock();
+
+	auto video_track = (current_rendition != nullptr) ? current_rendition->GetVideoTrack() : nullptr;
+
+	std::vector<uint32_t> frame_timestamps;
+
+	if (video_track != nullptr)
+	{
+		for (const auto &packet : packets)
+		{
+			auto rtp_packet = std::any_cast<std::shared_ptr<RtpPacket>>(&packet);
+			if ((rtp_packet == nullptr) || (*rtp_packet == nullptr) ||
+				((*rtp_packet)->IsVideoPacket() == false) || ((*rtp_packet)->GetTrackId() != video_track->GetId()))
+			{
+				continue;
+			}
+
+			auto timestamp = (*rtp_packet)->Timestamp();
+			if (frame_timestamps.empty() || (frame_timestamps.back() != timestamp))
+			{
+				frame_timestamps.push_back(timestamp);
+			}
+		}
+	}
+
+	std::lock_guard<std::mutex> send_lock(_send_lock);
+
+	_sending_gop_cache = true;
+
+	if (frame_timestamps.size() < 2)
+	{
+		return;
+	}
+
+	// The last frame keeps its timestamp, so the live frames follow it
+	uint32_t timestamp = frame_timestamps.back();
+	for (auto frame = frame_timestamps.rbegin(); frame != frame_timestamps.rend(); ++frame)
+	{
+		_gop_cache_timestamps[*frame] = timestamp;
+		timestamp -= RTC_GOP_CACHE_FRAME_INTERVAL;
+	}
+
+	_rebasing_gop_cache = true;
+
+	logtd("[WebRTC Publisher] GOP cache of %zu frames is sent to session %u", frame_timestamps.size(), GetId());
+}
+
+void RtcSession::OnGopCacheSent()
+{
+	std::lock_guard<std::mutex> send_lock(_send_lock);
+
+	_sending_gop_cache = false;
 }
 
 void RtcSession::ChangeRendition()
@@ -526,56 +601,174 @@ void RtcSession::SendOutgoingData(const std::any &packet)
 		return;
 	}
 
-	// RTP Session must be copied and sent because data is altered due to SRTP.
-	auto copy_packet = std::make_shared<RtpPacket>(*session_packet);
+	if (_sending_gop_cache && (session_packet->IsVideoPacket() == false))
+	{
+		return;
+	}
+
+	if (_pacer == nullptr)
+	{
+		SendSessionPacket(session_packet);
+		return;
+	}
+
+	std::lock_guard<std::mutex> send_lock(_send_lock);
 
-	if (copy_packet->IsVideoPacket())
+	if (session_packet->IsVideoPacket())
 	{
-		copy_packet->SetSequenceNumber(_video_rtp_sequence_number++);
+		// Video frames (especially keyframes) are bursts of packets, so they are spread over time by the pacer
+		_pacer->Enqueue(session_packet, ov::Clock::NowMSec());
 	}
 	else
 	{
-		copy_packet->SetSequenceNumber(_audio_rtp_sequence_number++);
+		// Audio packets are small and sensitive to delay, so they are sent immediately but consume the budget
+		SendSessionPacket(session_packet);
+	}
+
+	SendPacedPackets();
+}
+
+void RtcSession::SendSessionPacket(const std::shared_ptr<RtpPacket> &session_packet)
+{
+	// The packet is shared by all sessions, and SRTP encrypts the data in place.
+	// So only the packet data is copied (once) into a buffer that has room for the SRTP auth tag,
+	// and the fields that differ per session are rewritten in that buffer.
+	auto data = session_packet->CloneData(SRTP_MAX_TRAILER_LEN);
+	if (data == nullptr)
+	{
+		return;
+	}
+
+	auto buffer = data->GetWritableDataAs<uint8_t>();
+	auto sequence_number = session_packet->IsVideoPacket() ? _video_rtp_sequence_number++ : _audio_rtp_sequence_number++;
+
+	ByteWriter<uint16_t>::WriteBigEndian(&buffer[2], sequence_number);
+
+	if (_rebasing_gop_cache && session_packet->IsVideoPacket())
+	{
+		auto timestamp = _gop_cache_timestamps.find(session_packet->Timestamp());
+		if (timestamp != _gop_cache_timestamps.end())
+		{
+			ByteWriter<uint32_t>::WriteBigEndian(&buffer[4], timestamp->second);
+		}
+		else
+		{
+			// The live packets keep their timestamps
+			_rebasing_gop_cache = false;
+		}
 	}
 
 	// Set transport-wide sequence number
-	SetTransportWideSequenceNumber(copy_packet, _wide_sequence_number);
-	SetAbsSendTime(copy_packet, ov::Clock::NowMSec());
+	SetTransportWideSequenceNumber(session_packet, buffer, _wide_sequence_number);
+	SetAbsSendTime(session_packet, buffer, ov::Clock::NowMSec());
 
 	// rtp_rtcp -> srtp -> dtls -> Edge Node(RtcSession)
 
 	// Packet loss simulation codes
 	// if (ov::Random::GenerateUInt32(1, 33) != 10)
 	{
-		_rtp_rtcp->SendRtpPacket(copy_packet);
+		_rtp_rtcp->SendRtpPacket(session_packet, data);
 	}
 
-	RecordRtpSent(copy_packet, session_packet->SequenceNumber(), _wide_sequence_number);
+	RecordRtpSent(session_packet, sequence_number, _wide_sequence_number, data->GetLength());
 
 	_wide_sequence_number ++;
 
-	MonitorInstance->IncreaseBytesOut(*GetStream(), PublisherType::Webrtc, copy_packet->GetDataLength());
+	if (_metrics_handle != nullptr)
+	{
+		_metrics_handle->IncreaseBytesOut(data->GetLength());
+	}
+	else
+	{
+		MonitorInstance->IncreaseBytesOut(*GetStream(), PublisherType::Webrtc, data->GetLength());
+	}
+
+	if ((_pacer != nullptr) && (session_packet->IsVideoPacket() == false))
+	{
+		_pacer->OnPacketSent(data->GetLength(), ov::Clock::NowMSec());
+	}
+}
+
+void RtcSession::SendPacedPackets()
+{
+	auto now_ms = ov::Clock::NowMSec();
+
+	while (true)
+	{
+		auto packet = _pacer->Dequeue(now_ms);
+		if (packet == nullptr)
+		{
+			break;
+		}
+
+		SendSessionPacket(packet);
+	}
+
+	if ((_pacer->IsEmpty() == false) && (_pacing_requested == false))
+	{
+		_pacing_requested = true;
+		_publisher->RequestPacing(info::Session::GetSharedPtrAs<RtcSession>());
+	}
+}
+
+void RtcSession::ProcessPacer()
+{
+	std::shared_lock<std::shared_mutex> lock(_start_stop_lock);
+
+	if ((pub::Session::GetState() != SessionState::Started) || (_pacer == nullptr))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> send_lock(_send_lock);
+
+	_pacing_requested = false;
+	SendPacedPackets();
+}
+
+bool RtcSession::IsPacerEnabled() const
+{
+	return _pacer != nullptr;
+}
+
+RtpPacer::Stats RtcSession::GetPacerStats()
+{
+	if (_pacer == nullptr)
+	{
+		return RtpPacer::Stats();
+	}
+
+	std::lock_guard<std::mutex> send_lock(_send_lock);
+
+	return _pacer->GetStats(ov::Clock::NowMSec());
+}
+
+DelayBasedBwe::Stats RtcSession::GetBweStats()
+{
+	std::lock_guard<std::mutex> lock(_bwe_lock);
+
+	return _bwe.GetStats();
 }
 
-bool RtcSession::SetTransportWideSequenceNumber(const std::shared_ptr<RtpPacket> &rtp_packet, uint16_t wide_sequence_number)
+bool RtcSession::SetTransportWideSequenceNumber(const std::shared_ptr<const RtpPacket> &rtp_packet, uint8_t *buffer, uint16_t wide_sequence_number)
 {
-	auto extension_buffer = rtp_packet->Extension(RTP_HEADER_EXTENSION_TRANSPORT_CC_ID);
-	if (extension_buffer == nullptr)
+	auto extension_offset = rtp_packet->ExtensionOffset(RTP_HEADER_EXTENSION_TRANSPORT_CC_ID);
+	if (extension_offset < 0)
 	{
 		return false;
 	}
 
 	auto payload_offset = rtp_packet->GetExtensionType() == RtpHeaderExtension::HeaderType::ONE_BYTE_HEADER ? 1 : 2;
 	
-	ByteWriter<uint16_t>::WriteBigEndian(extension_buffer + payload_offset, wide_sequence_number);
+	ByteWriter<uint16_t>::WriteBigEndian(buffer + extension_offset + payload_offset, wide_sequence_number);
 
 	return true;
 }
 
-bool RtcSession::SetAbsSendTime(const std::shared_ptr<RtpPacket> &rtp_packet, uint64_t time_ms)
+bool RtcSession::SetAbsSendTime(const std::shared_ptr<const RtpPacket> &rtp_packet, uint8_t *buffer, uint64_t time_ms)
 {
-	auto extension_buffer = rtp_packet->Extension(RTP_HEADER_EXTENSION_ABS_SEND_TIME_ID);
-	if (extension_buffer == nullptr)
+	auto extension_offset = rtp_packet->ExtensionOffset(RTP_HEADER_EXTENSION_ABS_SEND_TIME_ID);
+	if (extension_offset < 0)
 	{
 		return false;
 	}
@@ -583,29 +776,29 @@ bool RtcSession::SetAbsSendTime(const std::shared_ptr<RtpPacket> &rtp_packet, ui
 	auto payload_offset = rtp_packet->GetExtensionType() == RtpHeaderExtension::HeaderType::ONE_BYTE_HEADER ? 1 : 2;
 
 	auto abs_send_time = RtpHeaderExtensionAbsSendTime::MsToAbsSendTime(time_ms);
-	ByteWriter<uint24_t>::WriteBigEndian(extension_buffer + payload_offset, abs_send_time);
+	ByteWriter<uint24_t>::WriteBigEndian(buffer + extension_offset + payload_offset, abs_send_time);
 
 	return true;
 }
 
-bool RtcSession::RecordRtpSent(const std::shared_ptr<const RtpPacket> &rtp_packet, uint16_t origin_sequence_number, uint16_t wide_sequence_number)
+bool RtcSession::RecordRtpSent(const std::shared_ptr<const RtpPacket> &origin_packet, uint16_t sequence_number, uint16_t wide_sequence_number, size_t sent_bytes)
 {
-	if (rtp_packet == nullptr)
+	if (origin_packet == nullptr)
 	{
 		return false;
 	}
 
 	auto sent_log = std::make_shared<RtpSentLog>();
-	sent_log->_sequence_number = rtp_packet->SequenceNumber();
+	sent_log->_sequence_number = sequence_number;
 	sent_log->_wide_sequence_number = wide_sequence_number;
-	sent_log->_track_id = rtp_packet->GetTrackId();
-	sent_log->_payload_type = rtp_packet->PayloadType();
-	sent_log->_origin_sequence_number = origin_sequence_number;
-	sent_log->_timestamp = rtp_packet->Timestamp();
-	sent_log->_marker = rtp_packet->Marker();
-	sent_log->_ssrc = rtp_packet->Ssrc();
-
-	sent_log->_sent_bytes = rtp_packet->GetDataLength();
+	sent_log->_track_id = origin_packet->GetTrackId();
+	sent_log->_payload_type = origin_packet->PayloadType();
+	sent_log->_origin_sequence_number = origin_packet->SequenceNumber();
+	sent_log->_timestamp = origin_packet->Timestamp();
+	sent_log->_marker = origin_packet->Marker();
+	sent_log->_ssrc = origin_packet->Ssrc();
+
+	sent_log->_sent_bytes = sent_bytes;
 	sent_log->_sent_time = std::chrono::system_clock::now();
 
 	auto video_rtp_key = sent_log->_sequence_number % MAX_RTP_RECORDS;
@@ -613,7 +806,7 @@ bool RtcSession::RecordRtpSent(const std::shared_ptr<const RtpPacket> &rtp_packe
 
 	std::lock_guard<std::shared_mutex> lock(_rtp_record_map_lock);
 
-	if (rtp_packet->IsVideoPacket())
+	if (origin_packet->IsVideoPacket())
 	{
 		_video_rtp_sent_record_map[video_rtp_key] = sent_log;
 	}
@@ -741,9 +934,26 @@ bool RtcSession::ProcessNACK(const std::shared_ptr<RtcpInfo> &rtcp_info)
 		auto rtx_packet = stream->GetRtxRtpPacket(sent_log->_track_id, sent_log->_payload_type, sent_log->_origin_sequence_number);
 		if(rtx_packet != nullptr)
 		{
-			auto copy_rtx_packet = std::make_shared<RtxRtpPacket>(*rtx_packet);
+			auto copy_rtx_packet = ov::MakePooledShared<RtxRtpPacket>(*rtx_packet);
 			copy_rtx_packet->SetSequenceNumber(_rtx_sequence_number++);
 			copy_rtx_packet->SetOriginalSequenceNumber(sent_log->_sequence_number);
+
+			{
+				// The frames of the GOP cache are retransmitted with the timestamps they were sent with
+				std::lock_guard<std::mutex> send_lock(_send_lock);
+				auto timestamp = _gop_cache_timestamps.find(copy_rtx_packet->Timestamp());
+				if (timestamp != _gop_cache_timestamps.end())
+				{
+					copy_rtx_packet->SetTimestamp(timestamp->second);
+				}
+			}
+
+			if (_pacer != nullptr)
+			{
+				std::lock_guard<std::mutex> send_lock(_send_lock);
+				_pacer->OnPacketSent(copy_rtx_packet->GetDataLength(), ov::Clock::NowMSec());
+			}
+
 			return _rtp_rtcp->SendRtpPacket(copy_rtx_packet);
 		}
 	}
@@ -761,76 +971,72 @@ bool RtcSession::ProcessTransportCc(const std::shared_ptr<RtcpInfo> &rtcp_info)
 		return false;
 	}
 
-	uint64_t sent_bytes = 0;
-	int64_t sent_duration = 0;
-
-	// For debug
-	// logtd("TransportCC - SenderSsrc(%u) MediaSsrc(%u) PacketStatusCount(%u)", transport_cc->GetSenderSsrc(), transport_cc->GetMediaSsrc(), transport_cc->GetPacketStatusCount());
-
-	// for (size_t i = 0; i < transport_cc->GetPacketStatusCount(); i++)
-	// {
-	// 	auto packet_status = transport_cc->GetPacketFeedbackInfo(i);
-	// 	auto sent_log = TraceRtpSentByWideSeqNo(packet_status->_wide_sequence_number);
-	// 	if (sent_log == nullptr)
-	// 	{
-	// 		logte("TransportCC - No sent log found for seqno(%u)", packet_status->_wide_sequence_number);
-	// 		continue;
-	// 	}
-
-	// 	logtd("%s", sent_log->ToString().CStr());
-	// }
+	std::vector<DelayBasedBwe::PacketResult> results;
+	results.reserve(transport_cc->GetPacketStatusCount());
 
-	// return true;
+	// The reference time is in multiples of 64 ms, and each receive delta is in 250 us units
+	// relative to the previous received packet (the first one is relative to the reference time)
+	int64_t arrival_time_us = static_cast<int64_t>(transport_cc->GetReferenceTime()) * 64000;
 
-	for (size_t i = 1; i < transport_cc->GetPacketStatusCount(); i++)
+	for (size_t i = 0; i < transport_cc->GetPacketStatusCount(); i++)
 	{
 		auto packet_status = transport_cc->GetPacketFeedbackInfo(i);
-		auto sent_log = TraceRtpSentByWideSeqNo(packet_status->_wide_sequence_number);
-		if (sent_log == nullptr)
+
+		// Accumulated even if the sent log is not found, otherwise the arrival times of the following packets are shifted
+		if (packet_status->_received)
 		{
-			logte("TransportCC - No sent log found for seqno(%u)", packet_status->_wide_sequence_number);
-			continue;
+			arrival_time_us += static_cast<int64_t>(packet_status->_received_delta) * 250;
 		}
-		auto prev_sent_log = TraceRtpSentByWideSeqNo(packet_status->_wide_sequence_number - 1);
-		if (prev_sent_log == nullptr)
+
+		auto sent_log = TraceRtpSentByWideSeqNo(packet_status->_wide_sequence_number);
+		if (sent_log == nullptr || sent_log->_wide_sequence_number != packet_status->_wide_sequence_number)
 		{
-			logtd("TransportCC - No prev sent log found for seqno(%u)", packet_status->_wide_sequence_number - 1);
+			logtd("TransportCC - No sent log found for seqno(%u)", packet_status->_wide_sequence_number);
 			continue;
 		}
 
-		// Calc delta of sent_log and prev_sent_log
-		int32_t sent_delta_time = (std::chrono::duration_cast<std::chrono::microseconds>(sent_log->_sent_time - prev_sent_log->_sent_time).count()) / 250; 
+		DelayBasedBwe::PacketResult result;
+		result.send_time_us = std::chrono::duration_cast<std::chrono::microseconds>(sent_log->_sent_time.time_since_epoch()).count();
+		result.size = sent_log->_sent_bytes;
 
-		auto duration = packet_status->_received_delta - sent_delta_time;
-		if (duration <= 0)
+		if (packet_status->_received)
 		{
-			//duration = 1;
+			result.arrival_time_us = arrival_time_us;
 		}
 
-		sent_bytes += sent_log->_sent_bytes;
-		sent_duration += duration;
+		results.push_back(result);
+	}
 
-		logtd("WideSeqNo(%u) Refer(%u) RecvDelta(%u) SentDelta(%u) SentBytes(%u) Duration(%d)", packet_status->_wide_sequence_number, transport_cc->GetReferenceTime(), packet_status->_received_delta, sent_delta_time, sent_log->_sent_bytes, duration);
+	if (results.empty())
+	{
+		return false;
 	}
 
-	if (sent_bytes > 0)
+	DelayBasedBwe::Stats bwe_stats;
 	{
-		double sent_seconds = static_cast<double>(sent_duration) / 4000.0;
+		std::lock_guard<std::mutex> lock(_bwe_lock);
+		_bwe.OnTransportFeedback(results, ov::Clock::NowMSec());
+		bwe_stats = _bwe.GetStats();
+	}
 
-		_total_sent_seconds += sent_seconds;
-		_total_sent_bytes += sent_bytes;
-		_estimated_bitrates = static_cast<double>((_total_sent_bytes * 8)) / _total_sent_seconds;
+	if (_pacer != nullptr)
+	{
+		std::lock_guard<std::mutex> send_lock(_send_lock);
+		_pacer->SetTargetBitrate(bwe_stats.target_bitrate);
+	}
 
-		if (_bitrate_estimate_watch.IsElapsed(1000) == true)
-		{
-			_bitrate_estimate_watch.Update();
-			ChangeRenditionIfNeeded();
+	if (_bitrate_estimate_watch.IsElapsed(1000) == true)
+	{
+		_bitrate_estimate_watch.Update();
 
-			logtd("Estimated Bandwidth(%f) TotalSentBytes(%u) TotalSentSeconds(%f)", static_cast<double>(_total_sent_bytes * 8) / _total_sent_seconds, _total_sent_bytes, _total_sent_seconds);
+		_previous_estimated_bitrate = _estimated_bitrates;
+		_estimated_bitrates = bwe_stats.target_bitrate;
 
-			_total_sent_seconds = 0;
-			_total_sent_bytes = 0;
-		}
+		logtd("Estimated Bandwidth(%llu) DelayBased(%llu) Acknowledged(%llu) Loss(%.2f) Usage(%s) State(%s)",
+			  bwe_stats.target_bitrate, bwe_stats.delay_based_bitrate, bwe_stats.acknowledged_bitrate, bwe_stats.loss_ratio,
+			  DelayBasedBwe::StringFromBandwidthUsage(bwe_stats.usage), DelayBasedBwe::StringFromRateControlState(bwe_stats.state));
+
+		ChangeRenditionIfNeeded();
 	}
 
 	return true;
@@ -845,6 +1051,12 @@ bool RtcSession::ProcessRemb(const std::shared_ptr<RtcpInfo> &rtcp_info)
 	_previous_estimated_bitrate = _estimated_bitrates;
 	_estimated_bitrates = remb->GetBitrateBps();
 
+	if (_pacer != nullptr)
+	{
+		std::lock_guard<std::mutex> send_lock(_send_lock);
+		_pacer->SetTargetBitrate(remb->GetBitrateBps());
+	}
+
 	if (_bitrate_estimate_watch.IsElapsed(1000) == true)
 	{
 		_bitrate_estimate_watch.Update();
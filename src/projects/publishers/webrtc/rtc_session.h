@@ -17,6 +17,8 @@
 #include "modules/ice/ice_port.h"
 #include "modules/rtp_rtcp/rtp_rtcp.h"
 #include "modules/rtp_rtcp/rtp_packetizer_interface.h"
+#include "modules/rtp_rtcp/rtp_pacer.h"
+#include "modules/rtp_rtcp/delay_based_bwe.h"
 #include "modules/dtls_srtp/dtls_transport.h"
 
 #include "rtc_playlist.h"
@@ -83,6 +85,8 @@ public:
 	// pub::Session Interface
 	void SendOutgoingData(const std::any &packet) override;
 	void OnMessageReceived(const std::any &message) override;
+	void OnGopCacheSending(const std::vector<std::any> &packets) override;
+	void OnGopCacheSent() override;
 	
 	// RtpRtcp Interface
 	void OnRtpFrameReceived(const std::vector<std::shared_ptr<RtpPacket>> &rtp_packets) override;
@@ -97,7 +101,19 @@ public:
 		return _ice_session_id;
 	}
 
+	// Sends the queued packets that the pacer allows now (called by WebRtcPublisher's pacing timer)
+	void ProcessPacer();
+
+	bool IsPacerEnabled() const;
+	RtpPacer::Stats GetPacerStats();
+	DelayBasedBwe::Stats GetBweStats();
+
 private:
+	// Rewrites the per-session fields of session_packet and sends it
+	void SendSessionPacket(const std::shared_ptr<RtpPacket> &session_packet);
+	// Must be called with _send_lock held
+	void SendPacedPackets();
+
 	bool ProcessReceiverReport(const std::shared_ptr<RtcpInfo> &rtcp_info);
 	bool ProcessNACK(const std::shared_ptr<RtcpInfo> &rtcp_info);
 	bool ProcessTransportCc(const std::shared_ptr<RtcpInfo> &rtcp_info);
@@ -174,7 +190,7 @@ private:
 		}
 	};
 
-	bool RecordRtpSent(const std::shared_ptr<const RtpPacket> &rtp_packet, uint16_t origin_sequence_number, uint16_t wide_sequence_number);
+	bool RecordRtpSent(const std::shared_ptr<const RtpPacket> &origin_packet, uint16_t sequence_number, uint16_t wide_sequence_number, size_t sent_bytes);
 
 	std::shared_mutex _rtp_record_map_lock;
 	// For NACK
@@ -187,12 +203,33 @@ private:
 	std::shared_ptr<RtpSentLog> TraceRtpSentByVideoSeqNo(uint16_t sequence_number);
 	std::shared_ptr<RtpSentLog> TraceRtpSentByWideSeqNo(uint16_t wide_sequence_number);
 
-	bool SetTransportWideSequenceNumber(const std::shared_ptr<RtpPacket> &rtp_packet, uint16_t wide_sequence_number);
-	bool SetAbsSendTime(const std::shared_ptr<RtpPacket> &rtp_packet, uint64_t time_ms);
+	// Rewrite the extensions of rtp_packet in buffer (the copy of the rtp_packet data)
+	bool SetTransportWideSequenceNumber(const std::shared_ptr<const RtpPacket> &rtp_packet, uint8_t *buffer, uint16_t wide_sequence_number);
+	bool SetAbsSendTime(const std::shared_ptr<const RtpPacket> &rtp_packet, uint8_t *buffer, uint64_t time_ms);
+
+	// Pacing (nullptr if the pacer is disabled)
+	std::shared_ptr<RtpPacer> _pacer;
+	std::mutex _send_lock;
+	// true while this session is waiting for the pacing timer of WebRtcPublisher
+	bool _pacing_requested = false;
+
+	// The GOP cache of the stream is requested once DTLS is connected
+	bool _gop_cache_requested = false;
+	// true while the packets of the GOP cache are sent (audio is not sent, it would be behind live)
+	bool _sending_gop_cache = false;
+	// The browser plays the frames at their RTP timestamps, so the cached frames are sent with the timestamps
+	// packed just before the last of them. They are decoded at once and the live frames follow without the delay of the GOP.
+	// Original RTP timestamp => Sent RTP timestamp, kept for the retransmission
+	std::unordered_map<uint32_t, uint32_t> _gop_cache_timestamps;
+	// false once a live video packet is sent
+	bool _rebasing_gop_cache = false;
+
+	// Resolved once in Start(), because bytes out is counted for every RTP packet
+	std::shared_ptr<mon::StreamMetricsHandle> _metrics_handle;
 
 	// For Estimated bitrate
-	double _total_sent_seconds = 0;
-	uint64_t _total_sent_bytes = 0;
+	DelayBasedBwe _bwe;
+	std::mutex _bwe_lock;
 	double _estimated_bitrates = 0;
 	ov::StopWatch _bitrate_estimate_watch;
 
@@ -129,6 +129,8 @@ bool RtcStream::Start()
 		return false;
 	}
 
+	EnableGopCache();
+
 	auto webrtc_config = GetApplicationInfo().GetConfig().GetPublishers().GetWebrtcPublisher();
 
 	_rtx_enabled = webrtc_config.IsRtxEnabled();
@@ -674,7 +676,17 @@ std::shared_ptr<PayloadAttr> RtcStream::MakeRtxPayloadAttr(const std::shared_ptr
 bool RtcStream::OnRtpPacketized(std::shared_ptr<RtpPacket> packet)
 {
 	auto stream_packet = std::make_any<std::shared_ptr<RtpPacket>>(packet);
-	BroadcastPacket(stream_packet);
+
+	auto packet_type = pub::GopCache::PacketType::Independent;
+	if (packet->IsVideoPacket())
+	{
+		packet_type = (packet->IsKeyframe() && packet->IsFirstPacketOfFrame()) ? pub::GopCache::PacketType::KeyFrame : pub::GopCache::PacketType::Dependent;
+	}
+
+	// The RED/FEC packets of a track are decoded separately from the media packets of it
+	auto gop_key = (static_cast<uint64_t>(packet->GetTrackId()) << 8) | packet->PayloadType();
+
+	BroadcastPacket(stream_packet, gop_key, packet_type, packet->GetDataLength());
 
 	if (_rtx_enabled == true)
 	{
@@ -109,6 +109,9 @@ bool WebRtcPublisher::Start()
 	if (StartSignallingServer(server_config, webrtc_bind_config) &&
 		StartICEPorts(server_config, webrtc_bind_config))
 	{
+		_pacing_timer.Push(std::bind(&WebRtcPublisher::ProcessPacing, this, std::placeholders::_1), PACING_INTERVAL_MS);
+		_pacing_timer.Start();
+
 		return Publisher::Start();
 	}
 
@@ -126,6 +129,8 @@ bool WebRtcPublisher::Start()
 
 bool WebRtcPublisher::Stop()
 {
+	_pacing_timer.Stop();
+
 	IcePortManager::GetInstance()->Release(IcePortObserver::GetSharedPtr());
 
 	if (_signalling_server != nullptr)
@@ -137,6 +142,35 @@ bool WebRtcPublisher::Stop()
 	return Publisher::Stop();
 }
 
+void WebRtcPublisher::RequestPacing(const std::shared_ptr<RtcSession> &session)
+{
+	std::lock_guard<std::mutex> lock(_pacing_session_list_lock);
+
+	_pacing_session_list.push_back(session);
+}
+
+ov::DelayQueueAction WebRtcPublisher::ProcessPacing(void *parameter)
+{
+	std::vector<std::weak_ptr<RtcSession>> session_list;
+
+	{
+		std::lock_guard<std::mutex> lock(_pacing_session_list_lock);
+		session_list.swap(_pacing_session_list);
+	}
+
+	for (auto &item : session_list)
+	{
+		auto session = item.lock();
+		if (session != nullptr)
+		{
+			// If the pacer still has packets, the session requests pacing again
+			session->ProcessPacer();
+		}
+	}
+
+	return ov::DelayQueueAction::Repeat;
+}
+
 bool WebRtcPublisher::DisconnectSessionInternal(const std::shared_ptr<RtcSession> &session)
 {
 	auto stream = std::dynamic_pointer_cast<RtcStream>(session->GetStream());
@@ -29,6 +29,9 @@ public:
 
 	bool Stop() override;
 
+	// Called by RtcSession when its pacer has packets that cannot be sent yet
+	void RequestPacing(const std::shared_ptr<RtcSession> &session);
+
 	// IcePortObserver Implementation
 	void OnStateChanged(IcePort &port, uint32_t session_id, IceConnectionState state, std::any user_data) override;
 	void OnDataReceived(IcePort &port, uint32_t session_id, std::shared_ptr<const ov::Data> data, std::any user_data) override;
@@ -79,6 +82,7 @@ private:
 
 	bool Start() override;
 	bool DisconnectSessionInternal(const std::shared_ptr<RtcSession> &session);
+	ov::DelayQueueAction ProcessPacing(void *parameter);
 
 	//--------------------------------------------------------------------
 	// Implementation of Publisher
@@ -105,6 +109,11 @@ private:
 	std::shared_ptr<IcePort> _ice_port;
 	std::shared_ptr<RtcSignallingServer> _signalling_server;
 
+	// Sessions waiting for the pacer to send the queued packets
+	std::mutex _pacing_session_list_lock;
+	std::vector<std::weak_ptr<RtcSession>> _pacing_session_list;
+	ov::DelayQueue _pacing_timer{"WebRTCPacer"};
+
 	// for special purpose log - Deprecated
 	// ov::DelayQueue _timer;
 };
@@ -82,6 +82,11 @@ bool FilterRescaler::InitializeSourceFilter()
 
 bool FilterRescaler::InitializeSinkFilter()
 {
+	if (IsLadder())
+	{
+		return InitializeLadderSinkFilters();
+	}
+
 	int ret = ::avfilter_graph_create_filter(&_buffersink_ctx, _buffersink, "out", nullptr, nullptr, _filter_graph);
 	if (ret < 0)
 	{
@@ -97,8 +102,164 @@ bool FilterRescaler::InitializeSinkFilter()
 	return true;
 }
 
+bool FilterRescaler::InitializeLadderSinkFilters()
+{
+	_ladder_buffersink_ctxs.clear();
+
+	AVFilterInOut *prev_inout = nullptr;
+
+	for (size_t index = 0; index < _ladder_output_tracks.size(); index++)
+	{
+		auto name = ov::String::FormatString("out%zu", index);
+
+		AVFilterContext *buffersink_ctx = nullptr;
+		int ret = ::avfilter_graph_create_filter(&buffersink_ctx, _buffersink, name, nullptr, nullptr, _filter_graph);
+		if (ret < 0)
+		{
+			logte("Could not create video buffer sink filter for rescaling ladder: %s, %d", name.CStr(), ret);
+			return false;
+		}
+
+		_ladder_buffersink_ctxs.push_back(buffersink_ctx);
+
+		// The first sink uses the pre-allocated _inputs
+		AVFilterInOut *inout = (index == 0) ? _inputs : ::avfilter_inout_alloc();
+		if (inout == nullptr)
+		{
+			logte("Could not allocate filter inout for rescaling ladder");
+			return false;
+		}
+
+		inout->name = ::av_strdup(name);
+		inout->filter_ctx = buffersink_ctx;
+		inout->pad_idx = 0;
+		inout->next = nullptr;
+
+		if (prev_inout != nullptr)
+		{
+			prev_inout->next = inout;
+		}
+		prev_inout = inout;
+	}
+
+	_buffersink_ctx = _ladder_buffersink_ctxs[0];
+
+	return true;
+}
+
+bool FilterRescaler::InitializeLadderFilterDescription()
+{
+	auto output_count = _ladder_output_tracks.size();
+
+	// Larger outputs come first, so that a smaller output can be scaled from the output of a larger one
+	std::vector<size_t> order(output_count);
+	for (size_t index = 0; index < output_count; index++)
+	{
+		order[index] = index;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+		auto &track_a = _ladder_output_tracks[a];
+		auto &track_b = _ladder_output_tracks[b];
+		return ((int64_t)track_a->GetWidth() * track_a->GetHeight()) > ((int64_t)track_b->GetWidth() * track_b->GetHeight());
+	});
+
+	// Cascade: An output is scaled from the smallest larger output that is at least twice its size in both dimensions
+	// (e.g. 1080p -> 720p -> 360p, 1080p -> 480p -> 240p). Otherwise, it is scaled from the source.
+	// Bilinear downscaling by 2x or more does not lose the details in a meaningful way, and the smaller input reduces the scaling cost.
+	std::vector<int64_t> parents(output_count, -1);
+	std::vector<std::vector<size_t>> children(output_count);
+	std::vector<size_t> source_children;
+
+	for (size_t position = 0; position < output_count; position++)
+	{
+		auto index = order[position];
+		auto &track = _ladder_output_tracks[index];
+
+		for (size_t candidate_position = 0; candidate_position < position; candidate_position++)
+		{
+			auto candidate_index = order[candidate_position];
+			auto &candidate = _ladder_output_tracks[candidate_index];
+
+			if ((candidate->GetWidth() >= track->GetWidth() * 2) && (candidate->GetHeight() >= track->GetHeight() * 2))
+			{
+				// Keep the last one, which is the smallest
+				parents[index] = candidate_index;
+			}
+		}
+
+		if (parents[index] < 0)
+		{
+			source_children.push_back(index);
+		}
+		else
+		{
+			children[parents[index]].push_back(index);
+		}
+	}
+
+	std::vector<ov::String> chains;
+
+	// Source: [in] -> settb -> split
+	auto source_desc = ov::String::FormatString("[in]settb=%s", _output_track->GetTimeBase().GetStringExpr().CStr());
+	if (source_children.size() > 1)
+	{
+		source_desc.AppendFormat(",split=%zu", source_children.size());
+	}
+	for (auto &index : source_children)
+	{
+		source_desc.AppendFormat("[src%zu]", index);
+	}
+	chains.push_back(source_desc);
+
+	// Outputs: [src|br] -> scale -> (split) -> format -> [out]
+	for (auto &index : order)
+	{
+		auto &track = _ladder_output_tracks[index];
+
+		ov::String desc;
+		if (parents[index] < 0)
+		{
+			desc.AppendFormat("[src%zu]", index);
+		}
+		else
+		{
+			desc.AppendFormat("[br%zu_%zu]", index, static_cast<size_t>(parents[index]));
+		}
+
+		desc.AppendFormat("scale=%dx%d:flags=bilinear", track->GetWidth(), track->GetHeight());
+
+		if (children[index].size() > 0)
+		{
+			desc.AppendFormat(",split=%zu[own%zu]", children[index].size() + 1, index);
+			for (auto &child_index : children[index])
+			{
+				desc.AppendFormat("[br%zu_%zu]", child_index, index);
+			}
+			desc.AppendFormat(";[own%zu]", index);
+		}
+		else
+		{
+			desc.Append(",");
+		}
+
+		desc.AppendFormat("format=%s[out%zu]", ::av_get_pix_fmt_name((AVPixelFormat)track->GetColorspace()), index);
+
+		chains.push_back(desc);
+	}
+
+	_filter_desc = ov::String::Join(chains, ";");
+
+	return true;
+}
+
 bool FilterRescaler::InitializeFilterDescription()
 {
+	if (IsLadder())
+	{
+		return InitializeLadderFilterDescription();
+	}
+
 	std::vector<ov::String> filters;
 
 	if (IsSingleTrack())
@@ -342,6 +503,17 @@ bool FilterRescaler::Configure(const std::shared_ptr<MediaTrack> &input_track, c
 		  _fps_filter.GetOutputFrameRate(), 
 		  _fps_filter.GetSkipFrames());
 
+	if (IsLadder())
+	{
+		std::vector<ov::String> outputs;
+		for (auto &track : _ladder_output_tracks)
+		{
+			outputs.push_back(ov::String::FormatString("#%u(%dx%d)", track->GetId(), track->GetWidth(), track->GetHeight()));
+		}
+
+		logti("Rescaler ladder. track(#%u -> %s)", _input_track->GetId(), ov::String::Join(outputs, ", ").CStr());
+	}
+
 	if ((::avfilter_graph_parse_ptr(_filter_graph, _filter_desc, &_inputs, &_outputs, nullptr)) < 0)
 	{
 		logte("Could not parse filter string for rescaling: %s", _filter_desc.CStr());
@@ -416,6 +588,16 @@ void FilterRescaler::Stop()
 	}
 
 	OV_SAFE_FUNC(_buffersrc_ctx, nullptr, ::avfilter_free, );
+	if (IsLadder())
+	{
+		// _buffersink_ctx is one of the ladder sinks
+		for (auto &buffersink_ctx : _ladder_buffersink_ctxs)
+		{
+			OV_SAFE_FUNC(buffersink_ctx, nullptr, ::avfilter_free, );
+		}
+		_ladder_buffersink_ctxs.clear();
+		_buffersink_ctx = nullptr;
+	}
 	OV_SAFE_FUNC(_buffersink_ctx, nullptr, ::avfilter_free, );
 	OV_SAFE_FUNC(_inputs, nullptr, ::avfilter_inout_free, &);
 	OV_SAFE_FUNC(_outputs, nullptr, ::avfilter_inout_free, &);
@@ -491,11 +673,29 @@ bool FilterRescaler::PushProcess(std::shared_ptr<MediaFrame> media_frame)
 }
 
 bool FilterRescaler::PopProcess(bool is_flush)
+{
+	if (IsLadder() == false)
+	{
+		return PopProcess(_buffersink_ctx, 0, is_flush);
+	}
+
+	for (size_t index = 0; index < _ladder_buffersink_ctxs.size(); index++)
+	{
+		if (PopProcess(_ladder_buffersink_ctxs[index], index, is_flush) == false)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FilterRescaler::PopProcess(AVFilterContext *buffersink_ctx, size_t output_index, bool is_flush)
 {
 	while (!_kill_flag || is_flush)
 	{
 		// Receive from filtergraph
-		int ret = ::av_buffersink_get_frame(_buffersink_ctx, _frame);
+		int ret = ::av_buffersink_get_frame(buffersink_ctx, _frame);
 		if (ret == AVERROR(EAGAIN))
 		{
 			break;
@@ -538,6 +738,12 @@ bool FilterRescaler::PopProcess(bool is_flush)
 			output_frame->SetDuration((int64_t)((double)output_frame->GetDuration() * _input_track->GetTimeBase().GetExpr() / _output_track->GetTimeBase().GetExpr()));
 			output_frame->SetSourceId(_source_id);
 
+			if (IsLadder())
+			{
+				// TranscodeFilter maps the index to the filter id of the output
+				output_frame->SetTrackId(output_index);
+			}
+
 			Complete(std::move(output_frame));
 		}
 	}
@@ -545,6 +751,70 @@ bool FilterRescaler::PopProcess(bool is_flush)
 	return true;
 }
 
+void FilterRescaler::SetLadderOutputTracks(const std::vector<std::shared_ptr<MediaTrack>> &output_tracks)
+{
+	_ladder_output_tracks = output_tracks;
+}
+
+bool FilterRescaler::IsLadder() const
+{
+	return _ladder_output_tracks.size() > 1;
+}
+
+static bool IsScaledInCpuMemory(cmn::MediaCodecModuleId input_module_id, cmn::MediaCodecModuleId output_module_id)
+{
+	switch (input_module_id)
+	{
+		case cmn::MediaCodecModuleId::X264:
+		case cmn::MediaCodecModuleId::QSV:		// CPU memory using 'gpu_copy=on'
+		case cmn::MediaCodecModuleId::NILOGAN:	// CPU memory using 'out=sw'
+		case cmn::MediaCodecModuleId::DEFAULT:	// CPU memory
+			break;
+		default:
+			return false;
+	}
+
+	switch (output_module_id)
+	{
+		case cmn::MediaCodecModuleId::DEFAULT:
+		case cmn::MediaCodecModuleId::BEAMR:
+		case cmn::MediaCodecModuleId::OPENH264:
+		case cmn::MediaCodecModuleId::X264:
+		case cmn::MediaCodecModuleId::QSV:
+		case cmn::MediaCodecModuleId::LIBVPX:
+		case cmn::MediaCodecModuleId::NILOGAN:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool FilterRescaler::IsLadderCompatible(const std::shared_ptr<MediaTrack> &input_track, const std::shared_ptr<MediaTrack> &output_track, const std::shared_ptr<MediaTrack> &other_output_track)
+{
+	if (input_track == nullptr || output_track == nullptr || other_output_track == nullptr)
+	{
+		return false;
+	}
+
+	if (input_track->GetMediaType() != cmn::MediaType::Video ||
+		output_track == input_track || other_output_track == input_track)
+	{
+		return false;
+	}
+
+	if (IsScaledInCpuMemory(input_track->GetCodecModuleId(), output_track->GetCodecModuleId()) == false ||
+		IsScaledInCpuMemory(input_track->GetCodecModuleId(), other_output_track->GetCodecModuleId()) == false)
+	{
+		return false;
+	}
+
+	// The fps filter and skip frames are applied before the graph, so they must be the same for all outputs
+	return (output_track->GetTimeBase() == other_output_track->GetTimeBase()) &&
+		   (output_track->GetFrameRateByConfig() == other_output_track->GetFrameRateByConfig()) &&
+		   (output_track->GetFrameRateByMeasured() == other_output_track->GetFrameRateByMeasured()) &&
+		   (output_track->GetSkipFramesByConfig() == other_output_track->GetSkipFramesByConfig());
+}
+
 #define DO_FILTER_ONCE(frame) \
 		if (!PushProcess(frame)) { break; } \
 		if (!PopProcess()) { break; } 
@@ -27,16 +27,31 @@ public:
 
 	void WorkerThread();
 
+	// ABR ladder: scales one input to several outputs in a single filter graph.
+	// output_tracks[0] must be the output track of this filter. Frames of output_tracks[i] are completed with track id i.
+	void SetLadderOutputTracks(const std::vector<std::shared_ptr<MediaTrack>> &output_tracks);
+	bool IsLadder() const;
+
+	// Returns true if the two output tracks can be scaled from the input track by the same ladder graph.
+	// Only outputs that are scaled in CPU memory, with the same timebase and the same framerate/skip frames settings, can be shared.
+	static bool IsLadderCompatible(const std::shared_ptr<MediaTrack> &input_track, const std::shared_ptr<MediaTrack> &output_track, const std::shared_ptr<MediaTrack> &other_output_track);
+
 private:
 	bool InitializeSourceFilter();
 	bool InitializeFilterDescription();
+	bool InitializeLadderFilterDescription();
 	bool InitializeSinkFilter();	
+	bool InitializeLadderSinkFilters();
 
 	bool PushProcess(std::shared_ptr<MediaFrame> media_frame);
 	bool PopProcess(bool is_flush = false);
+	bool PopProcess(AVFilterContext *buffersink_ctx, size_t output_index, bool is_flush);
 
 	bool SetHWContextToFilterIfNeed();	
 
 	// Constant FrameRate & SkipFrame Filter
 	FilterFps _fps_filter;
+
+	std::vector<std::shared_ptr<MediaTrack>> _ladder_output_tracks;
+	std::vector<AVFilterContext *> _ladder_buffersink_ctxs;
 };
@@ -12,6 +12,7 @@
 #include <base/ovlibrary/ovlibrary.h>
 #include <stdint.h>
 
+#include "base/mediarouter/media_trace.h"
 #include "base/mediarouter/media_type.h"
 extern "C"
 {
@@ -186,6 +187,36 @@ public:
 		return _flags;
 	}
 
+	// nullptr unless the source packet is sampled for latency tracing
+	void SetTrace(const std::shared_ptr<MediaTrace> &trace)
+	{
+		_trace = trace;
+	}
+
+	const std::shared_ptr<MediaTrace> &GetTrace() const
+	{
+		return _trace;
+	}
+
+	// Total size of the refcounted buffers of the frame
+	size_t GetBufferSize() const
+	{
+		size_t size = 0;
+
+		if (_priv_data != nullptr)
+		{
+			for (int i = 0; i < AV_NUM_DATA_POINTERS; i++)
+			{
+				if (_priv_data->buf[i] != nullptr)
+				{
+					size += _priv_data->buf[i]->size;
+				}
+			}
+		}
+
+		return size;
+	}
+
 	void FillZeroData()
 	{
 		if(!_priv_data) {
@@ -223,6 +254,7 @@ public:
 
 		frame->SetMediaType(_media_type);
 		frame->SetSourceId(_source_id);
+		frame->SetTrace(_trace);
 
 		if (_media_type == cmn::MediaType::Video)
 		{
@@ -295,4 +327,6 @@ private:
 	// This shows the ID of the module that made the media frame. It can be a decoder or a filter. 
 	// The encoder uses this value to check if the filter has changed.
 	int32_t _source_id = 0;
+
+	std::shared_ptr<MediaTrace> _trace;
 };
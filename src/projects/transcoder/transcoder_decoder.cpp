@@ -371,6 +371,11 @@ void TranscodeDecoder::Stop()
 
 void TranscodeDecoder::SendBuffer(std::shared_ptr<const MediaPacket> packet)
 {
+	if (MediaTrace::IsEnabled())
+	{
+		_trace_relay.Push(packet->GetTrace());
+	}
+
 	_input_buffer.Enqueue(std::move(packet));
 }
 
@@ -384,6 +389,11 @@ void TranscodeDecoder::Complete(TranscodeResult result, std::shared_ptr<MediaFra
 	// Invoke callback function when encoding/decoding is completed.
 	if (_complete_handler)
 	{
+		if (MediaTrace::IsEnabled() && result != TranscodeResult::NoData)
+		{
+			frame->SetTrace(_trace_relay.Pop(MediaTrace::Hop::Decoder));
+		}
+
 		frame->SetTrackId(_decoder_id);
 		_complete_handler(result, _decoder_id, std::move(frame));
 	}
@@ -57,4 +57,6 @@ protected:
 	std::thread _codec_thread;
 
 	CompleteHandler _complete_handler;
+
+	MediaTraceRelay _trace_relay;
 };
@@ -365,7 +365,12 @@ std::shared_ptr<MediaTrack> &TranscodeEncoder::GetRefTrack()
 void TranscodeEncoder::SendBuffer(std::shared_ptr<const MediaFrame> frame)
 {
 	// logte("%lld, msid:%u", frame->GetPts(), frame->GetMsid());
-		
+
+	if (MediaTrace::IsEnabled() && frame != nullptr)
+	{
+		_trace_relay.Push(frame->GetTrace());
+	}
+
 	if (_input_buffer.IsExceedWaitEnable() == true)
 	{
 		_input_buffer.Enqueue(std::move(frame), false, 1000);
@@ -385,6 +390,11 @@ void TranscodeEncoder::Complete(std::shared_ptr<MediaPacket> packet)
 {
 	if (_complete_handler)
 	{
+		if (MediaTrace::IsEnabled())
+		{
+			packet->SetTrace(_trace_relay.Pop(MediaTrace::Hop::Encoder));
+		}
+
 		_complete_handler(_encoder_id, std::move(packet));
 	}
 }
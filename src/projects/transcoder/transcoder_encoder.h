@@ -70,6 +70,8 @@ protected:
 
 	CompleteHandler _complete_handler;
 
+	MediaTraceRelay _trace_relay;
+
 	ov::PreciseTimer _force_keyframe_timer;
 
 	// 0: no force keyframe,  > 0: force keyframe by sum of duration
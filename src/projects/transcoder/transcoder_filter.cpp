@@ -32,6 +32,27 @@ std::shared_ptr<TranscodeFilter> TranscodeFilter::Create(int32_t id,
 	return filter;
 }
 
+std::shared_ptr<TranscodeFilter> TranscodeFilter::Create(const std::vector<int32_t>& ids,
+														 const std::shared_ptr<info::Stream>& input_stream_info, std::shared_ptr<MediaTrack> input_track,
+														 const std::shared_ptr<info::Stream>& output_stream_info, const std::vector<std::shared_ptr<MediaTrack>>& output_tracks,
+														 CompleteHandler complete_handler)
+{
+	if (ids.empty() || ids.size() != output_tracks.size())
+	{
+		return nullptr;
+	}
+
+	auto filter = std::make_shared<TranscodeFilter>();
+	filter->_ladder_ids = ids;
+	filter->_ladder_output_tracks = output_tracks;
+	if (filter->Configure(ids[0], input_stream_info, input_track, output_stream_info, output_tracks[0]) == false)
+	{
+		return nullptr;
+	}
+	filter->SetCompleteHandler(complete_handler);
+	return filter;
+}
+
 std::shared_ptr<TranscodeFilter> TranscodeFilter::Create(int32_t id,
 														 const std::shared_ptr<info::Stream>& output_stream_info, std::shared_ptr<MediaTrack> output_track,
 														 CompleteHandler complete_handler)
@@ -58,6 +79,11 @@ bool TranscodeFilter::Configure(int32_t id,
 	
 	_timestamp_jump_threshold = (int64_t)_input_track->GetTimeBase().GetTimescale() * PTS_INCREMENT_LIMIT;
 
+	for (size_t index = 0; index < std::max<size_t>(_ladder_ids.size(), 1); index++)
+	{
+		_trace_relays.push_back(std::make_unique<MediaTraceRelay>());
+	}
+
 	return CreateInternal();
 }
 
@@ -73,14 +99,25 @@ bool TranscodeFilter::CreateInternal()
 		_internal = nullptr;
 	}
 
+	for (auto &trace_relay : _trace_relays)
+	{
+		trace_relay->Clear();
+	}
+
 	switch (_input_track->GetMediaType())
 	{
 		case MediaType::Audio:
 			_internal = std::make_shared<FilterResampler>();
 			break;
-		case MediaType::Video:
-			_internal = std::make_shared<FilterRescaler>();
-			break;
+		case MediaType::Video: {
+			auto rescaler = std::make_shared<FilterRescaler>();
+			if (_ladder_output_tracks.size() > 1)
+			{
+				rescaler->SetLadderOutputTracks(_ladder_output_tracks);
+			}
+			_internal = rescaler;
+		}
+		break;
 		default:
 			logte("Unsupported media type in filter");
 			return false;
@@ -140,6 +177,14 @@ bool TranscodeFilter::SendBuffer(std::shared_ptr<MediaFrame> buffer)
 		return false;
 	}
 
+	if (MediaTrace::IsEnabled())
+	{
+		for (auto &trace_relay : _trace_relays)
+		{
+			trace_relay->Push(buffer->GetTrace());
+		}
+	}
+
 	return _internal->SendBuffer(std::move(buffer));
 }
 
@@ -205,6 +250,29 @@ void TranscodeFilter::OnComplete(std::shared_ptr<MediaFrame> frame)
 {
 	if (_complete_handler)
 	{
+		if (_ladder_ids.size() > 1)
+		{
+			// The rescaler sets the index of the output track as the track id
+			auto index = static_cast<size_t>(frame->GetTrackId());
+			if (index >= _ladder_ids.size())
+			{
+				return;
+			}
+
+			if (MediaTrace::IsEnabled())
+			{
+				frame->SetTrace(_trace_relays[index]->Pop(MediaTrace::Hop::Filter));
+			}
+
+			_complete_handler(_ladder_ids[index], frame);
+			return;
+		}
+
+		if (MediaTrace::IsEnabled())
+		{
+			frame->SetTrace(_trace_relays[0]->Pop(MediaTrace::Hop::Filter));
+		}
+
 		_complete_handler(_id, frame);
 	}
 }
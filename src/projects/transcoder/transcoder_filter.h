@@ -29,6 +29,14 @@ public:
 		const std::shared_ptr<info::Stream> &output_stream_info, std::shared_ptr<MediaTrack> output_track,
 		CompleteHandler complete_handler);
 
+	// ABR ladder: one video filter that scales the input track to several output tracks.
+	// Frames of output_tracks[i] are completed with filter_ids[i].
+	static std::shared_ptr<TranscodeFilter> Create(
+		const std::vector<int32_t> &filter_ids,
+		const std::shared_ptr<info::Stream> &input_stream_info, std::shared_ptr<MediaTrack> input_track,
+		const std::shared_ptr<info::Stream> &output_stream_info, const std::vector<std::shared_ptr<MediaTrack>> &output_tracks,
+		CompleteHandler complete_handler);
+
 	static std::shared_ptr<TranscodeFilter> Create(
 		int32_t filter_id,
 		const std::shared_ptr<info::Stream> &output_tsream_info, std::shared_ptr<MediaTrack> output_track,
@@ -60,6 +68,10 @@ private:
 
 	int32_t _id;
 
+	// Filter ids and output tracks of the ladder (empty if not a ladder)
+	std::vector<int32_t> _ladder_ids;
+	std::vector<std::shared_ptr<MediaTrack>> _ladder_output_tracks;
+
 	int64_t _last_timestamp = -1LL;
 	int64_t _timestamp_jump_threshold = 0LL;
 
@@ -72,4 +84,7 @@ private:
 
 	std::shared_mutex _mutex;
 	std::shared_ptr<FilterBase> _internal;
+
+	// One for each output track of the ladder (or one if not a ladder)
+	std::vector<std::unique_ptr<MediaTraceRelay>> _trace_relays;
 };
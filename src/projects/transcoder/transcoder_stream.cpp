@@ -11,8 +11,10 @@
 
 #include "config/config_manager.h"
 #include "modules/transcode_webhook/transcode_webhook.h"
+#include "monitoring/monitoring.h"
 #include "orchestrator/orchestrator.h"
 
+#include "filter/filter_rescaler.h"
 #include "transcoder_application.h"
 #include "transcoder_private.h"
 
@@ -43,6 +45,8 @@ TranscoderStream::TranscoderStream(const info::Application &application_info, co
 	// default output profiles configuration
 	_output_profiles_cfg = &(_application_info.GetConfig().GetOutputProfiles());
 
+	_input_stream_metrics = MonitorInstance->GetStreamMetrics(*_input_stream);
+
 	logtd("%s Trying to create transcode stream", _log_prefix.CStr());
 }
 
@@ -1198,6 +1202,14 @@ int32_t TranscoderStream::CreateFilters(std::shared_ptr<MediaFrame> buffer)
 		return created;
 	}
 
+	struct FilterGroup
+	{
+		std::shared_ptr<MediaTrack> input_track;
+		std::vector<MediaTrackId> filter_ids;
+		std::vector<std::shared_ptr<MediaTrack>> output_tracks;
+	};
+	std::vector<FilterGroup> groups;
+
 	// 2. Get Output Track of Encoders
 	auto filter_ids = decoder_to_filters_it->second;
 	for (auto &filter_id : filter_ids)
@@ -1232,17 +1244,94 @@ int32_t TranscoderStream::CreateFilters(std::shared_ptr<MediaFrame> buffer)
 			continue;
 		}
 
-		if (CreateFilter(filter_id, input_track, output_track) == false)
+		if (GetFilter(filter_id) != nullptr)
+		{
+			logtw("%s Filter already exists. Filter(%d)", _log_prefix.CStr(), filter_id);
+			created++;
+			continue;
+		}
+
+		// Group the video outputs that can share a ladder filter graph
+		bool grouped = false;
+		for (auto &group : groups)
+		{
+			if (group.input_track == input_track &&
+				FilterRescaler::IsLadderCompatible(input_track, group.output_tracks[0], output_track))
+			{
+				group.filter_ids.push_back(filter_id);
+				group.output_tracks.push_back(output_track);
+				grouped = true;
+				break;
+			}
+		}
+
+		if (grouped == false)
+		{
+			groups.push_back({input_track, {filter_id}, {output_track}});
+		}
+	}
+
+	// 3. Create Filters
+	for (auto &group : groups)
+	{
+		if (group.filter_ids.size() == 1)
+		{
+			if (CreateFilter(group.filter_ids[0], group.input_track, group.output_tracks[0]) == false)
+			{
+				continue;
+			}
+
+			created++;
+			continue;
+		}
+
+		if (CreateLadderFilter(group.filter_ids, group.input_track, group.output_tracks) == false)
 		{
 			continue;
 		}
 
-		created++;
+		created += group.filter_ids.size();
 	}
 
 	return created;
 }
 
+bool TranscoderStream::CreateLadderFilter(const std::vector<MediaTrackId> &filter_ids, std::shared_ptr<MediaTrack> input_track, const std::vector<std::shared_ptr<MediaTrack>> &output_tracks)
+{
+	auto input_stream = GetInputStream();
+	if(input_stream == nullptr)
+	{
+		logte("%s Could not found input stream", _log_prefix.CStr());
+		return false;
+	}
+
+	auto output_stream = GetOutputStreamByTrackId(output_tracks[0]->GetId());
+	if(output_stream == nullptr)
+	{
+		logte("%s Could not found output stream", _log_prefix.CStr());
+		return false;
+	}
+
+	std::vector<int32_t> ids(filter_ids.begin(), filter_ids.end());
+
+	auto filter = TranscodeFilter::Create(ids, input_stream, input_track, output_stream, output_tracks, bind(&TranscoderStream::OnFilteredFrame, this, std::placeholders::_1, std::placeholders::_2));
+	if (filter == nullptr)
+	{
+		logte("%s Failed to create ladder filter. Filter(%d), Outputs(%zu)", _log_prefix.CStr(), ids[0], ids.size());
+		return false;
+	}
+
+	// All filter ids of the ladder refer to the same filter
+	for (auto &filter_id : filter_ids)
+	{
+		SetFilter(filter_id, filter);
+	}
+
+	logtd("%s Created Ladder Filter. Filter(%d), Outputs(%zu)", _log_prefix.CStr(), ids[0], ids.size());
+
+	return true;
+}
+
 bool TranscoderStream::CreateFilter(MediaTrackId filter_id, std::shared_ptr<MediaTrack> input_track, std::shared_ptr<MediaTrack> output_track)
 {
 	if(GetFilter(filter_id) != nullptr)
@@ -1614,15 +1703,22 @@ void TranscoderStream::OnDecodedFrame(TranscodeResult result, MediaTrackId decod
 
 					for (int64_t filler_pts = start_pts; filler_pts < end_pts; filler_pts += duration_per_frame)
 					{
-						std::shared_ptr<MediaFrame> clone_frame = decoded_frame->CloneFrame(true);
+						// Only the audio filler is written (silence), the video filler references the last decoded picture
+						bool is_audio = (input_track->GetMediaType() == cmn::MediaType::Audio);
+						std::shared_ptr<MediaFrame> clone_frame = decoded_frame->CloneFrame(is_audio);
 						if (!clone_frame)
 						{
 							continue;
 						}
+
+						if (is_audio && (_input_stream_metrics != nullptr))
+						{
+							_input_stream_metrics->OnDecodedFrameCopied(clone_frame->GetBufferSize());
+						}
 						clone_frame->SetPts(filler_pts);
 						clone_frame->SetDuration(duration_per_frame);
 
-						if (input_track->GetMediaType() == cmn::MediaType::Audio)
+						if (is_audio)
 						{
 							if (end_pts - filler_pts < duration_per_frame)
 							{
@@ -1893,9 +1989,26 @@ void TranscoderStream::SpreadToFilters(MediaTrackId decoder_id, std::shared_ptr<
 	
 	auto filter_ids = filters->second;
 
+	// Filter ids of a ladder share the same filter, which needs only one frame
+	std::vector<std::shared_ptr<TranscodeFilter>> sent_filters;
+	uint32_t shared_count = 0;
+
 	for (auto &filter_id : filter_ids)
 	{
-		auto frame_clone = frame->CloneFrame(true);
+		auto filter = GetFilter(filter_id);
+		if (filter != nullptr)
+		{
+			if (std::find(sent_filters.begin(), sent_filters.end(), filter) != sent_filters.end())
+			{
+				continue;
+			}
+
+			sent_filters.push_back(filter);
+		}
+
+		// Each filter gets its own AVFrame referencing the refcounted buffers of the decoded frame.
+		// The buffers are never written by the transcoder, and libavfilter copies them only when a filter writes in place.
+		auto frame_clone = frame->CloneFrame();
 		if (frame_clone == nullptr)
 		{
 			logte("%s Failed to clone frame", _log_prefix.CStr());
@@ -1904,6 +2017,12 @@ void TranscoderStream::SpreadToFilters(MediaTrackId decoder_id, std::shared_ptr<
 		}
 
 		FilterFrame(filter_id, std::move(frame_clone));
+		shared_count++;
+	}
+
+	if ((_input_stream_metrics != nullptr) && (shared_count > 0))
+	{
+		_input_stream_metrics->OnDecodedFrameShared(shared_count, frame->GetBufferSize() * shared_count);
 	}
 }
 
@@ -24,6 +24,7 @@
 #include "transcoder_filter.h"
 #include "transcoder_stream_internal.h"
 #include "transcoder_events.h"
+#include "monitoring/stream_metrics.h"
 
 class TranscodeApplication;
 
@@ -147,6 +148,8 @@ private:
 
 	// Input Stream Info
 	std::shared_ptr<info::Stream> _input_stream;
+	// Metrics of the input stream, to count the decoded frames shared/copied
+	std::shared_ptr<mon::StreamMetrics> _input_stream_metrics;
 
 	// Output Stream Info
 	// [OUTPUT_STREAM_NAME, OUTPUT_stream]
@@ -228,6 +231,7 @@ private:
 
 	int32_t CreateFilters(std::shared_ptr<MediaFrame> buffer);
 	bool CreateFilter(MediaTrackId filter_id, std::shared_ptr<MediaTrack> input_track, std::shared_ptr<MediaTrack> output_track);
+	bool CreateLadderFilter(const std::vector<MediaTrackId> &filter_ids, std::shared_ptr<MediaTrack> input_track, const std::vector<std::shared_ptr<MediaTrack>> &output_tracks);
 	std::shared_ptr<TranscodeFilter> GetFilter(MediaTrackId filter_id);
 	void SetFilter(MediaTrackId filter_id, std::shared_ptr<TranscodeFilter> filter);
 	void RemoveFilters();